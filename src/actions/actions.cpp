@@ -1265,7 +1265,7 @@ impHandler(dumpGraphics)
 
     str.append(strprintf(",%f,", static_cast<double>(settings.guiAlpha)))
         .append(config.getBoolValue("adjustPerfomance") ? "1" : "0")
-        .append(config.getBoolValue("alphaCache") ? "1" : "0")
+        .append("0")
         .append(config.getBoolValue("enableMapReduce") ? "1" : "0")
         .append(config.getBoolValue("beingopacity") ? "1" : "0")
         .append(",")
@@ -28,6 +28,7 @@
 #include "game.h"
 #include "inventory.h"
 #include "item.h"
+#include "navigationmanager.h"
 #include "party.h"
 
 #include "actions/actiondef.h"
@@ -959,4 +960,36 @@ impHandler(serverConfGet)
     return true;
 }
 
+impHandler(findRoute)
+{
+    const std::string args = event.args;
+    if (args.empty() || !localPlayer || !Game::instance())
+        return false;
+
+    NavigationRoute route;
+    if (!NavigationManager::findRoute(Game::instance()->getCurrentMapName(),
+        localPlayer->getTileX(), localPlayer->getTileY(), args, route))
+    {
+        // TRANSLATORS: route command result
+        const std::string str = strprintf(_("Route to %s not found. "
+            "Only warps of already visited maps are known."),
+            args.c_str());
+        outStringNormal(event.tab, str, str);
+        return true;
+    }
+
+    // TRANSLATORS: route command result
+    std::string str = _("Route:");
+    FOR_EACH (NavigationRoute::const_iterator, it, route)
+    {
+        str.append(strprintf(" %s (%d,%d) ->", (*it).map.c_str(),
+            (*it).x, (*it).y));
+    }
+    str.append(" ").append(args);
+    outStringNormal(event.tab, str, str);
+    if (!route.empty())
+        localPlayer->navigateTo(route[0].x, route[0].y);
+    return true;
+}
+
 }  // namespace Actions
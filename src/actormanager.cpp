@@ -45,6 +45,7 @@
 
 #include "utils/checkutils.h"
 #include "utils/gettext.h"
+#include "utils/timer.h"
 
 #include "net/beinghandler.h"
 #include "net/charserverhandler.h"
@@ -52,6 +53,8 @@
 #include "net/playerhandler.h"
 #include "net/serverfeatures.h"
 
+#include "render/graphics.h"
+
 #include "resources/chatobject.h"
 #include "resources/iteminfo.h"
 
@@ -192,6 +195,7 @@ ActorManager::ActorManager() :
     mDeleteActors(),
     mBlockedBeings(),
     mMap(nullptr),
+    mVisibleArea(),
     mSpellHeal1(serverConfig.getValue("spellHeal1", "#lum")),
     mSpellHeal2(serverConfig.getValue("spellHeal2", "#inma")),
     mSpellItenplz(serverConfig.getValue("spellItenplz", "#itenplz")),
@@ -200,6 +204,8 @@ ActorManager::ActorManager() :
     mCyclePlayers(config.getBoolValue("cyclePlayers")),
     mCycleMonsters(config.getBoolValue("cycleMonsters")),
     mCycleNPC(config.getBoolValue("cycleNPC")),
+    mLogicTime(0),
+    mOffscreenCount(0),
     mExtMouseTargeting(config.getBoolValue("extMouseTargeting"))
 {
     config.addListener("targetDeadPlayers", this);
@@ -806,11 +812,37 @@ const ActorSprites &ActorManager::getAll() const
 void ActorManager::logic()
 {
     BLOCK_START("ActorManager::logic")
+    const unsigned int startTime = get_time_usec();
+    mOffscreenCount = 0;
+    if (viewport && mainGraphics)
+    {
+        // actors with sprites or particles near screen edges still visible
+        const int margin = mapTileSize * 4;
+        mVisibleArea.setAll(viewport->getCameraX() - margin,
+            viewport->getCameraY() - margin,
+            mainGraphics->mWidth + margin * 2,
+            mainGraphics->mHeight + margin * 2);
+    }
+    else
+    {
+        mVisibleArea.setAll(0, 0, 0, 0);
+    }
+
     for_actors
     {
-        if (*it)
-            (*it)->logic();
+        ActorSprite *const actor = *it;
+        if (!actor)
+            continue;
+        const bool offscreen = mVisibleArea.width
+            && actor != localPlayer
+            && !mVisibleArea.isPointInRect(actor->getPixelX(),
+            actor->getPixelY());
+        actor->setOffscreen(offscreen);
+        if (offscreen)
+            mOffscreenCount++;
+        actor->logic();
     }
+    mLogicTime = get_time_usec() - startTime;
 
     if (mDeleteActors.empty())
     {
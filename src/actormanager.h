@@ -25,6 +25,8 @@
 
 #include "flooritem.h"
 
+#include "gui/rect.h"
+
 #include "listeners/configlistener.h"
 
 #include "utils/stringmap.h"
@@ -214,6 +216,24 @@ class ActorManager final: public ConfigListener
          */
         void logic();
 
+        /**
+         * Returns visible map area in pixels used for off-screen logic.
+         */
+        const Rect &getVisibleArea() const A_WARN_UNUSED
+        { return mVisibleArea; }
+
+        /**
+         * Returns time of last actors logic tick in microseconds.
+         */
+        unsigned int getLogicTime() const A_WARN_UNUSED
+        { return mLogicTime; }
+
+        /**
+         * Returns number of actors updated as off-screen in last tick.
+         */
+        int getOffscreenCount() const A_WARN_UNUSED
+        { return mOffscreenCount; }
+
         /**
          * Destroys all ActorSprites except the local player
          */
@@ -350,6 +370,7 @@ class ActorManager final: public ConfigListener
         ActorSprites mDeleteActors;
         std::set<uint32_t> mBlockedBeings;
         Map *mMap;
+        Rect mVisibleArea;
         std::string mSpellHeal1;
         std::string mSpellHeal2;
         std::string mSpellItenplz;
@@ -358,6 +379,8 @@ class ActorManager final: public ConfigListener
         bool mCyclePlayers;
         bool mCycleMonsters;
         bool mCycleNPC;
+        unsigned int mLogicTime;
+        int mOffscreenCount;
         bool mExtMouseTargeting;
 
 #define defVarsP(mob) \
@@ -23,6 +23,7 @@
 #include "animatedsprite.h"
 
 #include "animationdelayload.h"
+#include "logger.h"
 
 #include "render/graphics.h"
 
@@ -33,6 +34,8 @@
 #include "resources/resourcemanager.h"
 #include "resources/spriteaction.h"
 
+#include "resources/map/mapconsts.h"
+
 #include "utils/delete2.h"
 
 #include "debug.h"
@@ -141,7 +144,11 @@ bool AnimatedSprite::play(const std::string &spriteAction)
         return true;
     }
 
-    const Action *const action = mSprite->getAction(spriteAction, mNumber);
+    return playAction(mSprite->getAction(spriteAction, mNumber));
+}
+
+bool AnimatedSprite::playAction(const Action *const action)
+{
     if (!action)
         return false;
 
@@ -197,6 +204,13 @@ bool AnimatedSprite::updateCurrentAnimation(const unsigned int time)
 
     mFrameTime += time;
 
+    // after long time without updates skip whole animation cycles,
+    // but keep one cycle for not miss terminators and jumps
+    const unsigned int duration = static_cast<unsigned int>(
+        mAnimation->mDuration);
+    if (duration > 0 && mFrameTime > duration * 2)
+        mFrameTime = duration + mFrameTime % duration;
+
     while ((mFrameTime > static_cast<unsigned int>(mFrame->delay)
            && mFrame->delay > 0) || (mFrame->type != Frame::ANIMATION
            && mFrame->type != Frame::PAUSE))
@@ -222,24 +236,13 @@ bool AnimatedSprite::updateCurrentAnimation(const unsigned int time)
         {
             if (mFrame->rand == 100 || rand() % 100 <= mFrame->rand)
             {
-                for (size_t i = 0; i < mAnimation->getLength(); i ++)
+                // label index resolved at sprite load time
+                if (mFrame->nextFrame >= 0)
                 {
-                    const Frame *const frame = &mAnimation->mFrames[i];
-                    if (frame->type == Frame::LABEL
-                        && mFrame->nextAction == frame->nextAction)
-                    {
-                        mFrameIndex = static_cast<unsigned int>(i);
-                        if (mFrameIndex >= static_cast<unsigned int>(
-                            mAnimation->getLength()))
-                        {
-                            mFrameIndex = 0;
-                        }
-
-                        mFrame = &mAnimation->mFrames[mFrameIndex];
-
-                        fail = false;
-                        break;
-                    }
+                    mFrameIndex = static_cast<unsigned int>(
+                        mFrame->nextFrame);
+                    mFrame = &mAnimation->mFrames[mFrameIndex];
+                    fail = false;
                 }
             }
             else
@@ -251,7 +254,15 @@ bool AnimatedSprite::updateCurrentAnimation(const unsigned int time)
         {
             if (mFrame->rand == 100 || rand() % 100 <= mFrame->rand)
             {
-                play(mFrame->nextAction);
+                const Action *const action = mSprite
+                    ? mSprite->getAction(mFrame->nextActionId, mNumber)
+                    : nullptr;
+                if (!action)
+                {
+                    logger->log("Warning: no action \"%s\" defined!",
+                        mFrame->nextAction.c_str());
+                }
+                playAction(action);
                 return true;
             }
         }
@@ -294,7 +305,20 @@ void AnimatedSprite::draw(Graphics *const graphics,
 {
     FUNC_BLOCK("AnimatedSprite::draw", 1)
     if (!mFrame || !mFrame->image)
+    {
+        if (mDelayLoad)
+        {
+            // sprite still loading, show placeholder in middle of tile
+            const Image *const placeholder = DelayedManager::getPlaceholder();
+            if (placeholder)
+            {
+                graphics->drawImage(placeholder,
+                    posX + (mapTileSize - placeholder->getWidth()) / 2,
+                    posY + (mapTileSize - placeholder->getHeight()) / 2);
+            }
+        }
         return;
+    }
 
     Image *const image = mFrame->image;
     if (image->getAlpha() != mAlpha)
@@ -428,3 +452,9 @@ void AnimatedSprite::clearDelayLoad()
 {
     mDelayLoad = nullptr;
 }
+
+void AnimatedSprite::setDelayPriority(const int priority)
+{
+    if (mDelayLoad)
+        DelayedManager::updatePriority(mDelayLoad, priority);
+}
@@ -96,6 +96,8 @@ class AnimatedSprite final : public Sprite
 
         void clearDelayLoad();
 
+        void setDelayPriority(const int priority) override final;
+
         void setSprite(SpriteDef *const sprite)
         { mSprite = sprite; }
 
@@ -125,6 +127,8 @@ class AnimatedSprite final : public Sprite
     private:
         bool updateCurrentAnimation(const unsigned int dt);
 
+        bool playAction(const Action *const action);
+
         void setDelayLoad(const std::string &filename, const int variant);
 
         SpriteDirection::Type mDirection;  /**< The sprite direction. */
@@ -33,6 +33,8 @@
 
 #include "utils/physfstools.h"
 
+#include <SDL_timer.h>
+
 #include "debug.h"
 
 static void init()
@@ -152,3 +154,100 @@ TEST(AnimatedSprite, basic2)
     delete client;
     client = nullptr;
 }
+
+TEST(AnimatedSprite, invisible)
+{
+    client = new Client;
+    init();
+    AnimatedSprite *sprite = AnimatedSprite::load(
+        "graphics/sprites/test.xml", 0);
+    sprite->play(SpriteAction::SIT);
+
+    EXPECT_EQ(false, sprite->update(1));
+    EXPECT_EQ(0, sprite->getFrameIndex());
+
+    // sprite not updated for about 22 days, cycle is 85 + 10 ms
+    const int cycles = 20000000;
+    EXPECT_EQ(false, sprite->update(1 + 95 * cycles + 50));
+    EXPECT_EQ(0, sprite->getFrameIndex());
+    EXPECT_EQ(50, sprite->getFrameTime());
+
+    EXPECT_EQ(true, sprite->update(1 + 95 * cycles + 90));
+    EXPECT_EQ(1, sprite->getFrameIndex());
+    EXPECT_EQ(5, sprite->getFrameTime());
+
+    delete sprite;
+    delete client;
+    client = nullptr;
+}
+
+TEST(AnimatedSprite, DISABLED_benchmark)
+{
+    client = new Client;
+    init();
+    const int sz = 5000;
+    AnimatedSprite *sprites[sz];
+    for (int f = 0; f < sz; f ++)
+    {
+        sprites[f] = AnimatedSprite::load("graphics/sprites/test.xml", 0);
+        sprites[f]->play(SpriteAction::STAND);
+    }
+
+    // label and goto frames must be never shown
+    int errors = 0;
+    const uint32_t startTime = SDL_GetTicks();
+    for (int time = 1; time < 2000; time ++)
+    {
+        for (int f = 0; f < sz; f ++)
+        {
+            sprites[f]->update(time);
+            const Frame *const frame = sprites[f]->getFrame();
+            if (!frame || frame->type != Frame::ANIMATION)
+                errors ++;
+        }
+    }
+    logger->log("animatedsprite: %d sprites updated 2000 times in %d ms",
+        sz, static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(0, errors);
+
+    for (int f = 0; f < sz; f ++)
+        EXPECT_NE(nullptr, sprites[f]->getFrame());
+    for (int f = 0; f < sz; f ++)
+        delete sprites[f];
+
+    delete client;
+    client = nullptr;
+}
+
+TEST(AnimatedSprite, actions)
+{
+    client = new Client;
+    init();
+    AnimatedSprite *sprite = AnimatedSprite::load(
+        "graphics/sprites/test.xml", 0);
+    const SpriteDef *const def = sprite->getSprite();
+    ASSERT_NE(nullptr, def);
+
+    const int standId = SpriteDef::findActionId(SpriteAction::STAND);
+    const int sitId = SpriteDef::findActionId(SpriteAction::SIT);
+    EXPECT_TRUE(standId >= 0);
+    EXPECT_TRUE(sitId >= 0);
+    EXPECT_NE(standId, sitId);
+
+    const Action *const stand = def->getAction(standId, 100);
+    EXPECT_NE(nullptr, stand);
+    EXPECT_EQ(stand, def->getAction(SpriteAction::STAND, 100));
+    EXPECT_NE(stand, def->getAction(sitId, 100));
+
+    // numbers without own actions use actions for 100
+    EXPECT_EQ(stand, def->getAction(standId, 0));
+    EXPECT_EQ(stand, def->getAction(standId, 50));
+    EXPECT_EQ(stand, def->getAction(standId, 1000));
+
+    EXPECT_EQ(nullptr, def->getAction(-1, 100));
+    EXPECT_EQ(nullptr, def->getAction(100000, 100));
+
+    delete sprite;
+    delete client;
+    client = nullptr;
+}
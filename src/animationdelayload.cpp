@@ -33,7 +33,9 @@ AnimationDelayLoad::AnimationDelayLoad(const std::string &fileName,
     mFileName(fileName),
     mVariant(variant),
     mSprite(sprite),
-    mAction(SpriteAction::STAND)
+    mAction(SpriteAction::STAND),
+    mIter(),
+    mPriority(DELAY_PRIORITY_DEFAULT)
 {
 }
 
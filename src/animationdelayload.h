@@ -21,6 +21,8 @@
 #ifndef ANIMATIONDELAYLOAD_H
 #define ANIMATIONDELAYLOAD_H
 
+#include "resources/delayedmanager.h"
+
 #include <string>
 
 #include "localconsts.h"
@@ -29,6 +31,8 @@ class AnimatedSprite;
 
 class AnimationDelayLoad final
 {
+    friend class DelayedManager;
+
     public:
         AnimationDelayLoad(const std::string &fileName,
                            const int variant, AnimatedSprite *const sprite);
@@ -44,11 +48,16 @@ class AnimationDelayLoad final
         void setAction(const std::string &action)
         { mAction = action; }
 
+        const std::string &getFileName() const A_WARN_UNUSED
+        { return mFileName; }
+
     private:
         std::string mFileName;
         int mVariant;
         AnimatedSprite *mSprite;
         std::string mAction;
+        DelayedAnimIter mIter;
+        int mPriority;
 };
 
 #endif  // ANIMATIONDELAYLOAD_H
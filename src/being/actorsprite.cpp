@@ -72,7 +72,8 @@ ActorSprite::ActorSprite(const int id) :
     mMustResetParticles(false),
     mPoison(false),
     mHaveCart(false),
-    mRiding(false)
+    mRiding(false),
+    mOffscreen(false)
 {
 }
 
@@ -110,6 +111,15 @@ void ActorSprite::draw1(Graphics *const graphics,
 void ActorSprite::logic()
 {
     BLOCK_START("ActorSprite::logic")
+    if (mOffscreen)
+    {
+        // Keep attached particles in place, animations and status
+        // particles resets wait until actor became visible
+        mChildParticleEffects.moveTo(mPos.x, mPos.y);
+        BLOCK_END("ActorSprite::logic")
+        return;
+    }
+
     // Update sprite animations
     update(tick_time * MILLISECONDS_IN_A_TICK);
 
@@ -166,6 +166,16 @@ class ActorSprite notfinal : public CompoundSprite, public Actor
         bool getPoison() const A_WARN_UNUSED
         { return mPoison; }
 
+        /**
+         * Marks actor as outside of visible area. Off-screen actors skip
+         * sprite animation, it catches up on first visible logic tick.
+         */
+        void setOffscreen(const bool b)
+        { mOffscreen = b; }
+
+        bool isOffscreen() const A_WARN_UNUSED
+        { return mOffscreen; }
+
         void setHaveCart(const bool b)
         { mHaveCart = b; }
 
@@ -239,6 +249,7 @@ class ActorSprite notfinal : public CompoundSprite, public Actor
         bool mPoison;
         bool mHaveCart;
         bool mRiding;
+        bool mOffscreen;
 };
 
 #endif  // BEING_ACTORSPRITE_H
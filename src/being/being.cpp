@@ -35,6 +35,7 @@
 
 #include "being/beingcacheentry.h"
 #include "being/beingflag.h"
+#include "being/beingspritecache.h"
 #include "being/beingspeech.h"
 #include "being/playerinfo.h"
 #include "being/playerrelations.h"
@@ -64,8 +65,11 @@
 #include "net/playerhandler.h"
 #include "net/serverfeatures.h"
 
+#include "render/graphics.h"
+
 #include "resources/attack.h"
 #include "resources/chatobject.h"
+#include "resources/delayedmanager.h"
 #include "resources/emoteinfo.h"
 #include "resources/emotesprite.h"
 #include "resources/horseinfo.h"
@@ -92,6 +96,7 @@
 #include "utils/delete2.h"
 #include "utils/files.h"
 #include "utils/gettext.h"
+#include "utils/hashmap.h"
 #include "utils/timer.h"
 
 #include "debug.h"
@@ -121,6 +126,9 @@ bool Being::mUseDiagonal = true;
 int Being::mAwayEffect = -1;
 
 std::list<BeingCacheEntry*> beingInfoCache;
+typedef std::list<BeingCacheEntry*>::iterator BeingInfoCacheIter;
+typedef HASHMAP<int, BeingInfoCacheIter> BeingInfoCacheIndex;
+static BeingInfoCacheIndex beingInfoCacheIndex;
 typedef std::map<int, Guild*>::const_iterator GuildsMapCIter;
 typedef std::map<int, int>::const_iterator IntMapCIter;
 
@@ -341,6 +349,7 @@ void Being::setSubtype(const uint16_t subtype, const uint16_t look)
                 0,
                 mInfo->getColor(mLook));
             mYDiff = mInfo->getSortOffsetY();
+            soundManager.preloadSfx(mInfo);
         }
     }
 #ifdef EATHENA_SUPPORT
@@ -1513,19 +1522,24 @@ void Being::logic()
     if (mSpeechTime == 0 && mText)
         delete2(mText)
 
-    const int time = tick_time * MILLISECONDS_IN_A_TICK;
-    if (mEmotionSprite)
-        mEmotionSprite->update(time);
+    // Off-screen beings update only position and timers,
+    // animations catch up lazily when being became visible.
+    if (!mOffscreen)
+    {
+        const int time = tick_time * MILLISECONDS_IN_A_TICK;
+        if (mEmotionSprite)
+            mEmotionSprite->update(time);
 #ifdef EATHENA_SUPPORT
-    if (mHorseSprite)
-        mHorseSprite->update(time);
+        if (mHorseSprite)
+            mHorseSprite->update(time);
 #endif
 
-    if (mAnimationEffect)
-    {
-        mAnimationEffect->update(time);
-        if (mAnimationEffect->isTerminated())
-            delete2(mAnimationEffect)
+        if (mAnimationEffect)
+        {
+            mAnimationEffect->update(time);
+            if (mAnimationEffect->isTerminated())
+                delete2(mAnimationEffect)
+        }
     }
 
     int frameCount = static_cast<int>(getFrameCount());
@@ -2206,13 +2220,15 @@ void Being::setSprite(const unsigned int slot, const int id,
             if (color.empty())
                 color = info.getDyeColorsString(colorId);
 
-            equipmentSprite = AnimatedSprite::delayedLoad(
-                paths.getStringValue("sprites").append(
-                combineDye(filename, color)));
+            equipmentSprite = BeingSpriteCache::get(id, mGender,
+                mSubType, color);
         }
 
         if (equipmentSprite)
+        {
             equipmentSprite->setSpriteDirection(getSpriteDirection());
+            equipmentSprite->setDelayPriority(getDelayPriority());
+        }
 
         CompoundSprite::setSprite(slot, equipmentSprite);
         mSpriteDraw[slot] = id;
@@ -2385,10 +2401,13 @@ void Being::addToCache() const
     {
         entry = new BeingCacheEntry(getId());
         beingInfoCache.push_front(entry);
+        beingInfoCacheIndex[getId()] = beingInfoCache.begin();
 
         if (beingInfoCache.size() >= CACHE_SIZE)
         {
-            delete beingInfoCache.back();
+            BeingCacheEntry *const last = beingInfoCache.back();
+            beingInfoCacheIndex.erase(last->getId());
+            delete last;
             beingInfoCache.pop_back();
         }
     }
@@ -2422,23 +2441,20 @@ void Being::addToCache() const
 
 BeingCacheEntry* Being::getCacheEntry(const int id)
 {
-    FOR_EACH (std::list<BeingCacheEntry*>::iterator, i, beingInfoCache)
-    {
-        if (!*i)
-            continue;
+    const BeingInfoCacheIndex::const_iterator it
+        = beingInfoCacheIndex.find(id);
+    if (it == beingInfoCacheIndex.end())
+        return nullptr;
 
-        if (id == (*i)->getId())
-        {
-            // Raise priority: move it to front
-            if ((*i)->getTime() + 120 < cur_time)
-            {
-                beingInfoCache.splice(beingInfoCache.begin(),
-                                      beingInfoCache, i);
-            }
-            return *i;
-        }
+    // splice keep list iterators valid, so index not need update
+    const BeingInfoCacheIter i = (*it).second;
+    // Raise priority: move it to front
+    if ((*i)->getTime() + 120 < cur_time)
+    {
+        beingInfoCache.splice(beingInfoCache.begin(),
+                              beingInfoCache, i);
     }
-    return nullptr;
+    return *i;
 }
 
 
@@ -3058,6 +3074,8 @@ void Being::clearCache()
 {
     delete_all(beingInfoCache);
     beingInfoCache.clear();
+    beingInfoCacheIndex.clear();
+    BeingSpriteCache::clear();
 }
 
 void Being::updateComment()
@@ -3538,6 +3556,23 @@ void Being::setTileCoords(const int x, const int y)
         mFixedOffsetY = mOffsetY;
         mNeedPosUpdate = true;
     }
+    setDelayPriority(getDelayPriority());
+}
+
+int Being::getDelayPriority() const
+{
+    if (!localPlayer || localPlayer == this)
+        return 0;
+    const int dx = abs(mX - localPlayer->getTileX());
+    const int dy = abs(mY - localPlayer->getTileY());
+    const int dist = dx > dy ? dx : dy;
+    if (mainGraphics && (dx * mapTileSize * 2 > mainGraphics->mWidth
+        || dy * mapTileSize * 2 > mainGraphics->mHeight))
+    {
+        // out of screen
+        return DELAY_PRIORITY_DEFAULT + dist;
+    }
+    return dist;
 }
 
 void Being::setMap(Map *const map)
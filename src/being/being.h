@@ -1017,6 +1017,12 @@ class Being notfinal : public ActorSprite,
         bool mIsGM;
 
     private:
+        /**
+         * Returns load priority for delayed sprites. Near and visible beings
+         * loaded first.
+         */
+        int getDelayPriority() const A_WARN_UNUSED;
+
         /**
          * Calculates the offset in the given directions.
          * If walking in direction 'neg' the value is negated.
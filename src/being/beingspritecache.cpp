@@ -0,0 +1,184 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "being/beingspritecache.h"
+
+#include "animatedsprite.h"
+#include "configuration.h"
+
+#include "resources/iteminfo.h"
+#include "resources/resourcemanager.h"
+#include "resources/spriteaction.h"
+#include "resources/spritedef.h"
+
+#include "resources/db/itemdb.h"
+
+#include "utils/stringutils.h"
+#include "utils/timer.h"
+
+#include "debug.h"
+
+namespace
+{
+    const size_t cacheMaxSize = 1000;
+    const unsigned int spritesMaxSize = 100;
+}  // namespace
+
+BeingSpriteCache::Entries BeingSpriteCache::mEntries;
+BeingSpriteCache::SpritesList BeingSpriteCache::mSprites;
+unsigned int BeingSpriteCache::mLoaded = 0;
+unsigned int BeingSpriteCache::mHits = 0;
+unsigned int BeingSpriteCache::mMisses = 0;
+unsigned int BeingSpriteCache::mResolveTime = 0;
+
+uint64_t BeingSpriteCache::getKey(const int id,
+                                  const Gender::Type gender,
+                                  const int subType,
+                                  const std::string &color)
+{
+    // FNV-1a, key collisions checked by entry fields
+    uint32_t hash = 2166136261U;
+    const size_t sz = color.size();
+    for (size_t f = 0; f < sz; f ++)
+    {
+        hash ^= static_cast<unsigned char>(color[f]);
+        hash *= 16777619U;
+    }
+    hash ^= static_cast<uint32_t>(subType) * 2654435761U;
+    hash ^= static_cast<uint32_t>(gender) << 29;
+    return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) | hash;
+}
+
+void BeingSpriteCache::addSprite(BeingSpriteCacheEntry &entry,
+                                 const uint64_t key,
+                                 SpriteDef *const sprite)
+{
+    // cache keep reference given by resource manager
+    entry.sprite = sprite;
+    mSprites.push_front(key);
+    entry.lruIter = mSprites.begin();
+    mLoaded ++;
+
+    // release least recently used sprite
+    if (mLoaded > spritesMaxSize)
+    {
+        const EntriesIter it = mEntries.find(mSprites.back());
+        if (it != mEntries.end())
+            removeSprite((*it).second);
+    }
+}
+
+void BeingSpriteCache::removeSprite(BeingSpriteCacheEntry &entry)
+{
+    if (!entry.sprite)
+        return;
+    entry.sprite->decRef();
+    entry.sprite = nullptr;
+    mSprites.erase(entry.lruIter);
+    mLoaded --;
+}
+
+AnimatedSprite *BeingSpriteCache::get(const int id,
+                                      const Gender::Type gender,
+                                      const int subType,
+                                      const std::string &color)
+{
+    const uint64_t key = getKey(id, gender, subType, color);
+    EntriesIter it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        BeingSpriteCacheEntry &entry = (*it).second;
+        if (entry.id == id
+            && entry.gender == gender
+            && entry.subType == subType
+            && entry.color == color)
+        {
+            mHits ++;
+            if (entry.path.empty())
+                return nullptr;
+            if (entry.sprite)
+            {
+                mSprites.splice(mSprites.begin(), mSprites, entry.lruIter);
+            }
+            else
+            {
+                // sprite was not loaded yet, or was released by cache
+                SpriteDef *const def = static_cast<SpriteDef*>(
+                    ResourceManager::getInstance()->getFromCache(
+                    entry.path, 0));
+                if (def)
+                    addSprite(entry, key, def);
+            }
+            if (entry.sprite)
+            {
+                AnimatedSprite *const sprite = new AnimatedSprite(
+                    entry.sprite);
+                sprite->play(SpriteAction::STAND);
+                return sprite;
+            }
+            return AnimatedSprite::delayedLoad(entry.path);
+        }
+    }
+
+    mMisses ++;
+    const unsigned int startTime = get_time_usec();
+    if (it == mEntries.end() && mEntries.size() >= cacheMaxSize)
+    {
+        clear();
+        it = mEntries.end();
+    }
+
+    // on key collision old entry replaced
+    BeingSpriteCacheEntry &entry = it != mEntries.end()
+        ? (*it).second : mEntries[key];
+    removeSprite(entry);
+    entry.id = id;
+    entry.gender = gender;
+    entry.subType = subType;
+    entry.color = color;
+    entry.path.clear();
+    AnimatedSprite *sprite = nullptr;
+    const std::string &filename = ItemDB::get(id).getSprite(gender, subType);
+    if (!filename.empty())
+    {
+        entry.path = paths.getStringValue("sprites").append(
+            combineDye(filename, color));
+        sprite = AnimatedSprite::delayedLoad(entry.path);
+        SpriteDef *const def = static_cast<SpriteDef*>(ResourceManager::
+            getInstance()->getFromCache(entry.path, 0));
+        if (def)
+            addSprite(entry, key, def);
+    }
+    mResolveTime += get_time_usec() - startTime;
+    return sprite;
+}
+
+void BeingSpriteCache::clear()
+{
+    FOR_EACH (EntriesIter, it, mEntries)
+    {
+        SpriteDef *const sprite = (*it).second.sprite;
+        if (sprite)
+            sprite->decRef();
+    }
+    mEntries.clear();
+    mSprites.clear();
+    mLoaded = 0;
+}
@@ -0,0 +1,123 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BEING_BEINGSPRITECACHE_H
+#define BEING_BEINGSPRITECACHE_H
+
+#include "enums/being/gender.h"
+
+#include "utils/hashmap.h"
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include <list>
+#include <string>
+
+#include "localconsts.h"
+
+class AnimatedSprite;
+class SpriteDef;
+
+struct BeingSpriteCacheEntry final
+{
+    BeingSpriteCacheEntry() :
+        id(0),
+        gender(Gender::UNSPECIFIED),
+        subType(0),
+        color(),
+        path(),
+        sprite(nullptr),
+        lruIter()
+    {
+    }
+
+    int id;
+    Gender::Type gender;
+    int subType;
+    std::string color;  /**< Dye color from key. */
+    std::string path;   /**< Resolved sprite path with dye. */
+    SpriteDef *sprite;  /**< Loaded sprite, shared by all beings. */
+    std::list<uint64_t>::iterator lruIter;  /**< Place in used sprites. */
+};
+
+/**
+ * Cache for resolved equipment and look sprites of beings.
+ * Beings with same appearance reuse resolved paths and loaded sprites.
+ * Only limited number of recently used sprites kept loaded by cache,
+ * other sprites can be released by resource manager.
+ */
+class BeingSpriteCache final
+{
+    public:
+        /**
+         * Returns new sprite for item in given appearance,
+         * or nullptr if item have no sprite.
+         */
+        static AnimatedSprite *get(const int id,
+                                   const Gender::Type gender,
+                                   const int subType,
+                                   const std::string &color) A_WARN_UNUSED;
+
+        static void clear();
+
+        static unsigned int getHits() A_WARN_UNUSED
+        { return mHits; }
+
+        static unsigned int getMisses() A_WARN_UNUSED
+        { return mMisses; }
+
+        static unsigned int getSize() A_WARN_UNUSED
+        { return static_cast<unsigned int>(mEntries.size()); }
+
+        /**
+         * Average resolve time of cache miss in microseconds.
+         */
+        static unsigned int getResolveTime() A_WARN_UNUSED
+        { return mMisses ? mResolveTime / mMisses : 0; }
+
+    private:
+        static uint64_t getKey(const int id,
+                               const Gender::Type gender,
+                               const int subType,
+                               const std::string &color) A_WARN_UNUSED;
+
+        static void addSprite(BeingSpriteCacheEntry &entry,
+                              const uint64_t key,
+                              SpriteDef *const sprite);
+
+        static void removeSprite(BeingSpriteCacheEntry &entry);
+
+        typedef HASHMAP<uint64_t, BeingSpriteCacheEntry> Entries;
+        typedef Entries::iterator EntriesIter;
+        typedef std::list<uint64_t> SpritesList;
+
+        static Entries mEntries;
+        static SpritesList mSprites;  /**< Loaded sprites, last used first */
+        static unsigned int mLoaded;
+        static unsigned int mHits;
+        static unsigned int mMisses;
+        static unsigned int mResolveTime;
+};
+
+#endif  // BEING_BEINGSPRITECACHE_H
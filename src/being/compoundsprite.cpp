@@ -556,6 +556,15 @@ bool CompoundSprite::updateNumber(const unsigned num)
     return res;
 }
 
+void CompoundSprite::setDelayPriority(const int priority)
+{
+    FOR_EACH (SpriteConstIterator, it, mSprites)
+    {
+        if (*it)
+            (*it)->setDelayPriority(priority);
+    }
+}
+
 CompoundItem::CompoundItem() :
     data(),
     image(nullptr),
@@ -116,6 +116,8 @@ class CompoundSprite notfinal : public Sprite
 
         bool updateNumber(const unsigned num) override final;
 
+        void setDelayPriority(const int priority) override final;
+
         static void setEnableDelay(bool b)
         { mEnableDelay = b; }
 
@@ -133,7 +133,8 @@ PlayerRelationsManager::PlayerRelationsManager() :
     mIgnoreStrategy(nullptr),
     mRelations(),
     mListeners(),
-    mIgnoreStrategies()
+    mIgnoreStrategies(),
+    mUnsecureChars()
 {
 }
 
@@ -211,6 +212,10 @@ void PlayerRelationsManager::init()
 {
     load();
 
+    config.removeListeners(this);
+    config.addListener("unsecureChars", this);
+    mUnsecureChars.buildChars(config.getStringValue("unsecureChars"));
+
     if (!mPersistIgnores)
     {
         clear();  // Yes, we still keep them around in the config file
@@ -601,22 +606,17 @@ bool PlayerRelationsManager::isGoodName(Being *const being) const
     return status;
 }
 
-bool PlayerRelationsManager::checkName(const std::string &name)
+bool PlayerRelationsManager::checkName(const std::string &name) const
 {
     const size_t size = name.size();
-    const std::string check = config.getStringValue("unsecureChars");
-    const std::string lastChar = name.substr(size - 1, 1);
+    const char lastChar = name[size - 1];
 
-    if (name.substr(0, 1) == " " || lastChar == " " || lastChar == "."
+    if (name[0] == ' ' || lastChar == ' ' || lastChar == '.'
         || name.find("  ") != std::string::npos)
     {
         return false;
     }
-    else if (check.empty())
-    {
-        return true;
-    }
-    else if (name.find_first_of(check) != std::string::npos)
+    else if (mUnsecureChars.find(name) != std::string::npos)
     {
         return false;
     }
@@ -626,4 +626,10 @@ bool PlayerRelationsManager::checkName(const std::string &name)
     }
 }
 
+void PlayerRelationsManager::optionChanged(const std::string &name)
+{
+    if (name == "unsecureChars")
+        mUnsecureChars.buildChars(config.getStringValue("unsecureChars"));
+}
+
 PlayerRelationsManager player_relations;
@@ -23,10 +23,12 @@
 #ifndef BEING_PLAYERRELATIONS_H
 #define BEING_PLAYERRELATIONS_H
 
-#include "utils/stringvector.h"
+#include "utils/stringmatcher.h"
 
 #include "being/playerrelation.h"
 
+#include "listeners/configlistener.h"
+
 #include <list>
 #include <map>
 
@@ -41,7 +43,7 @@ class PlayerRelationsListener;
  * preferences the user of the local client has wrt other players (identified
  * by std::string).
  */
-class PlayerRelationsManager final
+class PlayerRelationsManager final : public ConfigListener
 {
     public:
         PlayerRelationsManager();
@@ -187,6 +189,8 @@ class PlayerRelationsManager final
 
         bool checkBadRelation(const std::string &name) const A_WARN_UNUSED;
 
+        void optionChanged(const std::string &name) override final;
+
     private:
         void signalUpdate(const std::string &name);
 
@@ -194,12 +198,13 @@ class PlayerRelationsManager final
                                // ignored data upon reloading
         unsigned int mDefaultPermissions;
 
-        static bool checkName(const std::string &name) A_WARN_UNUSED;
+        bool checkName(const std::string &name) const A_WARN_UNUSED;
 
         PlayerIgnoreStrategy *mIgnoreStrategy;
         std::map<std::string, PlayerRelation *> mRelations;
         std::list<PlayerRelationsListener *> mListeners;
         std::vector<PlayerIgnoreStrategy *> mIgnoreStrategies;
+        StringMatcher mUnsecureChars;
 };
 
 
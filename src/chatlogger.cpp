@@ -38,44 +38,50 @@
 
 #include "debug.h"
 
+// max number of simultaneously opened chat log files
+static const size_t maxOpenedFiles = 20;
+
 ChatLogger *chatLogger = nullptr;
 
 ChatLogger::ChatLogger() :
-    mLogFile(),
+    mFiles(),
     mLogDir(),
     mBaseLogDir(),
     mServerName(),
-    mLogFileName()
+    mDirTime(0),
+    mNeedFlush(false)
 {
 }
 
 ChatLogger::~ChatLogger()
 {
-    if (mLogFile.is_open())
-        mLogFile.close();
+    closeFiles();
 }
 
-void ChatLogger::setLogFile(const std::string &logFilename)
+void ChatLogger::closeFiles()
 {
-    if (mLogFile.is_open())
-        mLogFile.close();
-
-    mLogFile.open(logFilename.c_str(), std::ios_base::app);
-    mLogFileName = logFilename;
-
-    if (!mLogFile.is_open())
-    {
-        std::cout << "Warning: error while opening " << logFilename <<
-            " for writing.\n";
-    }
+    FOR_EACH (LogFiles::iterator, it, mFiles)
+        delete (*it).second;
+    mFiles.clear();
+    mNeedFlush = false;
 }
 
-void ChatLogger::setLogDir(const std::string &logDir)
+void ChatLogger::updateLogDir(const time_t now)
 {
-    mLogDir = logDir;
+    // log directory depend on date, so check it again after midnight
+    struct tm *const timeinfo = localtime(&now);
+    timeinfo->tm_sec = 0;
+    timeinfo->tm_min = 0;
+    timeinfo->tm_hour = 0;
+    timeinfo->tm_mday ++;
+    mDirTime = mktime(timeinfo);
+
+    const std::string logDir = getDir();
+    if (logDir == mLogDir && !mFiles.empty())
+        return;
 
-    if (mLogFile.is_open())
-        mLogFile.close();
+    closeFiles();
+    mLogDir = logDir;
 
     DIR *const dir = opendir(mLogDir.c_str());
     if (!dir)
@@ -84,35 +90,61 @@ void ChatLogger::setLogDir(const std::string &logDir)
         closedir(dir);
 }
 
-void ChatLogger::log(std::string str)
+std::ofstream *ChatLogger::getFile(const std::string &name)
 {
-    const std::string &dateStr = getDir();
-    const std::string logFileName = strprintf(
-        "%s/#General.log", dateStr.c_str());
-    if (!mLogFile.is_open() || logFileName != mLogFileName)
+    const time_t now = time(nullptr);
+    if (now >= mDirTime)
+        updateLogDir(now);
+
+    const LogFiles::const_iterator it = mFiles.find(name);
+    if (it != mFiles.end())
+        return (*it).second;
+
+    if (mFiles.size() >= maxOpenedFiles)
+        closeFiles();
+
+    const std::string logFileName = strprintf("%s/%s.log",
+        mLogDir.c_str(), name.c_str());
+    std::ofstream *const file = new std::ofstream(logFileName.c_str(),
+        std::ios_base::app);
+    if (!file->is_open())
     {
-        setLogDir(dateStr);
-        setLogFile(logFileName);
+        std::cout << "Warning: error while opening " << logFileName <<
+            " for writing.\n";
+        delete file;
+        return nullptr;
     }
+    mFiles[name] = file;
+    return file;
+}
+
+void ChatLogger::log(std::string str)
+{
+    std::ofstream *const file = getFile("#General");
+    if (!file)
+        return;
 
-    str = removeColors(str);
-    writeTo(mLogFile, str);
+    *file << removeColors(str) << '\n';
+    mNeedFlush = true;
 }
 
 void ChatLogger::log(std::string name, std::string str)
 {
-    const std::string &dateStr = getDir();
-    const std::string logFileName = strprintf("%s/%s.log",
-        dateStr.c_str(), secureName(name).c_str());
+    std::ofstream *const file = getFile(secureName(name));
+    if (!file)
+        return;
 
-    if (!mLogFile.is_open() || logFileName != mLogFileName)
-    {
-        setLogDir(dateStr);
-        setLogFile(logFileName);
-    }
+    *file << removeColors(str) << '\n';
+    mNeedFlush = true;
+}
 
-    str = removeColors(str);
-    writeTo(mLogFile, str);
+void ChatLogger::flush()
+{
+    if (!mNeedFlush)
+        return;
+    FOR_EACH (LogFiles::iterator, it, mFiles)
+        (*it).second->flush();
+    mNeedFlush = false;
 }
 
 std::string ChatLogger::getDir() const
@@ -153,20 +185,14 @@ std::string ChatLogger::secureName(std::string &name)
     return name;
 }
 
-void ChatLogger::writeTo(std::ofstream &file,
-                         const std::string &str)
-{
-    file << str << std::endl;
-}
-
 void ChatLogger::setServerName(const std::string &serverName)
 {
     mServerName = serverName;
     if (mServerName == "")
         mServerName = config.getStringValue("MostUsedServerName0");
 
-    if (mLogFile.is_open())
-        mLogFile.close();
+    closeFiles();
+    mDirTime = 0;
 
     secureName(mServerName);
     if (mLogDir != "")
@@ -181,12 +207,24 @@ void ChatLogger::setServerName(const std::string &serverName)
     }
 }
 
+void ChatLogger::setBaseLogDir(const std::string &logDir)
+{
+    closeFiles();
+    mBaseLogDir = logDir;
+    mDirTime = 0;
+}
+
 void ChatLogger::loadLast(std::string name, std::list<std::string> &list,
                           const unsigned n) const
 {
+    secureName(name);
+    const LogFiles::const_iterator it = mFiles.find(name);
+    if (it != mFiles.end())
+        (*it).second->flush();
+
     std::ifstream logFile;
     std::string fileName = strprintf("%s/%s.log", getDir().c_str(),
-        secureName(name).c_str());
+        name.c_str());
 
     logFile.open(fileName.c_str(), std::ios::in);
 
@@ -212,7 +250,8 @@ void ChatLogger::loadLast(std::string name, std::list<std::string> &list,
 
 void ChatLogger::clear()
 {
+    closeFiles();
     mLogDir.clear();
     mServerName.clear();
-    mLogFileName.clear();
+    mDirTime = 0;
 }
@@ -23,8 +23,10 @@
 #ifndef CHATLOGGER_H
 #define CHATLOGGER_H
 
+#include <ctime>
 #include <fstream>
 #include <list>
+#include <map>
 
 #include "localconsts.h"
 
@@ -59,26 +61,34 @@ class ChatLogger final
 
         void setServerName(const std::string &serverName);
 
-        void setBaseLogDir(const std::string &logDir)
-        { mBaseLogDir = logDir; }
+        void setBaseLogDir(const std::string &logDir);
 
         void clear();
 
+        /**
+         * Flushes opened log files if something was written.
+         */
+        void flush();
+
     private:
+        typedef std::map<std::string, std::ofstream*> LogFiles;
+
         /**
-         * Sets the file to log to and opens it
+         * Returns opened log file for given secured name.
+         * Files stay opened until date or server changed.
          */
-        void setLogFile(const std::string &logFilename);
+        std::ofstream *getFile(const std::string &name);
 
-        void setLogDir(const std::string &logDir);
+        void updateLogDir(const time_t now);
 
-        static void writeTo(std::ofstream &file, const std::string &str);
+        void closeFiles();
 
-        std::ofstream mLogFile;
+        LogFiles mFiles;
         std::string mLogDir;
         std::string mBaseLogDir;
         std::string mServerName;
-        std::string mLogFileName;
+        time_t mDirTime;
+        bool mNeedFlush;
 };
 
 extern ChatLogger *chatLogger;
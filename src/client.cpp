@@ -124,10 +124,13 @@
 #ifdef ANDROID
 #include "utils/paths.h"
 #endif
+#include "utils/physfsindex.h"
 #include "utils/physfstools.h"
+#include "utils/process.h"
 #include "utils/sdlcheckutils.h"
 #include "utils/timer.h"
 
+#include "utils/translation/poparser.h"
 #include "utils/translation/translationmanager.h"
 
 #include "listeners/errorlistener.h"
@@ -220,6 +223,8 @@ Client::Client() :
     mButtonPadding(1),
     mButtonSpacing(3),
     mPing(0),
+    mUsageTime(0),
+    mUsageCpu(0),
     mConfigAutoSaved(false)
 {
     WindowManager::init();
@@ -287,6 +292,9 @@ void Client::gameInit()
 
     GettextHelper::initLang();
 
+    PhysFsIndex::setCacheFile(settings.localDataDir + "/fsindex.bin");
+    PoParser::setCacheDir(settings.localDataDir + "/cache/translations");
+
     chatLogger = new ChatLogger;
     if (settings.options.chatLogDir.empty())
     {
@@ -308,6 +316,11 @@ void Client::gameInit()
 
     // Initialize SDL
     logger->log1("Initializing SDL...");
+    if (settings.options.headless)
+    {
+        // headless sessions never show window
+        setEnv("SDL_VIDEODRIVER", "dummy");
+    }
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0)
     {
         logger->safeError(strprintf("Could not initialize SDL: %s",
@@ -340,6 +353,7 @@ void Client::gameInit()
 #if defined(USE_OPENGL) 
 #if !defined(ANDROID) && !defined(__APPLE__) && !defined(__native_client__)
     if (!settings.options.safeMode && settings.options.test.empty()
+        && !settings.options.headless
         && !config.getBoolValue("videodetected"))
     {
         graphicsManager.detectVideoSettings();
@@ -487,7 +501,7 @@ void Client::initSoundManager()
     // Initialize sound engine
     try
     {
-        if (config.getBoolValue("sound"))
+        if (config.getBoolValue("sound") && !settings.options.headless)
             soundManager.init();
 
         soundManager.setSfxVolume(config.getIntValue("sfxVolume"));
@@ -632,6 +646,7 @@ void Client::gameClear()
     delete2(dropShortcut);
 
     player_relations.store();
+    config.removeListeners(&player_relations);
 
     if (logger)
         logger->log1("Quitting2");
@@ -652,8 +667,6 @@ void Client::gameClear()
     if (logger)
         logger->log1("Quitting4");
 
-    XML::cleanupXML();
-
     if (logger)
         logger->log1("Quitting5");
 
@@ -694,6 +707,9 @@ void Client::gameClear()
     config.removeOldKeys();
     config.write();
     serverConfig.write();
+    Configuration::stopWriter();
+    // after last config write, writer thread also uses libxml
+    XML::cleanupXML();
 
     config.clear();
     serverConfig.clear();
@@ -712,6 +728,9 @@ void Client::gameClear()
 
     delete2(chatLogger);
     TranslationManager::close();
+
+    if (logger)
+        logger->stopThread();
 }
 
 int Client::testsExec()
@@ -794,7 +813,12 @@ int Client::gameExec()
         lastTickTime = tick_time;
 
         // Update the screen when application is visible, delay otherwise.
-        if (!WindowManager::getIsMinimized())
+        if (settings.options.headless)
+        {
+            // nothing to draw, sleep until next logic tick
+            SDL_Delay(MILLISECONDS_IN_A_TICK);
+        }
+        else if (!WindowManager::getIsMinimized())
         {
             frame_count++;
             if (gui)
@@ -1821,6 +1845,33 @@ void Client::logVars()
 
 void Client::slowLogic()
 {
+    if (settings.options.headless && cur_time >= mUsageTime)
+    {
+        // periodic report for measuring cost of idle headless sessions
+        const int period = 60;
+        mUsageTime = cur_time + period;
+        int rss = 0;
+        int maxRss = 0;
+        int cpu = 0;
+        if (getResourceUsage(rss, maxRss, cpu))
+        {
+            if (mUsageCpu)
+            {
+                // cpu load in percents for last period
+                const int load = (cpu - mUsageCpu) / (period * 10);
+                logger->log("Resource usage: rss %d KB, max rss %d KB, "
+                    "cpu time %d ms, cpu load %d%%",
+                    rss, maxRss, cpu, load);
+            }
+            else
+            {
+                logger->log("Resource usage: rss %d KB, max rss %d KB, "
+                    "cpu time %d ms", rss, maxRss, cpu);
+            }
+            mUsageCpu = cpu;
+        }
+    }
+
     if (!gameHandler || !gameHandler->mustPing())
         return;
 
@@ -138,6 +138,8 @@ class Client final : public ConfigListener,
         int mButtonPadding;
         int mButtonSpacing;
         int mPing;
+        int mUsageTime;
+        int mUsageCpu;
         bool mConfigAutoSaved;
 };
 
@@ -29,6 +29,18 @@
 
 #include "utils/delete2.h"
 #include "utils/paths.h"
+#include "utils/sdlhelper.h"
+
+#include <SDL_timer.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "debug.h"
 
@@ -46,6 +58,41 @@ Configuration features;            // XML file features
 Configuration branding;            // XML branding information reader
 Configuration paths;               // XML default paths information reader
 
+namespace
+{
+    struct ConfigSnapshot final
+    {
+        ConfigSnapshot(const std::string &path0,
+                       ConfigurationObject *const obj0,
+                       const uint32_t time0) :
+            path(path0),
+            obj(obj0),
+            firstTime(time0),
+            time(time0)
+        {
+        }
+
+        std::string path;
+        ConfigurationObject *obj;
+        uint32_t firstTime;
+        uint32_t time;
+    };
+
+    typedef std::list<ConfigSnapshot> ConfigSnapshots;
+
+    // Write after no changes for writeDelay ms, but not later than
+    // maxWriteDelay ms after first change.
+    const uint32_t writeDelay = 500;
+    const uint32_t maxWriteDelay = 5000;
+
+    ConfigSnapshots writeQueue;
+    SDL_mutex *queueMutex = nullptr;
+    SDL_mutex *writeMutex = nullptr;
+    SDL_sem *writeSem = nullptr;
+    SDL_Thread *writeThread = nullptr;
+    volatile bool writeStop = false;
+}  // namespace
+
 const std::string unusedKeys[] =
 {
     "hideShield",
@@ -326,6 +373,29 @@ void ConfigurationObject::clear()
     mContainerOptions.clear();
 }
 
+ConfigurationObject *ConfigurationObject::snapshot() const
+{
+    ConfigurationObject *const obj = new ConfigurationObject;
+    obj->mOptions = mOptions;
+#ifdef DEBUG_CONFIG
+    obj->mLogKeys = mLogKeys;
+    obj->mIsMain = mIsMain;
+#endif
+
+    for (std::map<std::string, ConfigurationList>::const_iterator
+         it = mContainerOptions.begin(), it_end = mContainerOptions.end();
+         it != it_end; ++ it)
+    {
+        ConfigurationList &list = obj->mContainerOptions[it->first];
+        FOR_EACH (ConfigurationList::const_iterator, elt_it, it->second)
+        {
+            if (*elt_it)
+                list.push_back((*elt_it)->snapshot());
+        }
+    }
+    return obj;
+}
+
 ConfigurationObject::ConfigurationObject() :
     mOptions(),
 #ifdef DEBUG_CONFIG
@@ -714,6 +784,7 @@ void Configuration::init(const std::string &filename,
                          const UseResman useResManager)
 {
     cleanDefaults();
+    flushWrites();
     XML::Document doc(filename, useResManager, SkipError_false);
     mFilename = filename;
     mUseResManager = useResManager;
@@ -750,6 +821,7 @@ void Configuration::init(const std::string &filename,
 
 void Configuration::reInit()
 {
+    flushWrites();
     XML::Document doc(mFilename, mUseResManager, SkipError_false);
     if (!doc.rootNode())
     {
@@ -823,42 +895,216 @@ void Configuration::write()
     }
 
     mUpdated = false;
-    // Do not attempt to write to file that cannot be opened for writing
-    FILE *const testFile = fopen(mConfigPath.c_str(), "w");
-    if (!testFile)
+    ConfigurationObject *const obj = snapshot();
+    if (!writeThread && !writeStop)
+        startWriter();
+    if (writeStop)
     {
-        logger->log("Configuration::write() couldn't open %s for writing",
-                    mConfigPath.c_str());
+        writeSnapshot(mConfigPath, obj);
+        delete obj;
         BLOCK_END("Configuration::write")
         return;
     }
-    else
+
+    const uint32_t time = SDL_GetTicks();
+    SDL_mutexP(queueMutex);
+    FOR_EACH (ConfigSnapshots::iterator, it, writeQueue)
+    {
+        ConfigSnapshot &snap = *it;
+        if (snap.path == mConfigPath)
+        {
+            // replace not yet written snapshot
+            delete snap.obj;
+            snap.obj = obj;
+            snap.time = time;
+            SDL_mutexV(queueMutex);
+            BLOCK_END("Configuration::write")
+            return;
+        }
+    }
+    writeQueue.push_back(ConfigSnapshot(mConfigPath, obj, time));
+    SDL_mutexV(queueMutex);
+    // wake writer for schedule new snapshot
+    SDL_SemPost(writeSem);
+    BLOCK_END("Configuration::write")
+}
+
+void Configuration::startWriter()
+{
+    queueMutex = SDL_CreateMutex();
+    writeMutex = SDL_CreateMutex();
+    writeSem = SDL_CreateSemaphore(0);
+    writeThread = SDL::createThread(&writerThread,
+        "configwriter", nullptr);
+    if (!writeThread)
+    {
+        logger->log1("Configuration: failed to create writer thread");
+        writeStop = true;
+    }
+}
+
+void Configuration::flushWrites()
+{
+    if (writeMutex)
+        writePending(true);
+}
+
+void Configuration::stopWriter()
+{
+    writeStop = true;
+    if (!writeThread)
+        return;
+
+    SDL_SemPost(writeSem);
+    SDL_WaitThread(writeThread, nullptr);
+    writeThread = nullptr;
+    writePending(true);
+    SDL_DestroySemaphore(writeSem);
+    writeSem = nullptr;
+    SDL_DestroyMutex(queueMutex);
+    queueMutex = nullptr;
+    SDL_DestroyMutex(writeMutex);
+    writeMutex = nullptr;
+}
+
+int Configuration::writerThread(void *ptr A_UNUSED)
+{
+    while (!writeStop)
     {
-        fclose(testFile);
+        // sleep until next snapshot is due or new snapshot queued
+        SDL_SemWaitTimeout(writeSem, nextWriteDelay());
+        writePending(false);
+    }
+    return 0;
+}
+
+uint32_t Configuration::nextWriteDelay()
+{
+    uint32_t delay = SDL_MUTEX_MAXWAIT;
+    SDL_mutexP(queueMutex);
+    const uint32_t time = SDL_GetTicks();
+    FOR_EACH (ConfigSnapshots::const_iterator, it, writeQueue)
+    {
+        const uint32_t passed = time - it->time;
+        const uint32_t firstPassed = time - it->firstTime;
+        if (passed >= writeDelay || firstPassed >= maxWriteDelay)
+        {
+            delay = 0;
+            break;
+        }
+        delay = std::min(delay, std::min(writeDelay - passed,
+            maxWriteDelay - firstPassed));
     }
+    SDL_mutexV(queueMutex);
+    return delay;
+}
 
-    const XmlTextWriterPtr writer = xmlNewTextWriterFilename(
-        mConfigPath.c_str(), 0);
+void Configuration::writePending(const bool all)
+{
+    // write mutex held until snapshots written, for keep writes order
+    SDL_mutexP(writeMutex);
+    ConfigSnapshots snapshots;
+    SDL_mutexP(queueMutex);
+    const uint32_t time = SDL_GetTicks();
+    ConfigSnapshots::iterator it = writeQueue.begin();
+    while (it != writeQueue.end())
+    {
+        if (all
+            || time - it->time >= writeDelay
+            || time - it->firstTime >= maxWriteDelay)
+        {
+            snapshots.splice(snapshots.end(), writeQueue, it++);
+        }
+        else
+        {
+            ++ it;
+        }
+    }
+    SDL_mutexV(queueMutex);
+
+    FOR_EACH (ConfigSnapshots::const_iterator, it2, snapshots)
+    {
+        writeSnapshot(it2->path, it2->obj);
+        delete it2->obj;
+    }
+    SDL_mutexV(writeMutex);
+}
+
+void Configuration::writeSnapshot(const std::string &path,
+                                  ConfigurationObject *const obj)
+{
+    // Write to temporary file and replace config only after success,
+    // to not lose config if client crashed while writing.
+    const std::string tempPath = path + ".tmp";
+    const xmlBufferPtr buffer = xmlBufferCreate();
+    const XmlTextWriterPtr writer = buffer
+        ? xmlNewTextWriterMemory(buffer, 0) : nullptr;
 
     if (!writer)
     {
-        logger->log1("Configuration::write() error while creating writer");
-        BLOCK_END("Configuration::write")
+        logger->log("Configuration::write() couldn't create writer for %s",
+                    path.c_str());
+        if (buffer)
+            xmlBufferFree(buffer);
         return;
     }
 
-    logger->log1("Configuration::write() writing configuration...");
+    logger->log("Configuration::write() writing configuration %s...",
+        path.c_str());
 
     xmlTextWriterSetIndent(writer, 1);
     xmlTextWriterStartDocument(writer, nullptr, nullptr, nullptr);
 //    xmlTextWriterStartDocument(writer, nullptr, "utf8", nullptr);
     XmlTextWriterStartElement(writer, "configuration");
 
-    writeToXML(writer);
+    obj->writeToXML(writer);
 
-    xmlTextWriterEndDocument(writer);
+    const int res = xmlTextWriterEndDocument(writer);
     xmlFreeTextWriter(writer);
-    BLOCK_END("Configuration::write")
+    if (res < 0)
+    {
+        logger->log("Configuration::write() error while writing %s",
+            path.c_str());
+        xmlBufferFree(buffer);
+        return;
+    }
+
+    FILE *const file = fopen(tempPath.c_str(), "wb");
+    if (!file)
+    {
+        logger->log("Configuration::write() couldn't open %s for writing",
+                    tempPath.c_str());
+        xmlBufferFree(buffer);
+        return;
+    }
+    const size_t size = static_cast<size_t>(xmlBufferLength(buffer));
+    bool ok = fwrite(xmlBufferContent(buffer), 1, size, file) == size;
+    xmlBufferFree(buffer);
+    // data must be on disk before rename, or crash can leave empty config
+    ok = ok && fflush(file) == 0;
+#ifdef WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = fclose(file) == 0 && ok;
+    if (!ok)
+    {
+        logger->log("Configuration::write() error while writing %s",
+            tempPath.c_str());
+        ::remove(tempPath.c_str());
+        return;
+    }
+
+#ifdef WIN32
+    // rename on windows can't replace existing file
+    ::remove(path.c_str());
+#endif
+    if (::rename(tempPath.c_str(), path.c_str()))
+    {
+        logger->log("Configuration::write() couldn't rename %s to %s",
+            tempPath.c_str(), path.c_str());
+    }
 }
 
 void Configuration::addListener(const std::string &key,
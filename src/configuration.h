@@ -207,6 +207,11 @@ class ConfigurationObject notfinal
         virtual void initFromXML(const XmlNodePtrConst parent_node);
         virtual void writeToXML(const XmlTextWriterPtr writer);
 
+        /**
+         * Creates deep copy of options and lists.
+         */
+        ConfigurationObject *snapshot() const A_WARN_UNUSED;
+
         void deleteList(const std::string &name);
 
         typedef std::map<std::string, std::string> Options;
@@ -262,9 +267,22 @@ class Configuration final : public ConfigurationObject
 
         /**
          * Writes the current settings back to the config file.
+         * Settings copied immediately, but written by background thread
+         * after short delay. Repeated writes inside delay are merged.
          */
         void write();
 
+        /**
+         * Writes all pending configuration snapshots and waits for it.
+         */
+        static void flushWrites();
+
+        /**
+         * Flushes pending writes and stops background writer.
+         * After this call write() works synchronously.
+         */
+        static void stopWriter();
+
         /**
          * Adds a listener to the listen list of the specified config option.
          */
@@ -353,6 +371,17 @@ class Configuration final : public ConfigurationObject
          */
         void cleanDefaults();
 
+        static void startWriter();
+
+        static int writerThread(void *ptr);
+
+        static uint32_t nextWriteDelay() A_WARN_UNUSED;
+
+        static void writePending(const bool all);
+
+        static void writeSnapshot(const std::string &path,
+                                  ConfigurationObject *const obj);
+
         typedef std::list<ConfigListener*> Listeners;
         typedef Listeners::iterator ListenerIterator;
         typedef std::map<std::string, Listeners> ListenerMap;
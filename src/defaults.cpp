@@ -219,7 +219,6 @@ DefaultsData* getConfigDefaults()
     AddDEF("drawHotKeys", true);
     AddDEF("serverAttack", true);
     AddDEF("autofixPos", false);
-    AddDEF("alphaCache", true);
     AddDEF("attackMoving", true);
     AddDEF("attackNext", false);
     AddDEF("quickStats", true);
@@ -300,6 +299,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("compresstextures", 0);
     AddDEF("rectangulartextures", false);
     AddDEF("networksleep", 0);
+    AddDEF("coalescePackets", false);
     AddDEF("newtextures", true);
     AddDEF("videodetected", false);
     AddDEF("hideErased", false);
@@ -352,6 +352,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("moveNames", false);
     AddDEF("uselonglivesprites", false);
     AddDEF("uselonglivesounds", true);
+    AddDEF("resourceCacheSize", 64);
     AddDEF("screenDensity", 0);
     AddDEF("cfgver", 13);
     AddDEF("enableDebugLog", false);
@@ -486,6 +487,7 @@ DefaultsData* getPathsDefaults()
     AddDEF("unknownItemFile", "unknown-item.png");
     AddDEF("sprites", "graphics/sprites/");
     AddDEF("spriteErrorFile", "error.xml");
+    AddDEF("spriteLoadingFile", "graphics/gui/progress-indicator.png");
     AddDEF("guiIcons", "graphics/guiicons/");
     AddDEF("shaders", "graphics/shaders/");
     AddDEF("help", "help/");
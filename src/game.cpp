@@ -35,6 +35,7 @@
 #include "guildmanager.h"
 #endif
 #include "itemshortcut.h"
+#include "navigationmanager.h"
 #include "soundmanager.h"
 #include "settings.h"
 #include "spellshortcut.h"
@@ -105,6 +106,7 @@
 
 #include "resources/delayedmanager.h"
 #include "resources/imagewriter.h"
+#include "resources/mapprefetcher.h"
 #include "resources/mapreader.h"
 #include "resources/resourcemanager.h"
 
@@ -398,8 +400,14 @@ Game::Game() :
         top->add(viewport);
     viewport->requestMoveToBottom();
 
-    AnimatedSprite::setEnableCache(mainGraphics->getOpenGL()
+    // null renderer have nothing to prefetch
+    const bool delayed = mainGraphics->getOpenGL()
+        && mainGraphics->getOpenGL() != RENDER_NULL;
+    AnimatedSprite::setEnableCache(delayed
         && config.getBoolValue("enableDelayedAnimations"));
+    if (delayed)
+        DelayedManager::start();
+    MapPrefetcher::start();
 
     CompoundSprite::setEnableDelay(
         config.getBoolValue("enableCompoundSpriteDelay"));
@@ -465,6 +473,9 @@ Game::~Game()
 #endif
     delete2(crazyMoves);
 
+    DelayedManager::stop();
+    MapPrefetcher::stop();
+    NavigationManager::clear();
     Being::clearCache();
     mInstance = nullptr;
     PlayerInfo::gameDestroyed();
@@ -593,7 +604,12 @@ void Game::logic()
     if (actorManager)
         actorManager->logic();
     if (particleEngine)
+    {
+        if (actorManager)
+            Particle::visibleArea = actorManager->getVisibleArea();
+        Particle::pausedEmitters = 0;
         particleEngine->update();
+    }
     if (mCurrentMap)
         mCurrentMap->update();
 
@@ -623,6 +639,7 @@ void Game::slowLogic()
         Being::reReadConfig();
         if (killStats)
             cilk_spawn killStats->recalcStats();
+        ResourceManager::getInstance()->cleanOrphans();
 
         if (time > mTime2 || mTime2 - time > 10)
         {
@@ -634,6 +651,12 @@ void Game::slowLogic()
 
     if (mainGraphics->getOpenGL())
         DelayedManager::delayedLoad();
+    if (localPlayer)
+    {
+        MapPrefetcher::logic(mCurrentMap,
+            localPlayer->getTileX(),
+            localPlayer->getTileY());
+    }
 
 #ifdef TMWA_SUPPORT
     if (shopWindow)
@@ -717,7 +740,7 @@ void Game::adjustPerfomance()
     {
         mNextAdjustTime = time + adjustDelay;
 
-        if (mAdjustLevel > 3 || !localPlayer || localPlayer->getHalfAway()
+        if (mAdjustLevel > 2 || !localPlayer || localPlayer->getHalfAway()
             || settings.awayMode)
         {
             return;
@@ -779,18 +802,6 @@ void Game::adjustPerfomance()
                         mLowerCounter = 2;
                     }
                     break;
-                case 3:
-                    if (!config.getBoolValue("alphaCache"))
-                    {
-                        config.setValue("alphaCache", true);
-                        config.setSilent("alphaCache", false);
-                        if (localChatTab)
-                        {
-                            localChatTab->chatLog("Auto enable opacity cache",
-                                ChatMsgType::BY_SERVER);
-                        }
-                    }
-                    break;
                 default:
                     break;
             }
@@ -810,20 +821,12 @@ void Game::resetAdjustLevel()
             config.setValue("beingopacity",
                 config.getBoolValue("beingopacity"));
             break;
-        case 2:
-            config.setValue("beingopacity",
-                config.getBoolValue("beingopacity"));
-            Particle::emitterSkip = config.getIntValue(
-                "particleEmitterSkip") + 1;
-            break;
         default:
-        case 3:
+        case 2:
             config.setValue("beingopacity",
                 config.getBoolValue("beingopacity"));
             Particle::emitterSkip = config.getIntValue(
                 "particleEmitterSkip") + 1;
-            config.setValue("alphaCache",
-                config.getBoolValue("alphaCache"));
             break;
     }
     mAdjustLevel = 0;
@@ -1000,10 +1003,12 @@ void Game::handleInput()
 void Game::changeMap(const std::string &mapPath)
 {
     BLOCK_START("Game::changeMap")
+    const unsigned int startTime = get_time_usec();
 
     resetAdjustLevel();
     ResourceManager *const resman = ResourceManager::getInstance();
     resman->cleanProtected();
+    soundManager.clearPreload();
 
     if (popupManager)
     {
@@ -1039,6 +1044,7 @@ void Game::changeMap(const std::string &mapPath)
         realFullMap.append(".gz");
 
     // Attempt to load the new map
+    MapPrefetcher::startMapLoad(realFullMap);
     Map *const newMap = MapReader::readMap(fullMap, realFullMap);
 
     if (mCurrentMap)
@@ -1094,7 +1100,9 @@ void Game::changeMap(const std::string &mapPath)
     if (localPlayer)
         localPlayer->recreateItemParticles();
 
+    soundManager.preloadNotifySfx();
     gameHandler->mapLoadedEvent();
+    MapPrefetcher::endMapLoad(get_time_usec() - startTime);
     BLOCK_END("Game::changeMap")
 }
 
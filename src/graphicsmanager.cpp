@@ -53,6 +53,7 @@
 #include "render/mobileopenglgraphics.h"
 #include "render/modernopenglgraphics.h"
 #include "render/normalopenglgraphics.h"
+#include "render/nullopenglgraphics.h"
 #include "render/safeopenglgraphics.h"
 #endif
 #include "render/renderers.h"
@@ -60,6 +61,7 @@
 
 #ifdef USE_OPENGL
 #include "resources/fboinfo.h"
+#include "resources/nullopenglimagehelper.h"
 #include "resources/openglimagehelper.h"
 
 #include "render/mglfunctions.h"
@@ -252,7 +254,11 @@ int GraphicsManager::detectGraphics()
 void GraphicsManager::createRenderers()
 {
     RenderType useOpenGL = RENDER_SOFTWARE;
-    if (!settings.options.noOpenGL)
+    if (settings.options.headless)
+    {
+        useOpenGL = RENDER_NULL;
+    }
+    else if (!settings.options.noOpenGL)
     {
         if (settings.options.renderer < 0)
         {
@@ -271,6 +277,12 @@ void GraphicsManager::createRenderers()
     // Create the graphics context
     switch (useOpenGL)
     {
+        case RENDER_NULL:
+            imageHelper = new NullOpenGLImageHelper;
+            surfaceImageHelper = new SurfaceImageHelper;
+            mainGraphics = new NullOpenGLGraphics;
+            mUseTextureSampler = false;
+            break;
         case RENDER_SOFTWARE:
 #ifdef USE_SDL2
             imageHelper = new SDL2SoftwareImageHelper;
@@ -288,7 +300,6 @@ void GraphicsManager::createRenderers()
         case RENDER_SDL2_DEFAULT:
 #endif
         case RENDER_LAST:
-        case RENDER_NULL:
         default:
 #ifndef ANDROID
             imageHelper = new OpenGLImageHelper;
@@ -336,7 +347,8 @@ void GraphicsManager::createRenderers()
 void GraphicsManager::createRenderers()
 {
     RenderType useOpenGL = RENDER_SOFTWARE;
-    if (!settings.options.noOpenGL)
+    // null renderer need OpenGL build, headless mode use software renderer
+    if (!settings.options.noOpenGL && !settings.options.headless)
         useOpenGL = intToRenderType(config.getIntValue("opengl"));
 
     // Setup image loading for the right image format
@@ -456,15 +468,15 @@ void GraphicsManager::setVideoMode()
 void GraphicsManager::initGraphics()
 {
     openGLMode = intToRenderType(config.getIntValue("opengl"));
+#ifdef USE_OPENGL
+    if (settings.options.headless)
+        openGLMode = RENDER_NULL;
+#endif
 #ifdef USE_OPENGL
     OpenGLImageHelper::setBlur(config.getBoolValue("blur"));
-    SurfaceImageHelper::SDLSetEnableAlphaCache(
-        config.getBoolValue("alphaCache") && !openGLMode);
     ImageHelper::setEnableAlpha(config.getFloatValue("guialpha") != 1.0F
         || openGLMode);
 #else
-    SurfaceImageHelper::SDLSetEnableAlphaCache(
-        config.getBoolValue("alphaCache"));
     ImageHelper::setEnableAlpha(config.getFloatValue("guialpha") != 1.0F);
 #endif
     createRenderers();
@@ -73,6 +73,7 @@
 
 #include "gui/widgets/window.h"
 
+#include "chatlogger.h"
 #include "dragdrop.h"
 #include "settings.h"
 #include "touchmanager.h"
@@ -341,6 +342,8 @@ void Gui::slowLogic()
     if (mTime != time)
     {
         logger->flush();
+        if (chatLogger)
+            chatLogger->flush();
         if (ipc)
             ipc->flush();
         mTime = time;
@@ -64,6 +64,14 @@ namespace
         }
         int mX, mY;
     };
+
+    struct LinePartYLess final
+    {
+        bool operator() (const LinePart &part, const int y) const
+        {
+            return part.mY < y;
+        }
+    };
 }  // namespace
 
 ImageSet *BrowserBox::mEmotes = nullptr;
@@ -78,6 +86,7 @@ BrowserBox::BrowserBox(const Widget2 *const widget,
     mTextRows(),
     mTextRowLinksCount(),
     mLineParts(),
+    mRowLayouts(),
     mLinks(),
     mLinkHandler(nullptr),
     mSkin(nullptr),
@@ -95,6 +104,11 @@ BrowserBox::BrowserBox(const Widget2 *const widget,
     mDataWidth(0),
     mHighlightColor(getThemeColor(Theme::HIGHLIGHT)),
     mHyperLinkColor(getThemeColor(Theme::HYPERLINK)),
+    mLayoutWidth(-1),
+    mLayoutY(0),
+    mLayoutOffset(0),
+    mLayoutSize(0),
+    mLayoutLink(0),
     mOpaque(opaque),
     mUseLinksAndUserColors(true),
     mUseEmotes(true),
@@ -102,7 +116,8 @@ BrowserBox::BrowserBox(const Widget2 *const widget,
     mProcessVars(false),
     mEnableImages(false),
     mEnableKeys(false),
-    mEnableTabs(false)
+    mEnableTabs(false),
+    mLayoutDirty(true)
 {
     mAllowLogic = false;
 
@@ -313,6 +328,7 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
     {
         mTextRows.push_front(newRow);
         mTextRowLinksCount.push_front(linksCount);
+        mLayoutDirty = true;
     }
     else
     {
@@ -326,14 +342,14 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
         while (mTextRows.size() > static_cast<size_t>(mMaxRows))
         {
             mTextRows.pop_front();
-            int cnt = mTextRowLinksCount.front();
+            const int links = mTextRowLinksCount.front();
+            int cnt = links;
             mTextRowLinksCount.pop_front();
 
-            while (cnt && !mLinks.empty())
-            {
-                mLinks.erase(mLinks.begin());
-                cnt --;
-            }
+            if (cnt > static_cast<int>(mLinks.size()))
+                cnt = static_cast<int>(mLinks.size());
+            mLinks.erase(mLinks.begin(), mLinks.begin() + cnt);
+            removeFirstRowLayout(links);
         }
     }
 
@@ -354,61 +370,6 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
             setWidth(w);
     }
 
-    const int fontHeight = font->getHeight();
-    if (mMode == AUTO_WRAP)
-    {
-        unsigned int y = 0;
-        unsigned int nextChar;
-        const char *const hyphen = "~";
-        const int hyphenWidth = font->getWidth(hyphen);
-        unsigned x = 0;
-
-        FOR_EACH (TextRowCIter, i, mTextRows)
-        {
-            std::string tempRow = *i;
-            for (unsigned int j = 0, sz = static_cast<unsigned int>(
-                 tempRow.size()); j < sz; j++)
-            {
-                const std::string character = tempRow.substr(j, 1);
-                x += font->getWidth(character);
-                nextChar = j + 1;
-
-                // Wraping between words (at blank spaces)
-                if (nextChar < sz && tempRow.at(nextChar) == ' ')
-                {
-                    int nextSpacePos = static_cast<int>(
-                        tempRow.find(" ", (nextChar + 1)));
-                    if (nextSpacePos <= 0)
-                        nextSpacePos = static_cast<int>(sz) - 1;
-
-                    const unsigned nextWordWidth = font->getWidth(
-                        tempRow.substr(nextChar,
-                        (nextSpacePos - nextChar)));
-
-                    if ((x + nextWordWidth + 10)
-                        > static_cast<unsigned>(getWidth()))
-                    {
-                        x = mNewLinePadding;  // Ident in new line
-                        y += 1;
-                        j ++;
-                    }
-                }
-                // Wrapping looong lines (brutal force)
-                else if ((x + 2 * hyphenWidth)
-                         > static_cast<unsigned>(getWidth()))
-                {
-                    x = mNewLinePadding;  // Ident in new line
-                    y += 1;
-                }
-            }
-        }
-
-        setHeight(fontHeight * (static_cast<int>(mTextRows.size()) + y));
-    }
-    else
-    {
-        setHeight(fontHeight * static_cast<int>(mTextRows.size()));
-    }
     mUpdateTime = 0;
     updateHeight();
 }
@@ -438,6 +399,7 @@ void BrowserBox::clearRows()
     mSelectedLink = -1;
     mUpdateTime = 0;
     mDataWidth = 0;
+    resetLayout();
     updateHeight();
 }
 
@@ -447,7 +409,7 @@ void BrowserBox::mousePressed(MouseEvent &event)
         return;
 
     const LinkIterator i = std::find_if(mLinks.begin(), mLinks.end(),
-        MouseOverLink(event.getX(), event.getY()));
+        MouseOverLink(event.getX(), event.getY() + mLayoutOffset));
 
     if (i != mLinks.end())
     {
@@ -459,7 +421,7 @@ void BrowserBox::mousePressed(MouseEvent &event)
 void BrowserBox::mouseMoved(MouseEvent &event)
 {
     const LinkIterator i = std::find_if(mLinks.begin(), mLinks.end(),
-        MouseOverLink(event.getX(), event.getY()));
+        MouseOverLink(event.getX(), event.getY() + mLayoutOffset));
 
     mSelectedLink = (i != mLinks.end())
         ? static_cast<int>(i - mLinks.begin()) : -1;
@@ -498,7 +460,7 @@ void BrowserBox::draw(Graphics *graphics)
             graphics->setColor(mHighlightColor);
             graphics->fillRectangle(Rect(
                 mLinks[mSelectedLink].x1,
-                mLinks[mSelectedLink].y1,
+                mLinks[mSelectedLink].y1 - mLayoutOffset,
                 mLinks[mSelectedLink].x2 - mLinks[mSelectedLink].x1,
                 mLinks[mSelectedLink].y2 - mLinks[mSelectedLink].y1));
         }
@@ -508,32 +470,37 @@ void BrowserBox::draw(Graphics *graphics)
             graphics->setColor(mHyperLinkColor);
             graphics->drawLine(
                 mLinks[mSelectedLink].x1,
-                mLinks[mSelectedLink].y2,
+                mLinks[mSelectedLink].y2 - mLayoutOffset,
                 mLinks[mSelectedLink].x2,
-                mLinks[mSelectedLink].y2);
+                mLinks[mSelectedLink].y2 - mLayoutOffset);
         }
     }
 
     Font *const font = getFont();
 
-    FOR_EACH (LinePartCIter, i, mLineParts)
+    // line parts positions counted from first row ever laid out
+    const int offset = mLayoutOffset;
+    const LinePartCIter i_end = mLineParts.end();
+    LinePartCIter i = mLineParts.begin();
+    for (i = std::lower_bound(i, i_end, mYStart - 50 + offset,
+         LinePartYLess());
+         i != i_end; ++ i)
     {
         const LinePart &part = *i;
-        if (part.mY + 50 < mYStart)
-            continue;
-        if (part.mY > yEnd)
+        const int y = part.mY - offset;
+        if (y > yEnd)
             break;
         if (!part.mType)
         {
             graphics->setColorAll(part.mColor, part.mColor2);
             if (part.mBold)
-                boldFont->drawString(graphics, part.mText, part.mX, part.mY);
+                boldFont->drawString(graphics, part.mText, part.mX, y);
             else
-                font->drawString(graphics, part.mText, part.mX, part.mY);
+                font->drawString(graphics, part.mText, part.mX, y);
         }
         else if (part.mImage)
         {
-            graphics->drawImage(part.mImage, part.mX, part.mY);
+            graphics->drawImage(part.mImage, part.mX, y);
         }
     }
 
@@ -542,342 +509,478 @@ void BrowserBox::draw(Graphics *graphics)
 
 int BrowserBox::calcHeight()
 {
-    unsigned int y = mPadding;
-    int wrappedLines = 0;
-    int moreHeight = 0;
-    int maxWidth = getWidth() - mPadding;
-    int link = 0;
-    bool bold = false;
-    unsigned int wWidth = maxWidth;
+    const int width = getWidth();
+    int maxWidth = width - mPadding;
 
     if (maxWidth < 0)
         return 1;
 
+    if (mLayoutDirty || width != mLayoutWidth
+        || mRowLayouts.size() > mTextRows.size())
+    {
+        resetLayout();
+        mLayoutWidth = width;
+    }
+
+    // Only rows added after last layout need to be wrapped
+    const size_t sz = mTextRows.size();
+    if (mRowLayouts.size() < sz)
+    {
+        const int wWidth = maxWidth;
+        TextRowCIter i = mTextRows.end();
+        for (size_t f = mRowLayouts.size(); f < sz; f ++)
+            -- i;
+        for (const TextRowCIter i_end = mTextRows.end(); i != i_end; ++ i)
+            layoutRow(*i, maxWidth);
+        if (wWidth != maxWidth)
+            setWidth(maxWidth);
+    }
+
+    return mLayoutSize + 2 * mPadding;
+}
+
+void BrowserBox::layoutRow(const std::string &row, int &maxWidth)
+{
+    unsigned int y = mLayoutY;
+    int wrappedLines = 0;
+    int link = mLayoutLink;
+    bool bold = false;
+    const unsigned int wWidth = mLayoutWidth - mPadding;
+    const size_t firstPart = mLineParts.size();
+
     const Font *const font = getFont();
     const int fontHeight = font->getHeight() + 2 * mItemPadding;
     const int fontWidthMinus = font->getWidth("-");
     const char *const hyphen = "~";
     const int hyphenWidth = font->getWidth(hyphen);
 
-    Color selColor[2] = {mForegroundColor, mForegroundColor2};
+    Color *const selColor = mLayoutColor;
     const Color textColor[2] = {mForegroundColor, mForegroundColor2};
-    ResourceManager *const resman = ResourceManager::getInstance();
 
-    mLineParts.clear();
+    unsigned int x = mPadding;
+    bool wrapped = false;
+    int objects = 0;
 
-    FOR_EACH (TextRowCIter, i, mTextRows)
+    // Check for separator lines
+    if (row.find("---", 0) == 0)
     {
-        unsigned int x = mPadding;
-        const std::string row = *(i);
-        bool wrapped = false;
-        int objects = 0;
-
-        // Check for separator lines
-        if (row.find("---", 0) == 0)
+        const int dashWidth = fontWidthMinus;
+        for (x = mPadding; x < wWidth; x ++)
         {
-            const int dashWidth = fontWidthMinus;
-            for (x = mPadding; x < wWidth; x ++)
-            {
-                mLineParts.push_back(LinePart(x, y + mItemPadding,
-                    selColor[0], selColor[1], "-", false));
-                x += dashWidth - 2;
-            }
-
-            y += fontHeight;
-            continue;
+            mLineParts.push_back(LinePart(x, y + mItemPadding,
+                selColor[0], selColor[1], "-", false));
+            x += dashWidth - 2;
         }
-        else if (mEnableImages && row.find("~~~", 0) == 0)
+
+        y += fontHeight;
+        addRowLayout(static_cast<unsigned int>(
+            mLineParts.size() - firstPart), static_cast<int>(y),
+            fontHeight, link);
+        return;
+    }
+    else if (mEnableImages && row.find("~~~", 0) == 0)
+    {
+        std::string str = row.substr(3);
+        const size_t sz = str.size();
+        if (sz > 2 && str.substr(sz - 1) == "~")
+            str = str.substr(0, sz - 1);
+        Image *const img = ResourceManager::getInstance()->getImage(str);
+        int moreHeight = 0;
+        if (img)
         {
-            std::string str = row.substr(3);
-            const size_t sz = str.size();
-            if (sz > 2 && str.substr(sz - 1) == "~")
-                str = str.substr(0, sz - 1);
-            Image *const img = resman->getImage(str);
-            if (img)
-            {
-                img->incRef();
-                mLineParts.push_back(LinePart(x, y + mItemPadding,
-                    selColor[0], selColor[1], img));
-                y += img->getHeight() + 2;
-                moreHeight += img->getHeight();
-                if (img->getWidth() > maxWidth)
-                    maxWidth = img->getWidth() + 2;
-            }
-            continue;
+            mLineParts.push_back(LinePart(x, y + mItemPadding,
+                selColor[0], selColor[1], img));
+            y += img->getHeight() + 2;
+            moreHeight = img->getHeight();
+            if (img->getWidth() > maxWidth)
+                maxWidth = img->getWidth() + 2;
         }
+        addRowLayout(static_cast<unsigned int>(
+            mLineParts.size() - firstPart), static_cast<int>(y),
+            fontHeight + moreHeight, link);
+        return;
+    }
 
-        Color prevColor[2];
-        prevColor[0] = selColor[0];
-        prevColor[1] = selColor[1];
-        bold = false;
+    Color prevColor[2];
+    prevColor[0] = selColor[0];
+    prevColor[1] = selColor[1];
+    bold = false;
 
-        for (size_t start = 0, end = std::string::npos;
-             start != std::string::npos;
-             start = end, end = std::string::npos)
-        {
-            bool processed(false);
+    for (size_t start = 0, end = std::string::npos;
+         start != std::string::npos;
+         start = end, end = std::string::npos)
+    {
+        bool processed(false);
 
-            // Wrapped line continuation shall be indented
-            if (wrapped)
-            {
-                y += fontHeight;
-                x = mNewLinePadding + mPadding;
-                wrapped = false;
-            }
+        // Wrapped line continuation shall be indented
+        if (wrapped)
+        {
+            y += fontHeight;
+            x = mNewLinePadding + mPadding;
+            wrapped = false;
+        }
 
-            size_t idx1 = end;
-            size_t idx2 = end;
+        size_t idx1 = end;
+        size_t idx2 = end;
 
-            // "Tokenize" the string at control sequences
-            if (mUseLinksAndUserColors)
-                idx1 = row.find("##", start + 1);
-            if (idx1 < idx2)
-                end = idx1;
-            else
-                end = idx2;
+        // "Tokenize" the string at control sequences
+        if (mUseLinksAndUserColors)
+            idx1 = row.find("##", start + 1);
+        if (idx1 < idx2)
+            end = idx1;
+        else
+            end = idx2;
 
-            if (start == 0 || mUseLinksAndUserColors)
+        if (start == 0 || mUseLinksAndUserColors)
+        {
+            // Check for color change in format "##x", x = [L,P,0..9]
+            if (row.find("##", start) == start && row.size() > start + 2)
             {
-                // Check for color change in format "##x", x = [L,P,0..9]
-                if (row.find("##", start) == start && row.size() > start + 2)
-                {
-                    const signed char c = row.at(start + 2);
+                const signed char c = row.at(start + 2);
 
-                    bool valid(false);
-                    const Color col[2] =
-                    {
-                        getThemeCharColor(c, valid),
-                        getThemeCharColor(static_cast<signed char>(
-                            c | 0x80), valid)
-                    };
-
-                    if (c == '>')
-                    {
-                        selColor[0] = prevColor[0];
-                        selColor[1] = prevColor[1];
-                    }
-                    else if (c == '<')
-                    {
-                        prevColor[0] = selColor[0];
-                        prevColor[1] = selColor[1];
-                        selColor[0] = col[0];
-                        selColor[1] = col[1];
-                    }
-                    else if (c == 'B')
-                    {
-                        bold = true;
-                    }
-                    else if (c == 'b')
-                    {
-                        bold = false;
-                    }
-                    else if (valid)
-                    {
-                        selColor[0] = col[0];
-                        selColor[1] = col[1];
-                    }
-                    else
-                    {
-                        switch (c)
-                        {
-                            case '0':
-                                selColor[0] = mColors[0][BLACK];
-                                selColor[1] = mColors[1][BLACK];
-                                break;
-                            case '1':
-                                selColor[0] = mColors[0][RED];
-                                selColor[1] = mColors[1][RED];
-                                break;
-                            case '2':
-                                selColor[0] = mColors[0][GREEN];
-                                selColor[1] = mColors[1][GREEN];
-                                break;
-                            case '3':
-                                selColor[0] = mColors[0][BLUE];
-                                selColor[1] = mColors[1][BLUE];
-                                break;
-                            case '4':
-                                selColor[0] = mColors[0][ORANGE];
-                                selColor[1] = mColors[1][ORANGE];
-                                break;
-                            case '5':
-                                selColor[0] = mColors[0][YELLOW];
-                                selColor[1] = mColors[1][YELLOW];
-                                break;
-                            case '6':
-                                selColor[0] = mColors[0][PINK];
-                                selColor[1] = mColors[1][PINK];
-                                break;
-                            case '7':
-                                selColor[0] = mColors[0][PURPLE];
-                                selColor[1] = mColors[1][PURPLE];
-                                break;
-                            case '8':
-                                selColor[0] = mColors[0][GRAY];
-                                selColor[1] = mColors[1][GRAY];
-                                break;
-                            case '9':
-                                selColor[0] = mColors[0][BROWN];
-                                selColor[1] = mColors[1][BROWN];
-                                break;
-                            default:
-                                selColor[0] = textColor[0];
-                                selColor[1] = textColor[1];
-                                break;
-                        }
-                    }
+                bool valid(false);
+                const Color col[2] =
+                {
+                    getThemeCharColor(c, valid),
+                    getThemeCharColor(static_cast<signed char>(
+                        c | 0x80), valid)
+                };
 
-                    if (c == '<' && link < static_cast<signed>(mLinks.size()))
+                if (c == '>')
+                {
+                    selColor[0] = prevColor[0];
+                    selColor[1] = prevColor[1];
+                }
+                else if (c == '<')
+                {
+                    prevColor[0] = selColor[0];
+                    prevColor[1] = selColor[1];
+                    selColor[0] = col[0];
+                    selColor[1] = col[1];
+                }
+                else if (c == 'B')
+                {
+                    bold = true;
+                }
+                else if (c == 'b')
+                {
+                    bold = false;
+                }
+                else if (valid)
+                {
+                    selColor[0] = col[0];
+                    selColor[1] = col[1];
+                }
+                else
+                {
+                    switch (c)
                     {
-                        const int size =
-                            font->getWidth(mLinks[link].caption) + 1;
-
-                        mLinks[link].x1 = x;
-                        mLinks[link].y1 = y;
-                        mLinks[link].x2 = mLinks[link].x1 + size;
-                        mLinks[link].y2 = y + fontHeight - 1;
-                        link++;
+                        case '0':
+                            selColor[0] = mColors[0][BLACK];
+                            selColor[1] = mColors[1][BLACK];
+                            break;
+                        case '1':
+                            selColor[0] = mColors[0][RED];
+                            selColor[1] = mColors[1][RED];
+                            break;
+                        case '2':
+                            selColor[0] = mColors[0][GREEN];
+                            selColor[1] = mColors[1][GREEN];
+                            break;
+                        case '3':
+                            selColor[0] = mColors[0][BLUE];
+                            selColor[1] = mColors[1][BLUE];
+                            break;
+                        case '4':
+                            selColor[0] = mColors[0][ORANGE];
+                            selColor[1] = mColors[1][ORANGE];
+                            break;
+                        case '5':
+                            selColor[0] = mColors[0][YELLOW];
+                            selColor[1] = mColors[1][YELLOW];
+                            break;
+                        case '6':
+                            selColor[0] = mColors[0][PINK];
+                            selColor[1] = mColors[1][PINK];
+                            break;
+                        case '7':
+                            selColor[0] = mColors[0][PURPLE];
+                            selColor[1] = mColors[1][PURPLE];
+                            break;
+                        case '8':
+                            selColor[0] = mColors[0][GRAY];
+                            selColor[1] = mColors[1][GRAY];
+                            break;
+                        case '9':
+                            selColor[0] = mColors[0][BROWN];
+                            selColor[1] = mColors[1][BROWN];
+                            break;
+                        default:
+                            selColor[0] = textColor[0];
+                            selColor[1] = textColor[1];
+                            break;
                     }
+                }
 
-                    processed = true;
-                    start += 3;
-                    if (start == row.size())
-                        break;
+                if (c == '<' && link < static_cast<signed>(mLinks.size()))
+                {
+                    const int size =
+                        font->getWidth(mLinks[link].caption) + 1;
+
+                    mLinks[link].x1 = x;
+                    mLinks[link].y1 = y;
+                    mLinks[link].x2 = mLinks[link].x1 + size;
+                    mLinks[link].y2 = y + fontHeight - 1;
+                    link++;
                 }
+
+                processed = true;
+                start += 3;
+                if (start == row.size())
+                    break;
             }
-            if (mUseEmotes)
-                idx2 = row.find("%%", start + 1);
-            if (idx1 < idx2)
-                end = idx1;
-            else
-                end = idx2;
-            if (mUseEmotes)
+        }
+        if (mUseEmotes)
+            idx2 = row.find("%%", start + 1);
+        if (idx1 < idx2)
+            end = idx1;
+        else
+            end = idx2;
+        if (mUseEmotes)
+        {
+            // check for emote icons
+            if (row.size() > start + 2 && row.substr(start, 2) == "%%")
             {
-                // check for emote icons
-                if (row.size() > start + 2 && row.substr(start, 2) == "%%")
+                if (objects < 5)
                 {
-                    if (objects < 5)
+                    const int cid = row.at(start + 2) - '0';
+                    if (cid >= 0)
                     {
-                        const int cid = row.at(start + 2) - '0';
-                        if (cid >= 0)
+                        if (mEmotes)
                         {
-                            if (mEmotes)
+                            const size_t sz = mEmotes->size();
+                            if (static_cast<size_t>(cid) < sz)
                             {
-                                const size_t sz = mEmotes->size();
-                                if (static_cast<size_t>(cid) < sz)
+                                Image *const img = mEmotes->get(cid);
+                                if (img)
                                 {
-                                    Image *const img = mEmotes->get(cid);
-                                    if (img)
-                                    {
-                                        mLineParts.push_back(LinePart(
-                                            x, y + mItemPadding,
-                                            selColor[0], selColor[1], img));
-                                        x += 18;
-                                    }
+                                    img->incRef();
+                                    mLineParts.push_back(LinePart(
+                                        x, y + mItemPadding,
+                                        selColor[0], selColor[1], img));
+                                    x += 18;
                                 }
                             }
                         }
-                        objects ++;
-                        processed = true;
                     }
+                    objects ++;
+                    processed = true;
+                }
 
-                    start += 3;
-                    if (start == row.size())
-                    {
-                        if (x > mDataWidth)
-                            mDataWidth = x;
-                        break;
-                    }
+                start += 3;
+                if (start == row.size())
+                {
+                    if (x > mDataWidth)
+                        mDataWidth = x;
+                    break;
                 }
             }
-            const size_t len = (end == std::string::npos) ? end : end - start;
+        }
+        const size_t len = (end == std::string::npos) ? end : end - start;
 
-            if (start >= row.length())
-                break;
+        if (start >= row.length())
+            break;
 
-            std::string part = row.substr(start, len);
-            int width = 0;
-            if (bold)
-                width = boldFont->getWidth(part);
-            else
-                width = font->getWidth(part);
+        std::string part = row.substr(start, len);
+        int width = 0;
+        if (bold)
+            width = boldFont->getWidth(part);
+        else
+            width = font->getWidth(part);
 
-            // Auto wrap mode
-            if (mMode == AUTO_WRAP && wWidth > 0 && width > 0
-                && (x + width + 10) > wWidth)
+        // Auto wrap mode
+        if (mMode == AUTO_WRAP && wWidth > 0 && width > 0
+            && (x + width + 10) > wWidth)
+        {
+            bool forced = false;
+
+            /* FIXME: This code layout makes it easy to crash remote
+               clients by talking garbage. Forged long utf-8 characters
+               will cause either a buffer underflow in substr or an
+               infinite loop in the main loop. */
+            do
             {
-                bool forced = false;
+                if (!forced)
+                    end = row.rfind(' ', end);
 
-                /* FIXME: This code layout makes it easy to crash remote
-                   clients by talking garbage. Forged long utf-8 characters
-                   will cause either a buffer underflow in substr or an
-                   infinite loop in the main loop. */
-                do
+                // Check if we have to (stupidly) force-wrap
+                if (end == std::string::npos || end <= start)
                 {
-                    if (!forced)
-                        end = row.rfind(' ', end);
-
-                    // Check if we have to (stupidly) force-wrap
-                    if (end == std::string::npos || end <= start)
-                    {
-                        forced = true;
-                        end = row.size();
-                        x += hyphenWidth;  // Account for the wrap-notifier
-                        continue;
-                    }
-
-                    // Skip to the start of the current character
-                    while ((row[end] & 192) == 128)
-                        end--;
-                    end--;  // And then to the last byte of the previous one
-
-                    part = row.substr(start, end - start + 1);
-                    if (bold)
-                        width = boldFont->getWidth(part);
-                    else
-                        width = font->getWidth(part);
+                    forced = true;
+                    end = row.size();
+                    x += hyphenWidth;  // Account for the wrap-notifier
+                    continue;
                 }
-                while (end > start && width > 0 && (x + width + 10) > wWidth);
 
-                if (forced)
-                {
-                    x -= hyphenWidth;  // Remove the wrap-notifier accounting
-                    mLineParts.push_back(LinePart(
-                        wWidth - hyphenWidth, y + mItemPadding,
-                        selColor[0], selColor[1], hyphen, bold));
-                    end++;  // Skip to the next character
-                }
+                // Skip to the start of the current character
+                while ((row[end] & 192) == 128)
+                    end--;
+                end--;  // And then to the last byte of the previous one
+
+                part = row.substr(start, end - start + 1);
+                if (bold)
+                    width = boldFont->getWidth(part);
                 else
-                {
-                    end += 2;  // Skip to after the space
-                }
+                    width = font->getWidth(part);
+            }
+            while (end > start && width > 0 && (x + width + 10) > wWidth);
 
-                wrapped = true;
-                wrappedLines++;
+            if (forced)
+            {
+                x -= hyphenWidth;  // Remove the wrap-notifier accounting
+                mLineParts.push_back(LinePart(
+                    wWidth - hyphenWidth, y + mItemPadding,
+                    selColor[0], selColor[1], hyphen, bold));
+                end++;  // Skip to the next character
+            }
+            else
+            {
+                end += 2;  // Skip to after the space
             }
 
-            mLineParts.push_back(LinePart(x, y + mItemPadding,
-                selColor[0], selColor[1], part.c_str(), bold));
+            wrapped = true;
+            wrappedLines++;
+        }
 
-            if (bold)
-                width = boldFont->getWidth(part);
-            else
-                width = font->getWidth(part);
+        mLineParts.push_back(LinePart(x, y + mItemPadding,
+            selColor[0], selColor[1], part.c_str(), bold));
 
-            if (mMode == AUTO_WRAP && (width == 0 && !processed))
-                break;
+        if (bold)
+            width = boldFont->getWidth(part);
+        else
+            width = font->getWidth(part);
 
-            x += width;
-            if (x > mDataWidth)
-                mDataWidth = x;
-        }
-        y += fontHeight;
+        if (mMode == AUTO_WRAP && (width == 0 && !processed))
+            break;
+
+        x += width;
+        if (x > mDataWidth)
+            mDataWidth = x;
     }
-    if (static_cast<signed>(wWidth) != maxWidth)
-        setWidth(maxWidth);
+    y += fontHeight;
+    addRowLayout(static_cast<unsigned int>(mLineParts.size() - firstPart),
+        static_cast<int>(y), (wrappedLines + 1) * fontHeight, link);
+}
 
-    return (static_cast<int>(mTextRows.size()) + wrappedLines)
-        * fontHeight + moreHeight + 2 * mPadding;
+void BrowserBox::addRowLayout(const unsigned int parts,
+                              const int y,
+                              const int size,
+                              const int link)
+{
+    BrowserRowLayout layout;
+    layout.color[0] = mLayoutColor[0];
+    layout.color[1] = mLayoutColor[1];
+    layout.parts = parts;
+    layout.links = link - mLayoutLink;
+    layout.height = y - mLayoutY;
+    layout.size = size;
+    mRowLayouts.push_back(layout);
+
+    mLayoutY = y;
+    mLayoutSize += size;
+    mLayoutLink = link;
+}
+
+void BrowserBox::removeFirstRowLayout(const int links)
+{
+    if (mRowLayouts.empty())
+        return;
+
+    const BrowserRowLayout layout = mRowLayouts.front();
+    mRowLayouts.pop_front();
+    if (mLayoutDirty
+        || layout.links != links
+        || layout.parts > mLineParts.size())
+    {
+        mLayoutDirty = true;
+        return;
+    }
+
+    // parts and links of next rows not moved, only view origin changed
+    mLineParts.erase(mLineParts.begin(), mLineParts.begin() + layout.parts);
+    mLayoutOffset += layout.height;
+    mLayoutSize -= layout.size;
+    mLayoutLink -= layout.links;
+
+    // prevent offset overflow in very long logs
+    if (mLayoutOffset > 0x10000000)
+    {
+        mLayoutDirty = true;
+        return;
+    }
+
+    // colors set in removed row was used as start colors of next row
+    if (!mRowLayouts.empty()
+        && (layout.color[0] != mForegroundColor
+        || layout.color[1] != mForegroundColor2))
+    {
+        relayoutFirstRow();
+    }
+}
+
+void BrowserBox::relayoutFirstRow()
+{
+    const BrowserRowLayout oldLayout = mRowLayouts.front();
+    const Color color[2] = {mLayoutColor[0], mLayoutColor[1]};
+    const int y = mLayoutY;
+    const int size = mLayoutSize;
+    const int link = mLayoutLink;
+    const size_t parts = mLineParts.size();
+    const int wWidth = mLayoutWidth - mPadding;
+    int maxWidth = wWidth;
+
+    mLayoutColor[0] = mForegroundColor;
+    mLayoutColor[1] = mForegroundColor2;
+    mLayoutY = mPadding + mLayoutOffset;
+    mLayoutLink = 0;
+    layoutRow(mTextRows.front(), maxWidth);
+    const BrowserRowLayout newLayout = mRowLayouts.back();
+    mRowLayouts.pop_back();
+    const LinePartList newParts(mLineParts.begin() + parts,
+        mLineParts.end());
+    mLineParts.erase(mLineParts.begin() + parts, mLineParts.end());
+
+    mLayoutColor[0] = color[0];
+    mLayoutColor[1] = color[1];
+    mLayoutY = y;
+    mLayoutSize = size;
+    mLayoutLink = link;
+
+    // if row end state changed, all next rows must be updated too
+    if (maxWidth != wWidth
+        || newLayout.parts != oldLayout.parts
+        || newLayout.height != oldLayout.height
+        || newLayout.links != oldLayout.links
+        || newLayout.color[0] != oldLayout.color[0]
+        || newLayout.color[1] != oldLayout.color[1])
+    {
+        mLayoutDirty = true;
+        return;
+    }
+    std::copy(newParts.begin(), newParts.end(), mLineParts.begin());
+}
+
+void BrowserBox::resetLayout()
+{
+    mLineParts.clear();
+    mRowLayouts.clear();
+    mLayoutColor[0] = mForegroundColor;
+    mLayoutColor[1] = mForegroundColor2;
+    mLayoutY = mPadding;
+    mLayoutOffset = 0;
+    mLayoutSize = 0;
+    mLayoutLink = 0;
+    mLayoutDirty = false;
 }
 
 void BrowserBox::updateHeight()
@@ -905,11 +1008,12 @@ std::string BrowserBox::getTextAtPos(const int x, const int y) const
     std::string str;
     int lastY = 0;
 
-    FOR_EACH (LinePartCIter, i, mLineParts)
+    textY += mLayoutOffset;
+    const LinePartCIter i_end = mLineParts.end();
+    for (LinePartCIter i = std::lower_bound(mLineParts.begin(), i_end,
+         mYStart - 50 + mLayoutOffset, LinePartYLess()); i != i_end; ++ i)
     {
         const LinePart &part = *i;
-        if (part.mY + 50 < mYStart)
-            continue;
         if (part.mY > textY)
             break;
 
@@ -927,11 +1031,17 @@ std::string BrowserBox::getTextAtPos(const int x, const int y) const
     return str;
 }
 
+void BrowserBox::fontChanged()
+{
+    mLayoutDirty = true;
+}
+
 void BrowserBox::setForegroundColorAll(const Color &color1,
                                        const Color &color2)
 {
     mForegroundColor = color1;
     mForegroundColor2 = color2;
+    mLayoutDirty = true;
 }
 
 void BrowserBox::moveSelectionUp()
@@ -29,6 +29,8 @@
 #include "gui/widgets/linepart.h"
 #include "gui/widgets/widget.h"
 
+#include <deque>
+
 #include "localconsts.h"
 
 class LinkHandler;
@@ -53,6 +55,28 @@ struct BrowserLink final
     std::string caption;
 };
 
+/**
+ * Cached layout of one text row. Line parts of the row are stored
+ * contiguously in BrowserBox::mLineParts.
+ */
+struct BrowserRowLayout final
+{
+    BrowserRowLayout() :
+        color(),
+        parts(0),
+        links(0),
+        height(0),
+        size(0)
+    {
+    }
+
+    Color color[2];  /**< Text colors active after this row. */
+    unsigned int parts;
+    int links;
+    int height;      /**< Vertical advance of this row. */
+    int size;        /**< Contribution to the widget height. */
+};
+
 /**
  * A simple browser box able to handle links and forward events to the
  * parent conteiner.
@@ -125,6 +149,8 @@ class BrowserBox final : public Widget,
 
         void updateHeight();
 
+        void fontChanged() override final;
+
         /**
          * BrowserBox modes.
          */
@@ -199,20 +225,47 @@ class BrowserBox final : public Widget,
 
         void selectSelection();
 
+#ifdef UNITTESTS
+        const std::deque<LinePart> &getLineParts() const
+        { return mLineParts; }
+
+        const std::deque<BrowserLink> &getLinks() const
+        { return mLinks; }
+
+        int getLayoutOffset() const
+        { return mLayoutOffset; }
+#endif
+
     private:
         int calcHeight() A_WARN_UNUSED;
 
+        void layoutRow(const std::string &row, int &maxWidth);
+
+        void addRowLayout(const unsigned int parts,
+                          const int y,
+                          const int size,
+                          const int link);
+
+        void removeFirstRowLayout(const int links);
+
+        void relayoutFirstRow();
+
+        void resetLayout();
+
         typedef TextRows::iterator TextRowIterator;
         typedef TextRows::const_iterator TextRowCIter;
         TextRows mTextRows;
         std::list<int> mTextRowLinksCount;
 
-        typedef std::vector<LinePart> LinePartList;
+        typedef std::deque<LinePart> LinePartList;
         typedef LinePartList::iterator LinePartIterator;
         typedef LinePartList::const_iterator LinePartCIter;
         LinePartList mLineParts;
 
-        typedef std::vector<BrowserLink> Links;
+        typedef std::deque<BrowserRowLayout> RowLayouts;
+        RowLayouts mRowLayouts;
+
+        typedef std::deque<BrowserLink> Links;
         typedef Links::iterator LinkIterator;
         Links mLinks;
 
@@ -234,6 +287,12 @@ class BrowserBox final : public Widget,
         Color mHighlightColor;
         Color mHyperLinkColor;
         Color mColors[2][COLORS_MAX];
+        Color mLayoutColor[2];
+        int mLayoutWidth;
+        int mLayoutY;
+        int mLayoutOffset;   /**< Height of rows removed from top. */
+        int mLayoutSize;
+        int mLayoutLink;
 
         bool mOpaque;
         bool mUseLinksAndUserColors;
@@ -243,6 +302,7 @@ class BrowserBox final : public Widget,
         bool mEnableImages;
         bool mEnableKeys;
         bool mEnableTabs;
+        bool mLayoutDirty;
 
         static ImageSet *mEmotes;
         static int mInstances;
@@ -28,10 +28,14 @@
 
 #include "resources/sdlimagehelper.h"
 
+#include "utils/stringutils.h"
+
 #include "gtest/gtest.h"
 
 #include <physfs.h>
 
+#include <SDL_timer.h>
+
 #include "debug.h"
 
 extern const char *dirSeparator;
@@ -145,3 +149,79 @@ TEST(browserbox, test1)
     delete client;
     client = nullptr;
 }
+
+TEST(browserbox, test2)
+{
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    client = new Client;
+    logger = new Logger();
+    imageHelper = new SDLImageHelper();
+    theme = new Theme;
+    Widget::setGlobalFont(new Font("/usr/share/fonts/truetype/"
+        "ttf-dejavu/DejaVuSans-Oblique.ttf", 18));
+    BrowserBox *box = new BrowserBox(nullptr, BrowserBox::AUTO_WRAP, true, "");
+    box->setWidth(300);
+    box->setMaxRow(5000);
+
+    // simulate long chat log
+    const uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < 10000; f ++)
+    {
+        box->addRow(strprintf("##%d[00:00] player %d: @@%d|link@@ "
+            "some long chat line what should be wrapped %%%%1 ##> end",
+            f % 10, f, f));
+    }
+    logger->log("browserbox: 10000 rows added in %d ms",
+        static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(5000U, box->getRows().size());
+
+    // removed rows only moved view origin
+    const int offset = box->getLayoutOffset();
+    EXPECT_TRUE(offset > 0);
+    const std::deque<LinePart> parts = box->getLineParts();
+    const std::deque<BrowserLink> links = box->getLinks();
+    ASSERT_FALSE(parts.empty());
+    EXPECT_EQ(5000U, links.size());
+    EXPECT_EQ(box->getPadding(), parts.front().mY - offset);
+
+    // full layout must produce same height as incremental one
+    const int height = box->getHeight();
+    box->setWidth(301);
+    box->updateHeight();
+    box->setWidth(300);
+    const uint32_t resizeTime = SDL_GetTicks();
+    box->updateHeight();
+    logger->log("browserbox: 5000 rows relayout in %d ms",
+        static_cast<int>(SDL_GetTicks() - resizeTime));
+    EXPECT_EQ(height, box->getHeight());
+
+    // and same visible parts and links
+    EXPECT_EQ(0, box->getLayoutOffset());
+    const std::deque<LinePart> &newParts = box->getLineParts();
+    ASSERT_EQ(parts.size(), newParts.size());
+    for (size_t f = 0; f < parts.size(); f ++)
+    {
+        EXPECT_EQ(parts[f].mX, newParts[f].mX);
+        EXPECT_EQ(parts[f].mY - offset, newParts[f].mY);
+        EXPECT_EQ(parts[f].mText, newParts[f].mText);
+        EXPECT_EQ(parts[f].mType, newParts[f].mType);
+        if (f > 0)
+        {
+            EXPECT_TRUE(newParts[f - 1].mY <= newParts[f].mY);
+        }
+    }
+    const std::deque<BrowserLink> &newLinks = box->getLinks();
+    ASSERT_EQ(links.size(), newLinks.size());
+    for (size_t f = 0; f < links.size(); f ++)
+    {
+        EXPECT_EQ(links[f].link, newLinks[f].link);
+        EXPECT_EQ(links[f].x1, newLinks[f].x1);
+        EXPECT_EQ(links[f].y1 - offset, newLinks[f].y1);
+        EXPECT_EQ(links[f].y2 - offset, newLinks[f].y2);
+    }
+
+    delete box;
+    delete client;
+    client = nullptr;
+}
@@ -26,6 +26,8 @@
 
 #include "gui/fonts/font.h"
 
+#include "gui/widgets/visiblerows.h"
+
 #include "debug.h"
 
 ExtendedListBox::ExtendedListBox(const Widget2 *const widget,
@@ -71,6 +73,8 @@ void ExtendedListBox::draw(Graphics *graphics)
     mSelectedItems.clear();
     int y = 0;
     const int insideWidth = width - pad2;
+    // rows may wrap to two lines, so visibility checked by row offset
+    const VisibleRows rows(graphics, mPadding, height, sz);
     for (int f = 0; f < sz; f ++)
     {
         int row = f;
@@ -82,6 +86,13 @@ void ExtendedListBox::draw(Graphics *graphics)
         if (image)
             strWidth += image->getWidth() + mImagePadding;
 
+        const int rowSpan = insideWidth < strWidth ? height * 2 : height;
+        if (!rows.isVisibleArea(y, rowSpan))
+        {
+            y += rowSpan;
+            continue;
+        }
+
         std::vector<ExtendedListBoxItem> &list =
             row == mSelected ? mSelectedItems : mListItems;
 
@@ -28,6 +28,8 @@
 
 #include "gui/models/tablemodel.h"
 
+#include "gui/widgets/visiblerows.h"
+
 #include "input/inputaction.h"
 
 #include "listeners/guitableactionlistener.h"
@@ -253,7 +255,6 @@ void GuiTable::draw(Graphics* graphics)
     const Rect &rect = mDimension;
     const int width = rect.width;
     const int height = rect.height;
-    const int y = rect.y;
     if (mOpaque)
     {
         mBackgroundColor.a = static_cast<int>(mAlpha * 255.0F);
@@ -266,19 +267,9 @@ void GuiTable::draw(Graphics* graphics)
     int rHeight = getRowHeight();
     if (!rHeight)
         rHeight = 1;
-    int first_row = -(y / rHeight);
-
-    if (first_row < 0)
-        first_row = 0;
-
-    unsigned rows_nr = 1 + (height / rHeight);  // May overestimate by one.
-    unsigned max_rows_nr;
-    if (mModel->getRows() < first_row)
-        max_rows_nr = 0;
-    else
-        max_rows_nr = mModel->getRows() - first_row;  // clip if neccessary:
-    if (max_rows_nr < rows_nr)
-        rows_nr = max_rows_nr;
+    const VisibleRows rows(graphics, 0, rHeight, mModel->getRows());
+    const unsigned first_row = rows.first;
+    const unsigned last_row = rows.last;
 
     // Now determine the first and last column
     // Take the easy way out; these are usually bounded and all visible.
@@ -287,7 +278,7 @@ void GuiTable::draw(Graphics* graphics)
 
     int y_offset = first_row * rHeight;
 
-    for (unsigned r = first_row; r < first_row + rows_nr; ++r)
+    for (unsigned r = first_row; r < last_row; ++r)
     {
         int x_offset = 0;
 
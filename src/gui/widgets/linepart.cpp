@@ -25,6 +25,37 @@
 
 #include "debug.h"
 
+LinePart::LinePart(const LinePart &part) :
+    mX(part.mX),
+    mY(part.mY),
+    mColor(part.mColor),
+    mColor2(part.mColor2),
+    mText(part.mText),
+    mType(part.mType),
+    mImage(part.mImage),
+    mBold(part.mBold)
+{
+    if (mImage)
+        mImage->incRef();
+}
+
+LinePart &LinePart::operator=(const LinePart &part)
+{
+    if (part.mImage)
+        part.mImage->incRef();
+    if (mImage)
+        mImage->decRef();
+    mX = part.mX;
+    mY = part.mY;
+    mColor = part.mColor;
+    mColor2 = part.mColor2;
+    mText = part.mText;
+    mType = part.mType;
+    mImage = part.mImage;
+    mBold = part.mBold;
+    return *this;
+}
+
 LinePart::~LinePart()
 {
     if (mImage)
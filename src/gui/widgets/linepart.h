@@ -60,6 +60,10 @@ class LinePart final
         {
         }
 
+        LinePart(const LinePart &part);
+
+        LinePart &operator=(const LinePart &part);
+
         ~LinePart();
 
         int mX, mY;
@@ -77,6 +77,8 @@
 
 #include "gui/fonts/font.h"
 
+#include "gui/widgets/visiblerows.h"
+
 #include "gui/models/listmodel.h"
 
 #include "debug.h"
@@ -166,10 +168,13 @@ void ListBox::draw(Graphics *graphics)
     const int rowHeight = getRowHeight();
     const int width = mDimension.width;
 
+    const int sz = mListModel->getNumberOfElements();
+    const VisibleRows rows(graphics, mPadding, rowHeight, sz);
+
     if (mCenterText)
     {
         // Draw filled rectangle around the selected list element
-        if (mSelected >= 0)
+        if (rows.isVisible(mSelected))
         {
             graphics->fillRectangle(Rect(mPadding,
                 rowHeight * mSelected + mPadding,
@@ -184,9 +189,9 @@ void ListBox::draw(Graphics *graphics)
         }
         // Draw the list elements
         graphics->setColorAll(mForegroundColor, mForegroundColor2);
-        const int sz = mListModel->getNumberOfElements();
-        for (int i = 0, y = mPadding + mItemPadding;
-             i < sz; ++i, y += rowHeight)
+        for (int i = rows.first,
+             y = mPadding + mItemPadding + rows.first * rowHeight;
+             i < rows.last; ++i, y += rowHeight)
         {
             if (i != mSelected)
             {
@@ -199,7 +204,7 @@ void ListBox::draw(Graphics *graphics)
     else
     {
         // Draw filled rectangle around the selected list element
-        if (mSelected >= 0)
+        if (rows.isVisible(mSelected))
         {
             graphics->fillRectangle(Rect(mPadding,
                 rowHeight * mSelected + mPadding,
@@ -213,9 +218,9 @@ void ListBox::draw(Graphics *graphics)
         }
         // Draw the list elements
         graphics->setColorAll(mForegroundColor, mForegroundColor2);
-        const int sz = mListModel->getNumberOfElements();
-        for (int i = 0, y = mPadding + mItemPadding; i < sz;
-             ++i, y += rowHeight)
+        for (int i = rows.first,
+             y = mPadding + mItemPadding + rows.first * rowHeight;
+             i < rows.last; ++i, y += rowHeight)
         {
             if (i != mSelected)
             {
@@ -150,6 +150,9 @@ class ListBox notfinal : public Widget,
         int getPressedIndex() const
         { return mPressedIndex; }
 
+        int getPadding() const A_WARN_UNUSED
+        { return mPadding; }
+
         virtual unsigned int getRowHeight() const A_WARN_UNUSED
         { return mRowHeight; }
 
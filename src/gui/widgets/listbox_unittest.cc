@@ -0,0 +1,191 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "logger.h"
+
+#include "client.h"
+
+#include "gui/theme.h"
+
+#include "gui/fonts/font.h"
+
+#include "gui/models/listmodel.h"
+
+#include "gui/widgets/listbox.h"
+#include "gui/widgets/visiblerows.h"
+
+#include "render/surfacegraphics.h"
+
+#include "resources/sdlimagehelper.h"
+
+#include "utils/stringutils.h"
+
+#include "gtest/gtest.h"
+
+#include <physfs.h>
+
+#include <SDL_timer.h>
+
+#include "debug.h"
+
+extern const char *dirSeparator;
+
+namespace
+{
+    // list model what remember requested rows
+    class DrawnRowsModel final : public ListModel
+    {
+        public:
+            DrawnRowsModel() :
+                ListModel(),
+                names(),
+                minRow(0),
+                maxRow(0),
+                drawn(0)
+            { }
+
+            A_DELETE_COPY(DrawnRowsModel)
+
+            int getNumberOfElements() override final
+            { return static_cast<int>(names.size()); }
+
+            std::string getElementAt(int i) override final
+            {
+                if (!drawn || i < minRow)
+                    minRow = i;
+                if (!drawn || i > maxRow)
+                    maxRow = i;
+                drawn ++;
+                return names[i];
+            }
+
+            void reset()
+            {
+                minRow = 0;
+                maxRow = 0;
+                drawn = 0;
+            }
+
+            StringVect names;
+            int minRow;
+            int maxRow;
+            int drawn;
+    };
+}  // namespace
+
+TEST(listbox, visibleRows)
+{
+    SurfaceGraphics graphics;
+    {
+        // no clip area, all rows
+        const VisibleRows rows(&graphics, 0, 10, 100);
+        EXPECT_EQ(0, rows.first);
+        EXPECT_EQ(100, rows.last);
+    }
+
+    // scroll area at 50,50 with size 200x100, scrolled by 305 pixels
+    graphics.pushClipArea(Rect(50, 50, 200, 100));
+    graphics.pushClipArea(Rect(0, -305, 200, 1000));
+    {
+        const VisibleRows rows(&graphics, 0, 10, 100);
+        EXPECT_EQ(30, rows.first);
+        EXPECT_EQ(41, rows.last);
+        EXPECT_FALSE(rows.isVisible(29));
+        EXPECT_TRUE(rows.isVisible(30));
+        EXPECT_TRUE(rows.isVisible(40));
+        EXPECT_FALSE(rows.isVisible(41));
+        EXPECT_FALSE(rows.isVisible(-1));
+    }
+    {
+        // rows with padding
+        const VisibleRows rows(&graphics, 5, 10, 100);
+        EXPECT_EQ(30, rows.first);
+        EXPECT_EQ(40, rows.last);
+    }
+    {
+        // list end visible
+        const VisibleRows rows(&graphics, 0, 10, 35);
+        EXPECT_EQ(30, rows.first);
+        EXPECT_EQ(35, rows.last);
+    }
+    {
+        // list ended before clip area
+        const VisibleRows rows(&graphics, 0, 10, 20);
+        EXPECT_EQ(20, rows.first);
+        EXPECT_EQ(20, rows.last);
+    }
+    graphics.popClipArea();
+    graphics.popClipArea();
+}
+
+TEST(listbox, DISABLED_benchmark)
+{
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    client = new Client;
+    logger = new Logger();
+    imageHelper = new SDLImageHelper();
+    theme = new Theme;
+    Widget::setGlobalFont(new Font("/usr/share/fonts/truetype/"
+        "ttf-dejavu/DejaVuSans-Oblique.ttf", 18));
+
+    // simulate who is online list
+    const int count = 100000;
+    DrawnRowsModel *const model = new DrawnRowsModel;
+    uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < count; f ++)
+        model->names.push_back(strprintf("player %d (level %d)", f, f % 100));
+    ListBox *const box = new ListBox(nullptr, model, "");
+    box->postInit();
+    box->setWidth(300);
+    logger->log("listbox: %d rows added in %d ms",
+        count, static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(count * box->getRowHeight(), box->getHeight());
+
+    // draw with scrolling in 300x400 scroll area
+    SurfaceGraphics graphics;
+    graphics.pushClipArea(Rect(0, 0, 300, 400));
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < 100; f ++)
+    {
+        graphics.pushClipArea(Rect(0, -f * 1000, 300, box->getHeight()));
+        model->reset();
+        box->draw(&graphics);
+
+        // only rows inside scroll area requested from model
+        const VisibleRows rows(&graphics, box->getPadding(),
+            static_cast<int>(box->getRowHeight()), count);
+        EXPECT_LT(rows.first, rows.last);
+        EXPECT_GT(count, rows.last - rows.first);
+        EXPECT_EQ(rows.last - rows.first, model->drawn);
+        EXPECT_EQ(rows.first, model->minRow);
+        EXPECT_EQ(rows.last - 1, model->maxRow);
+        graphics.popClipArea();
+    }
+    graphics.popClipArea();
+    logger->log("listbox: 100 frames with %d rows drawn in %d ms",
+        count, static_cast<int>(SDL_GetTicks() - startTime));
+
+    delete box;
+    delete model;
+    delete client;
+    client = nullptr;
+}
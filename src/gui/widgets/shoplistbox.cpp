@@ -36,6 +36,8 @@
 
 #include "gui/models/shopitems.h"
 
+#include "gui/widgets/visiblerows.h"
+
 #include "resources/image.h"
 
 #include "debug.h"
@@ -96,9 +98,10 @@ void ShopListBox::draw(Graphics *graphics)
     const int sz = mListModel->getNumberOfElements();
     const int fontHeigh = getFont()->getHeight();
     const int width = mDimension.width - 2 * mPadding;
+    const VisibleRows rows(graphics, mPadding, mRowHeight, sz);
     // Draw the list elements
-    for (int i = 0, y = 0;
-         i < sz;
+    for (int i = rows.first, y = rows.first * mRowHeight;
+         i < rows.last;
          ++i, y += mRowHeight)
     {
         bool needDraw(false);
@@ -22,8 +22,10 @@
 
 #include "gui/widgets/tabs/debugwindowtabs.h"
 
+#include "actormanager.h"
 #include "game.h"
 
+#include "being/beingspritecache.h"
 #include "being/localplayer.h"
 
 #include "particle/particle.h"
@@ -34,20 +36,44 @@
 #include "gui/widgets/label.h"
 #include "gui/widgets/layouthelper.h"
 
+#include "gui/windows/minimap.h"
+
 #ifdef USE_OPENGL
 #include "resources/imagehelper.h"
 #endif
 
+#include "resources/mapprefetcher.h"
+#include "resources/resourcemanager.h"
+
 #include "resources/map/map.h"
 
+#include "enums/resources/memorytype.h"
+
 #include "net/packetcounters.h"
+#include "net/packetschema.h"
 
 #include "utils/gettext.h"
 #include "utils/stringutils.h"
 #include "utils/timer.h"
 
+#include <algorithm>
+
 #include "debug.h"
 
+namespace
+{
+    class SortPacketStatsFunctor final
+    {
+        public:
+            bool operator() (const Net::PacketStats *const stats1,
+                             const Net::PacketStats *const stats2) const
+            {
+                return stats1->decoded + stats1->errors
+                    > stats2->decoded + stats2->errors;
+            }
+    } packetStatsSorter;
+}  // namespace
+
 MapDebugTab::MapDebugTab(const Widget2 *const widget) :
     DebugTab(widget),
     // TRANSLATORS: debug window label
@@ -65,6 +91,25 @@ MapDebugTab::MapDebugTab(const Widget2 *const widget) :
     mMapActorCountLabel(new Label(this, strprintf("%s %d",
         // TRANSLATORS: debug window label
         _("Map actors count:"), 88888))),
+    mSpriteCacheLabel(new Label(this, strprintf("%s %d / %d",
+        // TRANSLATORS: debug window label
+        _("Sprite cache hits / misses:"), 888888, 888888))),
+    mSpriteResolveLabel(new Label(this, strprintf(
+        // TRANSLATORS: debug window label
+        _("Sprite resolve time: %u us"), 888888))),
+    mActorLogicLabel(new Label(this, strprintf(
+        // TRANSLATORS: debug window label
+        _("Actors logic: %u us, off-screen: %d"), 888888, 88888))),
+    mPausedEmittersLabel(new Label(this, strprintf(
+        // TRANSLATORS: debug window label
+        _("Paused emitters: %d"), 88888))),
+    mMapPrefetchLabel(new Label(this, strprintf(
+        // TRANSLATORS: debug window label
+        _("Map prefetch hits / misses: %d / %d, warp time: %d ms"),
+        88888, 88888, 88888))),
+    mMinimapDrawLabel(new Label(this, strprintf(
+        // TRANSLATORS: debug window label
+        _("Minimap draw: %u us, dots updates: %d"), 888888, 88888))),
     // TRANSLATORS: debug window label
     mXYLabel(new Label(this, strprintf("%s (?,?)", _("Player Position:")))),
     mTexturesLabel(nullptr),
@@ -133,10 +178,16 @@ MapDebugTab::MapDebugTab(const Widget2 *const widget) :
     place(0, 6, mTileMouseLabel, 2);
     place(0, 7, mParticleCountLabel, 2);
     place(0, 8, mMapActorCountLabel, 2);
+    place(0, 9, mSpriteCacheLabel, 2);
+    place(0, 10, mSpriteResolveLabel, 2);
+    place(0, 11, mActorLogicLabel, 2);
+    place(0, 12, mPausedEmittersLabel, 2);
+    place(0, 13, mMapPrefetchLabel, 2);
+    place(0, 14, mMinimapDrawLabel, 2);
 #ifdef USE_OPENGL
 #if defined (DEBUG_OPENGL_LEAKS) || defined(DEBUG_DRAW_CALLS) \
     || defined(DEBUG_BIND_TEXTURE)
-    int n = 9;
+    int n = 15;
 #endif
 #ifdef DEBUG_OPENGL_LEAKS
     mTexturesLabel = new Label(this, strprintf("%s %s",
@@ -207,6 +258,38 @@ void MapDebugTab::logic()
                 // TRANSLATORS: debug window label
                 strprintf("%s %d", _("Map actors count:"),
                 map->getActorsCount()));
+
+            mSpriteCacheLabel->setCaption(strprintf("%s %u / %u",
+                // TRANSLATORS: debug window label
+                _("Sprite cache hits / misses:"),
+                BeingSpriteCache::getHits(),
+                BeingSpriteCache::getMisses()));
+            mSpriteResolveLabel->setCaption(strprintf(
+                // TRANSLATORS: debug window label
+                _("Sprite resolve time: %u us"),
+                BeingSpriteCache::getResolveTime()));
+            if (actorManager)
+            {
+                mActorLogicLabel->setCaption(strprintf(
+                    // TRANSLATORS: debug window label
+                    _("Actors logic: %u us, off-screen: %d"),
+                    actorManager->getLogicTime(),
+                    actorManager->getOffscreenCount()));
+            }
+            mPausedEmittersLabel->setCaption(strprintf(
+                // TRANSLATORS: debug window label
+                _("Paused emitters: %d"), Particle::pausedEmitters));
+            mMapPrefetchLabel->setCaption(strprintf(
+                // TRANSLATORS: debug window label
+                _("Map prefetch hits / misses: %d / %d, warp time: %d ms"),
+                MapPrefetcher::getHits(),
+                MapPrefetcher::getMisses(),
+                MapPrefetcher::getWarpTime()));
+            mMinimapDrawLabel->setCaption(strprintf(
+                // TRANSLATORS: debug window label
+                _("Minimap draw: %u us, dots updates: %d"),
+                Minimap::getDrawTime(),
+                Minimap::getDotsUpdates()));
 #ifdef USE_OPENGL
 #ifdef DEBUG_OPENGL_LEAKS
             mTexturesLabel->setCaption(strprintf("%s %d",
@@ -250,6 +333,12 @@ void MapDebugTab::logic()
 
     mMapActorCountLabel->adjustSize();
     mParticleCountLabel->adjustSize();
+    mSpriteCacheLabel->adjustSize();
+    mSpriteResolveLabel->adjustSize();
+    mActorLogicLabel->adjustSize();
+    mPausedEmittersLabel->adjustSize();
+    mMapPrefetchLabel->adjustSize();
+    mMinimapDrawLabel->adjustSize();
 
     mFPSLabel->setCaption(strprintf(mFPSText.c_str(), fps));
     // TRANSLATORS: debug window label, logic per second
@@ -429,7 +518,11 @@ NetDebugTab::NetDebugTab(const Widget2 *const widget) :
     DebugTab(widget),
     mPingLabel(new Label(this, "                ")),
     mInPackets1Label(new Label(this, "                ")),
-    mOutPackets1Label(new Label(this, "                "))
+    mOutPackets1Label(new Label(this, "                ")),
+    mOutStallsLabel(new Label(this, "                ")),
+    mInCoalescedLabel(new Label(this, "                ")),
+    mInStringsLabel(new Label(this, "                ")),
+    mSchemaLabels()
 {
     LayoutHelper h(this);
     ContainerPlacer place = h.getPlacer(0, 0);
@@ -437,6 +530,17 @@ NetDebugTab::NetDebugTab(const Widget2 *const widget) :
     place(0, 0, mPingLabel, 2);
     place(0, 1, mInPackets1Label, 2);
     place(0, 2, mOutPackets1Label, 2);
+    place(0, 3, mOutStallsLabel, 2);
+    place(0, 4, mInCoalescedLabel, 2);
+    place(0, 5, mInStringsLabel, 2);
+
+    // lines for busiest packet schemas
+    for (int f = 0; f < 10; f ++)
+    {
+        Label *const label = new Label(this, "                ");
+        mSchemaLabels.push_back(label);
+        place(0, 6 + f, label, 2);
+    }
 
     place.getCell().matchColWidth(0, 0);
     place = h.getPlacer(0, 1);
@@ -463,5 +567,113 @@ void NetDebugTab::logic()
     // TRANSLATORS: debug window label
     mOutPackets1Label->setCaption(strprintf(_("Out: %d bytes/s"),
         PacketCounters::getOutBytes()));
+    // TRANSLATORS: debug window label
+    mOutStallsLabel->setCaption(strprintf(_("Send stalls: %d/s, %d bytes"),
+        PacketCounters::getOutStalls(),
+        PacketCounters::getOutPending()));
+    // TRANSLATORS: debug window label
+    mInCoalescedLabel->setCaption(strprintf(_("Coalesced: %d packets/s"),
+        PacketCounters::getInCoalesced()));
+    // TRANSLATORS: debug window label
+    mInStringsLabel->setCaption(strprintf(
+        _("Strings: %d/s, packets: %d/s"),
+        PacketCounters::getInStrings(),
+        PacketCounters::getInPackets()));
+
+    // show only schemas used by current server, busiest first
+    std::vector<const Net::PacketStats*> schemas;
+    for (const Net::PacketStats *stats = Net::PacketStats::getFirst();
+         stats;
+         stats = stats->next)
+    {
+        if (stats->decoded || stats->errors)
+            schemas.push_back(stats);
+    }
+    const size_t shown = std::min(schemas.size(), mSchemaLabels.size());
+    std::partial_sort(schemas.begin(), schemas.begin() + shown,
+        schemas.end(), packetStatsSorter);
+    for (size_t f = 0; f < mSchemaLabels.size(); f ++)
+    {
+        if (f < shown)
+        {
+            const Net::PacketStats *const stats = schemas[f];
+            // TRANSLATORS: debug window label
+            mSchemaLabels[f]->setCaption(strprintf(
+                _("%s: %u decoded, %u errors"),
+                stats->name, stats->decoded, stats->errors));
+        }
+        else
+        {
+            mSchemaLabels[f]->setCaption("");
+        }
+    }
     BLOCK_END("NetDebugTab::logic")
 }
+
+CacheDebugTab::CacheDebugTab(const Widget2 *const widget) :
+    DebugTab(widget),
+    mImagesLabel(new Label(this, "                ")),
+    mImageSetsLabel(new Label(this, "                ")),
+    mSpritesLabel(new Label(this, "                ")),
+    mSoundsLabel(new Label(this, "                ")),
+    mMusicLabel(new Label(this, "                ")),
+    mOtherLabel(new Label(this, "                ")),
+    mOrphansLabel(new Label(this, "                "))
+{
+    LayoutHelper h(this);
+    ContainerPlacer place = h.getPlacer(0, 0);
+
+    place(0, 0, mImagesLabel, 2);
+    place(0, 1, mImageSetsLabel, 2);
+    place(0, 2, mSpritesLabel, 2);
+    place(0, 3, mSoundsLabel, 2);
+    place(0, 4, mMusicLabel, 2);
+    place(0, 5, mOtherLabel, 2);
+    place(0, 6, mOrphansLabel, 2);
+
+    place.getCell().matchColWidth(0, 0);
+    place = h.getPlacer(0, 1);
+    setDimension(Rect(0, 0, 600, 300));
+}
+
+void CacheDebugTab::logic()
+{
+    BLOCK_START("CacheDebugTab::logic")
+    const ResourceManager *const resman = ResourceManager::getInstance();
+    int memory[MemoryType::LAST];
+    int count[MemoryType::LAST];
+    resman->calcMemoryUsage(&memory[0], &count[0]);
+
+    // TRANSLATORS: debug window label
+    mImagesLabel->setCaption(strprintf(_("Images: %d, %d KB"),
+        count[MemoryType::IMAGES], memory[MemoryType::IMAGES] / 1024));
+    // TRANSLATORS: debug window label
+    mImageSetsLabel->setCaption(strprintf(_("Image sets: %d, %d KB"),
+        count[MemoryType::IMAGESETS], memory[MemoryType::IMAGESETS] / 1024));
+    // TRANSLATORS: debug window label
+    mSpritesLabel->setCaption(strprintf(_("Sprites: %d, %d KB"),
+        count[MemoryType::SPRITES], memory[MemoryType::SPRITES] / 1024));
+    // TRANSLATORS: debug window label
+    mSoundsLabel->setCaption(strprintf(_("Sounds: %d, %d KB"),
+        count[MemoryType::SOUNDS], memory[MemoryType::SOUNDS] / 1024));
+    // TRANSLATORS: debug window label
+    mMusicLabel->setCaption(strprintf(_("Music: %d, %d KB"),
+        count[MemoryType::MUSIC], memory[MemoryType::MUSIC] / 1024));
+    // TRANSLATORS: debug window label
+    mOtherLabel->setCaption(strprintf(_("Other: %d, %d KB"),
+        count[MemoryType::OTHER], memory[MemoryType::OTHER] / 1024));
+    // TRANSLATORS: debug window label
+    mOrphansLabel->setCaption(strprintf(_("Unused cache: %d, %d / %d KB"),
+        resman->getOrphanedCount(),
+        resman->getOrphanedMemory() / 1024,
+        resman->getCacheSize() / 1024));
+
+    mImagesLabel->adjustSize();
+    mImageSetsLabel->adjustSize();
+    mSpritesLabel->adjustSize();
+    mSoundsLabel->adjustSize();
+    mMusicLabel->adjustSize();
+    mOtherLabel->adjustSize();
+    mOrphansLabel->adjustSize();
+    BLOCK_END("CacheDebugTab::logic")
+}
@@ -25,6 +25,8 @@
 
 #include "gui/widgets/container.h"
 
+#include <vector>
+
 class Label;
 
 class DebugTab notfinal : public Container
@@ -65,6 +67,12 @@ class MapDebugTab final : public DebugTab
         Label *mTileMouseLabel;
         Label *mParticleCountLabel;
         Label *mMapActorCountLabel;
+        Label *mSpriteCacheLabel;
+        Label *mSpriteResolveLabel;
+        Label *mActorLogicLabel;
+        Label *mPausedEmittersLabel;
+        Label *mMapPrefetchLabel;
+        Label *mMinimapDrawLabel;
         Label *mXYLabel;
         Label *mTexturesLabel;
         int mUpdateTime;
@@ -121,6 +129,31 @@ class NetDebugTab final : public DebugTab
         Label *mPingLabel;
         Label *mInPackets1Label;
         Label *mOutPackets1Label;
+        Label *mOutStallsLabel;
+        Label *mInCoalescedLabel;
+        Label *mInStringsLabel;
+        std::vector<Label*> mSchemaLabels;
+};
+
+class CacheDebugTab final : public DebugTab
+{
+    friend class DebugWindow;
+
+    public:
+        explicit CacheDebugTab(const Widget2 *const widget);
+
+        A_DELETE_COPY(CacheDebugTab)
+
+        void logic() override final;
+
+    private:
+        Label *mImagesLabel;
+        Label *mImageSetsLabel;
+        Label *mSpritesLabel;
+        Label *mSoundsLabel;
+        Label *mMusicLabel;
+        Label *mOtherLabel;
+        Label *mOrphansLabel;
 };
 
 #endif  // GUI_WIDGETS_TABS_DEBUGWINDOWTABS_H
@@ -70,10 +70,6 @@ Setup_Perfomance::Setup_Perfomance(const Widget2 *const widget) :
     new SetupItemCheckBox(_("Hw acceleration"), "",
         "hwaccel", this, "hwaccelEvent");
 
-    // TRANSLATORS: settings option
-    new SetupItemCheckBox(_("Enable opacity cache (Software, can "
-        "use much memory)"), "", "alphaCache", this, "alphaCacheEvent");
-
 #ifndef USE_SDL2
     // TRANSLATORS: settings option
     new SetupItemCheckBox(_("Enable map reduce (Software)"), "",
@@ -156,6 +152,14 @@ Setup_Perfomance::Setup_Perfomance(const Widget2 *const widget) :
         "", "uselonglivesounds", this,
         "uselonglivesoundsEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemIntTextField(_("Unused resources cache size (MB)"), "",
+        "resourceCacheSize", this, "resourceCacheSizeEvent", 1, 1024);
+
+    // TRANSLATORS: settings option
+    new SetupItemCheckBox(_("Skip outdated being updates in network batch"),
+        "", "coalescePackets", this, "coalescePacketsEvent");
+
     // TRANSLATORS: settings group
     new SetupItemLabel(_("Critical options (DO NOT change if you don't "
         "know what you're doing)"), "", this);
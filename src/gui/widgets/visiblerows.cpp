@@ -0,0 +1,64 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gui/widgets/visiblerows.h"
+
+#include "render/graphics.h"
+
+#include <limits>
+
+#include "debug.h"
+
+VisibleRows::VisibleRows(const Graphics *const graphics,
+                         const int top,
+                         const int rowHeight,
+                         const int rows) :
+    first(0),
+    last(rows),
+    clipTop(std::numeric_limits<int>::min()),
+    clipBottom(std::numeric_limits<int>::max())
+{
+    if (!graphics)
+        return;
+    const ClipRect *const cr = graphics->getCurrentClipArea();
+    if (!cr)
+        return;
+
+    // clip area in widget coordinates, relative to first row
+    const int y1 = cr->y - cr->yOffset - top;
+    const int y2 = y1 + cr->height;
+    clipTop = y1;
+    clipBottom = y2;
+    if (rowHeight <= 0 || rows <= 0)
+        return;
+    if (y2 <= 0)
+    {
+        last = 0;
+        return;
+    }
+    if (y1 > 0)
+        first = y1 / rowHeight;
+    last = (y2 + rowHeight - 1) / rowHeight;
+    if (last > rows)
+        last = rows;
+    if (first > last)
+        first = last;
+}
@@ -0,0 +1,67 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GUI_WIDGETS_VISIBLEROWS_H
+#define GUI_WIDGETS_VISIBLEROWS_H
+
+#include "localconsts.h"
+
+class Graphics;
+
+/**
+ * Range of list rows inside current clip area. Rows outside of it
+ * not need to be measured or drawn.
+ */
+struct VisibleRows final
+{
+    /**
+     * @param top Y position of first row in widget.
+     * @param rowHeight Height of each row.
+     * @param rows Total rows count.
+     */
+    VisibleRows(const Graphics *const graphics,
+                const int top,
+                const int rowHeight,
+                const int rows);
+
+    A_DELETE_COPY(VisibleRows)
+
+    bool isVisible(const int row) const A_WARN_UNUSED
+    { return row >= first && row < last; }
+
+    /**
+     * Check area of variable height rows, with y offset relative to
+     * first row.
+     */
+    bool isVisibleArea(const int y, const int height) const A_WARN_UNUSED
+    { return y + height > clipTop && y < clipBottom; }
+
+    /** First visible row. */
+    int first;
+    /** Row after last visible row. */
+    int last;
+    /** Top of clip area, relative to first row. */
+    int clipTop;
+    /** Bottom of clip area, relative to first row. */
+    int clipBottom;
+};
+
+#endif  // GUI_WIDGETS_VISIBLEROWS_H
@@ -1537,7 +1537,7 @@ bool ChatWindow::resortChatLog(std::string line,
     if (!channel.empty())
         prefix = std::string("##3").append(channel).append("##0");
 
-    if (findI(line, mTradeFilter) != std::string::npos)
+    if (mTradeFilter.find(line) != std::string::npos)
     {
         if (tradeChatTab)
         {
@@ -1781,6 +1781,7 @@ void ChatWindow::initTradeFilter()
     std::ifstream tradeFile;
     struct stat statbuf;
 
+    StringVect filter;
     if (!stat(tradeListName.c_str(), &statbuf) && S_ISREG(statbuf.st_mode))
     {
         tradeFile.open(tradeListName.c_str(), std::ios::in);
@@ -1791,11 +1792,12 @@ void ChatWindow::initTradeFilter()
             {
                 const std::string str = line;
                 if (!str.empty())
-                    mTradeFilter.push_back(str);
+                    filter.push_back(str);
             }
         }
         tradeFile.close();
     }
+    mTradeFilter.build(filter);
 }
 
 void ChatWindow::updateOnline(const std::set<std::string> &onlinePlayers) const
@@ -1968,7 +1970,7 @@ void ChatWindow::addToAwayLog(const std::string &line)
     if (mAwayLog.size() > 20)
         mAwayLog.pop_front();
 
-    if (findI(line, mHighlights) != std::string::npos)
+    if (mHighlights.find(line) != std::string::npos)
         mAwayLog.push_back("##aaway:" + line);
 }
 
@@ -1994,10 +1996,12 @@ void ChatWindow::parseHighlights()
     if (!localPlayer)
         return;
 
-    splitToStringVector(mHighlights, config.getStringValue(
+    StringVect highlights;
+    splitToStringVector(highlights, config.getStringValue(
         "highlightWords"), ',');
 
-    mHighlights.push_back(localPlayer->getName());
+    highlights.push_back(localPlayer->getName());
+    mHighlights.build(highlights);
 }
 
 void ChatWindow::parseGlobalsFilter()
@@ -2006,15 +2010,16 @@ void ChatWindow::parseGlobalsFilter()
     if (!localPlayer)
         return;
 
-    splitToStringVector(mGlobalsFilter, config.getStringValue(
+    StringVect filters;
+    splitToStringVector(filters, config.getStringValue(
         "globalsFilter"), ',');
 
-    mHighlights.push_back(localPlayer->getName());
+    mGlobalsFilter.build(filters);
 }
 
 bool ChatWindow::findHighlight(const std::string &str)
 {
-    return findI(str, mHighlights) != std::string::npos;
+    return mHighlights.find(str) != std::string::npos;
 }
 
 void ChatWindow::copyToClipboard(const int x, const int y) const
@@ -2109,7 +2114,7 @@ void ChatWindow::logicChildren()
 
 void ChatWindow::addGlobalMessage(const std::string &line)
 {
-    if (debugChatTab && findI(line, mGlobalsFilter) != std::string::npos)
+    if (debugChatTab && mGlobalsFilter.find(line) != std::string::npos)
         debugChatTab->chatLog(line, ChatMsgType::BY_OTHER);
     else
         localChatTab->chatLog(line, ChatMsgType::BY_GM);
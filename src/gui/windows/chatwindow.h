@@ -35,6 +35,8 @@
 #include "listeners/keylistener.h"
 #include "listeners/statlistener.h"
 
+#include "utils/stringmatcher.h"
+
 class Button;
 class ChannelTab;
 class ChatTab;
@@ -390,14 +392,14 @@ class ChatWindow final : public Window,
         History mCommands;         /**< Command list. */
         History mCustomWords;
 
-        StringVect mTradeFilter;
+        StringMatcher mTradeFilter;
 
         ColorListModel *mColorListModel;
         DropDown *mColorPicker;
         Button *mChatButton;
         std::list<std::string> mAwayLog;
-        StringVect mHighlights;
-        StringVect mGlobalsFilter;
+        StringMatcher mHighlights;
+        StringMatcher mGlobalsFilter;
         int mChatColor;
         unsigned int mChatHistoryIndex;
         bool mReturnToggles;  // Marks whether <Return> toggles the chat log
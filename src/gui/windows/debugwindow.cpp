@@ -43,7 +43,8 @@ DebugWindow::DebugWindow() :
     mTabs(new TabbedArea(this)),
     mMapWidget(new MapDebugTab(this)),
     mTargetWidget(new TargetDebugTab(this)),
-    mNetWidget(new NetDebugTab(this))
+    mNetWidget(new NetDebugTab(this)),
+    mCacheWidget(new CacheDebugTab(this))
 {
     mTabs->postInit();
     setWindowName("Debug");
@@ -63,6 +64,8 @@ DebugWindow::DebugWindow() :
     mTabs->addTab(std::string(_("Target")), mTargetWidget);
     // TRANSLATORS: debug window tab
     mTabs->addTab(std::string(_("Net")), mNetWidget);
+    // TRANSLATORS: debug window tab
+    mTabs->addTab(std::string(_("Cache")), mCacheWidget);
 
     mTabs->setDimension(Rect(0, 0, 600, 300));
 
@@ -71,6 +74,7 @@ DebugWindow::DebugWindow() :
     mMapWidget->resize(w, h);
     mTargetWidget->resize(w, h);
     mNetWidget->resize(w, h);
+    mCacheWidget->resize(w, h);
     loadWindowState();
     enableVisibleSound(true);
 }
@@ -80,6 +84,7 @@ DebugWindow::~DebugWindow()
     delete2(mMapWidget);
     delete2(mTargetWidget);
     delete2(mNetWidget);
+    delete2(mCacheWidget);
 }
 
 void DebugWindow::postInit()
@@ -108,6 +113,9 @@ void DebugWindow::slowLogic()
         case 2:
             mNetWidget->logic();
             break;
+        case 3:
+            mCacheWidget->logic();
+            break;
     }
 
     if (localPlayer)
@@ -25,6 +25,7 @@
 
 #include "gui/widgets/window.h"
 
+class CacheDebugTab;
 class MapDebugTab;
 class NetDebugTab;
 class TabbedArea;
@@ -69,6 +70,7 @@ class DebugWindow final : public Window
         MapDebugTab *mMapWidget;
         TargetDebugTab *mTargetWidget;
         NetDebugTab *mNetWidget;
+        CacheDebugTab *mCacheWidget;
 };
 
 extern DebugWindow *debugWindow;
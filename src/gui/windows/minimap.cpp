@@ -47,15 +47,87 @@
 #include "utils/gettext.h"
 #include "utils/physfstools.h"
 #include "utils/sdlcheckutils.h"
+#include "utils/timer.h"
+
+#include <algorithm>
 
 #include "debug.h"
 
 Minimap *minimap = nullptr;
 bool Minimap::mShow = true;
+unsigned int Minimap::mDrawTime = 0;
+int Minimap::mDotsUpdates = 0;
+
+namespace
+{
+    // collision minimap tiles converted in one frame
+    const int mapImageTilesPerFrame = 16384;
+
+    typedef std::pair<int, Rect> MinimapDot;
+
+    struct DotTypeSorter final
+    {
+        bool operator() (const MinimapDot &dot1,
+                         const MinimapDot &dot2) const
+        {
+            return dot1.first < dot2.first;
+        }
+    } dotTypeSorter;
+
+    int getDotType(const Being *const being)
+    {
+        if (being->isGM())
+            return UserPalette::GM;
+        if (being->getGuild() == localPlayer->getGuild()
+            || being->getGuildName() == localPlayer->getGuildName())
+        {
+            return UserPalette::GUILD;
+        }
+
+        switch (being->getType())
+        {
+            case ActorType::Monster:
+                return UserPalette::MONSTER;
+
+            case ActorType::Npc:
+                return UserPalette::NPC;
+
+            case ActorType::Portal:
+                return UserPalette::PORTAL_HIGHLIGHT;
+
+            case ActorType::LocalPet:
+#ifdef EATHENA_SUPPORT
+            case ActorType::Pet:
+#endif
+                return UserPalette::PET;
+#ifdef EATHENA_SUPPORT
+            case ActorType::Mercenary:
+                return UserPalette::MERCENARY;
+
+            case ActorType::Homunculus:
+                return UserPalette::HOMUNCULUS;
+#endif
+            case ActorType::Avatar:
+            case ActorType::Unknown:
+            case ActorType::Player:
+            case ActorType::FloorItem:
+            default:
+                return -1;
+        }
+    }
+}  // namespace
 
 Minimap::Minimap() :
     // TRANSLATORS: mini map window name
     Window(_("Map"), Modal_false, nullptr, "map.xml"),
+    mActors(),
+    mDotRects(),
+    mDots(),
+    mMap(nullptr),
+    mMapSurface(nullptr),
+    mMapSurfaceRow(0),
+    mDotsOriginX(0),
+    mDotsOriginY(0),
     mWidthProportion(0.5),
     mHeightProportion(0.5),
     mMapImage(nullptr),
@@ -105,6 +177,12 @@ void Minimap::deleteMapImage()
             mMapImage->decRef();
         mMapImage = nullptr;
     }
+    if (mMapSurface)
+    {
+        MSDL_FreeSurface(mMapSurface);
+        mMapSurface = nullptr;
+    }
+    mMap = nullptr;
 }
 
 void Minimap::setMap(const Map *const map)
@@ -123,45 +201,25 @@ void Minimap::setMap(const Map *const map)
 
     setCaption(caption);
     deleteMapImage();
+    mActors.clear();
 
     if (map)
     {
         if (config.getBoolValue("showExtMinimaps"))
         {
-            SDL_Surface *const surface = MSDL_CreateRGBSurface(SDL_SWSURFACE,
+            // image converted from collisions by parts in draw
+            mMapSurface = MSDL_CreateRGBSurface(SDL_SWSURFACE,
                 map->getWidth(), map->getHeight(), 32,
                 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000);
-            if (!surface)
-            {
-                if (!isSticky())
-                    setVisible(false);
-                BLOCK_END("Minimap::setMap")
-                return;
-            }
-
-            // I'm not sure if the locks are necessary since it's a SWSURFACE
-            SDL_LockSurface(surface);
-            int* data = static_cast<int*>(surface->pixels);
-            if (!data)
+            if (!mMapSurface)
             {
                 if (!isSticky())
                     setVisible(false);
                 BLOCK_END("Minimap::setMap")
                 return;
             }
-            const int size = surface->h * surface->w;
-            const int mask = (BlockMask::WALL | BlockMask::AIR
-                | BlockMask::WATER);
-
-            for (int ptr = 0; ptr < size; ptr ++)
-                *(data ++) = -!(map->mMetaTiles[ptr].blockmask & mask);
-
-            SDL_UnlockSurface(surface);
-
-            mMapImage = imageHelper->load(surface);
-            mMapImage->setAlpha(settings.guiAlpha);
-            mCustomMapImage = true;
-            MSDL_FreeSurface(surface);
+            mMap = map;
+            mMapSurfaceRow = 0;
         }
         else
         {
@@ -187,13 +245,17 @@ void Minimap::setMap(const Map *const map)
         }
     }
 
-    if (mMapImage && map)
+    if ((mMapImage || mMapSurface) && map)
     {
-        const int width = mMapImage->mBounds.w + 2 * getPadding();
-        const int height = mMapImage->mBounds.h
+        const int imageWidth = mMapImage ? mMapImage->mBounds.w
+            : mMapSurface->w;
+        const int imageHeight = mMapImage ? mMapImage->mBounds.h
+            : mMapSurface->h;
+        const int width = imageWidth + 2 * getPadding();
+        const int height = imageHeight
             + getTitleBarHeight() + getPadding();
-        const int mapWidth = mMapImage->mBounds.w < 100 ? width : 100;
-        const int mapHeight = mMapImage->mBounds.h < 100 ? height : 100;
+        const int mapWidth = imageWidth < 100 ? width : 100;
+        const int mapHeight = imageHeight < 100 ? height : 100;
         const int minWidth = mapWidth > 310 ? 310 : mapWidth;
         const int minHeight = mapHeight > 220 ? 220 : mapHeight;
 
@@ -201,9 +263,9 @@ void Minimap::setMap(const Map *const map)
         setMinHeight(minHeight);
 
         mWidthProportion = static_cast<float>(
-                mMapImage->mBounds.w) / static_cast<float>(map->getWidth());
+                imageWidth) / static_cast<float>(map->getWidth());
         mHeightProportion = static_cast<float>(
-                mMapImage->mBounds.h) / static_cast<float>(map->getHeight());
+                imageHeight) / static_cast<float>(map->getHeight());
 
         setMaxWidth(width);
         setMaxHeight(height);
@@ -228,6 +290,183 @@ void Minimap::setMap(const Map *const map)
     BLOCK_END("Minimap::setMap")
 }
 
+void Minimap::buildMapImage()
+{
+    if (!mMapSurface || !mMap)
+        return;
+
+    BLOCK_START("Minimap::buildMapImage")
+    const int width = mMapSurface->w;
+    const int height = mMapSurface->h;
+    int rows = mapImageTilesPerFrame / width;
+    if (rows < 1)
+        rows = 1;
+    const int endRow = std::min(mMapSurfaceRow + rows, height);
+    const int mask = (BlockMask::WALL | BlockMask::AIR
+        | BlockMask::WATER);
+
+    // I'm not sure if the locks are necessary since it's a SWSURFACE
+    SDL_LockSurface(mMapSurface);
+    char *const pixels = static_cast<char*>(mMapSurface->pixels);
+    if (pixels)
+    {
+        const MetaTile *const tiles = mMap->mMetaTiles;
+        for (int y = mMapSurfaceRow; y < endRow; y ++)
+        {
+            int *data = reinterpret_cast<int*>(pixels
+                + y * mMapSurface->pitch);
+            const MetaTile *const row = tiles + y * width;
+            for (int x = 0; x < width; x ++)
+                *(data ++) = -!(row[x].blockmask & mask);
+        }
+    }
+    SDL_UnlockSurface(mMapSurface);
+
+    if (!pixels)
+    {
+        deleteMapImage();
+        BLOCK_END("Minimap::buildMapImage")
+        return;
+    }
+
+    mMapSurfaceRow = endRow;
+    if (mMapSurfaceRow >= height)
+    {
+        mMapImage = imageHelper->load(mMapSurface);
+        if (mMapImage)
+            mMapImage->setAlpha(settings.guiAlpha);
+        mCustomMapImage = true;
+        MSDL_FreeSurface(mMapSurface);
+        mMapSurface = nullptr;
+        mMap = nullptr;
+    }
+    BLOCK_END("Minimap::buildMapImage")
+}
+
+void Minimap::updateDots()
+{
+    BLOCK_START("Minimap::updateDots")
+    bool changed = mDotsOriginX != mMapOriginX
+        || mDotsOriginY != mMapOriginY;
+    const size_t sz = mActors.size();
+    size_t cnt = 0;
+
+    const ActorSprites &actors = actorManager->getAll();
+    FOR_EACH (ActorSpritesConstIterator, it, actors)
+    {
+        const ActorSprite *const actor = *it;
+        if (!actor || actor->getType() == ActorType::FloorItem)
+            continue;
+
+        const Vector &pos = actor->getPosition();
+        const int x = static_cast<int>(pos.x * mWidthProportion / 32);
+        const int y = static_cast<int>(pos.y * mHeightProportion / 32);
+        const int id = actor->getId();
+        const Being *const being = static_cast<const Being*>(actor);
+        const int type = being == localPlayer
+            ? static_cast<int>(UserPalette::SELF) : getDotType(being);
+        if (cnt < sz)
+        {
+            MinimapActor &item = mActors[cnt];
+            if (item.actor != actor || item.id != id
+                || item.x != x || item.y != y || item.type != type)
+            {
+                item.actor = actor;
+                item.id = id;
+                item.x = x;
+                item.y = y;
+                item.type = type;
+                changed = true;
+            }
+        }
+        else
+        {
+            const MinimapActor item = {actor, id, x, y, type};
+            mActors.push_back(item);
+            changed = true;
+        }
+        cnt ++;
+    }
+    if (cnt != sz)
+    {
+        mActors.resize(cnt);
+        changed = true;
+    }
+    if (!changed)
+    {
+        BLOCK_END("Minimap::updateDots")
+        return;
+    }
+
+    mDotsOriginX = mMapOriginX;
+    mDotsOriginY = mMapOriginY;
+    mDotsUpdates ++;
+
+    std::vector<MinimapDot> dots;
+    dots.reserve(cnt);
+    int selfX = 0;
+    int selfY = 0;
+    bool foundSelf = false;
+    FOR_EACH (std::vector<MinimapActor>::const_iterator, it, mActors)
+    {
+        const int type = (*it).type;
+        if (type == UserPalette::SELF)
+        {
+            selfX = (*it).x;
+            selfY = (*it).y;
+            foundSelf = true;
+            continue;
+        }
+        if (type < 0)
+            continue;
+
+        const int offsetHeight = static_cast<int>(mHeightProportion);
+        const int offsetWidth = static_cast<int>(mWidthProportion);
+        dots.push_back(MinimapDot(type, Rect(
+            (*it).x + mMapOriginX - offsetWidth,
+            (*it).y + mMapOriginY - offsetHeight, 2, 2)));
+    }
+    std::stable_sort(dots.begin(), dots.end(), dotTypeSorter);
+
+    // local player drawn over all other dots
+    if (foundSelf)
+    {
+        const int offsetHeight = static_cast<int>(2 * mHeightProportion);
+        const int offsetWidth = static_cast<int>(2 * mWidthProportion);
+        dots.push_back(MinimapDot(UserPalette::SELF, Rect(
+            selfX + mMapOriginX - offsetWidth,
+            selfY + mMapOriginY - offsetHeight, 3, 3)));
+    }
+
+    mDotRects.clear();
+    mDots.clear();
+    mDotRects.reserve(dots.size());
+    FOR_EACH (std::vector<MinimapDot>::const_iterator, it, dots)
+    {
+        const int type = (*it).first;
+        if (mDots.empty() || mDots.back().type != type)
+        {
+            const MinimapDots group = {type,
+                static_cast<int>(mDotRects.size()), 0};
+            mDots.push_back(group);
+        }
+        mDotRects.push_back((*it).second);
+        mDots.back().count ++;
+    }
+    BLOCK_END("Minimap::updateDots")
+}
+
+void Minimap::drawDots(Graphics *const graphics) const
+{
+    BLOCK_START("Minimap::drawDots")
+    FOR_EACH (std::vector<MinimapDots>::const_iterator, it, mDots)
+    {
+        graphics->setColor(userPalette->getColor((*it).type));
+        graphics->fillRectangles(&mDotRects[(*it).start], (*it).count);
+    }
+    BLOCK_END("Minimap::drawDots")
+}
+
 void Minimap::toggle()
 {
     setVisible(!isWindowVisible(), isSticky());
@@ -237,6 +476,7 @@ void Minimap::toggle()
 void Minimap::draw(Graphics *graphics)
 {
     BLOCK_START("Minimap::draw")
+    const unsigned int startTime = get_time_usec();
     Window::draw(graphics);
 
     if (!userPalette || !localPlayer || !viewport)
@@ -258,6 +498,9 @@ void Minimap::draw(Graphics *graphics)
     mMapOriginX = 0;
     mMapOriginY = 0;
 
+    if (mMapSurface)
+        buildMapImage();
+
     if (mMapImage)
     {
         const SDL_Rect &rect = mMapImage->mBounds;
@@ -288,88 +531,8 @@ void Minimap::draw(Graphics *graphics)
         graphics->drawImage(mMapImage, mMapOriginX, mMapOriginY);
     }
 
-    const ActorSprites &actors = actorManager->getAll();
-    FOR_EACH (ActorSpritesConstIterator, it, actors)
-    {
-        if (!(*it) || (*it)->getType() == ActorType::FloorItem)
-            continue;
-
-        const Being *const being = static_cast<const Being *const>(*it);
-        if (!being)
-            continue;
-
-        int dotSize = 2;
-        int type = UserPalette::PC;
-
-        if (being == localPlayer)
-        {
-            type = UserPalette::SELF;
-            dotSize = 3;
-        }
-        else if (being->isGM())
-        {
-            type = UserPalette::GM;
-        }
-        else if (being->getGuild() == localPlayer->getGuild()
-                 || being->getGuildName() == localPlayer->getGuildName())
-        {
-            type = UserPalette::GUILD;
-        }
-        else
-        {
-            switch (being->getType())
-            {
-                case ActorType::Monster:
-                    type = UserPalette::MONSTER;
-                    break;
-
-                case ActorType::Npc:
-                    type = UserPalette::NPC;
-                    break;
-
-                case ActorType::Portal:
-                    type = UserPalette::PORTAL_HIGHLIGHT;
-                    break;
-
-                case ActorType::LocalPet:
-#ifdef EATHENA_SUPPORT
-                case ActorType::Pet:
-#endif
-                    type = UserPalette::PET;
-                    break;
-#ifdef EATHENA_SUPPORT
-                case ActorType::Mercenary:
-                    type = UserPalette::MERCENARY;
-                    break;
-
-                case ActorType::Homunculus:
-                    type = UserPalette::HOMUNCULUS;
-                    break;
-#endif
-                case ActorType::Avatar:
-                case ActorType::Unknown:
-                case ActorType::Player:
-                case ActorType::FloorItem:
-                default:
-                    continue;
-            }
-        }
-
-        if (userPalette)
-            graphics->setColor(userPalette->getColor(type));
-
-        const int offsetHeight = static_cast<int>(static_cast<float>(
-                dotSize - 1) * mHeightProportion);
-        const int offsetWidth = static_cast<int>(static_cast<float>(
-                dotSize - 1) * mWidthProportion);
-        const Vector &pos = being->getPosition();
-
-        graphics->fillRectangle(Rect(
-            static_cast<float>(pos.x * mWidthProportion) / 32
-            + mMapOriginX - offsetWidth,
-            static_cast<float>(pos.y * mHeightProportion) / 32
-            + mMapOriginY - offsetHeight, dotSize, dotSize));
-    }
+    updateDots();
+    drawDots(graphics);
 
     if (localPlayer->isInParty())
     {
@@ -449,6 +612,7 @@ void Minimap::draw(Graphics *graphics)
     graphics->setColor(userPalette->getColor(UserPalette::PC));
     graphics->drawRectangle(Rect(x, y, w, h));
     graphics->popClipArea();
+    mDrawTime = get_time_usec() - startTime;
     BLOCK_END("Minimap::draw")
 }
 
@@ -23,11 +23,18 @@
 #ifndef GUI_WINDOWS_MINIMAP_H
 #define GUI_WINDOWS_MINIMAP_H
 
+#include "gui/rect.h"
+
 #include "gui/widgets/window.h"
 
+#include <vector>
+
+class ActorSprite;
 class Image;
 class Map;
 
+struct SDL_Surface;
+
 /**
  * Minimap window. Shows a minimap image and the name of the current map.
  *
@@ -73,9 +80,60 @@ class Minimap final : public Window, public ConfigListener
 
         void optionChanged(const std::string &name) override final;
 
+        static unsigned int getDrawTime() A_WARN_UNUSED
+        { return mDrawTime; }
+
+        static int getDotsUpdates() A_WARN_UNUSED
+        { return mDotsUpdates; }
+
     private:
+        /**
+         * Actor position on minimap without map origin.
+         */
+        struct MinimapActor final
+        {
+            const ActorSprite *actor;
+            int id;
+            int x;
+            int y;
+            // dot color, changed by guild or gm status too
+            int type;
+        };
+
+        /**
+         * Dots with same color, drawn in one batch.
+         */
+        struct MinimapDots final
+        {
+            int type;
+            int start;
+            int count;
+        };
+
         void deleteMapImage();
 
+        /**
+         * Fills part of collision minimap surface in each frame,
+         * and converts it to image after last row.
+         */
+        void buildMapImage();
+
+        /**
+         * Updates dots list if any actor moved or map origin changed.
+         */
+        void updateDots();
+
+        void drawDots(Graphics *const graphics) const;
+
+        std::vector<MinimapActor> mActors;
+        std::vector<Rect> mDotRects;
+        std::vector<MinimapDots> mDots;
+        const Map *mMap;
+        SDL_Surface *mMapSurface;
+        int mMapSurfaceRow;
+        int mDotsOriginX;
+        int mDotsOriginY;
+
         float mWidthProportion;
         float mHeightProportion;
         Image *mMapImage;
@@ -84,6 +142,8 @@ class Minimap final : public Window, public ConfigListener
         bool mCustomMapImage;
         bool mAutoResize;
         static bool mShow;
+        static unsigned int mDrawTime;
+        static int mDotsUpdates;
 };
 
 extern Minimap *minimap;
@@ -600,6 +600,7 @@ namespace InputAction
         SERVER_CONF_SET,
         CONG_GET,
         SERVER_CONG_GET,
+        FIND_ROUTE,
         TOTAL
     };
 }  // namespace InputAction
@@ -4489,6 +4489,11 @@ static const InputActionData inputActionData[InputAction::TOTAL] = {
         InputCondition::INGAME,
         "servconfget|getservconf",
         true},
+    {"keyFindRoute",
+        defaultAction(&Actions::findRoute),
+        InputCondition::INGAME,
+        "route|findroute",
+        true},
 };
 
 #undef defaultAction
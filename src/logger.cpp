@@ -26,6 +26,7 @@
 
 #include "listeners/debugmessagelistener.h"
 
+#include "utils/sdlhelper.h"
 #include "utils/stringutils.h"
 
 #include <iostream>
@@ -50,28 +51,26 @@
 
 #include "debug.h"
 
-#define DATESTREAM \
-    timeStr << "[" \
-        << ((((tv.tv_sec / 60) / 60) % 24 < 10) ? "0" : "") \
-        << static_cast<int>(((tv.tv_sec / 60) / 60) % 24) \
-        << ":" \
-        << (((tv.tv_sec / 60) % 60 < 10) ? "0" : "") \
-        << static_cast<int>((tv.tv_sec / 60) % 60) \
-        << ":" \
-        << ((tv.tv_sec % 60 < 10) ? "0" : "") \
-        << static_cast<int>(tv.tv_sec % 60) \
-        << "." \
-        << (((tv.tv_usec / 10000) % 100) < 10 ? "0" : "") \
-        << static_cast<int>((tv.tv_usec / 10000) % 100) \
-        << "] ";
+// ring buffer size, must be power of two
+static const unsigned int logBufferSize = 512 * 1024;
+static const unsigned int logBufferMask = logBufferSize - 1;
+// max size of formatted message
+static const unsigned int logLineSize = 4096;
 
 Logger *logger = nullptr;          // Log object
 
 Logger::Logger() :
-    mLogFile(),
-    mDelayedLog(),
+    mLogFile(nullptr),
+    mBuffer(new char[logBufferSize]),
     mMutex(SDL_CreateMutex()),
-    mThreadLocked(false),
+    mWriteMutex(SDL_CreateMutex()),
+    mSem(SDL_CreateSemaphore(0)),
+    mThread(nullptr),
+    mReadPos(0),
+    mWritePos(0),
+    mDropped(0),
+    mDroppedTotal(0),
+    mStop(false),
     mLogToStandardOut(true),
     mDebugLog(false),
     mReportUnimplimented(false)
@@ -80,166 +79,240 @@ Logger::Logger() :
 
 Logger::~Logger()
 {
-    if (mLogFile.is_open())
-        mLogFile.close();
+    stopThread();
+    if (mLogFile)
+        fclose(mLogFile);
+    SDL_DestroySemaphore(mSem);
+    SDL_DestroyMutex(mWriteMutex);
     SDL_DestroyMutex(mMutex);
+    delete [] mBuffer;
 }
 
 void Logger::setLogFile(const std::string &logFilename)
 {
-    if (mLogFile.is_open())
-        mLogFile.close();
+    SDL_mutexP(mWriteMutex);
+    if (mLogFile)
+        fclose(mLogFile);
 
-    mLogFile.open(logFilename.c_str(), std::ios_base::trunc);
+    mLogFile = fopen(logFilename.c_str(), "w");
+    SDL_mutexV(mWriteMutex);
 
-    if (!mLogFile.is_open())
+    if (!mLogFile)
     {
         std::cout << "Warning: error while opening " << logFilename <<
             " for writing.\n";
     }
+    else if (!mThread)
+    {
+        mStop = false;
+        mThread = SDL::createThread(&writerThread, "logger", this);
+    }
 }
 
-void Logger::log(const std::string &str)
+int Logger::writerThread(void *ptr)
 {
-    log("%s", str.c_str());
+    Logger *const log = static_cast<Logger*>(ptr);
+    if (log)
+        log->writeLoop();
+    return 0;
 }
 
-#ifdef ENABLEDEBUGLOG
-void Logger::dlog(const std::string &str)
+void Logger::writeLoop()
 {
-    if (!mDebugLog)
-        return;
+    while (!mStop)
+    {
+        SDL_SemWaitTimeout(mSem, 500);
+        writePending();
+    }
+}
 
-    // Get the current system time
-    timeval tv;
-    gettimeofday(&tv, nullptr);
+static void writeData(FILE *const file,
+                      const bool toStandardOut,
+                      const char *const data,
+                      const size_t size)
+{
+    if (file)
+        fwrite(data, 1, size, file);
+    if (toStandardOut)
+        fwrite(data, 1, size, stdout);
+}
 
-    // Print the log entry
-    std::stringstream timeStr;
-    DATESTREAM
-    DLOG_ANDROID(str.c_str())
+void Logger::writePending()
+{
+    SDL_mutexP(mWriteMutex);
+    SDL_mutexP(mMutex);
+    const unsigned int readPos = mReadPos;
+    const unsigned int writePos = mWritePos;
+    const unsigned int dropped = mDropped;
+    mDropped = 0;
+    SDL_mutexV(mMutex);
 
-    if (mLogFile.is_open())
-        mLogFile << timeStr.str() << str << std::endl;
+    // producers not touch data between read and write positions
+    const unsigned int size = writePos - readPos;
+    if (size)
+    {
+        const unsigned int start = readPos & logBufferMask;
+        const unsigned int part = logBufferSize - start;
+        if (size > part)
+        {
+            writeData(mLogFile, mLogToStandardOut, mBuffer + start, part);
+            writeData(mLogFile, mLogToStandardOut, mBuffer, size - part);
+        }
+        else
+        {
+            writeData(mLogFile, mLogToStandardOut, mBuffer + start, size);
+        }
+    }
+    if (dropped)
+    {
+        char buf[100];
+        const int len = snprintf(buf, sizeof(buf),
+            "Logger overloaded, dropped %u messages\n", dropped);
+        writeData(mLogFile, mLogToStandardOut, buf, len);
+    }
+    if (size || dropped)
+    {
+        if (mLogFile)
+            fflush(mLogFile);
+        if (mLogToStandardOut)
+            fflush(stdout);
+    }
 
-    if (mLogToStandardOut)
-        std::cout << timeStr.str() << str << std::endl;
+    SDL_mutexP(mMutex);
+    mReadPos = writePos;
+    SDL_mutexV(mMutex);
+    SDL_mutexV(mWriteMutex);
 }
 
-void Logger::dlog2(const std::string &str,
-                   const int pos,
-                   const char* const comment)
+void Logger::push(const char *const buf, unsigned int size)
 {
-    if (!mDebugLog)
-        return;
-
     // Get the current system time
     timeval tv;
     gettimeofday(&tv, nullptr);
 
-    // Print the log entry
-    std::stringstream timeStr;
-    DATESTREAM
-    DLOG_ANDROID(str.c_str())
+    char timeStr[20];
+    const unsigned int timeSize = static_cast<unsigned int>(snprintf(
+        timeStr, sizeof(timeStr), "[%02d:%02d:%02d.%02d] ",
+        static_cast<int>(((tv.tv_sec / 60) / 60) % 24),
+        static_cast<int>((tv.tv_sec / 60) % 60),
+        static_cast<int>(tv.tv_sec % 60),
+        static_cast<int>((tv.tv_usec / 10000) % 100)));
 
-    if (mLogFile.is_open())
+    if (size > logBufferSize / 4)
+        size = logBufferSize / 4;
+    const unsigned int fullSize = timeSize + size + 1;
+
+    SDL_mutexP(mMutex);
+    const unsigned int used = mWritePos - mReadPos;
+    if (used + fullSize > logBufferSize)
     {
-        if (comment)
-        {
-            mLogFile << timeStr.str();
-            mLogFile.fill('0');
-            mLogFile.width(4);
-            mLogFile << pos << " ";
-            mLogFile << str << ": " << comment << std::endl;
-        }
-        else
-        {
-            mLogFile << timeStr.str();
-            mLogFile.fill('0');
-            mLogFile.width(4);
-            mLogFile << pos << " ";
-            mLogFile << str << std::endl;
-        }
+        mDropped ++;
+        mDroppedTotal ++;
+        SDL_mutexV(mMutex);
+        SDL_SemPost(mSem);
+        return;
     }
 
-    if (mLogToStandardOut)
+    const char *const parts[3] = { timeStr, buf, "\n" };
+    const unsigned int sizes[3] = { timeSize, size, 1 };
+    unsigned int pos = mWritePos;
+    for (int f = 0; f < 3; f ++)
     {
-        if (comment)
+        const unsigned int start = pos & logBufferMask;
+        const unsigned int part = logBufferSize - start;
+        const unsigned int sz = sizes[f];
+        if (sz > part)
         {
-            std::cout << timeStr.str();
-            std::cout.fill('0');
-            std::cout.width(4);
-            std::cout << pos << " ";
-            std::cout << str << ": " << comment << std::endl;
+            memcpy(mBuffer + start, parts[f], part);
+            memcpy(mBuffer, parts[f] + part, sz - part);
         }
         else
         {
-            std::cout << timeStr.str();
-            std::cout.fill('0');
-            std::cout.width(4);
-            std::cout << pos << " ";
-            std::cout << str << std::endl;
+            memcpy(mBuffer + start, parts[f], sz);
         }
+        pos += sz;
     }
+    mWritePos = pos;
+    SDL_mutexV(mMutex);
+
+    if (!mThread)
+        writePending();
+    else if (used + fullSize > logBufferSize / 2)
+        SDL_SemPost(mSem);
 }
-#endif
 
-void Logger::log1(const char *const buf)
+void Logger::logv(const char *const log_text, va_list ap)
 {
-    if (settings.disableLoggingInGame)
+    char buf[logLineSize];
+    const int size = vsnprintf(buf, logLineSize, log_text, ap);
+    if (size < 0)
         return;
-
-    // Get the current system time
-    timeval tv;
-    gettimeofday(&tv, nullptr);
-
-    // Print the log entry
-    std::stringstream timeStr;
-    DATESTREAM
     LOG_ANDROID(buf)
+    push(buf, std::min(static_cast<unsigned int>(size), logLineSize - 1));
+}
 
-    if (mLogFile.is_open())
-        mLogFile << timeStr.str() << buf << std::endl;
+void Logger::log(const std::string &str)
+{
+    if (settings.disableLoggingInGame)
+        return;
 
-    if (mLogToStandardOut)
-        std::cout << timeStr.str() << buf << std::endl;
+    LOG_ANDROID(str.c_str())
+    push(str.c_str(), static_cast<unsigned int>(str.size()));
 }
 
-void Logger::log(const char *const log_text, ...)
+#ifdef ENABLEDEBUGLOG
+void Logger::dlog(const std::string &str)
 {
-    if (settings.disableLoggingInGame)
+    if (!mDebugLog)
         return;
 
-    unsigned size = 1024;
-    if (strlen(log_text) * 3 > size)
-        size = static_cast<unsigned>(strlen(log_text) * 3);
+    DLOG_ANDROID(str.c_str())
+    push(str.c_str(), static_cast<unsigned int>(str.size()));
+}
 
-    char* buf = new char[static_cast<size_t>(size + 1)];
-    va_list ap;
+void Logger::dlog2(const std::string &str,
+                   const int pos,
+                   const char* const comment)
+{
+    if (!mDebugLog)
+        return;
 
-    // Use a temporary buffer to fill in the variables
-    va_start(ap, log_text);
-    vsnprintf(buf, size, log_text, ap);
-    buf[size] = 0;
-    va_end(ap);
+    DLOG_ANDROID(str.c_str())
+    char buf[logLineSize];
+    int size;
+    if (comment)
+    {
+        size = snprintf(buf, logLineSize, "%04d %s: %s",
+            pos, str.c_str(), comment);
+    }
+    else
+    {
+        size = snprintf(buf, logLineSize, "%04d %s", pos, str.c_str());
+    }
+    if (size < 0)
+        return;
+    push(buf, std::min(static_cast<unsigned int>(size), logLineSize - 1));
+}
+#endif
 
-    // Get the current system time
-    timeval tv;
-    gettimeofday(&tv, nullptr);
+void Logger::log1(const char *const buf)
+{
+    if (settings.disableLoggingInGame)
+        return;
 
-    // Print the log entry
-    std::stringstream timeStr;
-    DATESTREAM
     LOG_ANDROID(buf)
+    push(buf, static_cast<unsigned int>(strlen(buf)));
+}
 
-    if (mLogFile.is_open())
-        mLogFile << timeStr.str() << buf << std::endl;
-
-    if (mLogToStandardOut)
-        std::cout << timeStr.str() << buf << std::endl;
+void Logger::log(const char *const log_text, ...)
+{
+    if (settings.disableLoggingInGame)
+        return;
 
-    // Delete temporary buffer
-    delete [] buf;
+    va_list ap;
+    va_start(ap, log_text);
+    logv(log_text, ap);
+    va_end(ap);
 }
 
 void Logger::log_r(const char *const log_text, ...)
@@ -247,63 +320,35 @@ void Logger::log_r(const char *const log_text, ...)
     if (settings.disableLoggingInGame)
         return;
 
-    SDL_mutexP(mMutex);
-
-    unsigned size = 1024;
-    if (strlen(log_text) * 3 > size)
-        size = static_cast<unsigned>(strlen(log_text) * 3);
-
-    char* buf = new char[static_cast<size_t>(size + 1)];
     va_list ap;
-
-    // Use a temporary buffer to fill in the variables
     va_start(ap, log_text);
-    vsnprintf(buf, size, log_text, ap);
-    buf[size] = 0;
+    logv(log_text, ap);
     va_end(ap);
-
-    // Get the current system time
-    timeval tv;
-    gettimeofday(&tv, nullptr);
-
-    // Print the log entry
-    std::stringstream timeStr;
-    DATESTREAM
-    LOG_ANDROID(buf)
-
-    if (mLogFile.is_open())
-    {
-        timeStr << buf << std::endl;
-        mThreadLocked = true;
-        mDelayedLog.push_back(timeStr.str());
-        mThreadLocked = false;
-    }
-
-    if (mLogToStandardOut)
-        std::cout << timeStr.str() << buf << std::endl;
-
-    // Delete temporary buffer
-    delete [] buf;
-
-    SDL_mutexV(mMutex);
 }
 
 void Logger::flush()
 {
-    if (!mThreadLocked)
+    if (mThread)
+        SDL_SemPost(mSem);
+}
+
+void Logger::stopThread()
+{
+    if (mThread)
     {
-        SDL_mutexP(mMutex);
-        FOR_EACH (std::vector<std::string>::const_iterator, it, mDelayedLog)
-            mLogFile << *it;
-        mDelayedLog.clear();
-        SDL_mutexV(mMutex);
+        mStop = true;
+        SDL_SemPost(mSem);
+        SDL_WaitThread(mThread, nullptr);
+        mThread = nullptr;
     }
+    writePending();
 }
 
 // here string must be safe for any usage
 void Logger::safeError(const std::string &error_text)
 {
     log("Error: %s", error_text.c_str());
+    stopThread();
 #ifdef WIN32
     MessageBox(nullptr, error_text.c_str(), "Error", MB_ICONERROR | MB_OK);
 #elif defined __APPLE__
@@ -332,6 +377,7 @@ void Logger::safeError(const std::string &error_text)
 void Logger::error(const std::string &error_text)
 {
     log("Error: %s", error_text.c_str());
+    stopThread();
 #ifdef WIN32
     MessageBox(nullptr, error_text.c_str(), "Error", MB_ICONERROR | MB_OK);
 #elif defined __APPLE__
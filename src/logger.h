@@ -26,18 +26,22 @@
 #include "main.h"
 
 #include <SDL_mutex.h>
+#include <SDL_thread.h>
 
+#include <cstdarg>
+#include <cstdio>
 #include <fstream>
 #include <vector>
 
 #include "localconsts.h"
 
 #ifdef ENABLEDEBUGLOG
+// message string not built if debug log disabled
 #define DEBUGLOG(str) \
-    if (logger && !mIgnore) \
+    if (logger && !mIgnore && logger->isDebugLog()) \
         logger->dlog(str)
 #define DEBUGLOG2(str, pos, comment) \
-    if (logger && !mIgnore) \
+    if (logger && !mIgnore && logger->isDebugLog()) \
         logger->dlog2(str, pos, comment)
 #define IGNOREDEBUGLOG mIgnore = Net::isIgnorePacket(mId)
 #else
@@ -51,6 +55,10 @@
 
 /**
  * The Log Class : Useful to write debug or info messages
+ *
+ * Messages are formatted on stack and copied to ring buffer. Log file
+ * written from separate thread in batches. If ring buffer full, messages
+ * dropped and count of dropped messages written to log later.
  */
 class Logger final
 {
@@ -129,8 +137,17 @@ class Logger final
          */
         void log(const std::string &str);
 
+        /**
+         * Wakes writer thread to write collected messages.
+         */
         void flush();
 
+        /**
+         * Writes all pending messages and stops writer thread.
+         * After this log written directly.
+         */
+        void stopThread();
+
 #ifdef ENABLEDEBUGLOG
         /**
          * Enters debug message in the log. The message will be timestamped.
@@ -145,6 +162,9 @@ class Logger final
         void setDebugLog(const bool n)
         { mDebugLog = n; }
 
+        bool isDebugLog() const A_WARN_UNUSED
+        { return mDebugLog; }
+
         void setReportUnimplimented(const bool n)
         { mReportUnimplimented = n; }
 
@@ -170,11 +190,31 @@ class Logger final
 
         void unimplimented(const int id);
 
+        unsigned int getDroppedCount() const A_WARN_UNUSED
+        { return mDroppedTotal; }
+
     private:
-        std::ofstream mLogFile;
-        std::vector<std::string> mDelayedLog;
+        static int writerThread(void *ptr);
+
+        void writeLoop();
+
+        void writePending();
+
+        void logv(const char *const log_text, va_list ap);
+
+        void push(const char *const buf, unsigned int size);
+
+        FILE *mLogFile;
+        char *mBuffer;
         SDL_mutex *mMutex;
-        volatile bool mThreadLocked;
+        SDL_mutex *mWriteMutex;
+        SDL_sem *mSem;
+        SDL_Thread *mThread;
+        unsigned int mReadPos;
+        unsigned int mWritePos;
+        unsigned int mDropped;
+        unsigned int mDroppedTotal;
+        volatile bool mStop;
         bool mLogToStandardOut;
         bool mDebugLog;
         bool mReportUnimplimented;
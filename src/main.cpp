@@ -136,7 +136,15 @@ static void printHelp()
         // TRANSLATORS: command line help
         << _("  -O --no-opengl      : Disable OpenGL for this session")
         << std::endl
-#endif
+        // TRANSLATORS: command line help
+        << _("     --headless       : Run without window drawing, textures "
+             "and sound") << std::endl
+#else  // USE_OPENGL
+        // TRANSLATORS: command line help
+        << _("     --headless       : Run without window drawing and sound"
+             " (images still decoded, no null renderer in build)")
+        << std::endl
+#endif  // USE_OPENGL
         ;
 }
 
@@ -173,6 +181,7 @@ static void parseOptions(const int argc, char *const argv[])
         { "test",           required_argument, nullptr, 't' },
         { "renderer",       required_argument, nullptr, 'r' },
         { "server-type",    required_argument, nullptr, 'y' },
+        { "headless",       no_argument,       nullptr, 'e' },
         { nullptr,          0,                 nullptr, 0 }
     };
 
@@ -261,6 +270,9 @@ static void parseOptions(const int argc, char *const argv[])
             case 'y':
                 options.serverType = optarg;
                 break;
+            case 'e':
+                options.headless = true;
+                break;
             default:
                 break;
         }
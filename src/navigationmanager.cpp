@@ -24,6 +24,25 @@
 #include "resources/map/metatile.h"
 #include "resources/map/walklayer.h"
 
+#ifndef DYECMD
+#include "configuration.h"
+#include "logger.h"
+#include "settings.h"
+
+#include "resources/map/mapitem.h"
+
+#include "utils/mkdir.h"
+#include "utils/physfstools.h"
+#include "utils/stringutils.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <queue>
+#endif
+
 #include "debug.h"
 
 static const int blockWalkMask = (BlockMask::WALL | BlockMask::AIR
@@ -42,8 +61,115 @@ namespace
         int x;
         int y;
     };
+
+#ifndef DYECMD
+    // "MNAV"
+    const int cacheMagic = 0x56414e4d;
+    const int cacheVersion = 1;
+    // route cost of one warp in tiles
+    const int warpCost = 10;
+
+    struct RouteState final
+    {
+        RouteState(const std::string &map0, const int region0,
+                   const int x0, const int y0, const int cost0,
+                   const int prev0, const int portalX0,
+                   const int portalY0) :
+            map(map0),
+            region(region0),
+            x(x0),
+            y(y0),
+            cost(cost0),
+            prev(prev0),
+            portalX(portalX0),
+            portalY(portalY0)
+        {
+        }
+
+        std::string map;
+        int region;
+        // entry tile or -1 if unknown
+        int x;
+        int y;
+        int cost;
+        // previous state and portal used in its map
+        int prev;
+        int portalX;
+        int portalY;
+    };
+
+    typedef std::pair<int, int> RouteQueueItem;
+    typedef std::priority_queue<RouteQueueItem,
+        std::vector<RouteQueueItem>,
+        std::greater<RouteQueueItem> > RouteQueue;
+
+    void checksumAdd(unsigned int &checksum, const int value)
+    {
+        // FNV-1a
+        for (int f = 0; f < 4; f ++)
+        {
+            checksum ^= static_cast<unsigned int>(value >> (f * 8)) & 0xffU;
+            checksum *= 16777619U;
+        }
+    }
+
+    void writeInt(std::ofstream &file, const int value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(int));
+    }
+
+    bool readInt(std::ifstream &file, int &value)
+    {
+        file.read(reinterpret_cast<char*>(&value), sizeof(int));
+        return file.good();
+    }
+
+    // key for best route cost to map region
+    std::string getRouteKey(const std::string &map, const int region)
+    {
+        return strprintf("%s:%d", map.c_str(), region);
+    }
+
+    std::string getMapName(const Map *const map)
+    {
+        // "maps/" + name + ".tmx"
+        std::string name = map->getProperty("_realfilename");
+        const std::string dir = paths.getValue("maps", "maps/");
+        if (!name.compare(0, dir.size(), dir))
+            name = name.substr(dir.size());
+        const size_t pos = name.rfind(".tmx");
+        if (pos != std::string::npos)
+            name = name.substr(0, pos);
+        return name;
+    }
+#endif
 }  // namespace
 
+#ifndef DYECMD
+NavigationMaps NavigationManager::mMaps;
+
+int NavigationMap::getRegion(const int x, const int y) const
+{
+    if (x < 0 || x >= width || y < 0 || y >= height || runs.empty())
+        return 0;
+    const int ptr = x + y * width;
+    size_t first = 0;
+    size_t last = runs.size();
+    // last run with start <= ptr
+    while (last - first > 1)
+    {
+        const size_t mid = (first + last) / 2;
+        if (runs[mid].start <= ptr)
+            first = mid;
+        else
+            last = mid;
+    }
+    const int region = runs[first].region;
+    // blocked tile near region marked by negative number
+    return region < 0 ? -region : region;
+}
+#endif
+
 NavigationManager::NavigationManager()
 {
 }
@@ -66,49 +192,366 @@ Resource *NavigationManager::loadWalkLayer(const Map *const map)
 
     const MetaTile *const tiles = map->getMetaTiles();
     int *const data = walkLayer->getData();
+    const int size = width * height;
+
+    NavigationMap *const navMap = new NavigationMap;
+    navMap->width = width;
+    navMap->height = height;
+    unsigned int checksum = 2166136261U;
+    checksumAdd(checksum, width);
+    checksumAdd(checksum, height);
+    for (int ptr = 0; ptr < size; ptr ++)
+    {
+        checksum ^= (tiles[ptr].blockmask & blockWalkMask) ? 1U : 0U;
+        checksum *= 16777619U;
+    }
+    const std::vector<MapItem*> &portals = map->getPortals();
+    FOR_EACH (std::vector<MapItem*>::const_iterator, it, portals)
+    {
+        const MapItem *const item = *it;
+        if (!item || item->getTarget().empty())
+            continue;
+        NavigationPortal portal;
+        portal.target = item->getTarget();
+        portal.x = item->getX();
+        portal.y = item->getY();
+        portal.targetX = item->getTargetX();
+        portal.targetY = item->getTargetY();
+        navMap->portals.push_back(portal);
+        FOR_EACH (std::string::const_iterator, it2, portal.target)
+            checksumAdd(checksum, *it2);
+        checksumAdd(checksum, portal.x);
+        checksumAdd(checksum, portal.y);
+        checksumAdd(checksum, portal.targetX);
+        checksumAdd(checksum, portal.targetY);
+    }
+    navMap->checksum = checksum;
 
-    int x = 0;
-    int y = 0;
-    int num = 1;
-    while (findWalkableTile(x, y, width, height, tiles, data))
+    const std::string fileName = map->getUserMapDirectory().append(
+        "/navigation.bin");
+    NavigationMap cached;
+    if (loadCache(fileName, cached)
+        && cached.checksum == checksum
+        && cached.width == width
+        && cached.height == height
+        && cached.portals.size() == navMap->portals.size())
+    {
+        const size_t sz = cached.runs.size();
+        for (size_t f = 0; f < sz; f ++)
+        {
+            const int end = f + 1 < sz ? cached.runs[f + 1].start : size;
+            const int region = cached.runs[f].region;
+            for (int ptr = cached.runs[f].start; ptr < end; ptr ++)
+                data[ptr] = region;
+        }
+        navMap->runs.swap(cached.runs);
+        navMap->portals.swap(cached.portals);
+    }
+    else
     {
-        fillNum(x, y, width, height, num, tiles, data);
-        num ++;
+        // one pass over tiles, each region filled once
+        int num = 1;
+        for (int ptr = 0; ptr < size; ptr ++)
+        {
+            if (!data[ptr] && !(tiles[ptr].blockmask & blockWalkMask))
+            {
+                fillNum(ptr % width, ptr / width, width, height,
+                    num, tiles, data);
+                num ++;
+            }
+        }
+
+        int region = data[0];
+        NavigationRun run = {0, region};
+        navMap->runs.push_back(run);
+        for (int ptr = 1; ptr < size; ptr ++)
+        {
+            if (data[ptr] != region)
+            {
+                region = data[ptr];
+                run.start = ptr;
+                run.region = region;
+                navMap->runs.push_back(run);
+            }
+        }
+        FOR_EACH (std::vector<NavigationPortal>::iterator,
+                  it, navMap->portals)
+        {
+            NavigationPortal &portal = *it;
+            portal.region = navMap->getRegion(portal.x, portal.y);
+        }
+        saveCache(fileName, *navMap);
     }
 
+    const std::string mapName = getMapName(map);
+    NavigationMapsIter it = mMaps.find(mapName);
+    if (it != mMaps.end())
+        delete (*it).second;
+    mMaps[mapName] = navMap;
+
     return walkLayer;
 }
+
+void NavigationManager::clear()
+{
+    FOR_EACH (NavigationMapsIter, it, mMaps)
+        delete (*it).second;
+    mMaps.clear();
+}
+
+std::string NavigationManager::getCacheFile(const std::string &mapName)
+{
+    return std::string(settings.serverConfigDir).append(dirSeparator)
+        .append(paths.getValue("maps", "maps/")).append(mapName)
+        .append(".tmx/navigation.bin");
+}
+
+const NavigationMap *NavigationManager::getMap(const std::string &mapName)
+{
+    const NavigationMapsIter it = mMaps.find(mapName);
+    if (it != mMaps.end())
+        return (*it).second;
+
+    // maps not visited yet also stored, to not read file again
+    NavigationMap *navMap = new NavigationMap;
+    if (!loadCache(getCacheFile(mapName), *navMap))
+    {
+        delete navMap;
+        navMap = nullptr;
+    }
+    mMaps[mapName] = navMap;
+    return navMap;
+}
+
+bool NavigationManager::loadCache(const std::string &fileName,
+                                  NavigationMap &navMap)
+{
+    std::ifstream file;
+    file.open(fileName.c_str(), std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    int magic = 0;
+    int version = 0;
+    int checksum = 0;
+    int count = 0;
+    if (!readInt(file, magic)
+        || magic != cacheMagic
+        || !readInt(file, version)
+        || version != cacheVersion
+        || !readInt(file, navMap.width)
+        || !readInt(file, navMap.height)
+        || navMap.width <= 0
+        || navMap.height <= 0
+        || navMap.width > INT_MAX / navMap.height
+        || !readInt(file, checksum)
+        || !readInt(file, count)
+        || count <= 0
+        || count > navMap.width * navMap.height)
+    {
+        return false;
+    }
+    navMap.checksum = static_cast<unsigned int>(checksum);
+
+    // runs used for filling tiles array, so must cover it exactly
+    const int size = navMap.width * navMap.height;
+    navMap.runs.resize(count);
+    for (int f = 0; f < count; f ++)
+    {
+        NavigationRun &run = navMap.runs[f];
+        if (!readInt(file, run.start)
+            || !readInt(file, run.region)
+            || run.start >= size
+            || (f == 0 && run.start != 0)
+            || (f > 0 && run.start <= navMap.runs[f - 1].start))
+        {
+            return false;
+        }
+    }
+
+    if (!readInt(file, count) || count < 0 || count > 10000)
+        return false;
+    navMap.portals.resize(count);
+    for (int f = 0; f < count; f ++)
+    {
+        NavigationPortal &portal = navMap.portals[f];
+        int len = 0;
+        if (!readInt(file, len) || len <= 0 || len > 1000)
+            return false;
+        portal.target.resize(len);
+        file.read(&portal.target[0], len);
+        if (!file.good()
+            || !readInt(file, portal.x)
+            || !readInt(file, portal.y)
+            || !readInt(file, portal.region)
+            || !readInt(file, portal.targetX)
+            || !readInt(file, portal.targetY))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NavigationManager::saveCache(const std::string &fileName,
+                                  const NavigationMap &navMap)
+{
+    const std::string dir = fileName.substr(0, fileName.rfind("/"));
+    if (mkdir_r(dir.c_str()))
+    {
+        logger->log("%s doesn't exist and can't be created!", dir.c_str());
+        return;
+    }
+
+    // partially written file never seen by loadCache
+    const std::string tempName = fileName + ".tmp";
+    std::ofstream file;
+    file.open(tempName.c_str(), std::ios::binary);
+    if (!file.is_open())
+    {
+        logger->log("Unable to open %s for writing", tempName.c_str());
+        return;
+    }
+
+    writeInt(file, cacheMagic);
+    writeInt(file, cacheVersion);
+    writeInt(file, navMap.width);
+    writeInt(file, navMap.height);
+    writeInt(file, static_cast<int>(navMap.checksum));
+    writeInt(file, static_cast<int>(navMap.runs.size()));
+    FOR_EACH (std::vector<NavigationRun>::const_iterator, it, navMap.runs)
+    {
+        writeInt(file, (*it).start);
+        writeInt(file, (*it).region);
+    }
+    writeInt(file, static_cast<int>(navMap.portals.size()));
+    FOR_EACH (std::vector<NavigationPortal>::const_iterator,
+              it, navMap.portals)
+    {
+        const NavigationPortal &portal = *it;
+        writeInt(file, static_cast<int>(portal.target.size()));
+        file.write(portal.target.c_str(), portal.target.size());
+        writeInt(file, portal.x);
+        writeInt(file, portal.y);
+        writeInt(file, portal.region);
+        writeInt(file, portal.targetX);
+        writeInt(file, portal.targetY);
+    }
+    file.close();
+    const bool failed = file.fail();
+
+#ifdef WIN32
+    // rename not replaces existing file
+    if (!failed)
+        remove(fileName.c_str());
 #endif
+    if (failed || rename(tempName.c_str(), fileName.c_str()))
+    {
+        logger->log("Unable to write %s", fileName.c_str());
+        remove(tempName.c_str());
+    }
+}
 
-bool NavigationManager::findWalkableTile(int &x1, int &y1,
-                                         const int width, const int height,
-                                         const MetaTile *const tiles,
-                                         const int *const data)
+bool NavigationManager::findRoute(const std::string &startMap,
+                                  const int startX, const int startY,
+                                  const std::string &endMap,
+                                  NavigationRoute &route)
 {
-    for (int y = 0; y < height; y ++)
+    route.clear();
+    const NavigationMap *const startNav = getMap(startMap);
+    if (!startNav)
+        return false;
+
+    std::vector<RouteState> states;
+    // best cost for map and region
+    std::map<std::string, int> costs;
+    RouteQueue queue;
+
+    const int startRegion = startNav->getRegion(startX, startY);
+    states.push_back(RouteState(startMap, startRegion,
+        startX, startY, 0, -1, -1, -1));
+    costs[getRouteKey(startMap, startRegion)] = 0;
+    queue.push(RouteQueueItem(0, 0));
+    int found = -1;
+
+    while (!queue.empty())
     {
-        const int y2 = y * width;
-        for (int x = 0; x < width; x ++)
+        const int idx = queue.top().second;
+        const int cost = queue.top().first;
+        queue.pop();
+        // skip state, if cheaper route to same region found after push
+        if (cost != costs[getRouteKey(states[idx].map, states[idx].region)])
+            continue;
+        if (states[idx].map == endMap)
+        {
+            found = idx;
+            break;
+        }
+        const NavigationMap *const navMap = getMap(states[idx].map);
+        if (!navMap)
+            continue;
+        FOR_EACH (std::vector<NavigationPortal>::const_iterator,
+                  it, navMap->portals)
         {
-            const int ptr = x + y2;
-            if (!(tiles[ptr].blockmask & blockWalkMask) && !data[ptr])
+            const RouteState &state = states[idx];
+            const NavigationPortal &portal = *it;
+            // region unknown if warp destination unknown
+            if (state.region && portal.region
+                && state.region != portal.region)
             {
-                x1 = x;
-                y1 = y;
-                return true;
+                continue;
             }
+            int newCost = state.cost + warpCost;
+            if (state.x >= 0)
+            {
+                newCost += std::max(abs(state.x - portal.x),
+                    abs(state.y - portal.y));
+            }
+            int region = 0;
+            if (portal.targetX >= 0)
+            {
+                const NavigationMap *const targetNav = getMap(portal.target);
+                if (targetNav)
+                {
+                    region = targetNav->getRegion(portal.targetX,
+                        portal.targetY);
+                }
+            }
+            const std::string key = getRouteKey(portal.target, region);
+            const std::map<std::string, int>::const_iterator it2
+                = costs.find(key);
+            if (it2 != costs.end() && (*it2).second <= newCost)
+                continue;
+            costs[key] = newCost;
+            states.push_back(RouteState(portal.target, region,
+                portal.targetX, portal.targetY, newCost, idx,
+                portal.x, portal.y));
+            queue.push(RouteQueueItem(newCost,
+                static_cast<int>(states.size() - 1)));
         }
     }
-    return false;
+    if (found < 0)
+        return false;
+
+    for (int idx = found; states[idx].prev >= 0; idx = states[idx].prev)
+    {
+        const RouteState &state = states[idx];
+        route.insert(route.begin(), NavigationStep(states[state.prev].map,
+            state.portalX, state.portalY));
+    }
+    return true;
 }
+#endif
 
 void NavigationManager::fillNum(int x, int y,
                                 const int width, const int height,
                                 const int num, const MetaTile *const tiles,
                                 int *const data)
 {
+    // tiles marked when added, so each tile added only once
     std::vector<Cell> cells;
     cells.push_back(Cell(x, y));
+    data[x + width * y] = num;
     while (!cells.empty())
     {
         const Cell cell = cells.back();
@@ -116,16 +559,20 @@ void NavigationManager::fillNum(int x, int y,
         int ptr;
         x = cell.x;
         y = cell.y;
-        data[x + width * y] = num;
         if (x > 0)
         {
             ptr = (x - 1) + width * y;
             if (!data[ptr])
             {
                 if (!(tiles[ptr].blockmask & blockWalkMask))
+                {
+                    data[ptr] = num;
                     cells.push_back(Cell(x - 1, y));
+                }
                 else
+                {
                     data[ptr] = -num;
+                }
             }
         }
         if (x < width - 1)
@@ -134,9 +581,14 @@ void NavigationManager::fillNum(int x, int y,
             if (!data[ptr])
             {
                 if (!(tiles[ptr].blockmask & blockWalkMask))
+                {
+                    data[ptr] = num;
                     cells.push_back(Cell(x + 1, y));
+                }
                 else
+                {
                     data[ptr] = -num;
+                }
             }
         }
         if (y > 0)
@@ -145,9 +597,14 @@ void NavigationManager::fillNum(int x, int y,
             if (!data[ptr])
             {
                 if (!(tiles[ptr].blockmask & blockWalkMask))
+                {
+                    data[ptr] = num;
                     cells.push_back(Cell(x, y - 1));
+                }
                 else
+                {
                     data[ptr] = -num;
+                }
             }
         }
         if (y < height - 1)
@@ -156,9 +613,14 @@ void NavigationManager::fillNum(int x, int y,
             if (!data[ptr])
             {
                 if (!(tiles[ptr].blockmask & blockWalkMask))
+                {
+                    data[ptr] = num;
                     cells.push_back(Cell(x, y + 1));
+                }
                 else
+                {
                     data[ptr] = -num;
+                }
             }
         }
     }
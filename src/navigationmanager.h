@@ -21,6 +21,12 @@
 #ifndef NAVIGATIONMANAGER_H
 #define NAVIGATIONMANAGER_H
 
+#ifndef DYECMD
+#include <map>
+#include <string>
+#endif
+#include <vector>
+
 #include "localconsts.h"
 
 class Map;
@@ -28,6 +34,86 @@ class Resource;
 
 struct MetaTile;
 
+#ifndef DYECMD
+/**
+ * Warp from one map region to other map.
+ */
+struct NavigationPortal final
+{
+    NavigationPortal() :
+        target(),
+        x(0),
+        y(0),
+        region(0),
+        targetX(-1),
+        targetY(-1)
+    {
+    }
+
+    std::string target;
+    int x;
+    int y;
+    int region;
+    int targetX;
+    int targetY;
+};
+
+/**
+ * Tiles with same region number, from start tile to start of next run.
+ */
+struct NavigationRun final
+{
+    int start;
+    int region;
+};
+
+/**
+ * Walk regions and warps of one map, saved in map user directory.
+ */
+struct NavigationMap final
+{
+    NavigationMap() :
+        runs(),
+        portals(),
+        width(0),
+        height(0),
+        checksum(0)
+    {
+    }
+
+    A_DELETE_COPY(NavigationMap)
+
+    int getRegion(const int x, const int y) const A_WARN_UNUSED;
+
+    std::vector<NavigationRun> runs;
+    std::vector<NavigationPortal> portals;
+    int width;
+    int height;
+    unsigned int checksum;
+};
+
+/**
+ * Portal tile where need go on map to get to next map in route.
+ */
+struct NavigationStep final
+{
+    NavigationStep(const std::string &map0, const int x0, const int y0) :
+        map(map0),
+        x(x0),
+        y(y0)
+    {
+    }
+
+    std::string map;
+    int x;
+    int y;
+};
+
+typedef std::vector<NavigationStep> NavigationRoute;
+typedef std::map<std::string, NavigationMap*> NavigationMaps;
+typedef NavigationMaps::iterator NavigationMapsIter;
+#endif
+
 class NavigationManager final
 {
     public:
@@ -39,18 +125,40 @@ class NavigationManager final
 
 #ifndef DYECMD
         static Resource *loadWalkLayer(const Map *const map);
+
+        /**
+         * Finds route from tile on start map to end map using warps of
+         * maps already visited. Returns false if no route known.
+         */
+        static bool findRoute(const std::string &startMap,
+                              const int startX, const int startY,
+                              const std::string &endMap,
+                              NavigationRoute &route);
+
+        static void clear();
 #endif
 
     private:
-        static bool findWalkableTile(int &x1, int &y1,
-                                     const int width, const int height,
-                                     const MetaTile *const tiles,
-                                     const int *const data);
-
         static void fillNum(int x, int y,
                             const int width, const int height,
                             const int num, const MetaTile *const tiles,
                             int *const data);
+
+#ifndef DYECMD
+        static std::string getCacheFile(const std::string &mapName)
+                                        A_WARN_UNUSED;
+
+        static const NavigationMap *getMap(const std::string &mapName)
+                                           A_WARN_UNUSED;
+
+        static bool loadCache(const std::string &fileName,
+                              NavigationMap &navMap);
+
+        static void saveCache(const std::string &fileName,
+                              const NavigationMap &navMap);
+
+        static NavigationMaps mMaps;
+#endif
 };
 
 #endif  // NAVIGATIONMANAGER_H
@@ -39,6 +39,8 @@
 
 #include "net/serverfeatures.h"
 
+#include "net/ea/packetschema.h"
+
 #include "debug.h"
 
 namespace Ea
@@ -92,12 +94,16 @@ void BeingHandler::processBeingRemove(Net::MessageIn &msg)
     }
 
     // A being should be removed or has died
+    BeingRemovePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingRemove")
+        return;
+    }
 
-    const int id = msg.readInt32("being id");
-    Being *const dstBeing = actorManager->findBeing(id);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
     {
-        msg.readUInt8("dead flag?");
         BLOCK_END("BeingHandler::processBeingRemove")
         return;
     }
@@ -109,7 +115,7 @@ void BeingHandler::processBeingRemove(Net::MessageIn &msg)
     if (dstBeing == localPlayer->getTarget())
         localPlayer->stopAttack(true);
 
-    if (msg.readUInt8("dead flag?") == 1U)
+    if (packet.deadFlag == 1U)
     {
         if (dstBeing->getCurrentAction() != BeingAction::DEAD)
         {
@@ -138,18 +144,18 @@ void BeingHandler::processSkillDamage(Net::MessageIn &msg)
         return;
     }
 
-    const int id = msg.readInt16("skill id");
-    Being *const srcBeing = actorManager->findBeing(
-        msg.readInt32("src being id"));
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("dst being id"));
-    msg.readInt32("tick");
-    msg.readInt32("src speed");
-    msg.readInt32("dst speed");
-    const int param1 = msg.readInt32("damage");
-    const int level = msg.readInt16("skill level");
-    msg.readInt16("div");
-    msg.readUInt8("skill hit/type?");
+    SkillDamagePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processSkillDamage")
+        return;
+    }
+
+    const int id = packet.skillId;
+    Being *const srcBeing = actorManager->findBeing(packet.srcId);
+    Being *const dstBeing = actorManager->findBeing(packet.dstId);
+    const int param1 = packet.damage;
+    const int level = packet.level;
     if (srcBeing)
         srcBeing->handleSkill(dstBeing, param1, id, level);
     if (dstBeing)
@@ -166,18 +172,19 @@ void BeingHandler::processBeingAction(Net::MessageIn &msg)
         return;
     }
 
-    Being *const srcBeing = actorManager->findBeing(
-        msg.readInt32("src being id"));
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("dst being id"));
+    BeingActionPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingAction")
+        return;
+    }
+
+    Being *const srcBeing = actorManager->findBeing(packet.srcId);
+    Being *const dstBeing = actorManager->findBeing(packet.dstId);
 
-    msg.readInt32("tick");
-    const int srcSpeed = msg.readInt32("src speed");
-    msg.readInt32("dst speed");
-    const int param1 = msg.readInt16("param1");
-    msg.readInt16("param 2");
-    const uint8_t type = msg.readUInt8("type");
-    msg.readInt16("param 3");
+    const int srcSpeed = packet.srcSpeed;
+    const int param1 = packet.param1;
+    const uint8_t type = packet.type;
 
     switch (type)
     {
@@ -253,7 +260,14 @@ void BeingHandler::processBeingEmotion(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingEmotionPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingEmotion")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
     {
         BLOCK_END("BeingHandler::processBeingEmotion")
@@ -262,7 +276,7 @@ void BeingHandler::processBeingEmotion(Net::MessageIn &msg)
 
     if (player_relations.hasPermission(dstBeing, PlayerRelation::EMOTE))
     {
-        const uint8_t emote = msg.readUInt8("emote");
+        const uint8_t emote = packet.emote;
         if (emote)
         {
             dstBeing->setEmote(emote, 0);
@@ -283,7 +297,14 @@ void BeingHandler::processNameResponse(Net::MessageIn &msg)
         return;
     }
 
-    const int beingId = msg.readInt32("being id");
+    BeingNameResponsePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processNameResponse")
+        return;
+    }
+
+    const int beingId = packet.beingId;
     Being *const dstBeing = actorManager->findBeing(beingId);
 
     if (dstBeing)
@@ -294,7 +315,7 @@ void BeingHandler::processNameResponse(Net::MessageIn &msg)
         }
         else
         {
-            const std::string name = msg.readString(24, "name");
+            const std::string name = packet.name.str();
             if (dstBeing->getType() != ActorType::Portal)
             {
                 dstBeing->setName(name);
@@ -331,7 +352,6 @@ void BeingHandler::processNameResponse(Net::MessageIn &msg)
             return;
         }
     }
-    msg.readString(24, "name");
     BLOCK_END("BeingHandler::processNameResponse")
 }
 
@@ -344,36 +364,39 @@ void BeingHandler::processPlayerStop(Net::MessageIn &msg)
         return;
     }
 
-    const int id = msg.readInt32("account id");
+    PlayerStopPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
+        return;
+    }
+
+    const int id = packet.beingId;
 
     if (mSync || id != localPlayer->getId())
     {
         Being *const dstBeing = actorManager->findBeing(id);
         if (dstBeing)
         {
-            const uint16_t x = msg.readInt16("x");
-            const uint16_t y = msg.readInt16("y");
-            dstBeing->setTileCoords(x, y);
+            dstBeing->setTileCoords(packet.x, packet.y);
             if (dstBeing->getCurrentAction() == BeingAction::MOVE)
                 dstBeing->setAction(BeingAction::STAND, 0);
             BLOCK_END("BeingHandler::processPlayerStop")
             return;
         }
     }
-    msg.readInt16("x");
-    msg.readInt16("y");
     BLOCK_END("BeingHandler::processPlayerStop")
 }
 
 void BeingHandler::processPlayerMoveToAttack(Net::MessageIn &msg)
 {
     BLOCK_START("BeingHandler::processPlayerStop")
-    msg.readInt32("target id");
-    msg.readInt16("target x");
-    msg.readInt16("target y");
-    msg.readInt16("x");
-    msg.readInt16("y");
-    msg.readInt16("attack range");
+    PlayerMoveToAttackPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
+        return;
+    }
 
     if (localPlayer)
         localPlayer->fixAttackTarget();
@@ -383,16 +406,21 @@ void BeingHandler::processPlayerMoveToAttack(Net::MessageIn &msg)
 void BeingHandler::processSkillNoDamage(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("skill id");
-    msg.readInt16("heal");
-    msg.readInt32("dst id");
-    msg.readInt32("src id");
-    msg.readUInt8("fail");
+    SkillNoDamagePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processPvpMapMode(Net::MessageIn &msg)
 {
     BLOCK_START("BeingHandler::processPvpMapMode")
+    PvpMapModePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPvpMapMode")
+        return;
+    }
+
     const Game *const game = Game::instance();
     if (!game)
     {
@@ -402,21 +430,25 @@ void BeingHandler::processPvpMapMode(Net::MessageIn &msg)
 
     Map *const map = game->getCurrentMap();
     if (map)
-        map->setPvpMode(msg.readInt16("pvp mode"));
+        map->setPvpMode(packet.pvpMode);
     BLOCK_END("BeingHandler::processPvpMapMode")
 }
 
 void BeingHandler::processPvpSet(Net::MessageIn &msg)
 {
     BLOCK_START("BeingHandler::processPvpSet")
-    const int id = msg.readInt32("being id");
-    const int rank = msg.readInt32("rank");
-    msg.readInt32("num");
+    PvpSetPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPvpSet")
+        return;
+    }
+
     if (actorManager)
     {
-        Being *const dstBeing = actorManager->findBeing(id);
+        Being *const dstBeing = actorManager->findBeing(packet.beingId);
         if (dstBeing)
-            dstBeing->setPvpRank(rank);
+            dstBeing->setPvpRank(packet.rank);
     }
     BLOCK_END("BeingHandler::processPvpSet")
 }
@@ -430,9 +462,15 @@ void BeingHandler::processNameResponse2(Net::MessageIn &msg)
         return;
     }
 
-    const int len = msg.readInt16("len");
-    const int beingId = msg.readInt32("account ic");
-    const std::string str = msg.readString(len - 8, "name");
+    BeingNameResponse2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processNameResponse2")
+        return;
+    }
+
+    const int beingId = packet.beingId;
+    const std::string str = msg.readString(packet.len - 8, "name");
     Being *const dstBeing = actorManager->findBeing(beingId);
     if (dstBeing)
     {
@@ -479,18 +517,24 @@ void BeingHandler::processBeingMove3(Net::MessageIn &msg)
     static const int16_t dirx[8] = {0, -1, -1, -1,  0,  1, 1, 1};
     static const int16_t diry[8] = {1,  1,  0, -1, -1, -1, 0, 1};
 
-    const int len = msg.readInt16("len") - 14;
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("being id"));
+    BeingMove3Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingMove3")
+        return;
+    }
+
+    const int len = packet.len - 14;
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
     {
         BLOCK_END("BeingHandler::processBeingMove3")
         return;
     }
-    const int16_t speed = msg.readInt16("speed");
+    const int16_t speed = packet.speed;
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
-    int16_t x = msg.readInt16("x");
-    int16_t y = msg.readInt16("y");
+    int16_t x = packet.x;
+    int16_t y = packet.y;
     const unsigned char *moves = msg.readBytes(len, "moving path");
     Path path;
     if (moves)
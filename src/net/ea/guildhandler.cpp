@@ -180,7 +180,7 @@ void GuildHandler::processGuildAlianceInfo(Net::MessageIn &msg)
     {
         msg.readInt32("opposition");
         msg.readInt32("guild id");
-        msg.readString(24, "guild name");
+        msg.readStringView(24, "guild name");
     }
 }
 
@@ -299,7 +299,7 @@ void GuildHandler::processGuildPositionChanged(Net::MessageIn &msg)
     msg.readInt32("mode");
     msg.readInt32("same ip");
     msg.readInt32("exp mode");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void GuildHandler::processGuildMemberPosChange(Net::MessageIn &msg)
@@ -411,7 +411,7 @@ void GuildHandler::processGuildInviteAck(Net::MessageIn &msg)
 void GuildHandler::processGuildLeave(Net::MessageIn &msg)
 {
     const std::string nick = msg.readString(24, "nick");
-    msg.readString(40, "message");
+    msg.readStringView(40, "message");
 
     if (taGuild)
         taGuild->removeMember(nick);
@@ -486,7 +486,7 @@ void GuildHandler::processGuildSkillUp(Net::MessageIn &msg)
 void GuildHandler::processGuildReqAlliance(Net::MessageIn &msg)
 {
     msg.readInt32("id");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void GuildHandler::processGuildReqAllianceAck(Net::MessageIn &msg)
@@ -25,6 +25,8 @@
 #include "configuration.h"
 #include "logger.h"
 
+#include "net/packetcounters.h"
+
 #include "utils/gettext.h"
 #include "utils/sdlhelper.h"
 
@@ -50,27 +52,51 @@ int networkThread(void *data)
     return 0;
 }
 
+int writerThread(void *data)
+{
+    Network *const network = static_cast<Network *const>(data);
+
+    if (!network)
+        return -1;
+
+    network->send();
+
+    return 0;
+}
+
 Network::Network() :
     mSocket(nullptr),
     mServer(),
     mInBuffer(new char[BUFFER_SIZE]),
     mOutBuffer(new char[BUFFER_SIZE]),
+    mSendBuffer(new char[BUFFER_SIZE]),
+    mWriteBuffer(new char[BUFFER_SIZE]),
     mInSize(0),
     mOutSize(0),
+    mSendSize(0),
     mToSkip(0),
     mState(IDLE),
     mError(),
     mWorkerThread(nullptr),
+    mWriterThread(nullptr),
     mMutexIn(SDL_CreateMutex()),
     mMutexOut(SDL_CreateMutex()),
+    mSendSem(SDL_CreateSemaphore(0)),
+    mSentSem(SDL_CreateSemaphore(0)),
     mSleep(config.getIntValue("networksleep")),
-    mPauseDispatch(false)
+    mPauseDispatch(false),
+    mWriting(false),
+    mWaitSent(false),
+    mCoalesce(config.getBoolValue("coalescePackets"))
 {
     TcpNet::init();
+    config.addListener("coalescePackets", this);
 }
 
 Network::~Network()
 {
+    config.removeListeners(this);
+    CHECKLISTENERS
     if (mState != IDLE && mState != NET_ERROR)
         disconnect();
 
@@ -78,13 +104,25 @@ Network::~Network()
     mMutexIn = nullptr;
     SDL_DestroyMutex(mMutexOut);
     mMutexOut = nullptr;
+    SDL_DestroySemaphore(mSendSem);
+    mSendSem = nullptr;
+    SDL_DestroySemaphore(mSentSem);
+    mSentSem = nullptr;
 
     delete []mInBuffer;
     delete []mOutBuffer;
+    delete []mSendBuffer;
+    delete []mWriteBuffer;
 
     TcpNet::quit();
 }
 
+void Network::optionChanged(const std::string &name)
+{
+    if (name == "coalescePackets")
+        mCoalesce = config.getBoolValue("coalescePackets");
+}
+
 bool Network::connect(const ServerInfo &server)
 {
     if (mState != IDLE && mState != NET_ERROR)
@@ -109,8 +147,11 @@ bool Network::connect(const ServerInfo &server)
 
     // Reset to sane values
     mOutSize = 0;
+    mSendSize = 0;
     mInSize = 0;
     mToSkip = 0;
+    mWriting = false;
+    mWaitSent = false;
 
     mState = CONNECTING;
     mWorkerThread = SDL::createThread(&networkThread, "network", this);
@@ -119,6 +160,12 @@ bool Network::connect(const ServerInfo &server)
         setError("Unable to create network worker thread");
         return false;
     }
+    mWriterThread = SDL::createThread(&writerThread, "networkwriter", this);
+    if (!mWriterThread)
+    {
+        setError("Unable to create network writer thread");
+        return false;
+    }
 
     return true;
 }
@@ -126,6 +173,13 @@ bool Network::connect(const ServerInfo &server)
 void Network::disconnect()
 {
     BLOCK_START("Network::disconnect")
+    if (mState == CONNECTED)
+    {
+        // give writer thread time for send last packets
+        flush();
+        waitSent(true, 1000);
+    }
+
     mState = IDLE;
 
     if (mWorkerThread && SDL_GetThreadID(mWorkerThread))
@@ -133,6 +187,12 @@ void Network::disconnect()
         SDL_WaitThread(mWorkerThread, nullptr);
         mWorkerThread = nullptr;
     }
+    if (mWriterThread)
+    {
+        SDL_SemPost(mSendSem);
+        SDL_WaitThread(mWriterThread, nullptr);
+        mWriterThread = nullptr;
+    }
 
     if (mSocket)
     {
@@ -149,23 +209,102 @@ void Network::flush()
     if (!mOutSize || mState != CONNECTED)
         return;
 
-    SDL_mutexP(mMutexOut);
-    const int ret = TcpNet::send(mSocket, mOutBuffer, mOutSize);
-/*
-    if (logger)
+    if (!waitSent(false, 500))
     {
-        logger->dlog(std::string("Send ").append(
-            toString(mOutSize)).append(" bytes"));
+        if (mState != CONNECTED)
+            mOutSize = 0;
+        return;
     }
-*/
-    if (ret < static_cast<int>(mOutSize))
+
+    // move complete packets to send queue,
+    // writer thread take it as soon as it free
+    SDL_mutexP(mMutexOut);
+    const bool wasEmpty = !mSendSize;
+    memcpy(mSendBuffer + static_cast<size_t>(mSendSize),
+        mOutBuffer, mOutSize);
+    mSendSize += mOutSize;
+    const unsigned int pending = mSendSize;
+    const bool writing = mWriting;
+    SDL_mutexV(mMutexOut);
+    mOutSize = 0;
+
+    if (writing)
+        PacketCounters::incOutStalls(static_cast<int>(pending));
+    // if queue was not empty, writer already signaled
+    if (wasEmpty)
+        SDL_SemPost(mSendSem);
+}
+
+bool Network::waitSent(const bool all, const int timeout)
+{
+    SDL_mutexP(mMutexOut);
+    while (mState == CONNECTED
+           && (all ? mSendSize || mWriting
+           : mSendSize + mOutSize > BUFFER_SIZE))
     {
+        mWaitSent = true;
         SDL_mutexV(mMutexOut);
-        setError("Error in TcpNet::send(): " +
-            std::string(TcpNet::getError()));
+        if (SDL_SemWaitTimeout(mSentSem, timeout))
+            return false;
+        SDL_mutexP(mMutexOut);
     }
-    mOutSize = 0;
     SDL_mutexV(mMutexOut);
+    return mState == CONNECTED;
+}
+
+void Network::send()
+{
+    while (mState == CONNECTING || mState == CONNECTED)
+    {
+        if (SDL_SemWaitTimeout(mSendSem, 500))
+            continue;
+
+        // take all queued packets, main thread can queue new ones
+        // while this data is sending
+        SDL_mutexP(mMutexOut);
+        char *const data = mSendBuffer;
+        mSendBuffer = mWriteBuffer;
+        mWriteBuffer = data;
+        const unsigned int size = mSendSize;
+        mSendSize = 0;
+        mWriting = size != 0;
+        wakeSent();
+        SDL_mutexV(mMutexOut);
+        if (!size || mState != CONNECTED)
+            continue;
+
+        const int ret = TcpNet::send(mSocket, data, size);
+/*
+        if (logger)
+        {
+            logger->dlog(std::string("Send ").append(
+                toString(size)).append(" bytes"));
+        }
+*/
+        if (ret < static_cast<int>(size))
+        {
+            setError("Error in TcpNet::send(): " +
+                std::string(TcpNet::getError()));
+        }
+
+        SDL_mutexP(mMutexOut);
+        mWriting = false;
+        wakeSent();
+        SDL_mutexV(mMutexOut);
+
+        if (ret < static_cast<int>(size))
+            break;
+    }
+}
+
+void Network::wakeSent()
+{
+    // called with locked mMutexOut
+    if (mWaitSent)
+    {
+        mWaitSent = false;
+        SDL_SemPost(mSentSem);
+    }
 }
 
 void Network::skip(const int len)
@@ -352,10 +491,17 @@ void Network::fixSendBuffer()
 {
     if (mOutSize > BUFFER_LIMIT)
     {
+        // packets collected while connecting
         if (mState != CONNECTED)
+        {
             mOutSize = 0;
-        else
+            return;
+        }
+        // flush wait while writer thread take queued packets
+        while (mOutSize > BUFFER_LIMIT && mState == CONNECTED)
             flush();
+        if (mState != CONNECTED)
+            mOutSize = 0;
     }
 }
 
@@ -23,13 +23,15 @@
 #ifndef NET_EA_NETWORK_H
 #define NET_EA_NETWORK_H
 
+#include "listeners/configlistener.h"
+
 #include "net/serverinfo.h"
 #include "net/sdltcpnet.h"
 
 namespace Ea
 {
 
-class Network notfinal
+class Network notfinal : public ConfigListener
 {
     public:
         Network();
@@ -66,6 +68,8 @@ class Network notfinal
         void pauseDispatch()
         { mPauseDispatch = true; }
 
+        void optionChanged(const std::string &name) override final;
+
         // ERROR replaced by NET_ERROR because already defined in Windows
         enum
         {
@@ -78,6 +82,7 @@ class Network notfinal
 
     protected:
         friend int networkThread(void *data);
+        friend int writerThread(void *data);
 
         void setError(const std::string &error);
 
@@ -87,14 +92,23 @@ class Network notfinal
 
         void receive();
 
+        void send();
+
+        bool waitSent(const bool all, const int timeout);
+
+        void wakeSent();
+
         TcpNet::Socket mSocket;
 
         ServerInfo mServer;
 
         char *mInBuffer;
         char *mOutBuffer;
+        char *mSendBuffer;
+        char *mWriteBuffer;
         unsigned int mInSize;
         unsigned int mOutSize;
+        unsigned int mSendSize;
 
         unsigned int mToSkip;
 
@@ -102,10 +116,16 @@ class Network notfinal
         std::string mError;
 
         SDL_Thread *mWorkerThread;
+        SDL_Thread *mWriterThread;
         SDL_mutex *mMutexIn;
         SDL_mutex *mMutexOut;
+        SDL_sem *mSendSem;
+        SDL_sem *mSentSem;
         int mSleep;
         bool mPauseDispatch;
+        bool mWriting;
+        bool mWaitSent;
+        bool mCoalesce;
 };
 
 }  // namespace Ea
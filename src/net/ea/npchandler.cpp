@@ -57,7 +57,7 @@ void NpcHandler::processNpcChoice(Net::MessageIn &msg)
     }
     else
     {
-        msg.readString(msg.getLength() - 8, "select items");
+        msg.readStringView(msg.getLength() - 8, "select items");
     }
 }
 
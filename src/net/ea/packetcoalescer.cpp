@@ -0,0 +1,136 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/ea/packetcoalescer.h"
+
+#include <set>
+
+#include "debug.h"
+
+namespace Ea
+{
+
+namespace
+{
+    // packets in little endian, like in MessageIn
+    uint32_t readValue(const unsigned char *const data, const int size)
+    {
+        uint32_t value = 0;
+        for (int f = size - 1; f >= 0; f --)
+            value = (value << 8) | data[f];
+        return value;
+    }
+}  // namespace
+
+PacketCoalescer::PacketCoalescer(const CoalescePacket *const packets) :
+    mPackets(packets),
+    mKeys(),
+    mReplaced(),
+    mBarriers(),
+    mReplacedCount(0),
+    mSpawnPending(false)
+{
+}
+
+void PacketCoalescer::clear()
+{
+    mKeys.clear();
+    mReplaced.clear();
+    mBarriers.clear();
+    mReplacedCount = 0;
+    // spawn from end of previous batch can be paired with first packet
+    // in this batch. Keeping it can only protect extra packet.
+}
+
+void PacketCoalescer::add(const char *const data,
+                          const unsigned int msgId,
+                          const int len)
+{
+    Key key(0, 0);
+    for (const CoalescePacket *packet = mPackets; packet->msgId; ++ packet)
+    {
+        if (packet->msgId != msgId)
+            continue;
+        const unsigned int flags = packet->flags;
+        if (packet->idPos + 4 > len
+            || packet->subPos + packet->subSize > len)
+        {
+            // broken packet still can take spawn id in handler
+            if (flags & COALESCE_SPAWNED)
+                mSpawnPending = false;
+            break;
+        }
+        const unsigned char *const ptr
+            = reinterpret_cast<const unsigned char*>(data);
+        const uint32_t id = readValue(ptr + packet->idPos, 4);
+
+        // handler pairs spawn with next spawned packet for any being
+        bool paired = false;
+        if (flags & COALESCE_SPAWNED)
+        {
+            paired = mSpawnPending;
+            mSpawnPending = false;
+        }
+        if (flags & COALESCE_SPAWN)
+            mSpawnPending = true;
+        if (flags & COALESCE_BARRIER)
+        {
+            mBarriers[id] ++;
+            break;
+        }
+        if (paired)
+            break;
+
+        uint32_t sub = 0;
+        if (packet->subSize)
+            sub = readValue(ptr + packet->subPos, packet->subSize);
+        key.first = (static_cast<uint64_t>(msgId) << 48)
+            | (static_cast<uint64_t>(sub & 0xffffU) << 32)
+            | id;
+        const std::map<uint32_t, uint32_t>::const_iterator it
+            = mBarriers.find(id);
+        if (it != mBarriers.end())
+            key.second = (*it).second;
+        break;
+    }
+    mKeys.push_back(key);
+}
+
+void PacketCoalescer::process()
+{
+    const size_t sz = mKeys.size();
+    mReplaced.assign(sz, false);
+
+    // last packet for each key applied, all previous replaced by it
+    std::set<Key> found;
+    for (size_t f = sz; f > 0; f --)
+    {
+        const Key &key = mKeys[f - 1];
+        if (!key.first)
+            continue;
+        if (!found.insert(key).second)
+        {
+            mReplaced[f - 1] = true;
+            mReplacedCount ++;
+        }
+    }
+}
+
+}  // namespace Ea
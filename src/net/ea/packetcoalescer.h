@@ -0,0 +1,131 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_EA_PACKETCOALESCER_H
+#define NET_EA_PACKETCOALESCER_H
+
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "localconsts.h"
+
+namespace Ea
+{
+
+enum CoalesceFlags
+{
+    /** Being state packet, replaced by later packet with same key. */
+    COALESCE_REPLACE = 0,
+    /**
+     * Packet never replaced, and state packets for same being before it
+     * not replaced by packets after it (appear, disappear).
+     */
+    COALESCE_BARRIER = 1,
+    /** Packet paired by handler with next COALESCE_SPAWNED packet. */
+    COALESCE_SPAWN = 2,
+    /** Packet what take spawn id, if it first after spawn packet. */
+    COALESCE_SPAWNED = 4
+};
+
+/**
+ * Being state packet what fully replaces state set by previous packet
+ * with same id for same being, or other being packet what limits
+ * replacing.
+ */
+struct CoalescePacket final
+{
+    uint16_t msgId;
+    /** Offset of being id. */
+    uint8_t idPos;
+    /** Offset of state part (look slot, status), or 0. */
+    uint8_t subPos;
+    /** Size of state part, 1 or 2 bytes. */
+    uint8_t subSize;
+    /** CoalesceFlags. */
+    uint8_t flags;
+};
+
+/**
+ * Finds being state packets in one dispatch batch, which replaced by later
+ * packets in same batch. Only final state applied, other packets
+ * (chat, damage, effects) still dispatched in order.
+ */
+class PacketCoalescer final
+{
+    public:
+        /**
+         * @param packets Rules list ended by packet with msgId 0.
+         */
+        explicit PacketCoalescer(const CoalescePacket *const packets);
+
+        A_DELETE_COPY(PacketCoalescer)
+
+        /**
+         * Starts new batch. Not paired spawn packet from previous batch
+         * still protects next spawned packet.
+         */
+        void clear();
+
+        /**
+         * Adds next complete packet from receive buffer to batch.
+         */
+        void add(const char *const data,
+                 const unsigned int msgId,
+                 const int len);
+
+        /**
+         * Marks replaced packets. Must be called after all packets added.
+         */
+        void process();
+
+        /**
+         * Returns true if packet with given index in batch can be skipped.
+         * Packets after end of batch never skipped.
+         */
+        bool isReplaced(const size_t index) const A_WARN_UNUSED
+        { return index < mReplaced.size() && mReplaced[index]; }
+
+        size_t size() const A_WARN_UNUSED
+        { return mKeys.size(); }
+
+        int getReplaced() const A_WARN_UNUSED
+        { return mReplacedCount; }
+
+    private:
+        /** Being state key and being barriers count before packet. */
+        typedef std::pair<uint64_t, uint32_t> Key;
+
+        const CoalescePacket *mPackets;
+        /** Being state key for each packet in batch, or 0. */
+        std::vector<Key> mKeys;
+        std::vector<bool> mReplaced;
+        /** Barriers count for each being in batch. */
+        std::map<uint32_t, uint32_t> mBarriers;
+        int mReplacedCount;
+        /** Last spawn packet still waiting for own pair. */
+        bool mSpawnPending;
+};
+
+}  // namespace Ea
+
+#endif  // NET_EA_PACKETCOALESCER_H
@@ -0,0 +1,404 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef TMWA_SUPPORT
+
+#include "net/ea/packetcoalescer.h"
+
+#include "logger.h"
+
+#include "net/tmwa/network.h"
+#include "net/tmwa/protocol.h"
+
+#include "utils/delete2.h"
+
+#include "gtest/gtest.h"
+
+#include <SDL_timer.h>
+
+#include <cstring>
+#include <map>
+
+#include "debug.h"
+
+namespace
+{
+    // tmwa being packets
+    const unsigned int beingVisible = SMSG_BEING_VISIBLE;
+    const unsigned int beingMove = SMSG_BEING_MOVE;
+    const unsigned int beingSpawn = SMSG_BEING_SPAWN;
+    const unsigned int beingRemove = SMSG_BEING_REMOVE;
+    const unsigned int beingChat = SMSG_BEING_CHAT;
+    const unsigned int playerChat = SMSG_PLAYER_CHAT;
+    const unsigned int beingMove2 = SMSG_BEING_MOVE2;
+    const unsigned int beingLooks = SMSG_BEING_CHANGE_LOOKS2;
+    const unsigned int beingStatus = SMSG_BEING_STATUS_CHANGE;
+
+    void makePacket(char *const data,
+                    const unsigned int msgId,
+                    const int id,
+                    const int sub,
+                    const int value)
+    {
+        memset(data, 0, 16);
+        data[0] = static_cast<char>(msgId & 0xff);
+        data[1] = static_cast<char>((msgId >> 8) & 0xff);
+        if (msgId == beingStatus)
+        {
+            data[2] = static_cast<char>(sub & 0xff);
+            data[3] = static_cast<char>((sub >> 8) & 0xff);
+            memcpy(data + 4, &id, 4);
+        }
+        else
+        {
+            memcpy(data + 2, &id, 4);
+            data[6] = static_cast<char>(sub);
+        }
+        memcpy(data + 8, &value, 4);
+    }
+
+    void addPacket(Ea::PacketCoalescer &coalescer,
+                   const unsigned int msgId,
+                   const int id,
+                   const int sub,
+                   const int len)
+    {
+        char data[16];
+        makePacket(data, msgId, id, sub, 0);
+        coalescer.add(data, msgId, len);
+    }
+
+    struct ReplayBeing final
+    {
+        ReplayBeing() :
+            move(0),
+            spawned(0),
+            looks(0),
+            status(0),
+            chats(0)
+        {
+        }
+
+        bool operator==(const ReplayBeing &being) const
+        {
+            return move == being.move
+                && spawned == being.spawned
+                && looks == being.looks
+                && status == being.status
+                && chats == being.chats;
+        }
+
+        int move;
+        int spawned;
+        int looks;
+        int status;
+        int chats;
+    };
+
+    typedef std::map<int, ReplayBeing> ReplayBeings;
+
+    struct ReplayState final
+    {
+        ReplayState() :
+            beings(),
+            spawnId(0),
+            spawned(0)
+        {
+        }
+
+        ReplayBeings beings;
+        int spawnId;
+        /** Spawn actions for all beings, also removed later. */
+        int spawned;
+    };
+
+    /**
+     * Applies packet like tmwa BeingHandler, including spawn id pairing.
+     */
+    void replayPacket(ReplayState &state,
+                      const char *const data)
+    {
+        ReplayBeings &beings = state.beings;
+        int &spawnId = state.spawnId;
+        unsigned int msgId = 0;
+        int id = 0;
+        int sub = 0;
+        int value = 0;
+        memcpy(&msgId, data, 2);
+        memcpy(&value, data + 8, 4);
+        if (msgId == beingStatus)
+        {
+            memcpy(&sub, data + 2, 2);
+            memcpy(&id, data + 4, 4);
+        }
+        else
+        {
+            memcpy(&id, data + 2, 4);
+            sub = data[6];
+        }
+
+        switch (msgId)
+        {
+            case beingSpawn:
+                spawnId = id;
+                break;
+            case beingVisible:
+            case beingMove:
+            {
+                ReplayBeing &being = beings[id];
+                if (id == spawnId)
+                {
+                    being.spawned ++;
+                    state.spawned ++;
+                }
+                spawnId = 0;
+                being.move = value;
+                break;
+            }
+            case beingMove2:
+                beings[id].move = value;
+                break;
+            case beingLooks:
+                beings[id].looks = (beings[id].looks & ~(0xff << sub * 8))
+                    | ((value & 0xff) << sub * 8);
+                break;
+            case beingStatus:
+                beings[id].status = sub * 1000 + value;
+                break;
+            case beingRemove:
+                beings.erase(id);
+                break;
+            case beingChat:
+                beings[id].chats ++;
+                break;
+            default:
+                break;
+        }
+    }
+}  // namespace
+
+TEST(PacketCoalescer, replace)
+{
+    // rules used by tmwa network
+    Ea::PacketCoalescer coalescer(TmwAthena::Network::getCoalesceRules());
+    addPacket(coalescer, beingMove2, 150000, 0, 16);  // 0 replaced by 3
+    addPacket(coalescer, beingMove2, 150001, 0, 16);  // 1
+    addPacket(coalescer, playerChat, 150000, 0, 16);  // 2 chat, never replaced
+    addPacket(coalescer, beingMove2, 150000, 0, 16);  // 3
+    addPacket(coalescer, beingLooks, 150000, 2, 11);  // 4 replaced by 6
+    addPacket(coalescer, beingLooks, 150000, 3, 11);  // 5 other slot
+    addPacket(coalescer, beingLooks, 150000, 2, 11);  // 6
+    addPacket(coalescer, beingStatus, 150000, 5, 9);   // 7 other status
+    addPacket(coalescer, beingStatus, 150000, 300, 9);  // 8
+    addPacket(coalescer, beingMove2, 150002, 0, 4);   // 9 too short
+    addPacket(coalescer, beingMove2, 150002, 0, 4);   // 10 too short
+    coalescer.process();
+
+    EXPECT_EQ(11U, coalescer.size());
+    EXPECT_EQ(2, coalescer.getReplaced());
+    EXPECT_TRUE(coalescer.isReplaced(0));
+    EXPECT_FALSE(coalescer.isReplaced(1));
+    EXPECT_FALSE(coalescer.isReplaced(2));
+    EXPECT_FALSE(coalescer.isReplaced(3));
+    EXPECT_TRUE(coalescer.isReplaced(4));
+    EXPECT_FALSE(coalescer.isReplaced(5));
+    EXPECT_FALSE(coalescer.isReplaced(6));
+    EXPECT_FALSE(coalescer.isReplaced(7));
+    EXPECT_FALSE(coalescer.isReplaced(8));
+    EXPECT_FALSE(coalescer.isReplaced(9));
+    EXPECT_FALSE(coalescer.isReplaced(10));
+    EXPECT_FALSE(coalescer.isReplaced(100));
+
+    coalescer.clear();
+    EXPECT_EQ(0U, coalescer.size());
+    EXPECT_EQ(0, coalescer.getReplaced());
+    EXPECT_FALSE(coalescer.isReplaced(0));
+}
+
+TEST(PacketCoalescer, barriers)
+{
+    // rules used by tmwa network
+    Ea::PacketCoalescer coalescer(TmwAthena::Network::getCoalesceRules());
+    // move paired with spawn by handler never replaced
+    addPacket(coalescer, beingSpawn, 150000, 0, 16);   // 0
+    addPacket(coalescer, beingMove, 150000, 0, 16);    // 1 paired
+    addPacket(coalescer, beingMove, 150001, 0, 16);    // 2
+    addPacket(coalescer, beingMove, 150000, 0, 16);    // 3
+    // spawn for other being pairs with next move for any being
+    addPacket(coalescer, beingSpawn, 150002, 0, 16);   // 4
+    addPacket(coalescer, beingMove, 150001, 0, 16);    // 5 paired
+    addPacket(coalescer, beingMove, 150001, 0, 16);    // 6
+    // appear and disappear separate states before and after it
+    addPacket(coalescer, beingMove2, 150003, 0, 16);   // 7 replaced by 8
+    addPacket(coalescer, beingMove2, 150003, 0, 16);   // 8
+    addPacket(coalescer, beingRemove, 150003, 0, 16);  // 9
+    addPacket(coalescer, beingMove2, 150003, 0, 16);   // 10
+    addPacket(coalescer, beingVisible, 150003, 0, 16);  // 11
+    addPacket(coalescer, beingVisible, 150003, 0, 16);  // 12
+    addPacket(coalescer, beingMove2, 150003, 0, 16);   // 13
+    coalescer.process();
+
+    EXPECT_EQ(14U, coalescer.size());
+    EXPECT_EQ(2, coalescer.getReplaced());
+    EXPECT_FALSE(coalescer.isReplaced(0));
+    EXPECT_FALSE(coalescer.isReplaced(1));
+    EXPECT_TRUE(coalescer.isReplaced(2));
+    EXPECT_FALSE(coalescer.isReplaced(3));
+    EXPECT_FALSE(coalescer.isReplaced(4));
+    EXPECT_FALSE(coalescer.isReplaced(5));
+    EXPECT_FALSE(coalescer.isReplaced(6));
+    EXPECT_TRUE(coalescer.isReplaced(7));
+    EXPECT_FALSE(coalescer.isReplaced(8));
+    EXPECT_FALSE(coalescer.isReplaced(9));
+    EXPECT_FALSE(coalescer.isReplaced(10));
+    EXPECT_FALSE(coalescer.isReplaced(11));
+    EXPECT_FALSE(coalescer.isReplaced(12));
+    EXPECT_FALSE(coalescer.isReplaced(13));
+}
+
+TEST(PacketCoalescer, crowd)
+{
+    // 50 beings walking, each sends 10 moves and 2 looks in one batch,
+    // with chat from every being in between.
+    // rules used by tmwa network
+    Ea::PacketCoalescer coalescer(TmwAthena::Network::getCoalesceRules());
+    const int beings = 50;
+    for (int step = 0; step < 10; step ++)
+    {
+        for (int f = 0; f < beings; f ++)
+        {
+            addPacket(coalescer, beingMove2, 110000000 + f, 0, 16);
+            if (step % 5 == 0)
+                addPacket(coalescer, beingLooks, 110000000 + f, 2, 11);
+            if (step == 0)
+                addPacket(coalescer, playerChat, 110000000 + f, 0, 16);
+        }
+    }
+    coalescer.process();
+
+    const int total = static_cast<int>(coalescer.size());
+    EXPECT_EQ(beings * (10 + 2 + 1), total);
+    // left only last move and last look for each being, and all chat
+    EXPECT_EQ(total - beings * 3, coalescer.getReplaced());
+}
+
+TEST(PacketCoalescer, replay)
+{
+    logger = new Logger();
+
+    // busy town: beings appear, walk, change looks and status, talk
+    // and go away, with many packets for same beings in each batch.
+    const int batches = 2000;
+    const int batchSize = 100;
+    const int beingsCount = 40;
+    std::vector<char> stream;
+    stream.reserve(batches * batchSize * 16);
+    unsigned int seed = 12345;
+    for (int f = 0; f < batches * batchSize; f ++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        const unsigned int rnd = seed >> 8;
+        const int id = 110000000 + static_cast<int>(rnd % beingsCount);
+        const int value = static_cast<int>((rnd >> 8) & 0xffff);
+        unsigned int msgId;
+        int sub = 0;
+        switch ((rnd >> 4) % 16)
+        {
+            case 0:
+                msgId = beingSpawn;
+                break;
+            case 1:
+                msgId = beingVisible;
+                break;
+            case 2:
+                msgId = beingRemove;
+                break;
+            case 3:
+                msgId = beingChat;
+                break;
+            case 4:
+            case 5:
+                msgId = beingLooks;
+                sub = static_cast<int>(rnd % 3);
+                break;
+            case 6:
+                msgId = beingStatus;
+                sub = static_cast<int>(rnd % 2);
+                break;
+            case 7:
+            case 8:
+            case 9:
+                msgId = beingMove2;
+                break;
+            default:
+                msgId = beingMove;
+                break;
+        }
+        char data[16];
+        makePacket(data, msgId, id, sub, value);
+        stream.insert(stream.end(), data, data + 16);
+    }
+
+    ReplayState state1;
+    uint32_t startTime = SDL_GetTicks();
+    for (size_t pos = 0; pos < stream.size(); pos += 16)
+        replayPacket(state1, &stream[pos]);
+    const int time1 = static_cast<int>(SDL_GetTicks() - startTime);
+
+    // rules used by tmwa network
+    Ea::PacketCoalescer coalescer(TmwAthena::Network::getCoalesceRules());
+    ReplayState state2;
+    int replaced = 0;
+    startTime = SDL_GetTicks();
+    for (int batch = 0; batch < batches; batch ++)
+    {
+        const char *const data = &stream[batch * batchSize * 16];
+        coalescer.clear();
+        for (int f = 0; f < batchSize; f ++)
+        {
+            const char *const packet = data + f * 16;
+            unsigned int msgId = 0;
+            memcpy(&msgId, packet, 2);
+            coalescer.add(packet, msgId, 16);
+        }
+        coalescer.process();
+        replaced += coalescer.getReplaced();
+        for (int f = 0; f < batchSize; f ++)
+        {
+            if (!coalescer.isReplaced(f))
+                replayPacket(state2, data + f * 16);
+        }
+    }
+    const int time2 = static_cast<int>(SDL_GetTicks() - startTime);
+
+    // final being states and spawn actions same as without coalescing
+    EXPECT_TRUE(state1.beings == state2.beings);
+    EXPECT_EQ(state1.spawnId, state2.spawnId);
+    EXPECT_EQ(state1.spawned, state2.spawned);
+    EXPECT_NE(0, state2.spawned);
+    EXPECT_NE(0, replaced);
+    logger->log("packetcoalescer: %d packets replayed in %d ms, "
+        "with coalescing %d skipped and replayed in %d ms",
+        batches * batchSize, time1, replaced, time2);
+
+    delete2(logger);
+}
+
+#endif  // TMWA_SUPPORT
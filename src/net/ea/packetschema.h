@@ -0,0 +1,212 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_EA_PACKETSCHEMA_H
+#define NET_EA_PACKETSCHEMA_H
+
+#include "net/packetschema.h"
+
+/**
+ * Schemas for packets with same layout in tmwa and eathena.
+ * Packet ids bound to schemas in server schema lists.
+ */
+namespace Ea
+{
+
+// SMSG_BEING_REMOVE
+#define EA_BEING_REMOVE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, deadFlag)
+PACKET_SCHEMA(BeingRemovePacket, EA_BEING_REMOVE_FIELDS)
+
+// SMSG_SKILL_DAMAGE
+#define EA_SKILL_DAMAGE_FIELDS(F) \
+    F(int16_t, skillId) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int32_t, tick) \
+    F(int32_t, srcSpeed) \
+    F(int32_t, dstSpeed) \
+    F(int32_t, damage) \
+    F(int16_t, level) \
+    F(int16_t, div) \
+    F(uint8_t, hitType)
+PACKET_SCHEMA(SkillDamagePacket, EA_SKILL_DAMAGE_FIELDS)
+
+// SMSG_BEING_ACTION
+#define EA_BEING_ACTION_FIELDS(F) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int32_t, tick) \
+    F(int32_t, srcSpeed) \
+    F(int32_t, dstSpeed) \
+    F(int16_t, param1) \
+    F(int16_t, param2) \
+    F(uint8_t, type) \
+    F(int16_t, param3)
+PACKET_SCHEMA(BeingActionPacket, EA_BEING_ACTION_FIELDS)
+
+// SMSG_BEING_EMOTION
+#define EA_BEING_EMOTION_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, emote)
+PACKET_SCHEMA(BeingEmotionPacket, EA_BEING_EMOTION_FIELDS)
+
+// SMSG_BEING_NAME_RESPONSE
+#define EA_BEING_NAME_RESPONSE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::String<24>, name)
+PACKET_SCHEMA(BeingNameResponsePacket, EA_BEING_NAME_RESPONSE_FIELDS)
+
+// SMSG_BEING_NAME_RESPONSE2, name up to end of packet
+#define EA_BEING_NAME_RESPONSE2_FIELDS(F) \
+    F(int16_t, len) \
+    F(int32_t, beingId)
+PACKET_VAR_SCHEMA(BeingNameResponse2Packet, EA_BEING_NAME_RESPONSE2_FIELDS)
+
+// SMSG_PLAYER_STOP
+#define EA_PLAYER_STOP_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint16_t, x) \
+    F(uint16_t, y)
+PACKET_SCHEMA(PlayerStopPacket, EA_PLAYER_STOP_FIELDS)
+
+// SMSG_PLAYER_MOVE_TO_ATTACK
+#define EA_PLAYER_MOVE_TO_ATTACK_FIELDS(F) \
+    F(int32_t, targetId) \
+    F(int16_t, targetX) \
+    F(int16_t, targetY) \
+    F(int16_t, x) \
+    F(int16_t, y) \
+    F(int16_t, attackRange)
+PACKET_SCHEMA(PlayerMoveToAttackPacket, EA_PLAYER_MOVE_TO_ATTACK_FIELDS)
+
+// SMSG_SKILL_NO_DAMAGE
+#define EA_SKILL_NO_DAMAGE_FIELDS(F) \
+    F(int16_t, skillId) \
+    F(int16_t, heal) \
+    F(int32_t, dstId) \
+    F(int32_t, srcId) \
+    F(uint8_t, fail)
+PACKET_SCHEMA(SkillNoDamagePacket, EA_SKILL_NO_DAMAGE_FIELDS)
+
+// SMSG_PVP_MAP_MODE
+#define EA_PVP_MAP_MODE_FIELDS(F) \
+    F(int16_t, pvpMode)
+PACKET_SCHEMA(PvpMapModePacket, EA_PVP_MAP_MODE_FIELDS)
+
+// SMSG_PVP_SET
+#define EA_PVP_SET_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, rank) \
+    F(int32_t, num)
+PACKET_SCHEMA(PvpSetPacket, EA_PVP_SET_FIELDS)
+
+// SMSG_BEING_MOVE3, move directions up to end of packet
+#define EA_BEING_MOVE3_FIELDS(F) \
+    F(int16_t, len) \
+    F(int32_t, beingId) \
+    F(int16_t, speed) \
+    F(int16_t, x) \
+    F(int16_t, y)
+PACKET_VAR_SCHEMA(BeingMove3Packet, EA_BEING_MOVE3_FIELDS)
+
+// SMSG_PLAYER_WARP
+#define EA_PLAYER_WARP_FIELDS(F) \
+    F(Net::String<16>, mapName) \
+    F(int16_t, x) \
+    F(int16_t, y)
+PACKET_SCHEMA(PlayerWarpPacket, EA_PLAYER_WARP_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_1, SMSG_PLAYER_STAT_UPDATE_2
+#define EA_PLAYER_STAT_UPDATE_FIELDS(F) \
+    F(int16_t, type) \
+    F(int32_t, value)
+PACKET_SCHEMA(PlayerStatUpdatePacket, EA_PLAYER_STAT_UPDATE_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_3
+#define EA_PLAYER_STAT_UPDATE3_FIELDS(F) \
+    F(int32_t, type) \
+    F(int32_t, base) \
+    F(int32_t, bonus)
+PACKET_SCHEMA(PlayerStatUpdate3Packet, EA_PLAYER_STAT_UPDATE3_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_4
+#define EA_PLAYER_STAT_UPDATE4_FIELDS(F) \
+    F(int16_t, type) \
+    F(uint8_t, ok) \
+    F(uint8_t, value)
+PACKET_SCHEMA(PlayerStatUpdate4Packet, EA_PLAYER_STAT_UPDATE4_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_6
+#define EA_PLAYER_STAT_UPDATE6_FIELDS(F) \
+    F(int16_t, type) \
+    F(uint8_t, value)
+PACKET_SCHEMA(PlayerStatUpdate6Packet, EA_PLAYER_STAT_UPDATE6_FIELDS)
+
+// SMSG_PLAYER_ARROW_MESSAGE
+#define EA_PLAYER_ARROW_MESSAGE_FIELDS(F) \
+    F(int16_t, type)
+PACKET_SCHEMA(PlayerArrowMessagePacket, EA_PLAYER_ARROW_MESSAGE_FIELDS)
+
+// SMSG_MAP_MASK
+#define EA_MAP_MASK_FIELDS(F) \
+    F(int32_t, mask) \
+    F(Net::Skip<4>, unused)
+PACKET_SCHEMA(MapMaskPacket, EA_MAP_MASK_FIELDS)
+
+// SMSG_MAP_MUSIC, music name up to end of packet
+#define EA_MAP_MUSIC_FIELDS(F) \
+    F(int16_t, len)
+PACKET_VAR_SCHEMA(MapMusicPacket, EA_MAP_MUSIC_FIELDS)
+
+// SMSG_ONLINE_LIST, players up to end of packet
+#define EA_ONLINE_LIST_FIELDS(F) \
+    F(int16_t, len)
+PACKET_VAR_SCHEMA(OnlineListPacket, EA_ONLINE_LIST_FIELDS)
+
+}  // namespace Ea
+
+// schemas of packets handled by shared code, bound to server packet ids
+#define EA_PACKET_SCHEMAS(F) \
+    F(SMSG_BEING_REMOVE, Ea::BeingRemovePacket) \
+    F(SMSG_SKILL_DAMAGE, Ea::SkillDamagePacket) \
+    F(SMSG_BEING_ACTION, Ea::BeingActionPacket) \
+    F(SMSG_BEING_EMOTION, Ea::BeingEmotionPacket) \
+    F(SMSG_BEING_NAME_RESPONSE, Ea::BeingNameResponsePacket) \
+    F(SMSG_BEING_NAME_RESPONSE2, Ea::BeingNameResponse2Packet) \
+    F(SMSG_PLAYER_STOP, Ea::PlayerStopPacket) \
+    F(SMSG_PLAYER_MOVE_TO_ATTACK, Ea::PlayerMoveToAttackPacket) \
+    F(SMSG_SKILL_NO_DAMAGE, Ea::SkillNoDamagePacket) \
+    F(SMSG_PVP_MAP_MODE, Ea::PvpMapModePacket) \
+    F(SMSG_PVP_SET, Ea::PvpSetPacket) \
+    F(SMSG_BEING_MOVE3, Ea::BeingMove3Packet) \
+    F(SMSG_PLAYER_WARP, Ea::PlayerWarpPacket) \
+    F(SMSG_PLAYER_STAT_UPDATE_1, Ea::PlayerStatUpdatePacket) \
+    F(SMSG_PLAYER_STAT_UPDATE_2, Ea::PlayerStatUpdatePacket) \
+    F(SMSG_PLAYER_STAT_UPDATE_3, Ea::PlayerStatUpdate3Packet) \
+    F(SMSG_PLAYER_STAT_UPDATE_4, Ea::PlayerStatUpdate4Packet) \
+    F(SMSG_PLAYER_STAT_UPDATE_6, Ea::PlayerStatUpdate6Packet) \
+    F(SMSG_PLAYER_ARROW_MESSAGE, Ea::PlayerArrowMessagePacket) \
+    F(SMSG_MAP_MASK, Ea::MapMaskPacket) \
+    F(SMSG_MAP_MUSIC, Ea::MapMusicPacket) \
+    F(SMSG_ONLINE_LIST, Ea::OnlineListPacket)
+
+#endif  // NET_EA_PACKETSCHEMA_H
@@ -47,6 +47,7 @@
 #include "resources/map/map.h"
 
 #include "net/ea/eaprotocol.h"
+#include "net/ea/packetschema.h"
 
 #include "debug.h"
 
@@ -89,9 +90,16 @@ Vector PlayerHandler::getDefaultWalkSpeed() const
 void PlayerHandler::processPlayerWarp(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerWarp")
-    std::string mapPath = msg.readString(16, "map name");
-    int x = msg.readInt16("x");
-    int y = msg.readInt16("y");
+    PlayerWarpPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerWarp")
+        return;
+    }
+
+    std::string mapPath = packet.mapName.str();
+    int x = packet.x;
+    int y = packet.y;
 
     logger->log("Warping to %s (%d, %d)", mapPath.c_str(), x, y);
 
@@ -163,8 +171,15 @@ void PlayerHandler::processPlayerWarp(Net::MessageIn &msg)
 void PlayerHandler::processPlayerStatUpdate1(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate1")
-    const int type = msg.readInt16("type");
-    const int value = msg.readInt32("value");
+    PlayerStatUpdatePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate1")
+        return;
+    }
+
+    const int type = packet.type;
+    const int value = packet.value;
     if (!localPlayer)
     {
         BLOCK_END("PlayerHandler::processPlayerStatUpdate1")
@@ -178,8 +193,15 @@ void PlayerHandler::processPlayerStatUpdate1(Net::MessageIn &msg)
 void PlayerHandler::processPlayerStatUpdate2(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate2")
-    const int type = msg.readInt16("type");
-    const int value = msg.readInt32("value");
+    PlayerStatUpdatePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate2")
+        return;
+    }
+
+    const int type = packet.type;
+    const int value = packet.value;
     playerHandler->setStat(msg, type, value, NoStat, Notify_true);
     BLOCK_END("PlayerHandler::processPlayerStatUpdate2")
 }
@@ -187,9 +209,16 @@ void PlayerHandler::processPlayerStatUpdate2(Net::MessageIn &msg)
 void PlayerHandler::processPlayerStatUpdate3(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate3")
-    const int type = msg.readInt32("type");
-    const int base = msg.readInt32("base");
-    const int bonus = msg.readInt32("bonus");
+    PlayerStatUpdate3Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate3")
+        return;
+    }
+
+    const int type = packet.type;
+    const int base = packet.base;
+    const int bonus = packet.bonus;
 
     playerHandler->setStat(msg, type, base, bonus, Notify_false);
     BLOCK_END("PlayerHandler::processPlayerStatUpdate3")
@@ -198,9 +227,16 @@ void PlayerHandler::processPlayerStatUpdate3(Net::MessageIn &msg)
 void PlayerHandler::processPlayerStatUpdate4(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate4")
-    const int type = msg.readInt16("type");
-    const uint8_t ok = msg.readUInt8("flag");
-    const int value = msg.readUInt8("value");
+    PlayerStatUpdate4Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate4")
+        return;
+    }
+
+    const int type = packet.type;
+    const uint8_t ok = packet.ok;
+    const int value = packet.value;
 
     if (ok != 1)
     {
@@ -218,8 +254,15 @@ void PlayerHandler::processPlayerStatUpdate4(Net::MessageIn &msg)
 void PlayerHandler::processPlayerStatUpdate6(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate6")
-    const int type = msg.readInt16("type");
-    const int value = msg.readUInt8("value");
+    PlayerStatUpdate6Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate6")
+        return;
+    }
+
+    const int type = packet.type;
+    const int value = packet.value;
     if (statusWindow)
         playerHandler->setStat(msg, type, value, NoStat, Notify_true);
     BLOCK_END("PlayerHandler::processPlayerStatUpdate6")
@@ -228,7 +271,14 @@ void PlayerHandler::processPlayerStatUpdate6(Net::MessageIn &msg)
 void PlayerHandler::processPlayerArrowMessage(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerArrowMessage")
-    const int type = msg.readInt16("type");
+    PlayerArrowMessagePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processPlayerArrowMessage")
+        return;
+    }
+
+    const int type = packet.type;
     switch (type)
     {
         case 0:
@@ -456,16 +506,20 @@ void PlayerHandler::setStat(Net::MessageIn &msg,
 
 void PlayerHandler::processMapMask(Net::MessageIn &msg)
 {
-    const int mask = msg.readInt32("mask");
-    msg.readInt32("unused");
+    MapMaskPacket packet;
+    if (!packet.decode(msg))
+        return;
     Map *const map = Game::instance()->getCurrentMap();
     if (map)
-        map->setMask(mask);
+        map->setMask(packet.mask);
 }
 
 void PlayerHandler::processMapMusic(Net::MessageIn &msg)
 {
-    const int size = msg.readInt16("len") - 5;
+    MapMusicPacket packet;
+    if (!packet.decode(msg))
+        return;
+    const int size = packet.len - 5;
     const std::string music = msg.readString(size, "name");
     soundManager.playMusic(music);
 
@@ -480,7 +534,14 @@ void PlayerHandler::processOnlineList(Net::MessageIn &msg)
         return;
 
     BLOCK_START("PlayerHandler::processOnlineList")
-    const int size = msg.readInt16("len") - 4;
+    OnlineListPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processOnlineList")
+        return;
+    }
+
+    const int size = packet.len - 4;
     std::vector<OnlinePlayer*> arr;
 
     if (!size)
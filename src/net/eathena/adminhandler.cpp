@@ -188,7 +188,7 @@ void AdminHandler::processAdminGetLoginAck(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readInt32("account id");
-    msg.readString(24, "login");
+    msg.readStringView(24, "login");
 }
 
 void AdminHandler::processSetTileType(Net::MessageIn &msg)
@@ -198,7 +198,7 @@ void AdminHandler::processSetTileType(Net::MessageIn &msg)
     msg.readInt16("x");
     msg.readInt16("y");
     msg.readInt16("type");
-    msg.readString(16, "map name");
+    msg.readStringView(16, "map name");
 }
 
 void AdminHandler::requestStats(const std::string &name)
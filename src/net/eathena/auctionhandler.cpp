@@ -95,7 +95,7 @@ void AuctionHandler::processAuctionResults(Net::MessageIn &msg)
     for (int f = 0; f < itemCount; f ++)
     {
         msg.readInt32("auction id");
-        msg.readString(24, "seller name");
+        msg.readStringView(24, "seller name");
         msg.readInt32("item id");
         msg.readInt32("auction type");
         msg.readInt16("item amount");  // always 1
@@ -106,7 +106,7 @@ void AuctionHandler::processAuctionResults(Net::MessageIn &msg)
             msg.readInt16("card");
         msg.readInt32("price");
         msg.readInt32("buy now");
-        msg.readString(24, "buyer name");
+        msg.readStringView(24, "buyer name");
         msg.readInt32("timestamp");
     }
 }
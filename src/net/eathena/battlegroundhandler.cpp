@@ -96,7 +96,7 @@ void BattleGroundHandler::processBattleEmblem(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readInt32("account id");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
     msg.readInt16("camp");
 }
 
@@ -111,7 +111,7 @@ void BattleGroundHandler::processBattleUpdateCoords(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readInt32("account id");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
     msg.readInt16("class");
     msg.readInt16("x");
     msg.readInt16("y");
@@ -120,34 +120,34 @@ void BattleGroundHandler::processBattleUpdateCoords(Net::MessageIn &msg)
 void BattleGroundHandler::processBattlePlay(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(24, "battle ground name");
+    msg.readStringView(24, "battle ground name");
 }
 
 void BattleGroundHandler::processBattleQueueAck(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readUInt8("type");
-    msg.readString(24, "bg name");
+    msg.readStringView(24, "bg name");
 }
 
 void BattleGroundHandler::processBattleBegins(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(24, "bg name");
-    msg.readString(24, "game name");
+    msg.readStringView(24, "bg name");
+    msg.readStringView(24, "game name");
 }
 
 void BattleGroundHandler::processBattleNoticeDelete(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readUInt8("type");
-    msg.readString(24, "bg name");
+    msg.readStringView(24, "bg name");
 }
 
 void BattleGroundHandler::processBattleJoined(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
     msg.readInt32("position");
 }
 
@@ -44,6 +44,7 @@
 
 #include "net/eathena/maptypeproperty2.h"
 #include "net/eathena/messageout.h"
+#include "net/eathena/packetschema.h"
 #include "net/eathena/protocol.h"
 #include "net/eathena/sprite.h"
 
@@ -270,7 +271,7 @@ void BeingHandler::handleMessage(Net::MessageIn &msg)
             break;
 
         case SMSG_SKILL_CAST_CANCEL:
-            msg.readInt32("id?");
+            processSkillCastCancel(msg);
             break;
 
         case SMSG_SKILL_NO_DAMAGE:
@@ -494,12 +495,15 @@ void BeingHandler::processBeingChangeLook2(Net::MessageIn &msg)
     if (!actorManager)
         return;
 
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("being id"));
-    const uint8_t type = msg.readUInt8("type");
+    BeingChangeLooks2Packet packet;
+    if (!packet.decode(msg))
+        return;
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
+    const uint8_t type = packet.type;
 
-    const int id = msg.readInt16("id1");
-    unsigned int id2 = msg.readInt16("id2");
+    const int id = packet.id1;
+    unsigned int id2 = packet.id2;
     if (type != 2)
         id2 = 1;
 
@@ -620,12 +624,15 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
     if (!actorManager)
         return;
 
-    msg.readInt16("len");
+    BeingVisiblePacket packet;
+    if (!packet.decode(msg))
+        return;
+
     const BeingType::BeingType type = static_cast<BeingType::BeingType>(
-        msg.readUInt8("object type"));
+        packet.objectType);
 
     // Information about a being in range
-    const int id = msg.readInt32("being id");
+    const int id = packet.beingId;
     int spawnId;
     if (id == mSpawnId)
         spawnId = mSpawnId;
@@ -633,13 +640,12 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
         spawnId = 0;
     mSpawnId = 0;
 
-    int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
+    int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
     // probably wrong effect usage
-    const uint32_t statusEffects = msg.readInt16("opt2");
-    msg.readInt32("option");
+    const uint32_t statusEffects = packet.statusEffects;
 
-    const int16_t job = msg.readInt16("class");
+    const int16_t job = packet.job;
 
     Being *dstBeing = actorManager->findBeing(id);
 
@@ -691,25 +697,21 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
     if (dstBeing->getType() == ActorType::Monster && localPlayer)
         localPlayer->checkNewName(dstBeing);
 
-    const int hairStyle = msg.readInt16("hair style");
-    const uint32_t weapon = static_cast<uint32_t>(msg.readInt32("weapon"));
-    const uint16_t headBottom = msg.readInt16("head bottom");
+    const int hairStyle = packet.hairStyle;
+    const uint32_t weapon = static_cast<uint32_t>(packet.weapon);
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const int hairColor = msg.readInt16("hair color");
-    const uint16_t shoes = msg.readInt16("shoes or clothes color?");
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const int hairColor = packet.hairColor;
+    const uint16_t shoes = packet.shoes;
 
-    const uint16_t gloves = msg.readInt16("head dir / gloves");
+    const uint16_t gloves = packet.gloves;
     // may be use robe as gloves?
-    msg.readInt16("robe");
-    msg.readInt32("guild id");
-    msg.readInt16("guild emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(
-        msg.readInt32("opt3")));
-    dstBeing->setKarma(msg.readUInt8("karma"));
-    uint8_t gender = static_cast<uint8_t>(msg.readUInt8("gender") & 3);
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(packet.opt3));
+    dstBeing->setKarma(packet.karma);
+    uint8_t gender = static_cast<uint8_t>(packet.gender & 3);
 
     if (dstBeing->getType() == ActorType::Player)
     {
@@ -732,12 +734,9 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
         dstBeing->setGender(Being::intToGender(gender));
     }
 
-    uint8_t dir;
-    uint16_t x, y;
-    msg.readCoordinates(x, y, dir, "position");
-    msg.readInt8("xs");
-    msg.readInt8("ys");
-    msg.readUInt8("action type");
+    const uint8_t dir = packet.position.direction;
+    const uint16_t x = packet.position.x;
+    const uint16_t y = packet.position.y;
     dstBeing->setTileCoords(x, y);
 
     if (job == 45 && socialWindow && outfitWindow)
@@ -756,17 +755,12 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
 
     dstBeing->setDirection(dir);
 
-    const int level = static_cast<int>(msg.readInt16("level"));
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
-    msg.readInt16("font");
 
-    const int maxHP = msg.readInt32("max hp");
-    const int hp = msg.readInt32("hp");
-    dstBeing->setMaxHP(maxHP);
-    dstBeing->setHP(hp);
-
-    msg.readInt8("is boss");
+    dstBeing->setMaxHP(packet.maxHP);
+    dstBeing->setHP(packet.hp);
 
     dstBeing->setStunMode(stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
@@ -780,24 +774,27 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
     if (!actorManager)
         return;
 
-    msg.readInt16("len");
+    BeingMovePacket packet;
+    if (!packet.decode(msg))
+        return;
+
     const BeingType::BeingType type = static_cast<BeingType::BeingType>(
-        msg.readUInt8("object type"));
+        packet.objectType);
 
     // Information about a being in range
-    const int id = msg.readInt32("being id");
+    const int id = packet.beingId;
     int spawnId;
     if (id == mSpawnId)
         spawnId = mSpawnId;
     else
         spawnId = 0;
     mSpawnId = 0;
-    int16_t speed = msg.readInt16("speed");
+    int16_t speed = packet.speed;
 //    if (visible)
 //    {
-        const uint16_t stunMode = msg.readInt16("opt1");
+        const uint16_t stunMode = packet.stunMode;
         // probably wrong effect usage
-        const uint32_t statusEffects = msg.readInt16("opt2");
+        const uint32_t statusEffects = packet.statusEffects;
 //    }
 //    else
 //    {
@@ -805,9 +802,8 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
 //        msg.readInt16("body state");
 //        msg.readInt16("health state");
 //    }
-    msg.readInt32("effect state");
 
-    const int16_t job = msg.readInt16("class");
+    const int16_t job = packet.job;
 
     Being *dstBeing = actorManager->findBeing(id);
 
@@ -851,27 +847,21 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
     if (dstBeing->getType() == ActorType::Monster && localPlayer)
         localPlayer->checkNewName(dstBeing);
 
-    const int hairStyle = msg.readInt16("hair style");
-    const uint32_t weapon = static_cast<uint32_t>(msg.readInt32("weapon"));
-    const uint16_t headBottom = msg.readInt16("head bottom");
-
-    msg.readInt32("tick");
+    const int hairStyle = packet.hairStyle;
+    const uint32_t weapon = static_cast<uint32_t>(packet.weapon);
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const int hairColor = msg.readInt16("hair color");
-    const uint16_t shoes = msg.readInt16("shoes or clothes color?");
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const int hairColor = packet.hairColor;
+    const uint16_t shoes = packet.shoes;
 
-    const uint16_t gloves = msg.readInt16("head dir / gloves");
+    const uint16_t gloves = packet.gloves;
     // may be use robe as gloves?
-    msg.readInt16("robe");
-    msg.readInt32("guild id");
-    msg.readInt16("guild emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(
-        msg.readInt32("opt3")));
-    dstBeing->setKarma(msg.readUInt8("karma"));
-    uint8_t gender = static_cast<uint8_t>(msg.readUInt8("gender") & 3);
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(packet.opt3));
+    dstBeing->setKarma(packet.karma);
+    uint8_t gender = static_cast<uint8_t>(packet.gender & 3);
 
     if (dstBeing->getType() == ActorType::Player)
     {
@@ -897,11 +887,10 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
         dstBeing->setGender(Being::intToGender(gender));
     }
 
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readUInt8("(sx<<4) | (sy&0x0f)");
-    msg.readInt8("xs");
-    msg.readInt8("ys");
+    const uint16_t srcX = packet.path.srcX;
+    const uint16_t srcY = packet.path.srcY;
+    const uint16_t dstX = packet.path.dstX;
+    const uint16_t dstY = packet.path.dstY;
     dstBeing->setAction(BeingAction::STAND, 0);
     dstBeing->setTileCoords(srcX, srcY);
     if (localPlayer)
@@ -930,17 +919,12 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
     if (d && dstBeing->getDirection() != d)
         dstBeing->setDirection(d);
 
-    const int level = static_cast<int>(msg.readInt16("level"));
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
-    msg.readInt16("font");
 
-    const int maxHP = msg.readInt32("max hp");
-    const int hp = msg.readInt32("hp");
-    dstBeing->setMaxHP(maxHP);
-    dstBeing->setHP(hp);
-
-    msg.readInt8("is boss");
+    dstBeing->setMaxHP(packet.maxHP);
+    dstBeing->setHP(packet.hp);
 
     dstBeing->setStunMode(stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
@@ -954,20 +938,23 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
     if (!actorManager)
         return;
 
-    msg.readInt16("len");
+    BeingSpawnPacket packet;
+    if (!packet.decode(msg))
+        return;
+
     const BeingType::BeingType type = static_cast<BeingType::BeingType>(
-        msg.readUInt8("object type"));
+        packet.objectType);
 
     // Information about a being in range
-    const int id = msg.readInt32("being id");
+    const int id = packet.beingId;
     mSpawnId = id;
     const int spawnId = id;
-    int16_t speed = msg.readInt16("speed");
+    int16_t speed = packet.speed;
 //    if (visible)
 //    {
-        const uint16_t stunMode = msg.readInt16("opt1");
+        const uint16_t stunMode = packet.stunMode;
         // probably wrong effect usage
-        const uint32_t statusEffects = msg.readInt16("opt2");
+        const uint32_t statusEffects = packet.statusEffects;
 //    }
 //    else
 //    {
@@ -975,9 +962,8 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
 //        msg.readInt16("body state");
 //        msg.readInt16("health state");
 //    }
-    msg.readInt32("effect state");
 
-    const int16_t job = msg.readInt16("class");
+    const int16_t job = packet.job;
 
     Being *dstBeing = actorManager->findBeing(id);
 
@@ -1023,25 +1009,21 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
     if (dstBeing->getType() == ActorType::Monster && localPlayer)
         localPlayer->checkNewName(dstBeing);
 
-    const int hairStyle = msg.readInt16("hair style");
-    const uint32_t weapon = static_cast<uint32_t>(msg.readInt32("weapon"));
-    const uint16_t headBottom = msg.readInt16("head bottom");
+    const int hairStyle = packet.hairStyle;
+    const uint32_t weapon = static_cast<uint32_t>(packet.weapon);
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const int hairColor = msg.readInt16("hair color");
-    const uint16_t shoes = msg.readInt16("shoes or clothes color?");
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const int hairColor = packet.hairColor;
+    const uint16_t shoes = packet.shoes;
 
-    const uint16_t gloves = msg.readInt16("head dir / gloves");
+    const uint16_t gloves = packet.gloves;
     // may be use robe as gloves?
-    msg.readInt16("robe");
-    msg.readInt32("guild id");
-    msg.readInt16("guild emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(
-        msg.readInt32("opt3")));
-    dstBeing->setKarma(msg.readUInt8("karma"));
-    uint8_t gender = static_cast<uint8_t>(msg.readUInt8("gender") & 3);
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, static_cast<uint16_t>(packet.opt3));
+    dstBeing->setKarma(packet.karma);
+    uint8_t gender = static_cast<uint8_t>(packet.gender & 3);
 
     if (dstBeing->getType() == ActorType::Player)
     {
@@ -1064,11 +1046,9 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
         dstBeing->setGender(Being::intToGender(gender));
     }
 
-    uint8_t dir;
-    uint16_t x, y;
-    msg.readCoordinates(x, y, dir, "position");
-    msg.readInt8("xs");
-    msg.readInt8("ys");
+    const uint8_t dir = packet.position.direction;
+    const uint16_t x = packet.position.x;
+    const uint16_t y = packet.position.y;
     dstBeing->setTileCoords(x, y);
 
     if (job == 45 && socialWindow && outfitWindow)
@@ -1087,17 +1067,12 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
 
     dstBeing->setDirection(dir);
 
-    const int level = static_cast<int>(msg.readInt16("level"));
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
-    msg.readInt16("font");
-
-    const int maxHP = msg.readInt32("max hp");
-    const int hp = msg.readInt32("hp");
-    dstBeing->setMaxHP(maxHP);
-    dstBeing->setHP(hp);
 
-    msg.readInt8("is boss");
+    dstBeing->setMaxHP(packet.maxHP);
+    dstBeing->setHP(packet.hp);
 
     dstBeing->setStunMode(stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
@@ -1108,13 +1083,14 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
 
 void BeingHandler::processMapTypeProperty(Net::MessageIn &msg)
 {
-    const int16_t type = msg.readInt16("type");
-    const int flags = msg.readInt32("flags");
-    if (type == 0x28)
+    MapTypeProperty2Packet packet;
+    if (!packet.decode(msg))
+        return;
+    if (packet.type == 0x28)
     {
         // +++ need get other flags from here
         MapTypeProperty2 props;
-        props.data = static_cast<uint32_t>(flags);
+        props.data = static_cast<uint32_t>(packet.flags);
         Game *const game = Game::instance();
         Map *const map = game->getCurrentMap();
         if (!map)
@@ -1127,21 +1103,24 @@ void BeingHandler::processMapType(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // battle ground map or not
-    msg.readInt16("type");
+    MapTypePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processSkillCasting(Net::MessageIn &msg)
 {
     // +++ need use other parameters
 
-    const int srcId = msg.readInt32("src id");
-    const int dstId = msg.readInt32("dst id");
-    const int dstX = msg.readInt16("dst x");
-    const int dstY = msg.readInt16("dst y");
-    const int skillId = msg.readInt16("skill id");
-    msg.readInt32("property");  // can be used to trigger effect
-    msg.readInt32("cast time");
-    msg.readInt8("dispossable");
+    SkillCastingPacket packet;
+    if (!packet.decode(msg))
+        return;
+    // property can be used to trigger effect
+    const int srcId = packet.srcId;
+    const int dstId = packet.dstId;
+    const int dstX = packet.dstX;
+    const int dstY = packet.dstY;
+    const int skillId = packet.skillId;
 
     if (!effectManager)
         return;
@@ -1164,6 +1143,13 @@ void BeingHandler::processSkillCasting(Net::MessageIn &msg)
     }
 }
 
+void BeingHandler::processSkillCastCancel(Net::MessageIn &msg)
+{
+    SkillCastCancelPacket packet;
+    if (!packet.decode(msg))
+        return;
+}
+
 void BeingHandler::processBeingStatusChange(Net::MessageIn &msg)
 {
     BLOCK_START("BeingHandler::processBeingStatusChange")
@@ -1174,19 +1160,17 @@ void BeingHandler::processBeingStatusChange(Net::MessageIn &msg)
     }
 
     // Status change
-    const uint16_t status = msg.readInt16("status");
-    const int id = msg.readInt32("being id");
-    const Enable flag = fromBool(
-        msg.readUInt8("flag: 0: stop, 1: start"), Enable);
-    msg.readInt32("total");
-    msg.readInt32("left");
-    msg.readInt32("val1");
-    msg.readInt32("val2");
-    msg.readInt32("val3");
-
-    Being *const dstBeing = actorManager->findBeing(id);
+    BeingStatusChangePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingStatusChange")
+        return;
+    }
+
+    const Enable flag = fromBool(packet.flag, Enable);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
-        dstBeing->setStatusEffect(status, flag);
+        dstBeing->setStatusEffect(packet.status, flag);
     BLOCK_END("BeingHandler::processBeingStatusChange")
 }
 
@@ -1200,18 +1184,17 @@ void BeingHandler::processBeingStatusChange2(Net::MessageIn &msg)
     }
 
     // Status change
-    const uint16_t status = msg.readInt16("status");
-    const int id = msg.readInt32("being id");
-    const Enable flag = fromBool(
-        msg.readUInt8("flag: 0: stop, 1: start"), Enable);
-    msg.readInt32("left");
-    msg.readInt32("val1");
-    msg.readInt32("val2");
-    msg.readInt32("val3");
-
-    Being *const dstBeing = actorManager->findBeing(id);
+    BeingStatusChange2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingStatusChange")
+        return;
+    }
+
+    const Enable flag = fromBool(packet.flag, Enable);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
-        dstBeing->setStatusEffect(status, flag);
+        dstBeing->setStatusEffect(packet.status, flag);
     BLOCK_END("BeingHandler::processBeingStatusChange")
 }
 
@@ -1229,12 +1212,18 @@ void BeingHandler::processBeingMove2(Net::MessageIn &msg)
       * later versions of eAthena for both mobs and
       * players
       */
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingMove2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingMove2")
+        return;
+    }
 
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readUInt8("(sx<<4) | (sy&0x0f)");
-    msg.readInt32("tick");
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
+    const uint16_t srcX = packet.path.srcX;
+    const uint16_t srcY = packet.path.srcY;
+    const uint16_t dstX = packet.path.dstX;
+    const uint16_t dstY = packet.path.dstY;
 
     /*
       * This packet doesn't have enough info to actually
@@ -1267,18 +1256,19 @@ void BeingHandler::processBeingAction2(Net::MessageIn &msg)
         return;
     }
 
-    Being *const srcBeing = actorManager->findBeing(
-        msg.readInt32("src being id"));
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("dst being id"));
+    BeingAction2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingAction2")
+        return;
+    }
+
+    Being *const srcBeing = actorManager->findBeing(packet.srcId);
+    Being *const dstBeing = actorManager->findBeing(packet.dstId);
 
-    msg.readInt32("tick");
-    const int srcSpeed = msg.readInt32("src speed");
-    msg.readInt32("dst speed");
-    const int param1 = msg.readInt32("damage");
-    msg.readInt16("count");
-    const uint8_t type = msg.readUInt8("action");
-    msg.readInt32("left damage");
+    const int srcSpeed = packet.srcSpeed;
+    const int param1 = packet.damage;
+    const uint8_t type = packet.type;
 
     switch (type)
     {
@@ -1351,80 +1341,69 @@ void BeingHandler::processBeingAction2(Net::MessageIn &msg)
 
 void BeingHandler::processMonsterHp(Net::MessageIn &msg)
 {
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("monster id"));
-    const int hp = msg.readInt32("hp");
-    const int maxHP = msg.readInt32("max hp");
+    MonsterHpPacket packet;
+    if (!packet.decode(msg))
+        return;
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
     {
-        dstBeing->setHP(hp);
-        dstBeing->setMaxHP(maxHP);
+        dstBeing->setHP(packet.hp);
+        dstBeing->setMaxHP(packet.maxHP);
     }
 }
 
 void BeingHandler::processSkillAutoCast(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("skill id");
-    msg.readInt16("inf");
-    msg.readInt16("unused");
-    msg.readInt16("skill level");
-    msg.readInt16("sp");
-    msg.readInt16("range");
-    msg.readString(24, "skill name");
-    msg.readInt8("unused");
+    SkillAutoCastPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processRanksList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ here need window with rank tables.
-    msg.readInt16("rank type");
-    for (int f = 0; f < 10; f ++)
-        msg.readString(24, "name");
-    for (int f = 0; f < 10; f ++)
-        msg.readInt32("points");
-    msg.readInt32("my points");
+    RanksListPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBlacksmithRanksList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ here need window with rank tables.
-    for (int f = 0; f < 10; f ++)
-        msg.readString(24, "name");
-    for (int f = 0; f < 10; f ++)
-        msg.readInt32("points");
+    ClassRanksListPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processAlchemistRanksList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ here need window with rank tables.
-    for (int f = 0; f < 10; f ++)
-        msg.readString(24, "name");
-    for (int f = 0; f < 10; f ++)
-        msg.readInt32("points");
+    ClassRanksListPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processTaekwonRanksList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ here need window with rank tables.
-    for (int f = 0; f < 10; f ++)
-        msg.readString(24, "name");
-    for (int f = 0; f < 10; f ++)
-        msg.readInt32("points");
+    ClassRanksListPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processPkRanksList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ here need window with rank tables.
-    for (int f = 0; f < 10; f ++)
-        msg.readString(24, "name");
-    for (int f = 0; f < 10; f ++)
-        msg.readInt32("points");
+    ClassRanksListPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingChangeDirection(Net::MessageIn &msg)
@@ -1436,12 +1415,17 @@ void BeingHandler::processBeingChangeDirection(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingChangeDirectionPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingChangeDirection")
+        return;
+    }
 
-    msg.readInt16("head direction");
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
     const uint8_t dir = Net::MessageIn::fromServerDirection(
-        static_cast<uint8_t>(msg.readUInt8("player direction") & 0x0FU));
+        static_cast<uint8_t>(packet.direction & 0x0FU));
 
     if (!dstBeing)
     {
@@ -1460,12 +1444,15 @@ void BeingHandler::processBeingSpecialEffect(Net::MessageIn &msg)
     if (!effectManager || !actorManager)
         return;
 
-    const int id = static_cast<uint32_t>(msg.readInt32("being id"));
-    Being *const being = actorManager->findBeing(id);
+    BeingSpecialEffectPacket packet;
+    if (!packet.decode(msg))
+        return;
+
+    Being *const being = actorManager->findBeing(packet.beingId);
     if (!being)
         return;
 
-    const int effectType = msg.readInt32("effect type");
+    const int effectType = packet.effectType;
 
     if (Particle::enabled)
         effectManager->trigger(effectType, being);
@@ -1483,19 +1470,18 @@ void BeingHandler::processBeingSpecialEffectNum(Net::MessageIn &msg)
     UNIMPLIMENTEDPACKET;
     // +++ need somhow show this effects.
     // type is not same with self/misc effect.
-    msg.readInt32("account id");
-    msg.readInt32("effect type");
-    msg.readInt32("num");  // effect variable
+    BeingSpecialEffectNumPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingSoundEffect(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ need play this effect.
-    msg.readString(24, "sound effect name");
-    msg.readUInt8("type");
-    msg.readInt32("unused");
-    msg.readInt32("source being id");
+    BeingSoundEffectPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::applyPlayerAction(Net::MessageIn &msg,
@@ -1541,26 +1527,17 @@ void BeingHandler::viewPlayerEquipment(const Being *const being)
 void BeingHandler::processSkillGroundNoDamage(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("skill id");
-    msg.readInt32("src id");
-    msg.readInt16("val");
-    msg.readInt16("x");
-    msg.readInt16("y");
-    msg.readInt32("tick");
+    SkillGroundNoDamagePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processSkillEntry(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("len");
-    msg.readInt32("accound id");
-    msg.readInt32("creator accound id");
-    msg.readInt16("x");
-    msg.readInt16("y");
-    msg.readInt32("job");
-    msg.readUInt8("radius");
-    msg.readUInt8("visible");
-    msg.readUInt8("level");
+    SkillEntryPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processPlaterStatusChange(Net::MessageIn &msg)
@@ -1573,17 +1550,25 @@ void BeingHandler::processPlaterStatusChange(Net::MessageIn &msg)
     }
 
     // Change in players' flags
-    const int id = msg.readInt32("account id");
-    Being *const dstBeing = actorManager->findBeing(id);
+    PlayerStatusChangePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
         return;
+    }
 
-    const uint16_t stunMode = msg.readInt16("stun mode");
-    uint32_t statusEffects = msg.readInt16("status effect");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt32("opt?"))) << 16;
-    dstBeing->setKarma(msg.readUInt8("karma"));
+    const uint32_t statusEffects = packet.statusEffects
+        | (packet.option << 16);
+    dstBeing->setKarma(packet.karma);
 
-    dstBeing->setStunMode(stunMode);
+    dstBeing->setStunMode(packet.stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
         (statusEffects >> 16) & 0xffff));
     dstBeing->setStatusEffectBlock(16, static_cast<uint16_t>(
@@ -1596,14 +1581,16 @@ void BeingHandler::processPlaterStatusChange2(Net::MessageIn &msg)
     if (!actorManager)
         return;
 
-    const int id = msg.readInt32("account id");
-    Being *const dstBeing = actorManager->findBeing(id);
+    PlayerStatusChange2Packet packet;
+    if (!packet.decode(msg))
+        return;
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
         return;
 
-    uint32_t statusEffects = msg.readInt32("status effect");
-    dstBeing->setLevel(msg.readInt32("level"));
-    msg.readInt32("showEFST");
+    const uint32_t statusEffects = packet.statusEffects;
+    dstBeing->setLevel(packet.level);
 
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
         (statusEffects >> 16) & 0xffff));
@@ -1613,16 +1600,16 @@ void BeingHandler::processPlaterStatusChange2(Net::MessageIn &msg)
 
 void BeingHandler::processPlaterStatusChangeNoTick(Net::MessageIn &msg)
 {
-    const uint16_t status = msg.readInt16("index");
-    const int id = msg.readInt32("account id");
-    const Enable flag = fromBool(msg.readUInt8("state")
-        ? true : false, Enable);
+    PlayerStatusChangeNoTickPacket packet;
+    if (!packet.decode(msg) || !actorManager)
+        return;
 
-    Being *const dstBeing = actorManager->findBeing(id);
+    const Enable flag = fromBool(packet.flag ? true : false, Enable);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
         return;
 
-    dstBeing->setStatusEffect(status, flag);
+    dstBeing->setStatusEffect(packet.status, flag);
 }
 
 void BeingHandler::processBeingResurrect(Net::MessageIn &msg)
@@ -1635,10 +1622,14 @@ void BeingHandler::processBeingResurrect(Net::MessageIn &msg)
     }
 
     // A being changed mortality status
+    BeingResurrectPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingResurrect")
+        return;
+    }
 
-    const int id = msg.readInt32("being id");
-    msg.readInt16("unused");
-    Being *const dstBeing = actorManager->findBeing(id);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
     {
         BLOCK_END("BeingHandler::processBeingResurrect")
@@ -1662,14 +1653,21 @@ void BeingHandler::processPlayerGuilPartyInfo(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    PlayerGuildPartyInfoPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerGuilPartyInfo")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
     if (dstBeing)
     {
-        dstBeing->setName(msg.readString(24, "char name"));
-        dstBeing->setPartyName(msg.readString(24, "party name"));
-        dstBeing->setGuildName(msg.readString(24, "guild name"));
-        dstBeing->setGuildPos(msg.readString(24, "guild pos"));
+        dstBeing->setName(packet.name.str());
+        dstBeing->setPartyName(packet.partyName.str());
+        dstBeing->setGuildName(packet.guildName.str());
+        dstBeing->setGuildPos(packet.guildPos.str());
         dstBeing->addToCache();
     }
     BLOCK_END("BeingHandler::processPlayerGuilPartyInfo")
@@ -1679,46 +1677,43 @@ void BeingHandler::processBeingRemoveSkil(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ if skill unit was added, here need remove it from actors
-    msg.readInt32("skill unit id");
+    BeingRemoveSkillPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingFakeName(Net::MessageIn &msg)
 {
+    BeingFakeNamePacket packet;
+    if (!packet.decode(msg))
+        return;
+
     const BeingType::BeingType type = static_cast<BeingType::BeingType>(
-        msg.readUInt8("object type"));
-    const int id = msg.readInt32("npc id");
-    msg.skip(8, "unused");
-    const uint16_t job = msg.readInt16("class?");  // 111
-    msg.skip(30, "unused");
-    uint16_t x, y;
-    uint8_t dir;
-    msg.readCoordinates(x, y, dir, "position");
-    msg.readUInt8("sx");
-    msg.readUInt8("sy");
-    msg.skip(4, "unsued");
-
-    Being *const dstBeing = createBeing2(msg, id, job, type);
+        packet.objectType);
+    const uint16_t job = packet.job;  // 111
+
+    Being *const dstBeing = createBeing2(msg, packet.beingId, job, type);
     dstBeing->setSubtype(job, 0);
-    dstBeing->setTileCoords(x, y);
-    dstBeing->setDirection(dir);
+    dstBeing->setTileCoords(packet.position.x, packet.position.y);
+    dstBeing->setDirection(packet.position.direction);
 }
 
 void BeingHandler::processBeingStatUpdate1(Net::MessageIn &msg)
 {
-    const int id = msg.readInt32("account id");
-    const int type = msg.readInt16("type");
-    const int value = msg.readInt32("value");
+    BeingStatUpdate1Packet packet;
+    if (!packet.decode(msg))
+        return;
 
-    Being *const dstBeing = actorManager->findBeing(id);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
         return;
 
-    if (type != Ea::MANNER)
+    if (packet.type != Ea::MANNER)
     {
         UNIMPLIMENTEDPACKET;
         return;
     }
-    dstBeing->setManner(value);
+    dstBeing->setManner(packet.value);
 }
 
 void BeingHandler::processBeingSelfEffect(Net::MessageIn &msg)
@@ -1730,41 +1725,45 @@ void BeingHandler::processBeingSelfEffect(Net::MessageIn &msg)
         return;
     }
 
-    const int id = static_cast<uint32_t>(msg.readInt32("being id"));
-    Being *const being = actorManager->findBeing(id);
+    BeingSelfEffectPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingSelfEffect")
+        return;
+    }
+
+    Being *const being = actorManager->findBeing(packet.beingId);
     if (!being)
     {
         BLOCK_END("BeingHandler::processBeingSelfEffect")
         return;
     }
 
-    const int effectType = msg.readInt32("effect type");
     if (Particle::enabled)
-        effectManager->trigger(effectType, being);
+        effectManager->trigger(packet.effectType, being);
 
     BLOCK_END("BeingHandler::processBeingSelfEffect")
 }
 
 void BeingHandler::processMobInfo(Net::MessageIn &msg)
 {
-    const int len = msg.readInt16("len");
-    if (len < 12)
+    MobInfoPacket packet;
+    if (!packet.decode(msg))
         return;
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("monster id"));
-    const int attackRange = msg.readInt32("range");
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
-        dstBeing->setAttackRange(attackRange);
+        dstBeing->setAttackRange(packet.range);
 }
 
 void BeingHandler::processBeingAttrs(Net::MessageIn &msg)
 {
-    const int len = msg.readInt16("len");
-    if (len < 12)
+    BeingAttrsPacket packet;
+    if (!packet.decode(msg))
         return;
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("player id"));
-    const int gmLevel = msg.readInt32("gm level");
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
+    const int gmLevel = packet.gmLevel;
     if (dstBeing && gmLevel)
     {
         if (dstBeing == localPlayer)
@@ -1783,161 +1782,128 @@ void BeingHandler::processBeingAttrs(Net::MessageIn &msg)
 void BeingHandler::processMonsterInfo(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt16("class");
-    msg.readInt16("level");
-    msg.readInt16("size");
-    msg.readInt32("hp");
-    msg.readInt16("def");
-    msg.readInt16("race");
-    msg.readInt16("mdef");
-    msg.readInt16("ele");
+    MonsterInfoPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processClassChange(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
-    msg.readUInt8("type");
-    msg.readInt32("class");
+    ClassChangePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processSpiritBalls(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
-    msg.readInt16("spirits amount");
+    SpiritBallsPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processSpiritBallSingle(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
-    msg.readInt16("spirits amount");
+    SpiritBallsPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBladeStop(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("src being id");
-    msg.readInt32("dst being id");
-    msg.readInt32("flag");
+    BladeStopPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processComboDelay(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
-    msg.readInt32("wait");
+    ComboDelayPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processWddingEffect(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
+    WeddingEffectPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingSlide(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("being id");
-    msg.readInt16("x");
-    msg.readInt16("y");
+    BeingSlidePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processStarsKill(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readString(24, "map name");
-    msg.readInt32("monster id");
-    msg.readUInt8("start");
-    msg.readUInt8("result");
+    StarsKillPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processGladiatorFeelRequest(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readUInt8("which");
+    GladiatorFeelRequestPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBossMapInfo(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readUInt8("info type");
-    msg.readInt32("x");
-    msg.readInt32("y");
-    msg.readInt16("min hours");
-    msg.readInt16("min minutes");
-    msg.readInt16("max hours");
-    msg.readInt16("max minutes");
-    msg.readString(24, "monster name");  // really can be used 51 byte?
+    BossMapInfoPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingFont(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("account id");
-    msg.readInt16("font");
+    BeingFontPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingMilleniumShield(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("account id");
-    msg.readInt16("shields");
-    msg.readInt16("unused");
+    BeingMilleniumShieldPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingCharm(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-
-    msg.readInt32("account id");
-    msg.readInt16("charm type");
-    msg.readInt16("charm count");
+    BeingCharmPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingViewEquipment(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
 
-    const int count = (msg.readInt16("len") - 45) / 31;
-    msg.readString(24, "name");
-    msg.readInt16("job");
-    msg.readInt16("head");
-    msg.readInt16("accessory");
-    msg.readInt16("accessory2");
-    msg.readInt16("accessory3");
-    msg.readInt16("robe");
-    msg.readInt16("hair color");
-    msg.readInt16("body color");
-    msg.readUInt8("gender");
+    BeingViewEquipmentPacket packet;
+    if (!packet.decode(msg))
+        return;
+    const int count = (packet.len - 45) / 31;
     for (int f = 0; f < count; f ++)
     {
-        msg.readInt16("index");
-        msg.readInt16("item id");
-        msg.readUInt8("item type");
-        msg.readInt32("location");
-        msg.readInt32("wear state");
-        msg.readInt8("refine");
-        for (int d = 0; d < 4; d ++)
-            msg.readInt16("card");
-        msg.readInt32("hire expire date (?)");
-        msg.readInt16("equip type");
-        msg.readInt16("item sprite number");
-        msg.readUInt8("flags");
+        ViewEquipmentItemBlock item;
+        if (!item.decode(msg))
+            return;
     }
 }
 
@@ -66,6 +66,8 @@ class BeingHandler final : public MessageHandler, public Ea::BeingHandler
 
         static void processSkillCasting(Net::MessageIn &msg);
 
+        static void processSkillCastCancel(Net::MessageIn &msg);
+
         static void processBeingStatusChange(Net::MessageIn &msg);
 
         static void processBeingStatusChange2(Net::MessageIn &msg);
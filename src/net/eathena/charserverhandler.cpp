@@ -265,7 +265,7 @@ void CharServerHandler::readPlayerData(Net::MessageIn &msg,
 
     character->slot = msg.readInt16("character slot id");
     msg.readInt16("rename");
-    msg.readString(16, "map name");
+    msg.readStringView(16, "map name");
     msg.readInt32("delete date");
     const int shoes = msg.readInt32("robe");
     tempPlayer->setSprite(SPRITE_HAIR, shoes);
@@ -742,7 +742,7 @@ void CharServerHandler::processCharBanCharList(Net::MessageIn &msg)
     for (int f = 0; f < count; f ++)
     {
         msg.readInt32("char id");
-        msg.readString(20, "unbun time");
+        msg.readStringView(20, "unbun time");
     }
 }
 
@@ -653,7 +653,7 @@ void ChatHandler::processChatIgnoreList(Net::MessageIn &msg)
     // +++ need put it in some object or window
     const int count = (msg.readInt16("len") - 4) / 24;
     for (int f = 0; f < count; f ++)
-        msg.readString(24, "nick");
+        msg.readStringView(24, "nick");
 }
 
 void ChatHandler::processChatDisplay(Net::MessageIn &msg)
@@ -693,7 +693,7 @@ void ChatHandler::processChatRoomJoinAck(Net::MessageIn &msg)
     for (int f = 0; f < count; f ++)
     {
         msg.readInt32("role");
-        msg.readString(24, "name");
+        msg.readStringView(24, "name");
     }
 
     ChatObject *oldChat = ChatObject::findById(id);
@@ -1075,7 +1075,7 @@ void ChatHandler::processChatTalkieBox(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readInt32("being id");
-    msg.readString(80, "message");
+    msg.readStringView(80, "message");
 }
 
 void ChatHandler::processBattleChatMessage(Net::MessageIn &msg)
@@ -1083,8 +1083,8 @@ void ChatHandler::processBattleChatMessage(Net::MessageIn &msg)
     UNIMPLIMENTEDPACKET;
     const int sz = msg.readInt16("len") - 24 - 8;
     msg.readInt32("account id");
-    msg.readString(24, "nick");
-    msg.readString(sz, "message");
+    msg.readStringView(24, "nick");
+    msg.readStringView(sz, "message");
 }
 
 void ChatHandler::processScriptMessage(Net::MessageIn &msg)
@@ -1092,7 +1092,7 @@ void ChatHandler::processScriptMessage(Net::MessageIn &msg)
     UNIMPLIMENTEDPACKET;
     const int sz = msg.readInt16("len") - 8;
     msg.readInt32("being id");
-    msg.readString(sz, "message");
+    msg.readStringView(sz, "message");
 }
 
 void ChatHandler::leaveChatRoom() const
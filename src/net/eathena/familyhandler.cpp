@@ -94,13 +94,13 @@ void FamilyHandler::processAskForChild(Net::MessageIn &msg)
     UNIMPLIMENTEDPACKET;
     msg.readInt32("account id who ask");
     msg.readInt32("acoount id for other parent");
-    msg.readString(24, "name who ask");
+    msg.readStringView(24, "name who ask");
 }
 
 void FamilyHandler::processCallPartner(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void FamilyHandler::askForChildReply(const bool accept)
@@ -114,7 +114,7 @@ void FamilyHandler::askForChildReply(const bool accept)
 void FamilyHandler::processDivorced(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void FamilyHandler::processAskForChildReply(Net::MessageIn &msg)
@@ -93,7 +93,7 @@ void FriendsHandler::processFriendsList(Net::MessageIn &msg)
     {
         msg.readInt32("account id");
         msg.readInt32("char id");
-        msg.readString(24, "name");
+        msg.readStringView(24, "name");
     }
 }
 
@@ -103,7 +103,7 @@ void FriendsHandler::processRequestAck(Net::MessageIn &msg)
     msg.readInt16("type");
     msg.readInt32("account id");
     msg.readInt32("char id");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void FriendsHandler::processRequest(Net::MessageIn &msg)
@@ -111,7 +111,7 @@ void FriendsHandler::processRequest(Net::MessageIn &msg)
     UNIMPLIMENTEDPACKET;
     msg.readInt32("account id");
     msg.readInt32("char id");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
 }
 
 void FriendsHandler::invite(const std::string &name) const
@@ -274,7 +274,7 @@ void GeneralHandler::processConnectionProblem(Net::MessageIn &msg)
 void GeneralHandler::processMapNotFound(Net::MessageIn &msg)
 {
     const int sz = msg.readInt16("len") - 4;
-    msg.readString(sz, "map name?");
+    msg.readStringView(sz, "map name?");
     errorMessage = _("Map not found");
     client->setState(STATE_ERROR);
 }
@@ -422,7 +422,7 @@ void GuildHandler::processGuildMemberLogin(Net::MessageIn &msg)
 void GuildHandler::processGuildExpulsion(Net::MessageIn &msg)
 {
     const std::string nick = msg.readString(24, "name");
-    msg.readString(40, "message");
+    msg.readStringView(40, "message");
 
     processGuildExpulsionContinue(nick);
 }
@@ -437,8 +437,8 @@ void GuildHandler::processGuildExpulsionList(Net::MessageIn &msg)
 
     for (int i = 0; i < count; i++)
     {
-        msg.readString(24, "name");
-        msg.readString(40, "message");
+        msg.readStringView(24, "name");
+        msg.readStringView(40, "message");
     }
 }
 
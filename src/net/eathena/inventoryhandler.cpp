@@ -614,7 +614,7 @@ void InventoryHandler::processPlayerStorage(Net::MessageIn &msg)
     mInventoryItems.clear();
 
     msg.readInt16("len");
-    msg.readString(24, "storage name");
+    msg.readStringView(24, "storage name");
 
     const int number = (msg.getLength() - 4 - 24) / 24;
 
@@ -714,7 +714,7 @@ void InventoryHandler::processPlayerStorageEquip(Net::MessageIn &msg)
     msg.readInt16("len");
     const int number = (msg.getLength() - 4 - 24) / 31;
 
-    msg.readString(24, "storage name");
+    msg.readStringView(24, "storage name");
     for (int loop = 0; loop < number; loop++)
     {
         const int index = msg.readInt16("index") - STORAGE_OFFSET;
@@ -106,7 +106,7 @@ void ItemHandler::processGraffiti(Net::MessageIn &msg)
     msg.readUInt8("job");
     msg.readUInt8("visible");
     msg.readUInt8("is content");
-    msg.readString(80, "text");
+    msg.readStringView(80, "text");
 }
 
 void ItemHandler::processItemMvpDropped(Net::MessageIn &msg)
@@ -116,9 +116,9 @@ void ItemHandler::processItemMvpDropped(Net::MessageIn &msg)
     msg.readUInt8("type");
     msg.readInt16("item id");
     msg.readUInt8("len");
-    msg.readString(24, "name");
+    msg.readStringView(24, "name");
     msg.readUInt8("monster name len");
-    msg.readString(24, "monster name");
+    msg.readStringView(24, "monster name");
 }
 
 }  // namespace EAthena
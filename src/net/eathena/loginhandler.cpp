@@ -176,7 +176,7 @@ ServerInfo *LoginHandler::getCharServer() const
 void LoginHandler::processLoginError2(Net::MessageIn &msg)
 {
     const uint32_t code = msg.readInt32("error");
-    msg.readString(20, "error message");
+    msg.readStringView(20, "error message");
     logger->log("Login::error code: %u", code);
 
     switch (code)
@@ -281,7 +281,7 @@ void LoginHandler::processCondingKey(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     const int sz = msg.readInt16("len") - 4;
-    msg.readString(sz, "coding key");
+    msg.readStringView(sz, "coding key");
 }
 
 int LoginHandler::supportedOptionalActions() const
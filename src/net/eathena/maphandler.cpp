@@ -74,7 +74,7 @@ void MapHandler::handleMessage(Net::MessageIn &msg)
 void MapHandler::processInstanceStart(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(61, "instance name");
+    msg.readStringView(61, "instance name");
     msg.readInt16("flag");
 }
 
@@ -87,7 +87,7 @@ void MapHandler::processInstanceCreate(Net::MessageIn &msg)
 void MapHandler::processInstanceInfo(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readString(61, "instance name");
+    msg.readStringView(61, "instance name");
     msg.readInt32("remaining time");
     msg.readInt32("no players close time");
 }
@@ -24,6 +24,7 @@
 #define NET_EATHENA_NETWORK_H
 
 #include "net/ea/network.h"
+#include "net/ea/packetcoalescer.h"
 
 /**
  * Protocol version, reported to the eAthena char and mapserver who can adjust
@@ -54,13 +55,26 @@ class Network final : public Ea::Network
 
         void dispatchMessages();
 
+        /**
+         * Writes lengths of packets with schemas into packet lengths.
+         * Returns false if some length was different before.
+         */
+        static bool applyPacketSchemas() A_WARN_UNUSED;
+
     protected:
         friend class MessageOut;
 
         static Network *instance() A_WARN_UNUSED;
 
+        int getPacketLength(const unsigned int msgId,
+                            const unsigned int pos) const A_WARN_UNUSED;
+
+        void coalescePackets();
+
         MessageHandler **mMessageHandlers;
 
+        Ea::PacketCoalescer mCoalescer;
+
         static Network *mInstance;
 };
 
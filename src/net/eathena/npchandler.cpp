@@ -336,7 +336,7 @@ void NpcHandler::processNpcCutin(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     mRequestLang = false;
-    msg.readString(64, "image name");
+    msg.readStringView(64, "image name");
     msg.readUInt8("type");
 }
 
@@ -35,6 +35,7 @@ namespace EAthena
 /** Warning: buffers and other variables are shared,
     so there can be only one connection active at a time */
 
+// lengths of packets with schemas overwritten from schemas on network start
 int16_t packet_lengths[] =
 {
 //0    1    2    3    4    5    6    7    8    9    a    b    c    d    e    f
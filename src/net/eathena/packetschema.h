@@ -0,0 +1,692 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_EATHENA_PACKETSCHEMA_H
+#define NET_EATHENA_PACKETSCHEMA_H
+
+#include "net/ea/packetschema.h"
+
+#include "net/eathena/protocol.h"
+
+namespace EAthena
+{
+
+// SMSG_BEING_MOVE2
+#define BEING_MOVE2_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::CoordinatePair, path) \
+    F(Net::Skip<1>, unused) \
+    F(int32_t, tick)
+PACKET_SCHEMA(BeingMove2Packet, BEING_MOVE2_FIELDS)
+
+// SMSG_BEING_CHANGE_DIRECTION
+#define BEING_CHANGE_DIRECTION_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, headDirection) \
+    F(uint8_t, direction)
+PACKET_SCHEMA(BeingChangeDirectionPacket, BEING_CHANGE_DIRECTION_FIELDS)
+
+// SMSG_BEING_STATUS_CHANGE
+#define BEING_STATUS_CHANGE_FIELDS(F) \
+    F(uint16_t, status) \
+    F(int32_t, beingId) \
+    F(uint8_t, flag) \
+    F(int32_t, total) \
+    F(int32_t, left) \
+    F(int32_t, val1) \
+    F(int32_t, val2) \
+    F(int32_t, val3)
+PACKET_SCHEMA(BeingStatusChangePacket, BEING_STATUS_CHANGE_FIELDS)
+
+// SMSG_BEING_STATUS_CHANGE2
+#define BEING_STATUS_CHANGE2_FIELDS(F) \
+    F(uint16_t, status) \
+    F(int32_t, beingId) \
+    F(uint8_t, flag) \
+    F(int32_t, left) \
+    F(int32_t, val1) \
+    F(int32_t, val2) \
+    F(int32_t, val3)
+PACKET_SCHEMA(BeingStatusChange2Packet, BEING_STATUS_CHANGE2_FIELDS)
+
+// SMSG_PLAYER_STATUS_CHANGE
+#define PLAYER_STATUS_CHANGE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint16_t, stunMode) \
+    F(int16_t, statusEffects) \
+    F(uint32_t, option) \
+    F(uint8_t, karma)
+PACKET_SCHEMA(PlayerStatusChangePacket, PLAYER_STATUS_CHANGE_FIELDS)
+
+// SMSG_PLAYER_STATUS_CHANGE2
+#define PLAYER_STATUS_CHANGE2_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint32_t, statusEffects) \
+    F(int32_t, level) \
+    F(int32_t, showEfst)
+PACKET_SCHEMA(PlayerStatusChange2Packet, PLAYER_STATUS_CHANGE2_FIELDS)
+
+// SMSG_PLAYER_STATUS_CHANGE_NO_TICK
+#define PLAYER_STATUS_CHANGE_NO_TICK_FIELDS(F) \
+    F(uint16_t, status) \
+    F(int32_t, beingId) \
+    F(uint8_t, flag)
+PACKET_SCHEMA(PlayerStatusChangeNoTickPacket,
+    PLAYER_STATUS_CHANGE_NO_TICK_FIELDS)
+
+// SMSG_BEING_CHANGE_LOOKS2
+#define BEING_CHANGE_LOOKS2_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, type) \
+    F(int16_t, id1) \
+    F(int16_t, id2)
+PACKET_SCHEMA(BeingChangeLooks2Packet, BEING_CHANGE_LOOKS2_FIELDS)
+
+// Common head of being visible, move and spawn packets
+#define BEING_HEAD_FIELDS(F) \
+    F(int16_t, len) \
+    F(uint8_t, objectType) \
+    F(int32_t, beingId) \
+    F(int16_t, speed) \
+    F(uint16_t, stunMode) \
+    F(int16_t, statusEffects) \
+    F(int32_t, option) \
+    F(int16_t, job) \
+    F(int16_t, hairStyle) \
+    F(int32_t, weapon) \
+    F(uint16_t, headBottom)
+
+// Being looks after head
+#define BEING_LOOKS_FIELDS(F) \
+    F(uint16_t, headTop) \
+    F(uint16_t, headMid) \
+    F(int16_t, hairColor) \
+    F(uint16_t, shoes) \
+    F(uint16_t, gloves) \
+    F(int16_t, robe) \
+    F(int32_t, guild) \
+    F(int16_t, emblem) \
+    F(int16_t, manner) \
+    F(int32_t, opt3) \
+    F(uint8_t, karma) \
+    F(uint8_t, gender)
+
+// Common tail of being visible, move and spawn packets
+#define BEING_TAIL_FIELDS(F) \
+    F(int16_t, level) \
+    F(int16_t, font) \
+    F(int32_t, maxHP) \
+    F(int32_t, hp) \
+    F(int8_t, isBoss)
+
+// SMSG_BEING_VISIBLE
+#define BEING_VISIBLE_FIELDS(F) \
+    BEING_HEAD_FIELDS(F) \
+    BEING_LOOKS_FIELDS(F) \
+    F(Net::Coordinates, position) \
+    F(int8_t, xs) \
+    F(int8_t, ys) \
+    F(uint8_t, actionType) \
+    BEING_TAIL_FIELDS(F)
+PACKET_VAR_SCHEMA(BeingVisiblePacket, BEING_VISIBLE_FIELDS)
+
+// SMSG_BEING_MOVE
+#define BEING_MOVE_FIELDS(F) \
+    BEING_HEAD_FIELDS(F) \
+    F(int32_t, tick) \
+    BEING_LOOKS_FIELDS(F) \
+    F(Net::CoordinatePair, path) \
+    F(uint8_t, subPosition) \
+    F(int8_t, xs) \
+    F(int8_t, ys) \
+    BEING_TAIL_FIELDS(F)
+PACKET_VAR_SCHEMA(BeingMovePacket, BEING_MOVE_FIELDS)
+
+// SMSG_BEING_SPAWN
+#define BEING_SPAWN_FIELDS(F) \
+    BEING_HEAD_FIELDS(F) \
+    BEING_LOOKS_FIELDS(F) \
+    F(Net::Coordinates, position) \
+    F(int8_t, xs) \
+    F(int8_t, ys) \
+    BEING_TAIL_FIELDS(F)
+PACKET_VAR_SCHEMA(BeingSpawnPacket, BEING_SPAWN_FIELDS)
+
+// SMSG_MAP_TYPE_PROPERTY2
+#define MAP_TYPE_PROPERTY2_FIELDS(F) \
+    F(int16_t, type) \
+    F(int32_t, flags)
+PACKET_SCHEMA(MapTypeProperty2Packet, MAP_TYPE_PROPERTY2_FIELDS)
+
+// SMSG_MAP_TYPE
+#define MAP_TYPE_FIELDS(F) \
+    F(int16_t, type)
+PACKET_SCHEMA(MapTypePacket, MAP_TYPE_FIELDS)
+
+// SMSG_SKILL_CASTING
+#define SKILL_CASTING_FIELDS(F) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int16_t, dstX) \
+    F(int16_t, dstY) \
+    F(int16_t, skillId) \
+    F(int32_t, property) \
+    F(int32_t, castTime) \
+    F(int8_t, dispossable)
+PACKET_SCHEMA(SkillCastingPacket, SKILL_CASTING_FIELDS)
+
+// SMSG_SKILL_CAST_CANCEL
+#define SKILL_CAST_CANCEL_FIELDS(F) \
+    F(int32_t, beingId)
+PACKET_SCHEMA(SkillCastCancelPacket, SKILL_CAST_CANCEL_FIELDS)
+
+// SMSG_BEING_ACTION2
+#define BEING_ACTION2_FIELDS(F) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int32_t, tick) \
+    F(int32_t, srcSpeed) \
+    F(int32_t, dstSpeed) \
+    F(int32_t, damage) \
+    F(int16_t, count) \
+    F(uint8_t, type) \
+    F(int32_t, leftDamage)
+PACKET_SCHEMA(BeingAction2Packet, BEING_ACTION2_FIELDS)
+
+// SMSG_MONSTER_HP, SMSG_PLAYER_HP
+#define MONSTER_HP_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, hp) \
+    F(int32_t, maxHP)
+PACKET_SCHEMA(MonsterHpPacket, MONSTER_HP_FIELDS)
+
+// SMSG_SKILL_AUTO_CAST
+#define SKILL_AUTO_CAST_FIELDS(F) \
+    F(int16_t, skillId) \
+    F(int16_t, inf) \
+    F(Net::Skip<2>, unused1) \
+    F(int16_t, level) \
+    F(int16_t, sp) \
+    F(int16_t, range) \
+    F(Net::String<24>, name) \
+    F(Net::Skip<1>, unused2)
+PACKET_SCHEMA(SkillAutoCastPacket, SKILL_AUTO_CAST_FIELDS)
+
+typedef Net::Array<Net::String<24>, 10> RankNamesArray;
+typedef Net::Array<int32_t, 10> RankPointsArray;
+
+// SMSG_RANKS_LIST
+#define RANKS_LIST_FIELDS(F) \
+    F(int16_t, rankType) \
+    F(RankNamesArray, names) \
+    F(RankPointsArray, points) \
+    F(int32_t, myPoints)
+PACKET_SCHEMA(RanksListPacket, RANKS_LIST_FIELDS)
+
+// SMSG_BLACKSMITH_RANKS_LIST, SMSG_ALCHEMIST_RANKS_LIST,
+// SMSG_TAEKWON_RANKS_LIST, SMSG_PK_RANKS_LIST
+#define CLASS_RANKS_LIST_FIELDS(F) \
+    F(RankNamesArray, names) \
+    F(RankPointsArray, points)
+PACKET_SCHEMA(ClassRanksListPacket, CLASS_RANKS_LIST_FIELDS)
+
+// SMSG_BEING_SPECIAL_EFFECT
+#define BEING_SPECIAL_EFFECT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, effectType)
+PACKET_SCHEMA(BeingSpecialEffectPacket, BEING_SPECIAL_EFFECT_FIELDS)
+
+// SMSG_BEING_SPECIAL_EFFECT_NUM
+#define BEING_SPECIAL_EFFECT_NUM_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, effectType) \
+    F(int32_t, num)
+PACKET_SCHEMA(BeingSpecialEffectNumPacket, BEING_SPECIAL_EFFECT_NUM_FIELDS)
+
+// SMSG_BEING_SOUND_EFFECT
+#define BEING_SOUND_EFFECT_FIELDS(F) \
+    F(Net::String<24>, name) \
+    F(uint8_t, type) \
+    F(Net::Skip<4>, unused) \
+    F(int32_t, srcId)
+PACKET_SCHEMA(BeingSoundEffectPacket, BEING_SOUND_EFFECT_FIELDS)
+
+// SMSG_SKILL_GROUND_NO_DAMAGE
+#define SKILL_GROUND_NO_DAMAGE_FIELDS(F) \
+    F(int16_t, skillId) \
+    F(int32_t, srcId) \
+    F(int16_t, val) \
+    F(int16_t, x) \
+    F(int16_t, y) \
+    F(int32_t, tick)
+PACKET_SCHEMA(SkillGroundNoDamagePacket, SKILL_GROUND_NO_DAMAGE_FIELDS)
+
+// SMSG_SKILL_ENTRY
+#define SKILL_ENTRY_FIELDS(F) \
+    F(int16_t, len) \
+    F(int32_t, unitId) \
+    F(int32_t, creatorId) \
+    F(int16_t, x) \
+    F(int16_t, y) \
+    F(int32_t, job) \
+    F(uint8_t, radius) \
+    F(uint8_t, visible) \
+    F(uint8_t, level)
+PACKET_VAR_SCHEMA(SkillEntryPacket, SKILL_ENTRY_FIELDS)
+
+// SMSG_BEING_RESURRECT
+#define BEING_RESURRECT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::Skip<2>, unused)
+PACKET_SCHEMA(BeingResurrectPacket, BEING_RESURRECT_FIELDS)
+
+// SMSG_PLAYER_GUILD_PARTY_INFO
+#define PLAYER_GUILD_PARTY_INFO_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::String<24>, name) \
+    F(Net::String<24>, partyName) \
+    F(Net::String<24>, guildName) \
+    F(Net::String<24>, guildPos)
+PACKET_SCHEMA(PlayerGuildPartyInfoPacket, PLAYER_GUILD_PARTY_INFO_FIELDS)
+
+// SMSG_BEING_REMOVE_SKILL
+#define BEING_REMOVE_SKILL_FIELDS(F) \
+    F(int32_t, unitId)
+PACKET_SCHEMA(BeingRemoveSkillPacket, BEING_REMOVE_SKILL_FIELDS)
+
+// SMSG_BEING_FAKE_NAME
+#define BEING_FAKE_NAME_FIELDS(F) \
+    F(uint8_t, objectType) \
+    F(int32_t, beingId) \
+    F(Net::Skip<8>, unused1) \
+    F(uint16_t, job) \
+    F(Net::Skip<30>, unused2) \
+    F(Net::Coordinates, position) \
+    F(uint8_t, sx) \
+    F(uint8_t, sy) \
+    F(Net::Skip<3>, unused3)
+PACKET_SCHEMA(BeingFakeNamePacket, BEING_FAKE_NAME_FIELDS)
+
+// SMSG_BEING_STAT_UPDATE_1
+#define BEING_STAT_UPDATE1_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, type) \
+    F(int32_t, value)
+PACKET_SCHEMA(BeingStatUpdate1Packet, BEING_STAT_UPDATE1_FIELDS)
+
+// SMSG_BEING_SELFEFFECT
+#define BEING_SELFEFFECT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, effectType)
+PACKET_SCHEMA(BeingSelfEffectPacket, BEING_SELFEFFECT_FIELDS)
+
+// SMSG_MOB_INFO
+#define MOB_INFO_FIELDS(F) \
+    F(int16_t, len) \
+    F(int32_t, beingId) \
+    F(int32_t, range)
+PACKET_VAR_SCHEMA(MobInfoPacket, MOB_INFO_FIELDS)
+
+// SMSG_BEING_ATTRS
+#define BEING_ATTRS_FIELDS(F) \
+    F(int16_t, len) \
+    F(int32_t, beingId) \
+    F(int32_t, gmLevel)
+PACKET_VAR_SCHEMA(BeingAttrsPacket, BEING_ATTRS_FIELDS)
+
+// SMSG_MONSTER_INFO
+#define MONSTER_INFO_FIELDS(F) \
+    F(int16_t, job) \
+    F(int16_t, level) \
+    F(int16_t, sizeType) \
+    F(int32_t, hp) \
+    F(int16_t, def) \
+    F(int16_t, race) \
+    F(int16_t, mdef) \
+    F(int16_t, element) \
+    F(Net::Skip<9>, resists)
+PACKET_SCHEMA(MonsterInfoPacket, MONSTER_INFO_FIELDS)
+
+// SMSG_CLASS_CHANGE
+#define CLASS_CHANGE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, type) \
+    F(int32_t, job)
+PACKET_SCHEMA(ClassChangePacket, CLASS_CHANGE_FIELDS)
+
+// SMSG_SPIRIT_BALLS, SMSG_SPIRIT_BALL_SINGLE
+#define SPIRIT_BALLS_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, amount)
+PACKET_SCHEMA(SpiritBallsPacket, SPIRIT_BALLS_FIELDS)
+
+// SMSG_BLADE_STOP
+#define BLADE_STOP_FIELDS(F) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int32_t, flag)
+PACKET_SCHEMA(BladeStopPacket, BLADE_STOP_FIELDS)
+
+// SMSG_COMBO_DELAY
+#define COMBO_DELAY_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, wait)
+PACKET_SCHEMA(ComboDelayPacket, COMBO_DELAY_FIELDS)
+
+// SMSG_WEDDING_EFFECT
+#define WEDDING_EFFECT_FIELDS(F) \
+    F(int32_t, beingId)
+PACKET_SCHEMA(WeddingEffectPacket, WEDDING_EFFECT_FIELDS)
+
+// SMSG_BEING_SLIDE
+#define BEING_SLIDE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, x) \
+    F(int16_t, y)
+PACKET_SCHEMA(BeingSlidePacket, BEING_SLIDE_FIELDS)
+
+// SMSG_STARS_KILL
+#define STARS_KILL_FIELDS(F) \
+    F(Net::String<24>, mapName) \
+    F(int32_t, monsterId) \
+    F(uint8_t, start) \
+    F(uint8_t, result)
+PACKET_SCHEMA(StarsKillPacket, STARS_KILL_FIELDS)
+
+// SMSG_GLADIATOR_FEEL_REQUEST
+#define GLADIATOR_FEEL_REQUEST_FIELDS(F) \
+    F(uint8_t, which)
+PACKET_SCHEMA(GladiatorFeelRequestPacket, GLADIATOR_FEEL_REQUEST_FIELDS)
+
+// SMSG_BOSS_MAP_INFO
+#define BOSS_MAP_INFO_FIELDS(F) \
+    F(uint8_t, infoType) \
+    F(int32_t, x) \
+    F(int32_t, y) \
+    F(int16_t, minHours) \
+    F(int16_t, minMinutes) \
+    F(int16_t, maxHours) \
+    F(int16_t, maxMinutes) \
+    F(Net::String<51>, monsterName)
+PACKET_SCHEMA(BossMapInfoPacket, BOSS_MAP_INFO_FIELDS)
+
+// SMSG_BEING_FONT
+#define BEING_FONT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, font)
+PACKET_SCHEMA(BeingFontPacket, BEING_FONT_FIELDS)
+
+// SMSG_BEING_MILLENIUM_SHIELD
+#define BEING_MILLENIUM_SHIELD_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, shields) \
+    F(Net::Skip<2>, unused)
+PACKET_SCHEMA(BeingMilleniumShieldPacket, BEING_MILLENIUM_SHIELD_FIELDS)
+
+// SMSG_BEING_CHARM
+#define BEING_CHARM_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, charmType) \
+    F(int16_t, charmCount)
+PACKET_SCHEMA(BeingCharmPacket, BEING_CHARM_FIELDS)
+
+// SMSG_BEING_VIEW_EQUIPMENT, equipment records up to end of packet
+#define BEING_VIEW_EQUIPMENT_FIELDS(F) \
+    F(int16_t, len) \
+    F(Net::String<24>, name) \
+    F(int16_t, job) \
+    F(int16_t, head) \
+    F(int16_t, accessory) \
+    F(int16_t, accessory2) \
+    F(int16_t, accessory3) \
+    F(int16_t, robe) \
+    F(int16_t, hairColor) \
+    F(int16_t, bodyColor) \
+    F(uint8_t, gender)
+PACKET_VAR_SCHEMA(BeingViewEquipmentPacket, BEING_VIEW_EQUIPMENT_FIELDS)
+
+typedef Net::Array<int16_t, 4> ItemCardsArray;
+
+// One item in SMSG_BEING_VIEW_EQUIPMENT
+#define VIEW_EQUIPMENT_ITEM_FIELDS(F) \
+    F(int16_t, index) \
+    F(int16_t, itemId) \
+    F(uint8_t, itemType) \
+    F(int32_t, location) \
+    F(int32_t, wearState) \
+    F(int8_t, refine) \
+    F(ItemCardsArray, cards) \
+    F(int32_t, hireExpireDate) \
+    F(int16_t, equipType) \
+    F(int16_t, sprite) \
+    F(uint8_t, flags)
+PACKET_BLOCK(ViewEquipmentItemBlock, VIEW_EQUIPMENT_ITEM_FIELDS)
+
+// One shortcut in SMSG_PLAYER_SHORTCUTS
+#define PLAYER_SHORTCUT_FIELDS(F) \
+    F(uint8_t, type) \
+    F(int32_t, id) \
+    F(int16_t, level)
+PACKET_BLOCK(PlayerShortcutBlock, PLAYER_SHORTCUT_FIELDS)
+
+typedef Net::Array<PlayerShortcutBlock, 27> PlayerShortcutsArray;
+
+// SMSG_PLAYER_SHORTCUTS
+#define PLAYER_SHORTCUTS_FIELDS(F) \
+    F(uint8_t, unused1) \
+    F(PlayerShortcutsArray, shortcuts) \
+    F(Net::Skip<77>, unused2)
+PACKET_SCHEMA(PlayerShortcutsPacket, PLAYER_SHORTCUTS_FIELDS)
+
+// SMSG_PLAYER_SHOW_EQUIP
+#define PLAYER_SHOW_EQUIP_FIELDS(F) \
+    F(uint8_t, showEquip)
+PACKET_SCHEMA(PlayerShowEquipPacket, PLAYER_SHOW_EQUIP_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_5
+#define PLAYER_STAT_UPDATE5_FIELDS(F) \
+    F(int16_t, charPoints) \
+    F(uint8_t, strBase) \
+    F(uint8_t, strCost) \
+    F(uint8_t, agiBase) \
+    F(uint8_t, agiCost) \
+    F(uint8_t, vitBase) \
+    F(uint8_t, vitCost) \
+    F(uint8_t, intBase) \
+    F(uint8_t, intCost) \
+    F(uint8_t, dexBase) \
+    F(uint8_t, dexCost) \
+    F(uint8_t, lukBase) \
+    F(uint8_t, lukCost) \
+    F(int16_t, atk) \
+    F(int16_t, atkMod) \
+    F(int16_t, matk) \
+    F(int16_t, matkMod) \
+    F(int16_t, def) \
+    F(int16_t, defMod) \
+    F(int16_t, mdef) \
+    F(int16_t, mdefMod) \
+    F(int16_t, hit) \
+    F(int16_t, flee) \
+    F(int16_t, fleeMod) \
+    F(int16_t, crit) \
+    F(int16_t, attackSpeed) \
+    F(int16_t, plusSpeed)
+PACKET_SCHEMA(PlayerStatUpdate5Packet, PLAYER_STAT_UPDATE5_FIELDS)
+
+// SMSG_PLAYER_GET_EXP
+#define PLAYER_GET_EXP_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, exp) \
+    F(int16_t, type) \
+    F(int16_t, fromQuest)
+PACKET_SCHEMA(PlayerGetExpPacket, PLAYER_GET_EXP_FIELDS)
+
+// SMSG_WALK_RESPONSE
+#define WALK_RESPONSE_FIELDS(F) \
+    F(int32_t, tick) \
+    F(Net::CoordinatePair, path) \
+    F(uint8_t, subPosition)
+PACKET_SCHEMA(WalkResponsePacket, WALK_RESPONSE_FIELDS)
+
+// SMSG_PVP_INFO
+#define PVP_INFO_FIELDS(F) \
+    F(int32_t, charId) \
+    F(int32_t, accountId) \
+    F(int32_t, won) \
+    F(int32_t, lost) \
+    F(int32_t, points)
+PACKET_SCHEMA(PvpInfoPacket, PVP_INFO_FIELDS)
+
+// SMSG_PLAYER_HEAL
+#define PLAYER_HEAL_FIELDS(F) \
+    F(int16_t, type) \
+    F(int16_t, amount)
+PACKET_SCHEMA(PlayerHealPacket, PLAYER_HEAL_FIELDS)
+
+// SMSG_PLAYER_SKILL_MESSAGE
+#define PLAYER_SKILL_MESSAGE_FIELDS(F) \
+    F(int32_t, type)
+PACKET_SCHEMA(PlayerSkillMessagePacket, PLAYER_SKILL_MESSAGE_FIELDS)
+
+// SMSG_PLAYER_NOTIFY_MAPINFO
+#define PLAYER_NOTIFY_MAPINFO_FIELDS(F) \
+    F(int16_t, type)
+PACKET_SCHEMA(PlayerNotifyMapInfoPacket, PLAYER_NOTIFY_MAPINFO_FIELDS)
+
+// SMSG_PLAYER_FAME_BLACKSMITH, SMSG_PLAYER_FAME_ALCHEMIST,
+// SMSG_PLAYER_FAME_TAEKWON
+#define PLAYER_FAME_FIELDS(F) \
+    F(int32_t, points) \
+    F(int32_t, totalPoints)
+PACKET_SCHEMA(PlayerFamePacket, PLAYER_FAME_FIELDS)
+
+// SMSG_PLAYER_UPGRADE_MESSAGE
+#define PLAYER_UPGRADE_MESSAGE_FIELDS(F) \
+    F(int32_t, result) \
+    F(int16_t, itemId)
+PACKET_SCHEMA(PlayerUpgradeMessagePacket, PLAYER_UPGRADE_MESSAGE_FIELDS)
+
+// SMSG_PLAYER_READ_BOOK
+#define PLAYER_READ_BOOK_FIELDS(F) \
+    F(int32_t, bookId) \
+    F(int32_t, page)
+PACKET_SCHEMA(PlayerReadBookPacket, PLAYER_READ_BOOK_FIELDS)
+
+// SMSG_PLAYER_EQUIP_TICK_ACK
+#define PLAYER_EQUIP_TICK_ACK_FIELDS(F) \
+    F(Net::Skip<4>, unused) \
+    F(int32_t, flag)
+PACKET_SCHEMA(PlayerEquipTickAckPacket, PLAYER_EQUIP_TICK_ACK_FIELDS)
+
+// SMSG_AUTOSHADOW_SPELL_LIST, skill ids up to end of packet
+#define AUTOSHADOW_SPELL_LIST_FIELDS(F) \
+    F(int16_t, len)
+PACKET_VAR_SCHEMA(AutoShadowSpellListPacket, AUTOSHADOW_SPELL_LIST_FIELDS)
+
+// SMSG_PLAYER_RANK_POINTS
+#define PLAYER_RANK_POINTS_FIELDS(F) \
+    F(int16_t, type) \
+    F(int32_t, points) \
+    F(int32_t, fame)
+PACKET_SCHEMA(PlayerRankPointsPacket, PLAYER_RANK_POINTS_FIELDS)
+
+// SMSG_PLAYER_CLIENT_COMMAND, command up to end of packet
+#define PLAYER_CLIENT_COMMAND_FIELDS(F) \
+    F(int16_t, len)
+PACKET_VAR_SCHEMA(PlayerClientCommandPacket, PLAYER_CLIENT_COMMAND_FIELDS)
+
+// all schemas, lengths written into packet lengths on network start
+#define EATHENA_PACKET_SCHEMAS(F) \
+    EA_PACKET_SCHEMAS(F) \
+    F(SMSG_BEING_MOVE2, BeingMove2Packet) \
+    F(SMSG_BEING_CHANGE_DIRECTION, BeingChangeDirectionPacket) \
+    F(SMSG_BEING_STATUS_CHANGE, BeingStatusChangePacket) \
+    F(SMSG_BEING_STATUS_CHANGE2, BeingStatusChange2Packet) \
+    F(SMSG_PLAYER_STATUS_CHANGE, PlayerStatusChangePacket) \
+    F(SMSG_PLAYER_STATUS_CHANGE2, PlayerStatusChange2Packet) \
+    F(SMSG_PLAYER_STATUS_CHANGE_NO_TICK, PlayerStatusChangeNoTickPacket) \
+    F(SMSG_BEING_CHANGE_LOOKS2, BeingChangeLooks2Packet) \
+    F(SMSG_BEING_VISIBLE, BeingVisiblePacket) \
+    F(SMSG_BEING_MOVE, BeingMovePacket) \
+    F(SMSG_BEING_SPAWN, BeingSpawnPacket) \
+    F(SMSG_MAP_TYPE_PROPERTY2, MapTypeProperty2Packet) \
+    F(SMSG_MAP_TYPE, MapTypePacket) \
+    F(SMSG_SKILL_CASTING, SkillCastingPacket) \
+    F(SMSG_SKILL_CAST_CANCEL, SkillCastCancelPacket) \
+    F(SMSG_BEING_ACTION2, BeingAction2Packet) \
+    F(SMSG_MONSTER_HP, MonsterHpPacket) \
+    F(SMSG_PLAYER_HP, MonsterHpPacket) \
+    F(SMSG_SKILL_AUTO_CAST, SkillAutoCastPacket) \
+    F(SMSG_RANKS_LIST, RanksListPacket) \
+    F(SMSG_BLACKSMITH_RANKS_LIST, ClassRanksListPacket) \
+    F(SMSG_ALCHEMIST_RANKS_LIST, ClassRanksListPacket) \
+    F(SMSG_TAEKWON_RANKS_LIST, ClassRanksListPacket) \
+    F(SMSG_PK_RANKS_LIST, ClassRanksListPacket) \
+    F(SMSG_BEING_SPECIAL_EFFECT, BeingSpecialEffectPacket) \
+    F(SMSG_BEING_SPECIAL_EFFECT_NUM, BeingSpecialEffectNumPacket) \
+    F(SMSG_BEING_SOUND_EFFECT, BeingSoundEffectPacket) \
+    F(SMSG_SKILL_GROUND_NO_DAMAGE, SkillGroundNoDamagePacket) \
+    F(SMSG_SKILL_ENTRY, SkillEntryPacket) \
+    F(SMSG_BEING_RESURRECT, BeingResurrectPacket) \
+    F(SMSG_PLAYER_GUILD_PARTY_INFO, PlayerGuildPartyInfoPacket) \
+    F(SMSG_BEING_REMOVE_SKILL, BeingRemoveSkillPacket) \
+    F(SMSG_BEING_FAKE_NAME, BeingFakeNamePacket) \
+    F(SMSG_BEING_STAT_UPDATE_1, BeingStatUpdate1Packet) \
+    F(SMSG_BEING_SELFEFFECT, BeingSelfEffectPacket) \
+    F(SMSG_MOB_INFO, MobInfoPacket) \
+    F(SMSG_BEING_ATTRS, BeingAttrsPacket) \
+    F(SMSG_MONSTER_INFO, MonsterInfoPacket) \
+    F(SMSG_CLASS_CHANGE, ClassChangePacket) \
+    F(SMSG_SPIRIT_BALLS, SpiritBallsPacket) \
+    F(SMSG_SPIRIT_BALL_SINGLE, SpiritBallsPacket) \
+    F(SMSG_BLADE_STOP, BladeStopPacket) \
+    F(SMSG_COMBO_DELAY, ComboDelayPacket) \
+    F(SMSG_WEDDING_EFFECT, WeddingEffectPacket) \
+    F(SMSG_BEING_SLIDE, BeingSlidePacket) \
+    F(SMSG_STARS_KILL, StarsKillPacket) \
+    F(SMSG_GLADIATOR_FEEL_REQUEST, GladiatorFeelRequestPacket) \
+    F(SMSG_BOSS_MAP_INFO, BossMapInfoPacket) \
+    F(SMSG_BEING_FONT, BeingFontPacket) \
+    F(SMSG_BEING_MILLENIUM_SHIELD, BeingMilleniumShieldPacket) \
+    F(SMSG_BEING_CHARM, BeingCharmPacket) \
+    F(SMSG_BEING_VIEW_EQUIPMENT, BeingViewEquipmentPacket) \
+    F(SMSG_PLAYER_SHORTCUTS, PlayerShortcutsPacket) \
+    F(SMSG_PLAYER_SHOW_EQUIP, PlayerShowEquipPacket) \
+    F(SMSG_PLAYER_STAT_UPDATE_5, PlayerStatUpdate5Packet) \
+    F(SMSG_PLAYER_GET_EXP, PlayerGetExpPacket) \
+    F(SMSG_WALK_RESPONSE, WalkResponsePacket) \
+    F(SMSG_PVP_INFO, PvpInfoPacket) \
+    F(SMSG_PLAYER_HEAL, PlayerHealPacket) \
+    F(SMSG_PLAYER_SKILL_MESSAGE, PlayerSkillMessagePacket) \
+    F(SMSG_PLAYER_NOTIFY_MAPINFO, PlayerNotifyMapInfoPacket) \
+    F(SMSG_PLAYER_FAME_BLACKSMITH, PlayerFamePacket) \
+    F(SMSG_PLAYER_FAME_ALCHEMIST, PlayerFamePacket) \
+    F(SMSG_PLAYER_FAME_TAEKWON, PlayerFamePacket) \
+    F(SMSG_PLAYER_UPGRADE_MESSAGE, PlayerUpgradeMessagePacket) \
+    F(SMSG_PLAYER_READ_BOOK, PlayerReadBookPacket) \
+    F(SMSG_PLAYER_EQUIP_TICK_ACK, PlayerEquipTickAckPacket) \
+    F(SMSG_AUTOSHADOW_SPELL_LIST, AutoShadowSpellListPacket) \
+    F(SMSG_PLAYER_RANK_POINTS, PlayerRankPointsPacket) \
+    F(SMSG_PLAYER_CLIENT_COMMAND, PlayerClientCommandPacket)
+
+}  // namespace EAthena
+
+#endif  // NET_EATHENA_PACKETSCHEMA_H
@@ -233,7 +233,7 @@ void PartyHandler::processPartyMemberInfo(Net::MessageIn &msg)
     const int x = msg.readInt16("x");
     const int y = msg.readInt16("y");
     const bool online = msg.readInt8("online") == 0U;
-    msg.readString(24, "party name");
+    msg.readStringView(24, "party name");
     const std::string nick = msg.readString(24, "player name");
     const std::string map = msg.readString(16, "map name");
     msg.readInt8("party.item&1");
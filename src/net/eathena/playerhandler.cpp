@@ -31,6 +31,7 @@
 #include "input/inputmanager.h"
 
 #include "net/eathena/messageout.h"
+#include "net/eathena/packetschema.h"
 #include "net/eathena/protocol.h"
 #include "net/eathena/inventoryhandler.h"
 
@@ -352,130 +353,80 @@ void PlayerHandler::processPlayerShortcuts(Net::MessageIn &msg)
 {
     // +++ player shortcuts ignored. It also disabled on server side.
     // may be in future better use it?
-    msg.readUInt8("unused?");
-    for (int f = 0; f < 27; f ++)
-    {
-        msg.readUInt8("type 0: item, 1: skill");
-        msg.readInt32("item or skill id");
-        msg.readInt16("skill level");
-    }
-    msg.skip(77, "unused");
+    PlayerShortcutsPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerShowEquip(Net::MessageIn &msg)
 {
     // +++ for now server allow only switch this option but not using it.
-    msg.readUInt8("show equip");  // 1 mean need open "equipment" window
+    // show equip 1 mean need open "equipment" window
+    PlayerShowEquipPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerStatUpdate5(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate5")
-    PlayerInfo::setAttribute(Attributes::CHAR_POINTS,
-        msg.readInt16("char points"));
-
-    unsigned int val = msg.readUInt8("str");
-    PlayerInfo::setStatBase(Attributes::STR, val);
-    if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::STR,
-            msg.readUInt8("str cost"));
-    }
-    else
+    PlayerStatUpdate5Packet packet;
+    if (!packet.decode(msg))
     {
-        msg.readUInt8("str need");
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate5")
+        return;
     }
 
-    val = msg.readUInt8("agi");
-    PlayerInfo::setStatBase(Attributes::AGI, val);
+    PlayerInfo::setAttribute(Attributes::CHAR_POINTS, packet.charPoints);
+
+    PlayerInfo::setStatBase(Attributes::STR, packet.strBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::AGI,
-            msg.readUInt8("agi cost"));
-    }
-    else
-    {
-        msg.readUInt8("agi cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::STR, packet.strCost);
 
-    val = msg.readUInt8("vit");
-    PlayerInfo::setStatBase(Attributes::VIT, val);
+    PlayerInfo::setStatBase(Attributes::AGI, packet.agiBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::VIT,
-            msg.readUInt8("vit cost"));
-    }
-    else
-    {
-        msg.readUInt8("vit cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::AGI, packet.agiCost);
 
-    val = msg.readUInt8("int");
-    PlayerInfo::setStatBase(Attributes::INT, val);
+    PlayerInfo::setStatBase(Attributes::VIT, packet.vitBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::INT,
-            msg.readUInt8("int cost"));
-    }
-    else
-    {
-        msg.readUInt8("int cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::VIT, packet.vitCost);
 
-    val = msg.readUInt8("dex");
-    PlayerInfo::setStatBase(Attributes::DEX, val);
+    PlayerInfo::setStatBase(Attributes::INT, packet.intBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::DEX,
-            msg.readUInt8("dex cost"));
-    }
-    else
-    {
-        msg.readUInt8("dex cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::INT, packet.intCost);
 
-    val = msg.readUInt8("luk");
-    PlayerInfo::setStatBase(Attributes::LUK, val);
+    PlayerInfo::setStatBase(Attributes::DEX, packet.dexBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::LUK,
-            msg.readUInt8("luk cost"));
-    }
-    else
-    {
-        msg.readUInt8("luk cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::DEX, packet.dexCost);
+
+    PlayerInfo::setStatBase(Attributes::LUK, packet.lukBase);
+    if (statusWindow)
+        statusWindow->setPointsNeeded(Attributes::LUK, packet.lukCost);
 
-    PlayerInfo::setStatBase(Attributes::ATK,
-        msg.readInt16("left atk"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::ATK, msg.readInt16("right atk"));
+    PlayerInfo::setStatBase(Attributes::ATK, packet.atk, Notify_false);
+    PlayerInfo::setStatMod(Attributes::ATK, packet.atkMod);
     PlayerInfo::updateAttrs();
 
-    val = msg.readInt16("right matk");
+    unsigned int val = packet.matk;
     PlayerInfo::setStatBase(Attributes::MATK, val, Notify_false);
 
-    val = msg.readInt16("left matk");
+    val = packet.matkMod;
     PlayerInfo::setStatMod(Attributes::MATK, val);
 
-    PlayerInfo::setStatBase(Attributes::DEF,
-        msg.readInt16("left def"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::DEF, msg.readInt16("right def"));
+    PlayerInfo::setStatBase(Attributes::DEF, packet.def, Notify_false);
+    PlayerInfo::setStatMod(Attributes::DEF, packet.defMod);
 
-    PlayerInfo::setStatBase(Attributes::MDEF,
-        msg.readInt16("left mdef"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::MDEF, msg.readInt16("right mdef"));
+    PlayerInfo::setStatBase(Attributes::MDEF, packet.mdef, Notify_false);
+    PlayerInfo::setStatMod(Attributes::MDEF, packet.mdefMod);
 
-    PlayerInfo::setStatBase(Attributes::HIT, msg.readInt16("hit"));
+    PlayerInfo::setStatBase(Attributes::HIT, packet.hit);
 
-    PlayerInfo::setStatBase(Attributes::FLEE,
-        msg.readInt16("flee"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::FLEE, msg.readInt16("flee2/10"));
+    PlayerInfo::setStatBase(Attributes::FLEE, packet.flee, Notify_false);
+    PlayerInfo::setStatMod(Attributes::FLEE, packet.fleeMod);
 
-    PlayerInfo::setStatBase(Attributes::CRIT, msg.readInt16("crit/10"));
+    PlayerInfo::setStatBase(Attributes::CRIT, packet.crit);
 
-    PlayerInfo::setAttribute(Attributes::ATTACK_DELAY,
-        msg.readInt16("attack speed"));
-    msg.readInt16("plus speed = 0");
+    PlayerInfo::setAttribute(Attributes::ATTACK_DELAY, packet.attackSpeed);
 
     BLOCK_END("PlayerHandler::processPlayerStatUpdate5")
 }
@@ -484,16 +435,15 @@ void PlayerHandler::processPlayerGetExp(Net::MessageIn &msg)
 {
     if (!localPlayer)
         return;
-    const int id = msg.readInt32("player id");
-    const int exp = msg.readInt32("exp amount");
-    const int stat = msg.readInt16("exp type");
-    const bool fromQuest = msg.readInt16("is from quest");
-    if (!fromQuest && id == localPlayer->getId())
+    PlayerGetExpPacket packet;
+    if (!packet.decode(msg))
+        return;
+    if (!packet.fromQuest && packet.beingId == localPlayer->getId())
     {
-        if (stat == 1)
-            localPlayer->addXpMessage(exp);
-        else if (stat == 2)
-            localPlayer->addJobMessage(exp);
+        if (packet.type == 1)
+            localPlayer->addXpMessage(packet.exp);
+        else if (packet.type == 2)
+            localPlayer->addJobMessage(packet.exp);
         else
             UNIMPLIMENTEDPACKET;
     }
@@ -508,12 +458,14 @@ void PlayerHandler::processWalkResponse(Net::MessageIn &msg)
       * and that the server will send a correction notice
       * otherwise.
       */
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readInt32("tick");
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readUInt8("(sx<<4) | (sy&0x0f)");
+    WalkResponsePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processWalkResponse")
+        return;
+    }
     if (localPlayer)
-        localPlayer->setRealPos(dstX, dstY);
+        localPlayer->setRealPos(packet.path.dstX, packet.path.dstY);
     BLOCK_END("PlayerHandler::processWalkResponse")
 }
 
@@ -537,11 +489,9 @@ void PlayerHandler::requestPvpInfo() const
 void PlayerHandler::processPvpInfo(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("char id");
-    msg.readInt32("account id");
-    msg.readInt32("pvp won");
-    msg.readInt32("pvp lost");
-    msg.readInt32("pvp point");
+    PvpInfoPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::revive() const
@@ -561,19 +511,22 @@ void PlayerHandler::processPlayerHeal(Net::MessageIn &msg)
     if (!localPlayer)
         return;
 
-    const int type = msg.readInt16("var id");
-    const int amount = msg.readInt16("value");
-    if (type == 5)
-        localPlayer->addHpMessage(amount);
-    else if (type == 7)
-        localPlayer->addSpMessage(amount);
+    PlayerHealPacket packet;
+    if (!packet.decode(msg))
+        return;
+    if (packet.type == 5)
+        localPlayer->addHpMessage(packet.amount);
+    else if (packet.type == 7)
+        localPlayer->addSpMessage(packet.amount);
 }
 
 void PlayerHandler::processPlayerSkillMessage(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     // +++ need show this message
-    msg.readInt32("type");
+    PlayerSkillMessagePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::setStat(Net::MessageIn &msg,
@@ -588,55 +541,66 @@ void PlayerHandler::setStat(Net::MessageIn &msg,
 void PlayerHandler::processNotifyMapInfo(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("type");
+    PlayerNotifyMapInfoPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerFameBlacksmith(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("points");
-    msg.readInt32("total points");
+    PlayerFamePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerFameAlchemist(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("points");
-    msg.readInt32("total points");
+    PlayerFamePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerUpgradeMessage(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("result");
-    msg.readInt16("item id");
+    PlayerUpgradeMessagePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerFameTaekwon(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("points");
-    msg.readInt32("total points");
+    PlayerFamePacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerReadBook(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("book id");
-    msg.readInt32("page");
+    PlayerReadBookPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerEquipTickAck(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt32("unused");
-    msg.readInt32("flag");
+    PlayerEquipTickAckPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerAutoShadowSpellList(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    const int count = (msg.readInt16("len") - 8) / 2;
+    AutoShadowSpellListPacket packet;
+    if (!packet.decode(msg))
+        return;
+    const int count = (packet.len - 8) / 2;
     for (int f = 0; f < count; f ++)
         msg.readInt16("skill id");
 }
@@ -644,15 +608,17 @@ void PlayerHandler::processPlayerAutoShadowSpellList(Net::MessageIn &msg)
 void PlayerHandler::processPlayerRankPoints(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
-    msg.readInt16("type");
-    msg.readInt32("points");
-    msg.readInt32("fame");
+    PlayerRankPointsPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void PlayerHandler::processPlayerClientCommand(Net::MessageIn &msg)
 {
-    const int sz = msg.readInt16("len") - 4;
-    std::string command = msg.readString(sz, "command");
+    PlayerClientCommandPacket packet;
+    if (!packet.decode(msg))
+        return;
+    std::string command = msg.readString(packet.len - 4, "command");
     std::string cmd;
     std::string args;
 
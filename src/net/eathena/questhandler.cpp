@@ -103,7 +103,7 @@ void QuestHandler::processAddQuest(Net::MessageIn &msg)
         // need use in quests kills list
         msg.readInt32("monster id");
         msg.readInt16("count");
-        msg.readString(24, "monster name");
+        msg.readStringView(24, "monster name");
     }
 
     msg.skipToEnd("unused");
@@ -156,7 +156,7 @@ void QuestHandler::processAddQuestsObjectives(Net::MessageIn &msg)
             // need use in quests kills list
             msg.readInt32("monster id");
             msg.readInt16("count");
-            msg.readString(24, "monster name");
+            msg.readStringView(24, "monster name");
         }
     }
     msg.skipToEnd("unused");
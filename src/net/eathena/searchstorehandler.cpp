@@ -121,7 +121,7 @@ void SearchStoreHandler::processSearchAck(Net::MessageIn &msg)
     {
         msg.readInt32("store id");
         msg.readInt32("aoount id");
-        msg.readString(80, "store name");
+        msg.readStringView(80, "store name");
         msg.readInt16("item id");
         msg.readUInt8("item type");
         msg.readInt32("price");
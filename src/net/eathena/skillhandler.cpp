@@ -433,10 +433,10 @@ void SkillHandler::processSkillWarpPoint(Net::MessageIn &msg)
 {
     UNIMPLIMENTEDPACKET;
     msg.readInt16("skill id");
-    msg.readString(16, "map name 1");
-    msg.readString(16, "map name 2");
-    msg.readString(16, "map name 3");
-    msg.readString(16, "map name 4");
+    msg.readStringView(16, "map name 1");
+    msg.readStringView(16, "map name 2");
+    msg.readStringView(16, "map name 3");
+    msg.readStringView(16, "map name 4");
 }
 
 void SkillHandler::processSkillMemoMessage(Net::MessageIn &msg)
@@ -213,6 +213,28 @@ void MessageIn::skipToEnd(const char *const str)
 }
 
 std::string MessageIn::readString(int length, const char *const dstr)
+{
+    const StringView view = readStringView(length, dstr);
+    PacketCounters::incInStrings();
+    return view.str();
+}
+
+std::string MessageIn::readRawString(int length, const char *const dstr)
+{
+    StringView hidden;
+    const StringView view = readRawStringView(length, hidden, dstr);
+    PacketCounters::incInStrings();
+    if (hidden.empty())
+        return view.str();
+
+    std::string str;
+    str.reserve(view.size() + hidden.size() + 1);
+    str.append(view.data(), view.size()).append("|").append(
+        hidden.data(), hidden.size());
+    return str;
+}
+
+StringView MessageIn::readStringView(int length, const char *const dstr)
 {
     // Get string length
     if (length < 0)
@@ -223,7 +245,7 @@ std::string MessageIn::readString(int length, const char *const dstr)
     {
         DEBUGLOG2("readString error", mPos, dstr);
         mPos = mLength + 1;
-        return "";
+        return StringView();
     }
 
     // Read the string
@@ -231,16 +253,20 @@ std::string MessageIn::readString(int length, const char *const dstr)
     const char *const stringEnd
         = static_cast<const char *const>(memchr(stringBeg, '\0', length));
 
-    const std::string str(stringBeg, stringEnd
+    const StringView view(stringBeg, stringEnd
         ? stringEnd - stringBeg : static_cast<size_t>(length));
-    DEBUGLOG2("readString: " + str, mPos, dstr);
+    DEBUGLOG2("readString: " + view.str(), mPos, dstr);
     mPos += length;
     PacketCounters::incInBytes(length);
-    return str;
+    return view;
 }
 
-std::string MessageIn::readRawString(int length, const char *const dstr)
+StringView MessageIn::readRawStringView(int length,
+                                        StringView &hidden,
+                                        const char *const dstr)
 {
+    hidden = StringView();
+
     // Get string length
     if (length < 0)
         length = readInt16("len");
@@ -249,17 +275,17 @@ std::string MessageIn::readRawString(int length, const char *const dstr)
     if (length < 0 || mPos + length > mLength)
     {
         mPos = mLength + 1;
-        return "";
+        return StringView();
     }
 
     // Read the string
     const char *const stringBeg = mData + static_cast<size_t>(mPos);
     const char *const stringEnd
         = static_cast<const char *const>(memchr(stringBeg, '\0', length));
-    std::string str(stringBeg, stringEnd
+    const StringView view(stringBeg, stringEnd
         ? stringEnd - stringBeg : static_cast<size_t>(length));
 
-    DEBUGLOG2("readString: " + str, mPos, dstr);
+    DEBUGLOG2("readString: " + view.str(), mPos, dstr);
 
     if (stringEnd)
     {
@@ -268,18 +294,15 @@ std::string MessageIn::readRawString(int length, const char *const dstr)
         const char *const stringBeg2 = stringEnd + 1;
         const char *const stringEnd2
             = static_cast<const char *const>(memchr(stringBeg2, '\0', len2));
-        const std::string hiddenPart = std::string(stringBeg2,
+        hidden = StringView(stringBeg2,
             stringEnd2 ? stringEnd2 - stringBeg2 : len2);
-        if (hiddenPart.length() > 0)
-        {
-            DEBUGLOG2("readString2: " + hiddenPart, mPos, dstr);
-            return str.append("|").append(hiddenPart);
-        }
+        if (!hidden.empty())
+            DEBUGLOG2("readString2: " + hidden.str(), mPos, dstr);
     }
     mPos += length;
     PacketCounters::incInBytes(length);
 
-    return str;
+    return view;
 }
 
 unsigned char *MessageIn::readBytes(int length, const char *const dstr)
@@ -325,4 +348,22 @@ unsigned char *MessageIn::readBytes(int length, const char *const dstr)
     return buf;
 }
 
+const char *MessageIn::readFixed(const unsigned int length,
+                                 const char *const dstr)
+{
+    if (mPos + length > mLength)
+    {
+        DEBUGLOG2("readFixed error", mPos, dstr);
+        mPos = mLength + 1;
+        return nullptr;
+    }
+
+    const char *const data = mData + static_cast<size_t>(mPos);
+    DEBUGLOG2("readFixed: " + toString(static_cast<int>(length)),
+        mPos, dstr);
+    mPos += length;
+    PacketCounters::incInBytes(length);
+    return data;
+}
+
 }  // namespace Net
@@ -23,7 +23,7 @@
 #ifndef NET_MESSAGEIN_H
 #define NET_MESSAGEIN_H
 
-#include <string>
+#include "utils/stringview.h"
 
 #include "localconsts.h"
 
@@ -112,9 +112,31 @@ class MessageIn notfinal
         virtual std::string readRawString(int length,
                                           const char *const dstr);
 
+        /**
+         * Reads a string without copy. View points into packet and valid
+         * only while packet handled.
+         */
+        StringView readStringView(int length,
+                                  const char *const dstr);
+
+        /**
+         * Reads a string without copy. Text after first zero byte
+         * returned in hidden.
+         */
+        StringView readRawStringView(int length,
+                                     StringView &hidden,
+                                     const char *const dstr);
+
         unsigned char *readBytes(int length,
                                  const char *const dstr);
 
+        /**
+         * Returns pointer to next length bytes of packet and skips them,
+         * or nullptr if packet is too short.
+         */
+        const char *readFixed(const unsigned int length,
+                              const char *const dstr) A_WARN_UNUSED;
+
         static uint8_t fromServerDirection(const uint8_t serverDir)
                                            A_WARN_UNUSED;
 
@@ -37,6 +37,17 @@ int PacketCounters::mOutBytes = 0;
 int PacketCounters::mOutBytesCalc = 0;
 int PacketCounters::mOutPackets = 0;
 int PacketCounters::mOutPacketsCalc = 0;
+int PacketCounters::mStallsCurrentSec = 0;
+int PacketCounters::mOutStalls = 0;
+int PacketCounters::mOutStallsCalc = 0;
+int PacketCounters::mOutPending = 0;
+int PacketCounters::mOutPendingCalc = 0;
+int PacketCounters::mCoalescedCurrentSec = 0;
+int PacketCounters::mInCoalesced = 0;
+int PacketCounters::mInCoalescedCalc = 0;
+int PacketCounters::mStringsCurrentSec = 0;
+int PacketCounters::mInStrings = 0;
+int PacketCounters::mInStringsCalc = 0;
 
 void PacketCounters::incInBytes(const int cnt)
 {
@@ -103,6 +114,62 @@ int PacketCounters::getOutPackets()
     return PacketCounters::mOutPacketsCalc;
 }
 
+void PacketCounters::incOutStalls(const int pending)
+{
+    if (!runCounters)
+        return;
+
+    updateStallCounters();
+
+    PacketCounters::mOutStalls ++;
+    // max pending bytes in second
+    if (pending > PacketCounters::mOutPending)
+        PacketCounters::mOutPending = pending;
+}
+
+int PacketCounters::getOutStalls()
+{
+    return PacketCounters::mOutStallsCalc;
+}
+
+int PacketCounters::getOutPending()
+{
+    return PacketCounters::mOutPendingCalc;
+}
+
+void PacketCounters::incInCoalesced()
+{
+    if (!runCounters)
+        return;
+
+    updateCounter(PacketCounters::mCoalescedCurrentSec,
+                  PacketCounters::mInCoalescedCalc,
+                  PacketCounters::mInCoalesced);
+
+    PacketCounters::mInCoalesced ++;
+}
+
+int PacketCounters::getInCoalesced()
+{
+    return PacketCounters::mInCoalescedCalc;
+}
+
+void PacketCounters::incInStrings()
+{
+    if (!runCounters)
+        return;
+
+    updateCounter(PacketCounters::mStringsCurrentSec,
+                  PacketCounters::mInStringsCalc,
+                  PacketCounters::mInStrings);
+
+    PacketCounters::mInStrings ++;
+}
+
+int PacketCounters::getInStrings()
+{
+    return PacketCounters::mInStringsCalc;
+}
 
 void PacketCounters::updateCounter(int &restrict currentSec,
                                    int &restrict calc,
@@ -117,6 +184,19 @@ void PacketCounters::updateCounter(int &restrict currentSec,
     }
 }
 
+void PacketCounters::updateStallCounters()
+{
+    const int idx = cur_time % 60;
+    if (mStallsCurrentSec != idx)
+    {
+        mStallsCurrentSec = idx;
+        mOutStallsCalc = mOutStalls;
+        mOutStalls = 0;
+        mOutPendingCalc = mOutPending;
+        mOutPending = 0;
+    }
+}
+
 void PacketCounters::update()
 {
     if (!runCounters)
@@ -131,5 +211,10 @@ void PacketCounters::update()
         PacketCounters::mOutBytesCalc, PacketCounters::mOutBytes);
     updateCounter(PacketCounters::mOutCurrentSec,
         PacketCounters::mOutPacketsCalc, PacketCounters::mOutPackets);
+    updateStallCounters();
+    updateCounter(PacketCounters::mCoalescedCurrentSec,
+        PacketCounters::mInCoalescedCalc, PacketCounters::mInCoalesced);
+    updateCounter(PacketCounters::mStringsCurrentSec,
+        PacketCounters::mInStringsCalc, PacketCounters::mInStrings);
     BLOCK_END("PacketCounters::update")
 }
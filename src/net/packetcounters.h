@@ -44,6 +44,28 @@ class PacketCounters final
 
         static int getOutPackets() A_WARN_UNUSED;
 
+        /**
+         * Called if packets can not be sent because previous packets
+         * still not sent.
+         */
+        static void incOutStalls(const int pending);
+
+        static int getOutStalls() A_WARN_UNUSED;
+
+        static int getOutPending() A_WARN_UNUSED;
+
+        static void incInCoalesced();
+
+        static int getInCoalesced() A_WARN_UNUSED;
+
+        /**
+         * Counts packet strings copied into std::string. String views
+         * not counted, they not allocate while debug log disabled.
+         */
+        static void incInStrings();
+
+        static int getInStrings() A_WARN_UNUSED;
+
         static void update();
 
         static int mInCurrentSec;
@@ -56,11 +78,24 @@ class PacketCounters final
         static int mOutBytesCalc;
         static int mOutPackets;
         static int mOutPacketsCalc;
+        static int mStallsCurrentSec;
+        static int mOutStalls;
+        static int mOutStallsCalc;
+        static int mOutPending;
+        static int mOutPendingCalc;
+        static int mCoalescedCurrentSec;
+        static int mInCoalesced;
+        static int mInCoalescedCalc;
+        static int mStringsCurrentSec;
+        static int mInStrings;
+        static int mInStringsCalc;
 
     private:
         static void updateCounter(int &restrict currentSec,
                                   int &restrict calc,
                                   int &restrict counter);
+
+        static void updateStallCounters();
 };
 
 #endif  // NET_PACKETCOUNTERS_H
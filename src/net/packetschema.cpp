@@ -0,0 +1,42 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/packetschema.h"
+
+#include "debug.h"
+
+namespace Net
+{
+
+// zero initialized before any stats constructed
+PacketStats *PacketStats::mFirst = nullptr;
+
+PacketStats::PacketStats(const char *const name0,
+                         const int size0) :
+    name(name0),
+    next(mFirst),
+    size(size0),
+    decoded(0),
+    errors(0)
+{
+    mFirst = this;
+}
+
+}  // namespace Net
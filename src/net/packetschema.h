@@ -0,0 +1,434 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_PACKETSCHEMA_H
+#define NET_PACKETSCHEMA_H
+
+#include "net/messagein.h"
+
+#include <cstring>
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "localconsts.h"
+
+namespace Net
+{
+
+/**
+ * Special 3 byte block with x and y coordinates and direction.
+ */
+struct Coordinates final
+{
+    uint16_t x;
+    uint16_t y;
+    uint8_t direction;
+};
+
+/**
+ * Special 5 byte block with source and destination coordinates.
+ */
+struct CoordinatePair final
+{
+    uint16_t srcX;
+    uint16_t srcY;
+    uint16_t dstX;
+    uint16_t dstY;
+};
+
+/**
+ * Unused bytes in packet.
+ */
+template<unsigned int N>
+struct Skip final
+{
+};
+
+/**
+ * Zero padded string with fixed size. Decoded as view into packet.
+ */
+template<unsigned int N>
+struct String final
+{
+};
+
+/**
+ * Raw bytes, for blocks with layout depend on other fields.
+ * Decoded as pointer into packet.
+ */
+template<unsigned int N>
+struct Bytes final
+{
+};
+
+/**
+ * Wire size and decoder for one packet field type.
+ * Values in packets stored in little endian.
+ * Not specialized types must be blocks declared by PACKET_BLOCK.
+ */
+template<typename T>
+struct PacketField final
+{
+    typedef T Type;
+
+    enum { size = T::size };
+
+    static void read(const unsigned char *const data, T &value)
+    { value.read(data); }
+};
+
+template<>
+struct PacketField<uint8_t> final
+{
+    typedef uint8_t Type;
+
+    enum { size = 1 };
+
+    static void read(const unsigned char *const data, uint8_t &value)
+    { value = data[0]; }
+};
+
+template<>
+struct PacketField<int8_t> final
+{
+    typedef int8_t Type;
+
+    enum { size = 1 };
+
+    static void read(const unsigned char *const data, int8_t &value)
+    { value = static_cast<int8_t>(data[0]); }
+};
+
+template<>
+struct PacketField<uint16_t> final
+{
+    typedef uint16_t Type;
+
+    enum { size = 2 };
+
+    static void read(const unsigned char *const data, uint16_t &value)
+    {
+        value = static_cast<uint16_t>(data[0]
+            | (static_cast<unsigned int>(data[1]) << 8));
+    }
+};
+
+template<>
+struct PacketField<int16_t> final
+{
+    typedef int16_t Type;
+
+    enum { size = 2 };
+
+    static void read(const unsigned char *const data, int16_t &value)
+    {
+        value = static_cast<int16_t>(data[0]
+            | (static_cast<unsigned int>(data[1]) << 8));
+    }
+};
+
+template<>
+struct PacketField<uint32_t> final
+{
+    typedef uint32_t Type;
+
+    enum { size = 4 };
+
+    static void read(const unsigned char *const data, uint32_t &value)
+    {
+        value = static_cast<uint32_t>(data[0])
+            | (static_cast<uint32_t>(data[1]) << 8)
+            | (static_cast<uint32_t>(data[2]) << 16)
+            | (static_cast<uint32_t>(data[3]) << 24);
+    }
+};
+
+template<>
+struct PacketField<int32_t> final
+{
+    typedef int32_t Type;
+
+    enum { size = 4 };
+
+    static void read(const unsigned char *const data, int32_t &value)
+    {
+        uint32_t tmp;
+        PacketField<uint32_t>::read(data, tmp);
+        value = static_cast<int32_t>(tmp);
+    }
+};
+
+template<>
+struct PacketField<int64_t> final
+{
+    typedef int64_t Type;
+
+    enum { size = 8 };
+
+    static void read(const unsigned char *const data, int64_t &value)
+    {
+        uint32_t low;
+        uint32_t high;
+        PacketField<uint32_t>::read(data, low);
+        PacketField<uint32_t>::read(data + 4, high);
+        value = static_cast<int64_t>((static_cast<uint64_t>(high) << 32)
+            | low);
+    }
+};
+
+template<>
+struct PacketField<Coordinates> final
+{
+    typedef Coordinates Type;
+
+    enum { size = 3 };
+
+    static void read(const unsigned char *const data, Coordinates &value)
+    {
+        value.x = static_cast<uint16_t>(((data[0] << 8)
+            | (data[1] & 0xc0U)) >> 6);
+        value.y = static_cast<uint16_t>((((data[1] & 0x3fU) << 8)
+            | (data[2] & 0xf0U)) >> 4);
+        value.direction = MessageIn::fromServerDirection(
+            static_cast<uint8_t>(data[2] & 0x0fU));
+    }
+};
+
+template<>
+struct PacketField<CoordinatePair> final
+{
+    typedef CoordinatePair Type;
+
+    enum { size = 5 };
+
+    static void read(const unsigned char *const data,
+                     CoordinatePair &value)
+    {
+        value.srcX = static_cast<uint16_t>(((data[0] << 8)
+            | data[1]) >> 6);
+        value.srcY = static_cast<uint16_t>((((data[1] & 0x3fU) << 8)
+            | data[2]) >> 4);
+        value.dstX = static_cast<uint16_t>((((data[2] & 0x0fU) << 8)
+            | data[3]) >> 2);
+        value.dstY = static_cast<uint16_t>(((data[3] & 0x03U) << 8)
+            | data[4]);
+    }
+};
+
+template<unsigned int N>
+struct PacketField<Skip<N> > final
+{
+    typedef Skip<N> Type;
+
+    enum { size = N };
+
+    static void read(const unsigned char *const data A_UNUSED,
+                     Skip<N> &value A_UNUSED)
+    { }
+};
+
+template<unsigned int N>
+struct PacketField<String<N> > final
+{
+    typedef StringView Type;
+
+    enum { size = N };
+
+    static void read(const unsigned char *const data, StringView &value)
+    {
+        const char *const str = reinterpret_cast<const char*>(data);
+        const char *const end = static_cast<const char*>(
+            memchr(str, '\0', N));
+        value = StringView(str, end ? end - str : N);
+    }
+};
+
+template<unsigned int N>
+struct PacketField<Bytes<N> > final
+{
+    typedef const unsigned char *Type;
+
+    enum { size = N };
+
+    static void read(const unsigned char *const data,
+                     const unsigned char *&value)
+    { value = data; }
+};
+
+/**
+ * N fields of same type in row.
+ */
+template<typename T, unsigned int N>
+struct Array final
+{
+    typename PacketField<T>::Type values[N];
+
+    enum { size = PacketField<T>::size * N };
+
+    void read(const unsigned char *const data)
+    {
+        for (unsigned int f = 0; f < N; f ++)
+            PacketField<T>::read(data + f * PacketField<T>::size, values[f]);
+    }
+};
+
+/**
+ * Decoded packets count for one schema.
+ * All schemas stats linked in list for debug window.
+ */
+class PacketStats final
+{
+    public:
+        PacketStats(const char *const name0,
+                    const int size0);
+
+        A_DELETE_COPY(PacketStats)
+
+        static const PacketStats *getFirst() A_WARN_UNUSED
+        { return mFirst; }
+
+        const char *const name;
+        const PacketStats *const next;
+        const int size;
+        unsigned int decoded;
+        unsigned int errors;
+
+    private:
+        static PacketStats *mFirst;
+};
+
+template<typename T>
+struct PacketSchemaStats final
+{
+    static PacketStats stats;
+};
+
+template<typename T>
+PacketStats PacketSchemaStats<T>::stats(T::getName(), T::size);
+
+/**
+ * Writes packet length generated from schema into packets table.
+ * Returns false if table had other length for this packet before.
+ */
+template<typename T>
+bool applyPacketSchema(int16_t *const lengths,
+                       const unsigned int lengthsSize,
+                       const unsigned int id);
+
+template<typename T>
+bool applyPacketSchema(int16_t *const lengths,
+                       const unsigned int lengthsSize,
+                       const unsigned int id)
+{
+    if (id >= lengthsSize)
+        return false;
+    const bool same = lengths[id] == T::length;
+    lengths[id] = static_cast<int16_t>(T::length);
+    return same;
+}
+
+}  // namespace Net
+
+#define PACKET_FIELD_MEMBER(type, name) \
+    Net::PacketField<type >::Type name;
+
+#define PACKET_FIELD_SIZE(type, name) + Net::PacketField<type >::size
+
+#define PACKET_FIELD_READ(type, name) \
+    Net::PacketField<type >::read(ptr, name); \
+    ptr += Net::PacketField<type >::size;
+
+#define PACKET_BLOCK_BODY(fields) \
+        fields(PACKET_FIELD_MEMBER) \
+        enum { size = 0 fields(PACKET_FIELD_SIZE) }; \
+        void read(const unsigned char *ptr) \
+        { \
+            fields(PACKET_FIELD_READ) \
+        }
+
+#define PACKET_SCHEMA_BODY(packet, fields) \
+        PACKET_BLOCK_BODY(fields) \
+        static const char *getName() A_WARN_UNUSED \
+        { return #packet; } \
+        bool decode(Net::MessageIn &msg) A_WARN_UNUSED \
+        { \
+            const char *const data = msg.readFixed(size, #packet); \
+            if (!data) \
+            { \
+                Net::PacketSchemaStats<packet>::stats.errors ++; \
+                return false; \
+            } \
+            read(reinterpret_cast<const unsigned char*>(data)); \
+            Net::PacketSchemaStats<packet>::stats.decoded ++; \
+            return true; \
+        }
+
+/**
+ * Declares struct for part of packet what can repeat or can be nested
+ * into other blocks and packets.
+ */
+#define PACKET_BLOCK(block, fields) \
+    struct block final \
+    { \
+        PACKET_BLOCK_BODY(fields) \
+        bool decode(Net::MessageIn &msg) A_WARN_UNUSED \
+        { \
+            const char *const data = msg.readFixed(size, #block); \
+            if (!data) \
+                return false; \
+            read(reinterpret_cast<const unsigned char*>(data)); \
+            return true; \
+        } \
+    };
+
+/**
+ * Declares struct for packet body (after packet id) with given fields list
+ * and decoder for it. Packet size checked once for whole packet.
+ * Packet length in packets table generated from schema on network start.
+ *
+ * Fields list is macro like:
+ * #define BEING_DIRECTION_FIELDS(F) \
+ *     F(int32_t, beingId) \
+ *     F(Net::Skip<2>, unused) \
+ *     F(uint8_t, direction)
+ */
+#define PACKET_SCHEMA(packet, fields) \
+    struct packet final \
+    { \
+        PACKET_SCHEMA_BODY(packet, fields) \
+        enum { length = size + 2 }; \
+    };
+
+/**
+ * Declares schema for fixed head of packet with variable length.
+ * First field must be packet length. Rest of packet read by handler.
+ */
+#define PACKET_VAR_SCHEMA(packet, fields) \
+    struct packet final \
+    { \
+        PACKET_SCHEMA_BODY(packet, fields) \
+        enum { length = -1 }; \
+    };
+
+#endif  // NET_PACKETSCHEMA_H
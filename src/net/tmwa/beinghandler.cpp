@@ -40,6 +40,7 @@
 #include "net/serverfeatures.h"
 
 #include "net/tmwa/messageout.h"
+#include "net/tmwa/packetschema.h"
 #include "net/tmwa/protocol.h"
 #include "net/tmwa/sprite.h"
 
@@ -266,11 +267,17 @@ void BeingHandler::processBeingChangeLook(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("being id"));
+    BeingChangeLooksPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingChangeLook")
+        return;
+    }
 
-    const uint8_t type = msg.readUInt8("type");
-    const int16_t id = static_cast<int16_t>(msg.readUInt8("id"));
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
+
+    const uint8_t type = packet.type;
+    const int16_t id = static_cast<int16_t>(packet.id);
     const int id2 = 1;
 
     if (!localPlayer || !dstBeing)
@@ -291,22 +298,23 @@ void BeingHandler::processBeingChangeLook2(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readInt32("being id"));
+    BeingChangeLooks2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingChangeLook")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
-    const uint8_t type = msg.readUInt8("type");
+    const uint8_t type = packet.type;
     int id2 = 0;
 
-    const int16_t id = msg.readInt16("id1");
+    const int16_t id = packet.id1;
     if (type == 2 || serverFeatures->haveItemColors())
-    {
-        id2 = msg.readInt16("id2");
-    }
+        id2 = packet.id2;
     else
-    {
-        msg.readInt16("id2");
         id2 = 1;
-    }
 
     if (!localPlayer || !dstBeing)
     {
@@ -426,14 +434,20 @@ void BeingHandler::processPlayerUpdate1(Net::MessageIn &msg)
         return;
     }
 
+    PlayerUpdate1Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerMoveUpdate")
+        return;
+    }
+
     // An update about a player, potentially including movement.
-    const int id = msg.readInt32("account id");
-    const int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
-    uint32_t statusEffects = msg.readInt16("opt2");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("options")))
-        << 16;
-    const int16_t job = msg.readInt16("job");
+    const int id = packet.beingId;
+    const int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
+    uint32_t statusEffects = packet.statusEffects;
+    statusEffects |= (static_cast<uint32_t>(packet.option)) << 16;
+    const int16_t job = packet.job;
     int disguiseId = 0;
     if (id < 110000000 && job >= 1000)
         disguiseId = job;
@@ -477,26 +491,23 @@ void BeingHandler::processPlayerUpdate1(Net::MessageIn &msg)
 
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
 
-    const uint8_t hairStyle = msg.readUInt8("hair style");
-    const uint16_t look = msg.readUInt8("look");
+    const uint8_t hairStyle = packet.hairStyle;
+    const uint16_t look = packet.look;
     dstBeing->setSubtype(job, look);
-    const uint16_t weapon = msg.readInt16("weapon");
-    const uint16_t shield = msg.readInt16("shield");
-    const uint16_t headBottom = msg.readInt16("head bottom");
+    const uint16_t weapon = packet.weapon;
+    const uint16_t shield = packet.shield;
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const uint8_t hairColor = msg.readUInt8("hair color");
-    msg.readUInt8("unused");
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const uint8_t hairColor = packet.hairColor;
 
     uint8_t colors[9];
-    colors[0] = msg.readUInt8("color 0");
-    colors[1] = msg.readUInt8("color 1");
-    colors[2] = msg.readUInt8("color 2");
-
-    msg.readUInt8("unused");
+    colors[0] = packet.color0;
+    colors[1] = packet.color1;
+    colors[2] = packet.color2;
 
-    const int guild = msg.readInt32("guild");
+    const int guild = packet.guild;
 
     if (!guildManager || !GuildManager::getEnableGuildBot())
     {
@@ -506,13 +517,12 @@ void BeingHandler::processPlayerUpdate1(Net::MessageIn &msg)
             dstBeing->setGuild(Guild::getGuild(static_cast<int16_t>(guild)));
     }
 
-    msg.readInt16("emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, msg.readInt16("opt3"));
-    dstBeing->setKarma(msg.readUInt8("karma"));
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, packet.opt3);
+    dstBeing->setKarma(packet.karma);
     // reserving bit for future usage
     dstBeing->setGender(Being::intToGender(
-        static_cast<uint8_t>(msg.readUInt8("gender") & 3)));
+        static_cast<uint8_t>(packet.gender & 3)));
 
     if (!disguiseId)
     {
@@ -539,25 +549,24 @@ void BeingHandler::processPlayerUpdate1(Net::MessageIn &msg)
     }
     localPlayer->imitateOutfit(dstBeing);
 
-    uint16_t x, y;
-    msg.readCoordinates(x, y, dir, "position");
+    const uint16_t x = packet.position.x;
+    const uint16_t y = packet.position.y;
+    dir = packet.position.direction;
     dstBeing->setTileCoords(x, y);
     dstBeing->setDirection(dir);
 
     localPlayer->imitateDirection(dstBeing, dir);
 
-    const uint16_t gmstatus = msg.readInt16("gm status");
+    const uint16_t gmstatus = packet.gmStatus;
 
     if (gmstatus & 0x80)
         dstBeing->setGM(true);
 
-    applyPlayerAction(msg, dstBeing, msg.readUInt8("action type"));
-    const int level = static_cast<int>(msg.readUInt8("level"));
+    applyPlayerAction(msg, dstBeing, packet.actionType);
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
 
-    msg.readUInt8("unused");
-
     dstBeing->setActionTime(tick_time);
 
     dstBeing->setStunMode(stunMode);
@@ -578,14 +587,20 @@ void BeingHandler::processPlayerUpdate2(Net::MessageIn &msg)
         return;
     }
 
+    PlayerUpdate2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerMoveUpdate")
+        return;
+    }
+
     // An update about a player, potentially including movement.
-    const int id = msg.readInt32("account id");
-    const int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
-    uint32_t statusEffects = msg.readInt16("opt2");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("options")))
-        << 16;
-    const int16_t job = msg.readInt16("job");
+    const int id = packet.beingId;
+    const int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
+    uint32_t statusEffects = packet.statusEffects;
+    statusEffects |= (static_cast<uint32_t>(packet.option)) << 16;
+    const int16_t job = packet.job;
     int disguiseId = 0;
     if (id < 110000000 && job >= 1000)
         disguiseId = job;
@@ -629,25 +644,22 @@ void BeingHandler::processPlayerUpdate2(Net::MessageIn &msg)
 
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
 
-    const uint8_t hairStyle = msg.readUInt8("hair style");
-    const uint16_t look = msg.readUInt8("look");
+    const uint8_t hairStyle = packet.hairStyle;
+    const uint16_t look = packet.look;
     dstBeing->setSubtype(job, look);
-    const uint16_t weapon = msg.readInt16("weapon");
-    const uint16_t shield = msg.readInt16("shield");
-    const uint16_t headBottom = msg.readInt16("head bottom");
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const uint8_t hairColor = msg.readUInt8("hair color");
-    msg.readUInt8("unused");
+    const uint16_t weapon = packet.weapon;
+    const uint16_t shield = packet.shield;
+    const uint16_t headBottom = packet.headBottom;
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const uint8_t hairColor = packet.hairColor;
 
     uint8_t colors[9];
-    colors[0] = msg.readUInt8("color 0");
-    colors[1] = msg.readUInt8("color 1");
-    colors[2] = msg.readUInt8("color 2");
-
-    msg.readUInt8("unused");
+    colors[0] = packet.color0;
+    colors[1] = packet.color1;
+    colors[2] = packet.color2;
 
-    const int guild = msg.readInt32("guild");
+    const int guild = packet.guild;
 
     if (!guildManager || !GuildManager::getEnableGuildBot())
     {
@@ -657,13 +669,12 @@ void BeingHandler::processPlayerUpdate2(Net::MessageIn &msg)
             dstBeing->setGuild(Guild::getGuild(static_cast<int16_t>(guild)));
     }
 
-    msg.readInt16("emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, msg.readInt16("opt3"));
-    dstBeing->setKarma(msg.readUInt8("karma"));
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, packet.opt3);
+    dstBeing->setKarma(packet.karma);
     // reserving bit for future usage
     dstBeing->setGender(Being::intToGender(
-        static_cast<uint8_t>(msg.readUInt8("gender") & 3)));
+        static_cast<uint8_t>(packet.gender & 3)));
 
     if (!disguiseId)
     {
@@ -690,20 +701,21 @@ void BeingHandler::processPlayerUpdate2(Net::MessageIn &msg)
     }
     localPlayer->imitateOutfit(dstBeing);
 
-    uint16_t x, y;
-    msg.readCoordinates(x, y, dir, "position");
+    const uint16_t x = packet.position.x;
+    const uint16_t y = packet.position.y;
+    dir = packet.position.direction;
     dstBeing->setTileCoords(x, y);
     dstBeing->setDirection(dir);
 
     localPlayer->imitateDirection(dstBeing, dir);
 
-    const uint16_t gmstatus = msg.readInt16("gm status");
+    const uint16_t gmstatus = packet.gmStatus;
 
     if (gmstatus & 0x80)
         dstBeing->setGM(true);
 
-    applyPlayerAction(msg, dstBeing, msg.readUInt8("action type"));
-    const int level = static_cast<int>(msg.readUInt8("level"));
+    applyPlayerAction(msg, dstBeing, packet.actionType);
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
 
@@ -726,14 +738,20 @@ void BeingHandler::processPlayerMove(Net::MessageIn &msg)
         return;
     }
 
+    PlayerMovePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerMoveUpdate")
+        return;
+    }
+
     // An update about a player, potentially including movement.
-    const int id = msg.readInt32("account id");
-    const int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
-    uint32_t statusEffects = msg.readInt16("opt2");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("options")))
-        << 16;
-    const int16_t job = msg.readInt16("job");
+    const int id = packet.beingId;
+    const int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
+    uint32_t statusEffects = packet.statusEffects;
+    statusEffects |= (static_cast<uint32_t>(packet.option)) << 16;
+    const int16_t job = packet.job;
     int disguiseId = 0;
     if (id < 110000000 && job >= 1000)
         disguiseId = job;
@@ -777,28 +795,23 @@ void BeingHandler::processPlayerMove(Net::MessageIn &msg)
 
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
 
-    const uint8_t hairStyle = msg.readUInt8("hair style");
-    const uint16_t look = msg.readUInt8("look");
+    const uint8_t hairStyle = packet.hairStyle;
+    const uint16_t look = packet.look;
     dstBeing->setSubtype(job, look);
-    const uint16_t weapon = msg.readInt16("weapon");
-    const uint16_t shield = msg.readInt16("shield");
-    const uint16_t headBottom = msg.readInt16("head bottom");
+    const uint16_t weapon = packet.weapon;
+    const uint16_t shield = packet.shield;
+    const uint16_t headBottom = packet.headBottom;
 
-    msg.readInt32("tick");
-
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const uint8_t hairColor = msg.readUInt8("hair color");
-    msg.readUInt8("unused");
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const uint8_t hairColor = packet.hairColor;
 
     uint8_t colors[9];
-    colors[0] = msg.readUInt8("color 0");
-    colors[1] = msg.readUInt8("color 1");
-    colors[2] = msg.readUInt8("color 2");
-
-    msg.readUInt8("unused");
+    colors[0] = packet.color0;
+    colors[1] = packet.color1;
+    colors[2] = packet.color2;
 
-    const int guild = msg.readInt32("guild");
+    const int guild = packet.guild;
 
     if (!guildManager || !GuildManager::getEnableGuildBot())
     {
@@ -808,13 +821,12 @@ void BeingHandler::processPlayerMove(Net::MessageIn &msg)
             dstBeing->setGuild(Guild::getGuild(static_cast<int16_t>(guild)));
     }
 
-    msg.readInt16("emblem");
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, msg.readInt16("opt3"));
-    dstBeing->setKarma(msg.readUInt8("karma"));
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, packet.opt3);
+    dstBeing->setKarma(packet.karma);
     // reserving bit for future usage
     dstBeing->setGender(Being::intToGender(
-        static_cast<uint8_t>(msg.readUInt8("gender") & 3)));
+        static_cast<uint8_t>(packet.gender & 3)));
 
     if (!disguiseId)
     {
@@ -841,8 +853,10 @@ void BeingHandler::processPlayerMove(Net::MessageIn &msg)
     }
     localPlayer->imitateOutfit(dstBeing);
 
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "moving path");
+    const uint16_t srcX = packet.path.srcX;
+    const uint16_t srcY = packet.path.srcY;
+    const uint16_t dstX = packet.path.dstX;
+    const uint16_t dstY = packet.path.dstY;
 
     localPlayer->followMoveTo(dstBeing, srcX, srcY, dstX, dstY);
 
@@ -868,19 +882,15 @@ void BeingHandler::processPlayerMove(Net::MessageIn &msg)
             dstBeing->getDirection());
     }
 
-    const uint16_t gmstatus = msg.readInt16("gm status");
+    const uint16_t gmstatus = packet.gmStatus;
 
     if (gmstatus & 0x80)
         dstBeing->setGM(true);
 
-    msg.readUInt8("unused");
-
-    const int level = static_cast<int>(msg.readUInt8("level"));
+    const int level = static_cast<int>(packet.level);
     if (level)
         dstBeing->setLevel(level);
 
-    msg.readUInt8("unused");
-
     if (dstBeing->getType() != ActorType::Player)
         dstBeing->setActionTime(tick_time);
 
@@ -904,20 +914,27 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
         return;
     }
 
+    BeingVisiblePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingVisibleOrMove")
+        return;
+    }
+
     int spawnId;
 
     // Information about a being in range
-    const int id = msg.readInt32("being id");
+    const int id = packet.beingId;
     if (id == mSpawnId)
         spawnId = mSpawnId;
     else
         spawnId = 0;
     mSpawnId = 0;
-    int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
-    uint32_t statusEffects = msg.readInt16("opt2");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("option"))) << 16;
-    const int16_t job = msg.readInt16("class");
+    int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
+    uint32_t statusEffects = packet.statusEffects;
+    statusEffects |= (static_cast<uint32_t>(packet.option)) << 16;
+    const int16_t job = packet.job;
     int disguiseId = 0;
     if (id == localPlayer->getId() && job >= 1000)
         disguiseId = job;
@@ -984,29 +1001,30 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
     if (speed == 0)
         speed = 150;
 
-    const uint8_t hairStyle = msg.readUInt8("hair style");
-    const uint16_t look = msg.readUInt8("look");
+    const uint8_t hairStyle = packet.hairStyle;
+    const uint16_t look = packet.look;
     dstBeing->setSubtype(job, look);
     if (dstBeing->getType() == ActorType::Monster && localPlayer)
         localPlayer->checkNewName(dstBeing);
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
-    const uint16_t weapon = msg.readInt16("weapon");
-    const uint16_t headBottom = msg.readInt16("head bottom");
+    const uint16_t weapon = packet.weapon;
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t shield = msg.readInt16("shield");
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const uint8_t hairColor = msg.readUInt8("hair color");
-    msg.readUInt8("unused");
-    const uint16_t shoes = msg.readInt16("shoes / clothes color");
+    const uint16_t shield = packet.shield;
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const uint8_t hairColor = packet.hairColor;
+    const uint16_t shoes = packet.shoes;
 
     uint16_t gloves;
     if (dstBeing->getType() == ActorType::Monster)
     {
         if (serverFeatures->haveServerHp())
         {
-            const int hp = msg.readInt32("hp");
-            const int maxHP = msg.readInt32("max hp");
+            BeingHpBlock hpBlock;
+            hpBlock.read(packet.extra);
+            const int hp = hpBlock.hp;
+            const int maxHP = hpBlock.maxHP;
             if (hp && maxHP)
             {
                 dstBeing->setMaxHP(maxHP);
@@ -1015,34 +1033,28 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
                     dstBeing->setHP(hp);
             }
         }
-        else
-        {
-            msg.readInt32("unused");
-            msg.readInt32("unused");
-        }
         gloves = 0;
     }
     else
     {
-        gloves = msg.readInt16("gloves / head dir");
-        msg.readInt32("guild");
-        msg.readInt16("guild emblem");
+        BeingGuildBlock guildBlock;
+        guildBlock.read(packet.extra);
+        gloves = guildBlock.gloves;
     }
 
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, msg.readInt16("opt3"));
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, packet.opt3);
     if (serverFeatures->haveMonsterAttackRange()
         && dstBeing->getType() == ActorType::Monster)
     {
-        const int attackRange = static_cast<int>(
-            msg.readUInt8("attack range (was karma)"));
+        const int attackRange = static_cast<int>(packet.karma);
         dstBeing->setAttackRange(attackRange);
     }
     else
     {
-        dstBeing->setKarma(msg.readUInt8("karma"));
+        dstBeing->setKarma(packet.karma);
     }
-    uint8_t gender = msg.readUInt8("gender");
+    uint8_t gender = packet.gender;
 
     if (!disguiseId && dstBeing->getType() == ActorType::Player)
     {
@@ -1067,9 +1079,9 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
         setServerGender(dstBeing, gender);
     }
 
-    uint8_t dir;
-    uint16_t x, y;
-    msg.readCoordinates(x, y, dir, "position");
+    const uint8_t dir = packet.position.direction;
+    const uint16_t x = packet.position.x;
+    const uint16_t y = packet.position.y;
     dstBeing->setTileCoords(x, y);
 
     if (job == 45 && socialWindow && outfitWindow)
@@ -1088,12 +1100,6 @@ void BeingHandler::processBeingVisible(Net::MessageIn &msg)
 
     dstBeing->setDirection(dir);
 
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-
     dstBeing->setStunMode(stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
         (statusEffects >> 16) & 0xffff));
@@ -1111,20 +1117,27 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
         return;
     }
 
+    BeingMovePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingVisibleOrMove")
+        return;
+    }
+
     int spawnId;
 
     // Information about a being in range
-    const int id = msg.readInt32("being id");
+    const int id = packet.beingId;
     if (id == mSpawnId)
         spawnId = mSpawnId;
     else
         spawnId = 0;
     mSpawnId = 0;
-    int16_t speed = msg.readInt16("speed");
-    const uint16_t stunMode = msg.readInt16("opt1");
-    uint32_t statusEffects = msg.readInt16("opt2");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("option"))) << 16;
-    const int16_t job = msg.readInt16("class");
+    int16_t speed = packet.speed;
+    const uint16_t stunMode = packet.stunMode;
+    uint32_t statusEffects = packet.statusEffects;
+    statusEffects |= (static_cast<uint32_t>(packet.option)) << 16;
+    const int16_t job = packet.job;
     int disguiseId = 0;
     if (id == localPlayer->getId() && job >= 1000)
         disguiseId = job;
@@ -1183,31 +1196,30 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
     if (speed == 0)
         speed = 150;
 
-    const uint8_t hairStyle = msg.readUInt8("hair style");
-    const uint16_t look = msg.readUInt8("look");
+    const uint8_t hairStyle = packet.hairStyle;
+    const uint16_t look = packet.look;
     dstBeing->setSubtype(job, look);
     if (dstBeing->getType() == ActorType::Monster && localPlayer)
         localPlayer->checkNewName(dstBeing);
     dstBeing->setWalkSpeed(Vector(speed, speed, 0));
-    const uint16_t weapon = msg.readInt16("weapon");
-    const uint16_t headBottom = msg.readInt16("head bottom");
-
-    msg.readInt32("tick");
+    const uint16_t weapon = packet.weapon;
+    const uint16_t headBottom = packet.headBottom;
 
-    const uint16_t shield = msg.readInt16("shield");
-    const uint16_t headTop = msg.readInt16("head top");
-    const uint16_t headMid = msg.readInt16("head mid");
-    const uint8_t hairColor = msg.readUInt8("hair color");
-    msg.readUInt8("unused");
-    const uint16_t shoes = msg.readInt16("shoes / clothes color");
+    const uint16_t shield = packet.shield;
+    const uint16_t headTop = packet.headTop;
+    const uint16_t headMid = packet.headMid;
+    const uint8_t hairColor = packet.hairColor;
+    const uint16_t shoes = packet.shoes;
 
     uint16_t gloves;
     if (dstBeing->getType() == ActorType::Monster)
     {
         if (serverFeatures->haveServerHp())
         {
-            const int hp = msg.readInt32("hp");
-            const int maxHP = msg.readInt32("max hp");
+            BeingHpBlock hpBlock;
+            hpBlock.read(packet.extra);
+            const int hp = hpBlock.hp;
+            const int maxHP = hpBlock.maxHP;
             if (hp && maxHP)
             {
                 dstBeing->setMaxHP(maxHP);
@@ -1216,34 +1228,28 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
                     dstBeing->setHP(hp);
             }
         }
-        else
-        {
-            msg.readInt32("unused");
-            msg.readInt32("unused");
-        }
         gloves = 0;
     }
     else
     {
-        gloves = msg.readInt16("gloves / head dir");
-        msg.readInt32("guild");
-        msg.readInt16("guild emblem");
+        BeingGuildBlock guildBlock;
+        guildBlock.read(packet.extra);
+        gloves = guildBlock.gloves;
     }
 
-    dstBeing->setManner(msg.readInt16("manner"));
-    dstBeing->setStatusEffectBlock(32, msg.readInt16("opt3"));
+    dstBeing->setManner(packet.manner);
+    dstBeing->setStatusEffectBlock(32, packet.opt3);
     if (serverFeatures->haveMonsterAttackRange()
         && dstBeing->getType() == ActorType::Monster)
     {
-        const int attackRange = static_cast<int>(
-            msg.readUInt8("attack range (was karma)"));
+        const int attackRange = static_cast<int>(packet.karma);
         dstBeing->setAttackRange(attackRange);
     }
     else
     {
-        dstBeing->setKarma(msg.readUInt8("karma"));
+        dstBeing->setKarma(packet.karma);
     }
-    uint8_t gender = msg.readUInt8("gender");
+    uint8_t gender = packet.gender;
 
     if (!disguiseId && dstBeing->getType() == ActorType::Player)
     {
@@ -1268,8 +1274,10 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
         setServerGender(dstBeing, gender);
     }
 
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
+    const uint16_t srcX = packet.path.srcX;
+    const uint16_t srcY = packet.path.srcY;
+    const uint16_t dstX = packet.path.dstX;
+    const uint16_t dstY = packet.path.dstY;
     if (!disguiseId)
     {
         dstBeing->setAction(BeingAction::STAND, 0);
@@ -1278,12 +1286,6 @@ void BeingHandler::processBeingMove(Net::MessageIn &msg)
             dstBeing->setDestination(dstX, dstY);
     }
 
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-    msg.readUInt8("unknown");
-
     dstBeing->setStunMode(stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
         (statusEffects >> 16) & 0xffff));
@@ -1296,25 +1298,17 @@ void BeingHandler::processBeingSpawn(Net::MessageIn &msg)
 {
     BLOCK_START("BeingHandler::processBeingSpawn")
     // skipping this packet
-    mSpawnId = msg.readInt32("being id");
-    msg.readInt16("speed");
-    msg.readInt16("opt1");
-    msg.readInt16("opt2");
-    msg.readInt16("option");
-    msg.readInt16("disguise");
-    msg.skip(25, "unused");
+    BeingSpawnPacket packet;
+    if (packet.decode(msg))
+        mSpawnId = packet.beingId;
     BLOCK_END("BeingHandler::processBeingSpawn")
 }
 
 void BeingHandler::processSkillCasting(Net::MessageIn &msg)
 {
-    msg.readInt32("src id");
-    msg.readInt32("dst id");
-    msg.readInt16("dst x");
-    msg.readInt16("dst y");
-    msg.readInt16("skill num");
-    msg.readInt32("skill get p1");
-    msg.readInt32("cast time");
+    SkillCastingPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processBeingStatusChange(Net::MessageIn &msg)
@@ -1327,14 +1321,17 @@ void BeingHandler::processBeingStatusChange(Net::MessageIn &msg)
     }
 
     // Status change
-    const uint16_t status = msg.readInt16("status");
-    const int id = msg.readInt32("being id");
-    const Enable flag = fromBool(
-        msg.readUInt8("flag: 0: stop, 1: start"), Enable);
+    BeingStatusChangePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingStatusChange")
+        return;
+    }
 
-    Being *const dstBeing = actorManager->findBeing(id);
+    const Enable flag = fromBool(packet.flag, Enable);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
-        dstBeing->setStatusEffect(status, flag);
+        dstBeing->setStatusEffect(packet.status, flag);
     BLOCK_END("BeingHandler::processBeingStatusChange")
 }
 
@@ -1352,7 +1349,14 @@ void BeingHandler::processBeingMove2(Net::MessageIn &msg)
       * later versions of eAthena for both mobs and
       * players
       */
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingMove2Packet packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingMove2")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
     /*
       * This packet doesn't have enough info to actually
@@ -1366,13 +1370,10 @@ void BeingHandler::processBeingMove2(Net::MessageIn &msg)
         return;
     }
 
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readInt32("tick");
-
+    const Net::CoordinatePair &path = packet.path;
     dstBeing->setAction(BeingAction::STAND, 0);
-    dstBeing->setTileCoords(srcX, srcY);
-    dstBeing->setDestination(dstX, dstY);
+    dstBeing->setTileCoords(path.srcX, path.srcY);
+    dstBeing->setDestination(path.dstX, path.dstY);
     if (dstBeing->getType() == ActorType::Player)
         dstBeing->setMoveTime();
     BLOCK_END("BeingHandler::processBeingMove2")
@@ -1387,20 +1388,23 @@ void BeingHandler::processBeingChangeDirection(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingChangeDirectionPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingChangeDirection")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
     if (!dstBeing)
     {
-        msg.readInt16("unused");
-        msg.readUInt8("direction");
         BLOCK_END("BeingHandler::processBeingChangeDirection");
         return;
     }
 
-    msg.readInt16("unused");
-
     const uint8_t dir = Net::MessageIn::fromServerDirection(
-        static_cast<uint8_t>(msg.readUInt8("direction") & 0x0FU));
+        static_cast<uint8_t>(packet.direction & 0x0FU));
     dstBeing->setDirection(dir);
     if (localPlayer)
         localPlayer->imitateDirection(dstBeing, dir);
@@ -1470,17 +1474,24 @@ void BeingHandler::processPlaterStatusChange(Net::MessageIn &msg)
     }
 
     // Change in players' flags
-    const int id = msg.readInt32("account id");
-    Being *const dstBeing = actorManager->findBeing(id);
+    PlayerStatusChangePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
+    {
+        BLOCK_END("BeingHandler::processPlayerStop")
         return;
+    }
 
-    const uint16_t stunMode = msg.readInt16("stun mode");
-    uint32_t statusEffects = msg.readInt16("status effect");
-    statusEffects |= (static_cast<uint32_t>(msg.readInt16("opt?"))) << 16;
-    msg.readUInt8("Unused?");
+    const uint32_t statusEffects = packet.statusEffects
+        | (static_cast<uint32_t>(packet.option) << 16);
 
-    dstBeing->setStunMode(stunMode);
+    dstBeing->setStunMode(packet.stunMode);
     dstBeing->setStatusEffectBlock(0, static_cast<uint16_t>(
         (statusEffects >> 16) & 0xffff));
     dstBeing->setStatusEffectBlock(16, static_cast<uint16_t>(
@@ -1498,9 +1509,14 @@ void BeingHandler::processBeingResurrect(Net::MessageIn &msg)
     }
 
     // A being changed mortality status
+    BeingResurrectPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingResurrect")
+        return;
+    }
 
-    const int id = msg.readInt32("being id");
-    Being *const dstBeing = actorManager->findBeing(id);
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (!dstBeing)
     {
         BLOCK_END("BeingHandler::processBeingResurrect")
@@ -1511,7 +1527,7 @@ void BeingHandler::processBeingResurrect(Net::MessageIn &msg)
     if (dstBeing == localPlayer->getTarget())
         localPlayer->stopAttack();
 
-    if (msg.readUInt8("flag?") == 1U)
+    if (packet.flag == 1U)
         dstBeing->setAction(BeingAction::STAND, 0);
     BLOCK_END("BeingHandler::processBeingResurrect")
 }
@@ -1525,30 +1541,24 @@ void BeingHandler::processPlayerGuilPartyInfo(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    PlayerGuildPartyInfoPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processPlayerGuilPartyInfo")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
 
     if (dstBeing)
     {
-        dstBeing->setPartyName(msg.readString(24, "party name"));
+        dstBeing->setPartyName(packet.partyName.str());
         if (!guildManager || !GuildManager::getEnableGuildBot())
         {
-            dstBeing->setGuildName(msg.readString(24, "guild name"));
-            dstBeing->setGuildPos(msg.readString(24, "guild pos"));
-        }
-        else
-        {
-            msg.readString(24, "guild name");
-            msg.readString(24, "guild pos");
+            dstBeing->setGuildName(packet.guildName.str());
+            dstBeing->setGuildPos(packet.guildPos.str());
         }
         dstBeing->addToCache();
-        msg.readString(24, "?");
-    }
-    else
-    {
-        msg.readString(24, "party name");
-        msg.readString(24, "guild name");
-        msg.readString(24, "guild pos");
-        msg.readString(24, "?");
     }
     BLOCK_END("BeingHandler::processPlayerGuilPartyInfo")
 }
@@ -1562,15 +1572,21 @@ void BeingHandler::processBeingSelfEffect(Net::MessageIn &msg)
         return;
     }
 
-    const int id = static_cast<uint32_t>(msg.readInt32("being id"));
-    Being *const being = actorManager->findBeing(id);
+    BeingSelfEffectPacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processBeingSelfEffect")
+        return;
+    }
+
+    Being *const being = actorManager->findBeing(packet.beingId);
     if (!being)
     {
         BLOCK_END("BeingHandler::processBeingSelfEffect")
         return;
     }
 
-    const int effectType = msg.readInt32("effect type");
+    const int effectType = packet.effectType;
 
     if (Particle::enabled)
         effectManager->trigger(effectType, being);
@@ -1586,7 +1602,9 @@ void BeingHandler::processBeingSelfEffect(Net::MessageIn &msg)
 
 void BeingHandler::processSkillCastCancel(Net::MessageIn &msg)
 {
-    msg.readInt32("skill id");
+    SkillCastCancelPacket packet;
+    if (!packet.decode(msg))
+        return;
 }
 
 void BeingHandler::processIpResponse(Net::MessageIn &msg)
@@ -1598,9 +1616,16 @@ void BeingHandler::processIpResponse(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(msg.readInt32("being id"));
+    BeingIpResponsePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("BeingHandler::processIpResponse")
+        return;
+    }
+
+    Being *const dstBeing = actorManager->findBeing(packet.beingId);
     if (dstBeing)
-        dstBeing->setIp(ipToString(msg.readInt32("ip address")));
+        dstBeing->setIp(ipToString(packet.ip));
     BLOCK_END("BeingHandler::processIpResponse")
 }
 
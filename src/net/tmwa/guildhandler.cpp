@@ -401,7 +401,7 @@ void GuildHandler::processGuildExpulsion(Net::MessageIn &msg)
     msg.readInt16("len?");
     const std::string nick = msg.readString(24, "name?");
     msg.skip(24, "player name");
-    msg.readString(44, "message");
+    msg.readStringView(44, "message");
     processGuildExpulsionContinue(nick);
 }
 
@@ -415,9 +415,9 @@ void GuildHandler::processGuildExpulsionList(Net::MessageIn &msg)
 
     for (int i = 0; i < count; i++)
     {
-        msg.readString(24, "name of expulsed");
-        msg.readString(24, "name of expluser");
-        msg.readString(24, "message");
+        msg.readStringView(24, "name of expulsed");
+        msg.readStringView(24, "name of expluser");
+        msg.readStringView(24, "message");
     }
 }
 
@@ -0,0 +1,97 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/tmwa/messagein.h"
+
+#include "logger.h"
+
+#include "net/packetcounters.h"
+
+#include "utils/delete2.h"
+
+#include "gtest/gtest.h"
+
+#include "debug.h"
+
+extern volatile bool runCounters;
+
+namespace
+{
+    // SMSG_BEING_CHAT like packet with raw string and hidden part
+    const char chat[] =
+    {
+        '\x8d', '\x00', '\x17', '\x00',
+        'n', 'a', 'm', 'e', '\0', '\0',
+        'h', 'i', ' ', 'a', 'l', 'l', '\0',
+        'x', 'y', '\0', '\0',
+        '\x01', '\x02'
+    };
+}  // namespace
+
+TEST(MessageIn, readStringView)
+{
+    logger = new Logger();
+
+    TmwAthena::MessageIn msg(chat, sizeof(chat));
+    msg.postInit();
+    EXPECT_EQ(0x17, msg.readInt16("len"));
+    const StringView name = msg.readStringView(6, "name");
+    EXPECT_EQ(4U, name.size());
+    EXPECT_TRUE(name == "name");
+    EXPECT_TRUE(name == std::string("name"));
+    EXPECT_TRUE(name != "nam");
+    EXPECT_TRUE(name != "names");
+    EXPECT_EQ(chat + 4, name.data());
+
+    StringView hidden;
+    const StringView text = msg.readRawStringView(11, hidden, "message");
+    EXPECT_EQ("hi all", text.str());
+    EXPECT_EQ("xy", hidden.str());
+    EXPECT_EQ(2U, msg.getUnreadLength());
+
+    const StringView error = msg.readStringView(10, "error");
+    EXPECT_TRUE(error.empty());
+    EXPECT_TRUE(error == "");
+
+    delete2(logger);
+}
+
+TEST(MessageIn, readRawString)
+{
+    logger = new Logger();
+    const bool counters = runCounters;
+    runCounters = true;
+    const int strings = PacketCounters::mInStrings;
+
+    TmwAthena::MessageIn msg(chat, sizeof(chat));
+    msg.postInit();
+    msg.readInt16("len");
+    msg.readStringView(6, "name");
+    EXPECT_EQ("hi all|xy", msg.readRawString(11, "message"));
+    // position moved to end of string even with hidden part
+    EXPECT_EQ(0x0201, msg.readInt16("unused"));
+    EXPECT_EQ(0U, msg.getUnreadLength());
+
+    // only readRawString allocated string
+    EXPECT_EQ(strings + 1, PacketCounters::mInStrings);
+
+    runCounters = counters;
+    delete2(logger);
+}
@@ -46,6 +46,11 @@ MessageOut::MessageOut(const int16_t id, const char *const str) :
     writeInt16(id, str);
 }
 
+MessageOut::~MessageOut()
+{
+    mNetwork->flush();
+}
+
 void MessageOut::expand(const size_t bytes)
 {
     mNetwork->mOutSize += static_cast<unsigned>(bytes);
@@ -48,6 +48,11 @@ class MessageOut final : public Net::MessageOut
 
         A_DELETE_COPY(MessageOut)
 
+        /**
+         * Destructor. Packet is complete and queued for sending.
+         */
+        ~MessageOut();
+
         /**< Writes a short. */
         void writeInt16(const int16_t value,
                         const char *const str) override final;
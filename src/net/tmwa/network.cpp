@@ -27,8 +27,11 @@
 #include "net/tmwa/messagehandler.h"
 #include "net/tmwa/messagein.h"
 #include "net/tmwa/packets.h"
+#include "net/tmwa/packetschema.h"
 #include "net/tmwa/protocol.h"
 
+#include "net/packetcounters.h"
+
 #include "utils/delete2.h"
 
 #include "debug.h"
@@ -41,12 +44,39 @@ static const unsigned int packet_lengths_size
 static const unsigned int messagesSize = 0xFFFFU;
 Network *Network::mInstance = nullptr;
 
+// being state packets, where last packet for being overrides previous,
+// and packets what limit replacing
+static const Ea::CoalescePacket coalesceRules[] =
+{
+    {SMSG_BEING_MOVE,             2, 0, 0, Ea::COALESCE_SPAWNED},
+    {SMSG_BEING_MOVE2,            2, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_MOVE3,            4, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_PLAYER_MOVE,            2, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_PLAYER_STOP,            2, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_CHANGE_DIRECTION, 2, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_CHANGE_LOOKS,     2, 6, 1, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_CHANGE_LOOKS2,    2, 6, 1, Ea::COALESCE_REPLACE},
+    {SMSG_PLAYER_STATUS_CHANGE,   2, 0, 0, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_STATUS_CHANGE,    4, 2, 2, Ea::COALESCE_REPLACE},
+    {SMSG_BEING_VISIBLE,          2, 0, 0,
+        Ea::COALESCE_BARRIER | Ea::COALESCE_SPAWNED},
+    {SMSG_BEING_SPAWN,            2, 0, 0,
+        Ea::COALESCE_BARRIER | Ea::COALESCE_SPAWN},
+    {SMSG_PLAYER_UPDATE_1,        2, 0, 0, Ea::COALESCE_BARRIER},
+    {SMSG_PLAYER_UPDATE_2,        2, 0, 0, Ea::COALESCE_BARRIER},
+    {SMSG_BEING_REMOVE,           2, 0, 0, Ea::COALESCE_BARRIER},
+    {0,                           0, 0, 0, Ea::COALESCE_REPLACE}
+};
+
 Network::Network() :
     Ea::Network(),
-    mMessageHandlers(new MessageHandler*[messagesSize])
+    mMessageHandlers(new MessageHandler*[messagesSize]),
+    mCoalescer(coalesceRules)
 {
     mInstance = this;
     memset(&mMessageHandlers[0], 0, sizeof(MessageHandler*) * 0xffff);
+    if (!applyPacketSchemas())
+        logger->log1("Error: packet schemas not match packet lengths");
 }
 
 Network::~Network()
@@ -56,6 +86,30 @@ Network::~Network()
     mInstance = nullptr;
 }
 
+#define APPLY_PACKET_SCHEMA(id, packet) \
+    if (!Net::applyPacketSchema<packet>(packet_lengths, \
+        packet_lengths_size, id)) \
+    { \
+        logger->log("Packet schema %s length %d not match packet 0x%04x", \
+            packet::getName(), static_cast<int>(packet::length), \
+            static_cast<unsigned int>(id)); \
+        ok = false; \
+    }
+
+bool Network::applyPacketSchemas()
+{
+    bool ok = true;
+    TMWA_PACKET_SCHEMAS(APPLY_PACKET_SCHEMA)
+    return ok;
+}
+
+#undef APPLY_PACKET_SCHEMA
+
+const Ea::CoalescePacket *Network::getCoalesceRules()
+{
+    return coalesceRules;
+}
+
 void Network::registerHandler(MessageHandler *const handler)
 {
     if (!handler)
@@ -94,6 +148,10 @@ void Network::dispatchMessages()
 {
     BLOCK_START("Network::dispatchMessages 1")
     mPauseDispatch = false;
+    const bool coalesce = mCoalesce;
+    if (coalesce)
+        coalescePackets();
+    size_t index = 0;
     while (messageReady())
     {
         SDL_mutexP(mMutexIn);
@@ -110,6 +168,15 @@ void Network::dispatchMessages()
         if (len == -1)
             len = readWord(2);
 
+        if (coalesce && mCoalescer.isReplaced(index ++))
+        {
+            SDL_mutexV(mMutexIn);
+            BLOCK_END("Network::dispatchMessages 2")
+            PacketCounters::incInCoalesced();
+            skip(len);
+            continue;
+        }
+
         MessageIn msg(mInBuffer, len);
         msg.postInit();
         SDL_mutexV(mMutexIn);
@@ -145,6 +212,42 @@ void Network::dispatchMessages()
     BLOCK_END("Network::dispatchMessages 1")
 }
 
+int Network::getPacketLength(const unsigned int msgId,
+                             const unsigned int pos) const
+{
+    int len = -1;
+    if (msgId == SMSG_SERVER_VERSION_RESPONSE)
+        len = 10;
+    else if (msgId == SMSG_UPDATE_HOST2)
+        len = -1;
+    else if (msgId < packet_lengths_size)
+        len = packet_lengths[msgId];
+
+    if (len == -1 && pos + 4 <= mInSize)
+        len = readWord(static_cast<int>(pos + 2));
+    return len;
+}
+
+void Network::coalescePackets()
+{
+    BLOCK_START("Network::coalescePackets")
+    mCoalescer.clear();
+    SDL_mutexP(mMutexIn);
+    unsigned int pos = 0;
+    while (pos + 2 <= mInSize)
+    {
+        const unsigned int msgId = readWord(static_cast<int>(pos));
+        const int len = getPacketLength(msgId, pos);
+        if (len <= 0 || pos + len > mInSize)
+            break;
+        mCoalescer.add(mInBuffer + pos, msgId, len);
+        pos += len;
+    }
+    SDL_mutexV(mMutexIn);
+    mCoalescer.process();
+    BLOCK_END("Network::coalescePackets")
+}
+
 bool Network::messageReady()
 {
     int len = -1;
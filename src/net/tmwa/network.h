@@ -24,6 +24,7 @@
 #define NET_TMWA_NETWORK_H
 
 #include "net/ea/network.h"
+#include "net/ea/packetcoalescer.h"
 
 /**
  * Protocol version, reported to the eAthena char and mapserver who can adjust
@@ -55,13 +56,32 @@ class Network final : public Ea::Network
 
         void dispatchMessages();
 
+        /**
+         * Writes lengths of packets with schemas into packet lengths.
+         * Returns false if some length was different before.
+         */
+        static bool applyPacketSchemas() A_WARN_UNUSED;
+
+        /**
+         * Returns being packets coalescing rules, ended by packet with
+         * msgId 0.
+         */
+        static const Ea::CoalescePacket *getCoalesceRules() A_WARN_UNUSED;
+
     protected:
         friend class MessageOut;
 
         static Network *instance() A_WARN_UNUSED;
 
+        int getPacketLength(const unsigned int msgId,
+                            const unsigned int pos) const A_WARN_UNUSED;
+
+        void coalescePackets();
+
         MessageHandler **mMessageHandlers;
 
+        Ea::PacketCoalescer mCoalescer;
+
         static Network *mInstance;
 };
 
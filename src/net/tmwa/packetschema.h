@@ -0,0 +1,313 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_TMWA_PACKETSCHEMA_H
+#define NET_TMWA_PACKETSCHEMA_H
+
+#include "net/ea/packetschema.h"
+
+#include "net/tmwa/protocol.h"
+
+namespace TmwAthena
+{
+
+// SMSG_BEING_MOVE2
+#define BEING_MOVE2_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::CoordinatePair, path) \
+    F(Net::Skip<1>, unused) \
+    F(int32_t, tick)
+PACKET_SCHEMA(BeingMove2Packet, BEING_MOVE2_FIELDS)
+
+// SMSG_BEING_CHANGE_DIRECTION
+#define BEING_CHANGE_DIRECTION_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::Skip<2>, unused) \
+    F(uint8_t, direction)
+PACKET_SCHEMA(BeingChangeDirectionPacket, BEING_CHANGE_DIRECTION_FIELDS)
+
+// SMSG_BEING_STATUS_CHANGE
+#define BEING_STATUS_CHANGE_FIELDS(F) \
+    F(uint16_t, status) \
+    F(int32_t, beingId) \
+    F(uint8_t, flag)
+PACKET_SCHEMA(BeingStatusChangePacket, BEING_STATUS_CHANGE_FIELDS)
+
+// SMSG_PLAYER_STATUS_CHANGE
+#define PLAYER_STATUS_CHANGE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint16_t, stunMode) \
+    F(int16_t, statusEffects) \
+    F(int16_t, option) \
+    F(Net::Skip<1>, unused)
+PACKET_SCHEMA(PlayerStatusChangePacket, PLAYER_STATUS_CHANGE_FIELDS)
+
+// SMSG_BEING_CHANGE_LOOKS
+#define BEING_CHANGE_LOOKS_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, type) \
+    F(uint8_t, id)
+PACKET_SCHEMA(BeingChangeLooksPacket, BEING_CHANGE_LOOKS_FIELDS)
+
+// SMSG_BEING_CHANGE_LOOKS2
+#define BEING_CHANGE_LOOKS2_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, type) \
+    F(int16_t, id1) \
+    F(int16_t, id2)
+PACKET_SCHEMA(BeingChangeLooks2Packet, BEING_CHANGE_LOOKS2_FIELDS)
+
+// Common head of player update and move packets
+#define PLAYER_HEAD_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, speed) \
+    F(uint16_t, stunMode) \
+    F(int16_t, statusEffects) \
+    F(int16_t, option) \
+    F(int16_t, job) \
+    F(uint8_t, hairStyle) \
+    F(uint8_t, look) \
+    F(uint16_t, weapon) \
+    F(uint16_t, shield) \
+    F(uint16_t, headBottom)
+
+// Player looks and guild after head
+#define PLAYER_LOOKS_FIELDS(F) \
+    F(uint16_t, headTop) \
+    F(uint16_t, headMid) \
+    F(uint8_t, hairColor) \
+    F(Net::Skip<1>, unused1) \
+    F(uint8_t, color0) \
+    F(uint8_t, color1) \
+    F(uint8_t, color2) \
+    F(Net::Skip<1>, unused2) \
+    F(int32_t, guild) \
+    F(int16_t, emblem) \
+    F(int16_t, manner) \
+    F(uint16_t, opt3) \
+    F(uint8_t, karma) \
+    F(uint8_t, gender)
+
+// SMSG_PLAYER_UPDATE_2
+#define PLAYER_UPDATE2_FIELDS(F) \
+    PLAYER_HEAD_FIELDS(F) \
+    PLAYER_LOOKS_FIELDS(F) \
+    F(Net::Coordinates, position) \
+    F(uint16_t, gmStatus) \
+    F(uint8_t, actionType) \
+    F(uint8_t, level)
+PACKET_SCHEMA(PlayerUpdate2Packet, PLAYER_UPDATE2_FIELDS)
+
+// SMSG_PLAYER_UPDATE_1
+#define PLAYER_UPDATE1_FIELDS(F) \
+    PLAYER_UPDATE2_FIELDS(F) \
+    F(Net::Skip<1>, unused3)
+PACKET_SCHEMA(PlayerUpdate1Packet, PLAYER_UPDATE1_FIELDS)
+
+// SMSG_PLAYER_MOVE
+#define PLAYER_MOVE_FIELDS(F) \
+    PLAYER_HEAD_FIELDS(F) \
+    F(int32_t, tick) \
+    PLAYER_LOOKS_FIELDS(F) \
+    F(Net::CoordinatePair, path) \
+    F(uint16_t, gmStatus) \
+    F(Net::Skip<1>, unused3) \
+    F(uint8_t, level) \
+    F(Net::Skip<1>, unused4)
+PACKET_SCHEMA(PlayerMovePacket, PLAYER_MOVE_FIELDS)
+
+// Monster hp in being visible and move packets
+#define BEING_HP_FIELDS(F) \
+    F(int32_t, hp) \
+    F(int32_t, maxHP)
+PACKET_BLOCK(BeingHpBlock, BEING_HP_FIELDS)
+
+// Player gloves and guild in being visible and move packets
+#define BEING_GUILD_FIELDS(F) \
+    F(uint16_t, gloves) \
+    F(int32_t, guild) \
+    F(int16_t, emblem)
+PACKET_BLOCK(BeingGuildBlock, BEING_GUILD_FIELDS)
+
+// Common head of being visible and move packets
+#define BEING_HEAD_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, speed) \
+    F(uint16_t, stunMode) \
+    F(int16_t, statusEffects) \
+    F(int16_t, option) \
+    F(int16_t, job) \
+    F(uint8_t, hairStyle) \
+    F(uint8_t, look) \
+    F(uint16_t, weapon) \
+    F(uint16_t, headBottom)
+
+// Being looks after head. Extra is BeingHpBlock for monsters,
+// BeingGuildBlock for others.
+#define BEING_LOOKS_FIELDS(F) \
+    F(uint16_t, shield) \
+    F(uint16_t, headTop) \
+    F(uint16_t, headMid) \
+    F(uint8_t, hairColor) \
+    F(Net::Skip<1>, unused1) \
+    F(uint16_t, shoes) \
+    F(Net::Bytes<8>, extra) \
+    F(int16_t, manner) \
+    F(uint16_t, opt3) \
+    F(uint8_t, karma) \
+    F(uint8_t, gender)
+
+// SMSG_BEING_VISIBLE
+#define BEING_VISIBLE_FIELDS(F) \
+    BEING_HEAD_FIELDS(F) \
+    BEING_LOOKS_FIELDS(F) \
+    F(Net::Coordinates, position) \
+    F(Net::Skip<5>, unused2)
+PACKET_SCHEMA(BeingVisiblePacket, BEING_VISIBLE_FIELDS)
+
+// SMSG_BEING_MOVE
+#define BEING_MOVE_FIELDS(F) \
+    BEING_HEAD_FIELDS(F) \
+    F(int32_t, tick) \
+    BEING_LOOKS_FIELDS(F) \
+    F(Net::CoordinatePair, path) \
+    F(Net::Skip<5>, unused2)
+PACKET_SCHEMA(BeingMovePacket, BEING_MOVE_FIELDS)
+
+// SMSG_BEING_SPAWN
+#define BEING_SPAWN_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int16_t, speed) \
+    F(int16_t, opt1) \
+    F(int16_t, opt2) \
+    F(int16_t, option) \
+    F(int16_t, disguise) \
+    F(Net::Skip<25>, unused)
+PACKET_SCHEMA(BeingSpawnPacket, BEING_SPAWN_FIELDS)
+
+// SMSG_SKILL_CASTING
+#define SKILL_CASTING_FIELDS(F) \
+    F(int32_t, srcId) \
+    F(int32_t, dstId) \
+    F(int16_t, dstX) \
+    F(int16_t, dstY) \
+    F(int16_t, skillNum) \
+    F(int32_t, skillGetP1) \
+    F(int32_t, castTime)
+PACKET_SCHEMA(SkillCastingPacket, SKILL_CASTING_FIELDS)
+
+// SMSG_BEING_RESURRECT
+#define BEING_RESURRECT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(uint8_t, flag) \
+    F(Net::Skip<1>, unused)
+PACKET_SCHEMA(BeingResurrectPacket, BEING_RESURRECT_FIELDS)
+
+// SMSG_PLAYER_GUILD_PARTY_INFO
+#define PLAYER_GUILD_PARTY_INFO_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(Net::String<24>, partyName) \
+    F(Net::String<24>, guildName) \
+    F(Net::String<24>, guildPos) \
+    F(Net::Skip<24>, unused)
+PACKET_SCHEMA(PlayerGuildPartyInfoPacket, PLAYER_GUILD_PARTY_INFO_FIELDS)
+
+// SMSG_BEING_SELFEFFECT
+#define BEING_SELFEFFECT_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, effectType)
+PACKET_SCHEMA(BeingSelfEffectPacket, BEING_SELFEFFECT_FIELDS)
+
+// SMSG_SKILL_CAST_CANCEL
+#define SKILL_CAST_CANCEL_FIELDS(F) \
+    F(int32_t, skillId)
+PACKET_SCHEMA(SkillCastCancelPacket, SKILL_CAST_CANCEL_FIELDS)
+
+// SMSG_BEING_IP_RESPONSE
+#define BEING_IP_RESPONSE_FIELDS(F) \
+    F(int32_t, beingId) \
+    F(int32_t, ip)
+PACKET_SCHEMA(BeingIpResponsePacket, BEING_IP_RESPONSE_FIELDS)
+
+// SMSG_PLAYER_STAT_UPDATE_5
+#define PLAYER_STAT_UPDATE5_FIELDS(F) \
+    F(int16_t, charPoints) \
+    F(uint8_t, strBase) \
+    F(uint8_t, strCost) \
+    F(uint8_t, agiBase) \
+    F(uint8_t, agiCost) \
+    F(uint8_t, vitBase) \
+    F(uint8_t, vitCost) \
+    F(uint8_t, intBase) \
+    F(uint8_t, intCost) \
+    F(uint8_t, dexBase) \
+    F(uint8_t, dexCost) \
+    F(uint8_t, lukBase) \
+    F(uint8_t, lukCost) \
+    F(int16_t, atk) \
+    F(int16_t, atkMod) \
+    F(int16_t, matk) \
+    F(int16_t, matkMod) \
+    F(int16_t, def) \
+    F(int16_t, defMod) \
+    F(int16_t, mdef) \
+    F(int16_t, mdefMod) \
+    F(int16_t, hit) \
+    F(int16_t, flee) \
+    F(int16_t, fleeMod) \
+    F(int16_t, crit) \
+    F(int16_t, manner) \
+    F(Net::Skip<2>, unused)
+PACKET_SCHEMA(PlayerStatUpdate5Packet, PLAYER_STAT_UPDATE5_FIELDS)
+
+// SMSG_WALK_RESPONSE
+#define WALK_RESPONSE_FIELDS(F) \
+    F(int32_t, tick) \
+    F(Net::CoordinatePair, path) \
+    F(Net::Skip<1>, unused)
+PACKET_SCHEMA(WalkResponsePacket, WALK_RESPONSE_FIELDS)
+
+// all schemas, lengths written into packet lengths on network start
+#define TMWA_PACKET_SCHEMAS(F) \
+    EA_PACKET_SCHEMAS(F) \
+    F(SMSG_BEING_MOVE2, BeingMove2Packet) \
+    F(SMSG_BEING_CHANGE_DIRECTION, BeingChangeDirectionPacket) \
+    F(SMSG_BEING_STATUS_CHANGE, BeingStatusChangePacket) \
+    F(SMSG_PLAYER_STATUS_CHANGE, PlayerStatusChangePacket) \
+    F(SMSG_BEING_CHANGE_LOOKS, BeingChangeLooksPacket) \
+    F(SMSG_BEING_CHANGE_LOOKS2, BeingChangeLooks2Packet) \
+    F(SMSG_PLAYER_UPDATE_1, PlayerUpdate1Packet) \
+    F(SMSG_PLAYER_UPDATE_2, PlayerUpdate2Packet) \
+    F(SMSG_PLAYER_MOVE, PlayerMovePacket) \
+    F(SMSG_BEING_VISIBLE, BeingVisiblePacket) \
+    F(SMSG_BEING_MOVE, BeingMovePacket) \
+    F(SMSG_BEING_SPAWN, BeingSpawnPacket) \
+    F(SMSG_SKILL_CASTING, SkillCastingPacket) \
+    F(SMSG_BEING_RESURRECT, BeingResurrectPacket) \
+    F(SMSG_PLAYER_GUILD_PARTY_INFO, PlayerGuildPartyInfoPacket) \
+    F(SMSG_BEING_SELFEFFECT, BeingSelfEffectPacket) \
+    F(SMSG_SKILL_CAST_CANCEL, SkillCastCancelPacket) \
+    F(SMSG_BEING_IP_RESPONSE, BeingIpResponsePacket) \
+    F(SMSG_PLAYER_STAT_UPDATE_5, PlayerStatUpdate5Packet) \
+    F(SMSG_WALK_RESPONSE, WalkResponsePacket)
+
+}  // namespace TmwAthena
+
+#endif  // NET_TMWA_PACKETSCHEMA_H
@@ -0,0 +1,176 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/tmwa/packetschema.h"
+
+#include "logger.h"
+
+#include "net/tmwa/messagein.h"
+#include "net/tmwa/network.h"
+
+#include "utils/delete2.h"
+
+#include "gtest/gtest.h"
+
+#include <SDL_timer.h>
+
+#include "debug.h"
+
+namespace
+{
+    typedef Net::PacketSchemaStats<TmwAthena::BeingMove2Packet> Move2Stats;
+
+    // SMSG_BEING_MOVE2 from 150000, path 100,200 -> 101,198
+    const char move2[] =
+    {
+        '\x86', '\x00', '\xf0', '\x49', '\x02', '\x00',
+        '\x19', '\x0c', '\x81', '\x94', '\xc6',
+        '\x88', '\x01', '\x02', '\x03', '\x04'
+    };
+}  // namespace
+
+TEST(PacketSchema, decode)
+{
+    logger = new Logger();
+
+    // packet sizes from packet_lengths without packet id
+    EXPECT_EQ(14, static_cast<int>(
+        TmwAthena::BeingMove2Packet::size));
+    EXPECT_EQ(7, static_cast<int>(
+        TmwAthena::BeingChangeDirectionPacket::size));
+    EXPECT_EQ(7, static_cast<int>(
+        TmwAthena::BeingStatusChangePacket::size));
+    EXPECT_EQ(11, static_cast<int>(
+        TmwAthena::PlayerStatusChangePacket::size));
+
+    // lengths with packet id, as was in packet_lengths before schemas
+    EXPECT_EQ(54, static_cast<int>(
+        TmwAthena::PlayerUpdate1Packet::length));
+    EXPECT_EQ(60, static_cast<int>(
+        TmwAthena::PlayerMovePacket::length));
+    EXPECT_EQ(54, static_cast<int>(
+        TmwAthena::BeingVisiblePacket::length));
+    EXPECT_EQ(60, static_cast<int>(
+        TmwAthena::BeingMovePacket::length));
+    EXPECT_EQ(-1, static_cast<int>(
+        Ea::BeingNameResponse2Packet::length));
+    EXPECT_TRUE(TmwAthena::Network::applyPacketSchemas());
+
+    // stats of all schemas listed for debug window
+    bool found = false;
+    for (const Net::PacketStats *stats = Net::PacketStats::getFirst();
+         stats;
+         stats = stats->next)
+    {
+        if (stats == &Move2Stats::stats)
+            found = true;
+    }
+    EXPECT_TRUE(found);
+    EXPECT_EQ(14, Move2Stats::stats.size);
+
+    uint16_t srcX = 0;
+    uint16_t srcY = 0;
+    uint16_t dstX = 0;
+    uint16_t dstY = 0;
+    int id = 0;
+    int tick = 0;
+    {
+        TmwAthena::MessageIn msg(move2, sizeof(move2));
+        msg.postInit();
+        id = msg.readInt32("being id");
+        msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
+        msg.readUInt8("unused");
+        tick = msg.readInt32("tick");
+    }
+    EXPECT_EQ(150000, id);
+    EXPECT_EQ(100, srcX);
+    EXPECT_EQ(200, srcY);
+    EXPECT_EQ(101, dstX);
+    EXPECT_EQ(198, dstY);
+
+    const unsigned int decoded = Move2Stats::stats.decoded;
+    {
+        TmwAthena::MessageIn msg(move2, sizeof(move2));
+        msg.postInit();
+        TmwAthena::BeingMove2Packet packet;
+        EXPECT_TRUE(packet.decode(msg));
+        EXPECT_EQ(id, packet.beingId);
+        EXPECT_EQ(srcX, packet.path.srcX);
+        EXPECT_EQ(srcY, packet.path.srcY);
+        EXPECT_EQ(dstX, packet.path.dstX);
+        EXPECT_EQ(dstY, packet.path.dstY);
+        EXPECT_EQ(tick, packet.tick);
+        EXPECT_EQ(0U, msg.getUnreadLength());
+    }
+    EXPECT_EQ(decoded + 1, Move2Stats::stats.decoded);
+
+    // too short packet
+    const unsigned int errors = Move2Stats::stats.errors;
+    {
+        TmwAthena::MessageIn msg(move2, sizeof(move2) - 1);
+        msg.postInit();
+        TmwAthena::BeingMove2Packet packet;
+        EXPECT_FALSE(packet.decode(msg));
+    }
+    EXPECT_EQ(errors + 1, Move2Stats::stats.errors);
+
+    delete2(logger);
+}
+
+TEST(PacketSchema, DISABLED_benchmark)
+{
+    logger = new Logger();
+    const int count = 1000000;
+
+    int sum1 = 0;
+    uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < count; f ++)
+    {
+        TmwAthena::MessageIn msg(move2, sizeof(move2));
+        msg.postInit();
+        uint16_t srcX;
+        uint16_t srcY;
+        uint16_t dstX;
+        uint16_t dstY;
+        msg.readInt32("being id");
+        msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
+        msg.readUInt8("unused");
+        msg.readInt32("tick");
+        sum1 += srcX + dstY;
+    }
+    logger->log("packetschema: %d packets read by fields in %d ms",
+        count, static_cast<int>(SDL_GetTicks() - startTime));
+
+    int sum2 = 0;
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < count; f ++)
+    {
+        TmwAthena::MessageIn msg(move2, sizeof(move2));
+        msg.postInit();
+        TmwAthena::BeingMove2Packet packet;
+        if (packet.decode(msg))
+            sum2 += packet.path.srcX + packet.path.dstY;
+    }
+    logger->log("packetschema: %d packets decoded by schema in %d ms",
+        count, static_cast<int>(SDL_GetTicks() - startTime));
+
+    EXPECT_EQ(sum1, sum2);
+    delete2(logger);
+}
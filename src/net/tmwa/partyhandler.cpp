@@ -419,8 +419,8 @@ void PartyHandler::processPartyMove(Net::MessageIn &msg)
         if (m->getOnline() != online)
             partyTab->showOnline(m->getName(), online);
         m->setOnline(online);
-        msg.readString(24, "party");
-        msg.readString(24, "nick");
+        msg.readStringView(24, "party");
+        msg.readStringView(24, "nick");
         m->setMap(msg.readString(16, "map"));
     }
     else
@@ -429,9 +429,9 @@ void PartyHandler::processPartyMove(Net::MessageIn &msg)
         msg.readInt16("x");
         msg.readInt16("y");
         msg.readUInt8("online");
-        msg.readString(24, "party");
-        msg.readString(24, "nick");
-        msg.readString(16, "map");
+        msg.readStringView(24, "party");
+        msg.readStringView(24, "nick");
+        msg.readStringView(16, "map");
     }
 }
 
@@ -30,6 +30,7 @@
 
 #include "net/tmwa/inventoryhandler.h"
 #include "net/tmwa/messageout.h"
+#include "net/tmwa/packetschema.h"
 #include "net/tmwa/protocol.h"
 
 #include "debug.h"
@@ -252,110 +253,63 @@ void PlayerHandler::updateStatus(const uint8_t status) const
 void PlayerHandler::processPlayerStatUpdate5(Net::MessageIn &msg)
 {
     BLOCK_START("PlayerHandler::processPlayerStatUpdate5")
-    PlayerInfo::setAttribute(Attributes::CHAR_POINTS,
-        msg.readInt16("char points"));
-
-    unsigned int val = msg.readUInt8("str");
-    PlayerInfo::setStatBase(Attributes::STR, val);
-    if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::STR,
-            msg.readUInt8("str cost"));
-    }
-    else
+    PlayerStatUpdate5Packet packet;
+    if (!packet.decode(msg))
     {
-        msg.readUInt8("str cost");
+        BLOCK_END("PlayerHandler::processPlayerStatUpdate5")
+        return;
     }
 
-    val = msg.readUInt8("agi");
-    PlayerInfo::setStatBase(Attributes::AGI, val);
+    PlayerInfo::setAttribute(Attributes::CHAR_POINTS, packet.charPoints);
+
+    PlayerInfo::setStatBase(Attributes::STR, packet.strBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::AGI,
-            msg.readUInt8("agi cost"));
-    }
-    else
-    {
-        msg.readUInt8("agi cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::STR, packet.strCost);
 
-    val = msg.readUInt8("vit");
-    PlayerInfo::setStatBase(Attributes::VIT, val);
+    PlayerInfo::setStatBase(Attributes::AGI, packet.agiBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::VIT,
-            msg.readUInt8("vit cost"));
-    }
-    else
-    {
-        msg.readUInt8("vit cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::AGI, packet.agiCost);
 
-    val = msg.readUInt8("int");
-    PlayerInfo::setStatBase(Attributes::INT, val);
+    PlayerInfo::setStatBase(Attributes::VIT, packet.vitBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::INT,
-            msg.readUInt8("int cost"));
-    }
-    else
-    {
-        msg.readUInt8("int cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::VIT, packet.vitCost);
 
-    val = msg.readUInt8("dex");
-    PlayerInfo::setStatBase(Attributes::DEX, val);
+    PlayerInfo::setStatBase(Attributes::INT, packet.intBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::DEX,
-            msg.readUInt8("dex cost"));
-    }
-    else
-    {
-        msg.readUInt8("dex cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::INT, packet.intCost);
 
-    val = msg.readUInt8("luk");
-    PlayerInfo::setStatBase(Attributes::LUK, val);
+    PlayerInfo::setStatBase(Attributes::DEX, packet.dexBase);
     if (statusWindow)
-    {
-        statusWindow->setPointsNeeded(Attributes::LUK,
-            msg.readUInt8("luk cost"));
-    }
-    else
-    {
-        msg.readUInt8("luk cost");
-    }
+        statusWindow->setPointsNeeded(Attributes::DEX, packet.dexCost);
 
-    PlayerInfo::setStatBase(Attributes::ATK,
-        msg.readInt16("atk"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::ATK, msg.readInt16("atk+"));
+    PlayerInfo::setStatBase(Attributes::LUK, packet.lukBase);
+    if (statusWindow)
+        statusWindow->setPointsNeeded(Attributes::LUK, packet.lukCost);
+
+    PlayerInfo::setStatBase(Attributes::ATK, packet.atk, Notify_false);
+    PlayerInfo::setStatMod(Attributes::ATK, packet.atkMod);
     PlayerInfo::updateAttrs();
 
-    val = msg.readInt16("matk");
+    unsigned int val = packet.matk;
     PlayerInfo::setStatBase(Attributes::MATK, val, Notify_false);
 
-    val = msg.readInt16("matk+");
+    val = packet.matkMod;
     PlayerInfo::setStatMod(Attributes::MATK, val);
 
-    PlayerInfo::setStatBase(Attributes::DEF,
-        msg.readInt16("def"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::DEF, msg.readInt16("def+"));
+    PlayerInfo::setStatBase(Attributes::DEF, packet.def, Notify_false);
+    PlayerInfo::setStatMod(Attributes::DEF, packet.defMod);
 
-    PlayerInfo::setStatBase(Attributes::MDEF,
-        msg.readInt16("mdef"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::MDEF, msg.readInt16("mdef+"));
+    PlayerInfo::setStatBase(Attributes::MDEF, packet.mdef, Notify_false);
+    PlayerInfo::setStatMod(Attributes::MDEF, packet.mdefMod);
 
-    PlayerInfo::setStatBase(Attributes::HIT, msg.readInt16("hit"));
+    PlayerInfo::setStatBase(Attributes::HIT, packet.hit);
 
-    PlayerInfo::setStatBase(Attributes::FLEE,
-        msg.readInt16("flee"), Notify_false);
-    PlayerInfo::setStatMod(Attributes::FLEE, msg.readInt16("flee+"));
+    PlayerInfo::setStatBase(Attributes::FLEE, packet.flee, Notify_false);
+    PlayerInfo::setStatMod(Attributes::FLEE, packet.fleeMod);
 
-    PlayerInfo::setStatBase(Attributes::CRIT, msg.readInt16("crit"));
+    PlayerInfo::setStatBase(Attributes::CRIT, packet.crit);
 
-    PlayerInfo::setStatBase(Attributes::MANNER, msg.readInt16("manner"));
-    msg.readInt16("unused?");
+    PlayerInfo::setStatBase(Attributes::MANNER, packet.manner);
     BLOCK_END("PlayerHandler::processPlayerStatUpdate5")
 }
 
@@ -367,12 +321,14 @@ void PlayerHandler::processWalkResponse(Net::MessageIn &msg)
       * and that the server will send a correction notice
       * otherwise.
       */
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readInt32("tick");
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readUInt8("unused");
+    WalkResponsePacket packet;
+    if (!packet.decode(msg))
+    {
+        BLOCK_END("PlayerHandler::processWalkResponse")
+        return;
+    }
     if (localPlayer)
-        localPlayer->setRealPos(dstX, dstY);
+        localPlayer->setRealPos(packet.path.dstX, packet.path.dstY);
     BLOCK_END("PlayerHandler::processWalkResponse")
 }
 
@@ -63,7 +63,8 @@ struct Options final
         chooseDefault(false),
         noOpenGL(false),
         safeMode(false),
-        testMode(false)
+        testMode(false),
+        headless(false)
     {}
 
     std::string username;
@@ -90,6 +91,7 @@ struct Options final
     bool noOpenGL;
     bool safeMode;
     bool testMode;
+    bool headless;
 };
 
 #endif  // OPTIONS_H
@@ -50,6 +50,8 @@ int Particle::maxCount = 0;
 int Particle::fastPhysics = 0;
 int Particle::emitterSkip = 1;
 bool Particle::enabled = true;
+Rect Particle::visibleArea;
+int Particle::pausedEmitters = 0;
 const float Particle::PARTICLE_SKY = 800.0F;
 
 Particle::Particle() :
@@ -198,8 +200,15 @@ bool Particle::update()
         }
 
         // Update child emitters
-        if (Particle::emitterSkip && (mLifetimePast - 1)
-            % Particle::emitterSkip == 0)
+        if (!mChildEmitters.empty() && visibleArea.width
+            && !visibleArea.isPointInRect(static_cast<int>(mPos.x),
+            static_cast<int>(mPos.y)))
+        {
+            // off-screen emitters are paused until became visible
+            pausedEmitters += static_cast<int>(mChildEmitters.size());
+        }
+        else if (Particle::emitterSkip && (mLifetimePast - 1)
+                 % Particle::emitterSkip == 0)
         {
             FOR_EACH (EmitterConstIterator, e, mChildEmitters)
             {
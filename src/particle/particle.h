@@ -25,6 +25,8 @@
 
 #include "being/actor.h"
 
+#include "gui/rect.h"
+
 #include "localconsts.h"
 
 class Color;
@@ -63,6 +65,9 @@ class Particle notfinal : public Actor
                                           // emitter updates in ticks
         static bool enabled;  // true when non-crucial particle effects
                               // are disabled
+        static Rect visibleArea;  // Emitters outside of this area are
+                                  // paused. Empty area disable culling
+        static int pausedEmitters;  // Emitters paused during last update
 
         Particle();
 
@@ -0,0 +1,479 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USE_SDL2
+
+#include "render/alphablit.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "debug.h"
+
+namespace
+{
+    // Division by 255 with rounding, exact for v <= 255 * 255.
+    inline uint32_t div255(uint32_t v)
+    {
+        v += 128;
+        return (v + (v >> 8)) >> 8;
+    }
+
+    inline uint32_t readPixel(const uint8_t *const p, const int bpp)
+    {
+        switch (bpp)
+        {
+            case 1:
+                return *p;
+            case 2:
+                return *reinterpret_cast<const uint16_t*>(p);
+            case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+                return p[0] << 16 | p[1] << 8 | p[2];
+#else
+                return p[0] | p[1] << 8 | p[2] << 16;
+#endif
+            case 4:
+            default:
+                return *reinterpret_cast<const uint32_t*>(p);
+        }
+    }
+
+    inline void writePixel(uint8_t *const p, const int bpp,
+                           const uint32_t pixel)
+    {
+        switch (bpp)
+        {
+            case 1:
+                *p = static_cast<uint8_t>(pixel);
+                break;
+            case 2:
+                *reinterpret_cast<uint16_t*>(p) =
+                    static_cast<uint16_t>(pixel);
+                break;
+            case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+                p[0] = static_cast<uint8_t>(pixel >> 16);
+                p[1] = static_cast<uint8_t>(pixel >> 8);
+                p[2] = static_cast<uint8_t>(pixel);
+#else
+                p[0] = static_cast<uint8_t>(pixel);
+                p[1] = static_cast<uint8_t>(pixel >> 8);
+                p[2] = static_cast<uint8_t>(pixel >> 16);
+#endif
+                break;
+            case 4:
+            default:
+                *reinterpret_cast<uint32_t*>(p) = pixel;
+                break;
+        }
+    }
+
+    /**
+     * Blends groups of 4 pixels with SSE2.
+     * Returns number of blended pixels, rest must be blended by scalar code.
+     */
+    int blendRowSse2(const uint32_t *restrict const src A_UNUSED,
+                     uint32_t *restrict const dst A_UNUSED,
+                     const int width A_UNUSED,
+                     const uint32_t alpha A_UNUSED,
+                     const int ashift A_UNUSED,
+                     const uint32_t keepMask A_UNUSED)
+    {
+        int x = 0;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaVec = _mm_set1_epi32(static_cast<int>(alpha));
+        const __m128i byteMask = _mm_set1_epi32(0xff);
+        const __m128i c128 = _mm_set1_epi16(128);
+        const __m128i c255 = _mm_set1_epi16(255);
+        const __m128i keep = _mm_set1_epi32(static_cast<int>(keepMask));
+        const __m128i shift = _mm_cvtsi32_si128(ashift);
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128i s = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + x));
+
+            // source alpha multiplied by global alpha, one per 32 bit lane
+            __m128i a = _mm_and_si128(_mm_srl_epi32(s, shift), byteMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xffff)
+                continue;
+            a = _mm_add_epi16(_mm_mullo_epi16(a, alphaVec), c128);
+            a = _mm_srli_epi16(_mm_add_epi16(a, _mm_srli_epi16(a, 8)), 8);
+
+            // spread alpha to 16 bit lanes of each pixel channel
+            a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+            const __m128i aLo = _mm_unpacklo_epi32(a, a);
+            const __m128i aHi = _mm_unpackhi_epi32(a, a);
+
+            __m128i *const dstPtr = reinterpret_cast<__m128i*>(dst + x);
+            const __m128i d = _mm_loadu_si128(dstPtr);
+
+            __m128i lo = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), aLo),
+                _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero),
+                _mm_sub_epi16(c255, aLo)));
+            lo = _mm_add_epi16(lo, c128);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+
+            __m128i hi = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), aHi),
+                _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero),
+                _mm_sub_epi16(c255, aHi)));
+            hi = _mm_add_epi16(hi, c128);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+            const __m128i res = _mm_packus_epi16(lo, hi);
+            _mm_storeu_si128(dstPtr, _mm_or_si128(
+                _mm_andnot_si128(keep, res),
+                _mm_and_si128(keep, d)));
+        }
+#endif
+        return x;
+    }
+
+    /**
+     * Blends row of 32 bit pixels with same color masks, starting from x.
+     * Bits from keepMask (unused or alpha bits of destination)
+     * copied from destination.
+     */
+    void blendRowScalar(const uint32_t *restrict const src,
+                        uint32_t *restrict const dst,
+                        int x,
+                        const int width,
+                        const uint32_t alpha,
+                        const int ashift,
+                        const uint32_t keepMask)
+    {
+        for (; x < width; x ++)
+        {
+            const uint32_t s = src[x];
+            const uint32_t a = div255(((s >> ashift) & 0xff) * alpha);
+            if (!a)
+                continue;
+            const uint32_t d = dst[x];
+            const uint32_t na = 255 - a;
+            uint32_t rb = (s & 0x00ff00ff) * a
+                + (d & 0x00ff00ff) * na + 0x00800080;
+            rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+            uint32_t ag = ((s >> 8) & 0x00ff00ff) * a
+                + ((d >> 8) & 0x00ff00ff) * na + 0x00800080;
+            ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+            dst[x] = ((rb | ag) & ~keepMask) | (d & keepMask);
+        }
+    }
+
+    void blendRow(const uint32_t *restrict const src,
+                  uint32_t *restrict const dst,
+                  const int width,
+                  const uint32_t alpha,
+                  const int ashift,
+                  const uint32_t keepMask)
+    {
+        const int x = blendRowSse2(src, dst, width, alpha, ashift, keepMask);
+        blendRowScalar(src, dst, x, width, alpha, ashift, keepMask);
+    }
+
+    void blendGeneric(const SDL_Surface *restrict const src,
+                      const SDL_Rect &restrict srcRect,
+                      SDL_Surface *restrict const dst,
+                      const SDL_Rect &restrict dstRect,
+                      const uint32_t alpha)
+    {
+        const SDL_PixelFormat *const srcFormat = src->format;
+        const SDL_PixelFormat *const dstFormat = dst->format;
+        const int srcBpp = srcFormat->BytesPerPixel;
+        const int dstBpp = dstFormat->BytesPerPixel;
+        const int w = srcRect.w;
+        const int h = srcRect.h;
+        for (int y = 0; y < h; y ++)
+        {
+            const uint8_t *srcPtr = static_cast<const uint8_t*>(src->pixels)
+                + (srcRect.y + y) * src->pitch + srcRect.x * srcBpp;
+            uint8_t *dstPtr = static_cast<uint8_t*>(dst->pixels)
+                + (dstRect.y + y) * dst->pitch + dstRect.x * dstBpp;
+            for (int x = 0; x < w; x ++)
+            {
+                uint8_t sr, sg, sb, sa;
+                SDL_GetRGBA(readPixel(srcPtr, srcBpp), srcFormat,
+                    &sr, &sg, &sb, &sa);
+                const uint32_t a = div255(sa * alpha);
+                if (a)
+                {
+                    const uint32_t na = 255 - a;
+                    uint8_t dr, dg, db;
+                    SDL_GetRGB(readPixel(dstPtr, dstBpp), dstFormat,
+                        &dr, &dg, &db);
+                    writePixel(dstPtr, dstBpp, SDL_MapRGB(dstFormat,
+                        static_cast<uint8_t>(div255(sr * a + dr * na)),
+                        static_cast<uint8_t>(div255(sg * a + dg * na)),
+                        static_cast<uint8_t>(div255(sb * a + db * na))));
+                }
+                srcPtr += srcBpp;
+                dstPtr += dstBpp;
+            }
+        }
+    }
+
+    void combineGeneric(const SDL_Surface *restrict const src,
+                        const SDL_Rect &restrict srcRect,
+                        SDL_Surface *restrict const dst,
+                        const SDL_Rect &restrict dstRect,
+                        const uint32_t alpha)
+    {
+        const SDL_PixelFormat *const srcFormat = src->format;
+        const SDL_PixelFormat *const dstFormat = dst->format;
+        const int srcBpp = srcFormat->BytesPerPixel;
+        const int dstBpp = dstFormat->BytesPerPixel;
+        const int w = srcRect.w;
+        const int h = srcRect.h;
+        for (int y = 0; y < h; y ++)
+        {
+            const uint8_t *srcPtr = static_cast<const uint8_t*>(src->pixels)
+                + (srcRect.y + y) * src->pitch + srcRect.x * srcBpp;
+            uint8_t *dstPtr = static_cast<uint8_t*>(dst->pixels)
+                + (dstRect.y + y) * dst->pitch + dstRect.x * dstBpp;
+            for (int x = 0; x < w; x ++)
+            {
+                uint8_t sr, sg, sb, sa;
+                SDL_GetRGBA(readPixel(srcPtr, srcBpp), srcFormat,
+                    &sr, &sg, &sb, &sa);
+                const uint32_t a = div255(sa * alpha);
+                if (a)
+                {
+                    uint8_t dr, dg, db, da;
+                    SDL_GetRGBA(readPixel(dstPtr, dstBpp), dstFormat,
+                        &dr, &dg, &db, &da);
+                    // destination weight after covered by source
+                    const uint32_t dw = div255(da * (255 - a));
+                    const uint32_t outA = a + dw;
+                    const uint32_t half = outA / 2;
+                    writePixel(dstPtr, dstBpp, SDL_MapRGBA(dstFormat,
+                        static_cast<uint8_t>((sr * a + dr * dw + half) / outA),
+                        static_cast<uint8_t>((sg * a + dg * dw + half) / outA),
+                        static_cast<uint8_t>((sb * a + db * dw + half) / outA),
+                        static_cast<uint8_t>(outA)));
+                }
+                srcPtr += srcBpp;
+                dstPtr += dstBpp;
+            }
+        }
+    }
+
+    bool clipRects(const SDL_Surface *restrict const src,
+                   const SDL_Rect *restrict const srcRect,
+                   const SDL_Surface *restrict const dst,
+                   const SDL_Rect *restrict const dstRect,
+                   SDL_Rect &restrict outSrc,
+                   SDL_Rect &restrict outDst)
+    {
+        int srcX = 0;
+        int srcY = 0;
+        int w = src->w;
+        int h = src->h;
+        if (srcRect)
+        {
+            srcX = srcRect->x;
+            srcY = srcRect->y;
+            w = srcRect->w;
+            h = srcRect->h;
+        }
+        int dstX = 0;
+        int dstY = 0;
+        if (dstRect)
+        {
+            dstX = dstRect->x;
+            dstY = dstRect->y;
+        }
+
+        if (srcX < 0)
+        {
+            w += srcX;
+            dstX -= srcX;
+            srcX = 0;
+        }
+        const int maxw = src->w - srcX;
+        if (maxw < w)
+            w = maxw;
+
+        if (srcY < 0)
+        {
+            h += srcY;
+            dstY -= srcY;
+            srcY = 0;
+        }
+        const int maxh = src->h - srcY;
+        if (maxh < h)
+            h = maxh;
+
+        const SDL_Rect &clip = dst->clip_rect;
+        int dx = clip.x - dstX;
+        if (dx > 0)
+        {
+            w -= dx;
+            dstX += dx;
+            srcX += dx;
+        }
+        dx = dstX + w - clip.x - clip.w;
+        if (dx > 0)
+            w -= dx;
+
+        int dy = clip.y - dstY;
+        if (dy > 0)
+        {
+            h -= dy;
+            dstY += dy;
+            srcY += dy;
+        }
+        dy = dstY + h - clip.y - clip.h;
+        if (dy > 0)
+            h -= dy;
+
+        if (w <= 0 || h <= 0)
+            return false;
+
+        outSrc.x = static_cast<int16_t>(srcX);
+        outSrc.y = static_cast<int16_t>(srcY);
+        outSrc.w = static_cast<uint16_t>(w);
+        outSrc.h = static_cast<uint16_t>(h);
+        outDst.x = static_cast<int16_t>(dstX);
+        outDst.y = static_cast<int16_t>(dstY);
+        outDst.w = static_cast<uint16_t>(w);
+        outDst.h = static_cast<uint16_t>(h);
+        return true;
+    }
+}  // namespace
+
+void AlphaBlit::lowerBlit(SDL_Surface *restrict const src,
+                          const SDL_Rect &restrict srcRect,
+                          SDL_Surface *restrict const dst,
+                          const SDL_Rect &restrict dstRect,
+                          const uint8_t alpha)
+{
+    if (!alpha)
+        return;
+
+    if (SDL_MUSTLOCK(src))
+        SDL_LockSurface(src);
+    if (SDL_MUSTLOCK(dst))
+        SDL_LockSurface(dst);
+
+    const SDL_PixelFormat *const srcFormat = src->format;
+    const SDL_PixelFormat *const dstFormat = dst->format;
+    if (srcFormat->BytesPerPixel == 4
+        && dstFormat->BytesPerPixel == 4
+        && srcFormat->Amask
+        && srcFormat->Rmask == dstFormat->Rmask
+        && srcFormat->Gmask == dstFormat->Gmask
+        && srcFormat->Bmask == dstFormat->Bmask)
+    {
+        const uint32_t keepMask = ~(dstFormat->Rmask
+            | dstFormat->Gmask | dstFormat->Bmask);
+        const int w = srcRect.w;
+        const int h = srcRect.h;
+        const int ashift = srcFormat->Ashift;
+        for (int y = 0; y < h; y ++)
+        {
+            const uint32_t *const srcRow = reinterpret_cast<uint32_t*>(
+                static_cast<uint8_t*>(src->pixels)
+                + (srcRect.y + y) * src->pitch) + srcRect.x;
+            uint32_t *const dstRow = reinterpret_cast<uint32_t*>(
+                static_cast<uint8_t*>(dst->pixels)
+                + (dstRect.y + y) * dst->pitch) + dstRect.x;
+            blendRow(srcRow, dstRow, w, alpha, ashift, keepMask);
+        }
+    }
+    else
+    {
+        blendGeneric(src, srcRect, dst, dstRect, alpha);
+    }
+
+    if (SDL_MUSTLOCK(dst))
+        SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(src))
+        SDL_UnlockSurface(src);
+}
+
+void AlphaBlit::upperBlit(SDL_Surface *restrict const src,
+                          const SDL_Rect *restrict const srcRect,
+                          SDL_Surface *restrict const dst,
+                          const SDL_Rect *restrict const dstRect,
+                          const uint8_t alpha)
+{
+    if (!src || !dst)
+        return;
+
+    SDL_Rect clippedSrc;
+    SDL_Rect clippedDst;
+    if (clipRects(src, srcRect, dst, dstRect, clippedSrc, clippedDst))
+        lowerBlit(src, clippedSrc, dst, clippedDst, alpha);
+}
+
+void AlphaBlit::combine(SDL_Surface *restrict const src,
+                        const SDL_Rect *restrict const srcRect,
+                        SDL_Surface *restrict const dst,
+                        const SDL_Rect *restrict const dstRect,
+                        const uint8_t alpha)
+{
+    if (!src || !dst || !alpha)
+        return;
+
+    SDL_Rect clippedSrc;
+    SDL_Rect clippedDst;
+    if (!clipRects(src, srcRect, dst, dstRect, clippedSrc, clippedDst))
+        return;
+
+    if (SDL_MUSTLOCK(src))
+        SDL_LockSurface(src);
+    if (SDL_MUSTLOCK(dst))
+        SDL_LockSurface(dst);
+
+    combineGeneric(src, clippedSrc, dst, clippedDst, alpha);
+
+    if (SDL_MUSTLOCK(dst))
+        SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(src))
+        SDL_UnlockSurface(src);
+}
+
+#ifdef UNITTESTS
+void AlphaBlit::blendRowFast(const uint32_t *restrict const src,
+                             uint32_t *restrict const dst,
+                             const int width,
+                             const uint8_t alpha,
+                             const int ashift,
+                             const uint32_t keepMask)
+{
+    blendRow(src, dst, width, alpha, ashift, keepMask);
+}
+
+void AlphaBlit::blendRowSlow(const uint32_t *restrict const src,
+                             uint32_t *restrict const dst,
+                             const int width,
+                             const uint8_t alpha,
+                             const int ashift,
+                             const uint32_t keepMask)
+{
+    blendRowScalar(src, dst, 0, width, alpha, ashift, keepMask);
+}
+#endif  // UNITTESTS
+
+#endif  // USE_SDL2
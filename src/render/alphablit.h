@@ -0,0 +1,93 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RENDER_ALPHABLIT_H
+#define RENDER_ALPHABLIT_H
+
+#ifndef USE_SDL2
+
+#include <SDL_video.h>
+
+#include "localconsts.h"
+
+/**
+ * Software blitters for images drawn with global alpha.
+ *
+ * Source pixels alpha multiplied by global alpha while blending, so images
+ * with alpha channel not need to be rewritten or copied for each alpha.
+ * 32 bit surfaces with same color masks blended with SSE2 if available,
+ * other formats use slow generic code.
+ */
+namespace AlphaBlit
+{
+    /**
+     * Blends source over destination. Rects must be already clipped.
+     * Destination alpha channel not changed, like in SDL_LowerBlit.
+     */
+    void lowerBlit(SDL_Surface *restrict const src,
+                   const SDL_Rect &restrict srcRect,
+                   SDL_Surface *restrict const dst,
+                   const SDL_Rect &restrict dstRect,
+                   const uint8_t alpha);
+
+    /**
+     * Clips rects like SDL_BlitSurface and blends source over destination.
+     */
+    void upperBlit(SDL_Surface *restrict const src,
+                   const SDL_Rect *restrict const srcRect,
+                   SDL_Surface *restrict const dst,
+                   const SDL_Rect *restrict const dstRect,
+                   const uint8_t alpha);
+
+    /**
+     * Blends source over destination with alpha channel and updates
+     * destination alpha. Used for combine images into cache surfaces.
+     */
+    void combine(SDL_Surface *restrict const src,
+                 const SDL_Rect *restrict const srcRect,
+                 SDL_Surface *restrict const dst,
+                 const SDL_Rect *restrict const dstRect,
+                 const uint8_t alpha);
+
+#ifdef UNITTESTS
+    /**
+     * Blends row of 32 bit pixels like lowerBlit, with SSE2 if available.
+     */
+    void blendRowFast(const uint32_t *restrict const src,
+                      uint32_t *restrict const dst,
+                      const int width,
+                      const uint8_t alpha,
+                      const int ashift,
+                      const uint32_t keepMask);
+
+    /**
+     * Blends row of 32 bit pixels with scalar code only.
+     */
+    void blendRowSlow(const uint32_t *restrict const src,
+                      uint32_t *restrict const dst,
+                      const int width,
+                      const uint8_t alpha,
+                      const int ashift,
+                      const uint32_t keepMask);
+#endif  // UNITTESTS
+}  // namespace AlphaBlit
+
+#endif  // USE_SDL2
+#endif  // RENDER_ALPHABLIT_H
@@ -0,0 +1,79 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USE_SDL2
+
+#include "render/alphablit.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include "debug.h"
+
+namespace
+{
+    uint32_t randomPixel()
+    {
+        return (static_cast<uint32_t>(rand() & 0xffff) << 16)
+            | static_cast<uint32_t>(rand() & 0xffff);
+    }
+}  // namespace
+
+TEST(AlphaBlit, fastAndSlow)
+{
+    srand(1234);
+    // not multiple of 4, to check scalar tail after SSE2 code
+    const int width = 1023;
+    std::vector<uint32_t> src(width);
+    std::vector<uint32_t> dst1(width);
+    std::vector<uint32_t> dst2(width);
+
+    // alpha in high byte (ARGB) and in low byte (RGBA)
+    const int shifts[] = { 24, 0 };
+    const uint32_t keepMasks[] = { 0xff000000U, 0x000000ffU };
+    for (int mode = 0; mode < 2; mode ++)
+    {
+        for (int f = 0; f < 200; f ++)
+        {
+            for (int x = 0; x < width; x ++)
+            {
+                src[x] = randomPixel();
+                dst1[x] = randomPixel();
+                dst2[x] = dst1[x];
+            }
+            // fully transparent and opaque pixels
+            src[f] &= ~keepMasks[mode];
+            src[f + 1] |= keepMasks[mode];
+
+            const uint8_t alpha = static_cast<uint8_t>(
+                f < 2 ? 255 * f : rand() & 0xff);
+            AlphaBlit::blendRowFast(&src[0], &dst1[0], width,
+                alpha, shifts[mode], keepMasks[mode]);
+            AlphaBlit::blendRowSlow(&src[0], &dst2[0], width,
+                alpha, shifts[mode], keepMasks[mode]);
+            for (int x = 0; x < width; x ++)
+                ASSERT_EQ(dst2[x], dst1[x]) << "pixel " << x;
+        }
+    }
+}
+
+#endif  // USE_SDL2
@@ -561,6 +561,13 @@ void Graphics::drawNet(const int x1, const int y1,
         drawLine(x, y1, x, y2);
 }
 
+void Graphics::fillRectangles(const Rect *const rects,
+                              const int count)
+{
+    for (int f = 0; f < count; f ++)
+        fillRectangle(rects[f]);
+}
+
 void Graphics::setWindowSize(const int width A_UNUSED,
                              const int height A_UNUSED)
 {
@@ -231,6 +231,13 @@ class Graphics notfinal
 
         virtual void fillRectangle(const Rect& rectangle) = 0;
 
+        /**
+         * Fills many rectangles with current color.
+         * Renderers can draw it in one batch.
+         */
+        virtual void fillRectangles(const Rect *const rects,
+                                    const int count);
+
         /**
          * Updates the screen. This is done by either copying the buffer to the
          * screen or swapping pages.
@@ -1400,6 +1400,46 @@ void NormalOpenGLGraphics::fillRectangle(const Rect& rect)
     drawRectangle(rect, true);
 }
 
+void NormalOpenGLGraphics::fillRectangles(const Rect *const rects,
+                                          const int count)
+{
+    BLOCK_START("Graphics::fillRectangles")
+    unsigned int vp = 0;
+    const unsigned int vLimit = mMaxVertices * 4;
+
+    setTexturingAndBlending(false);
+    restoreColor();
+
+    for (int f = 0; f < count; f ++)
+    {
+        const Rect &rect = rects[f];
+        const float x1 = static_cast<float>(rect.x);
+        const float y1 = static_cast<float>(rect.y);
+        const float x2 = static_cast<float>(rect.x + rect.width);
+        const float y2 = static_cast<float>(rect.y + rect.height);
+
+        mFloatTexArray[vp + 0] = x1;
+        mFloatTexArray[vp + 1] = y1;
+        mFloatTexArray[vp + 2] = x2;
+        mFloatTexArray[vp + 3] = y1;
+        mFloatTexArray[vp + 4] = x2;
+        mFloatTexArray[vp + 5] = y2;
+        mFloatTexArray[vp + 6] = x1;
+        mFloatTexArray[vp + 7] = y2;
+
+        vp += 8;
+        if (vp + 8 > vLimit)
+        {
+            drawRectArrayf(vp);
+            vp = 0;
+        }
+    }
+
+    if (vp > 0)
+        drawRectArrayf(vp);
+    BLOCK_END("Graphics::fillRectangles")
+}
+
 void NormalOpenGLGraphics::setTexturingAndBlending(const bool enable)
 {
     if (enable)
@@ -1620,6 +1660,16 @@ inline void NormalOpenGLGraphics::drawLineArrayf(const int size)
     glDrawArrays(GL_LINES, 0, size / 2);
 }
 
+inline void NormalOpenGLGraphics::drawRectArrayf(const int size)
+{
+    glVertexPointer(2, GL_FLOAT, 0, mFloatTexArray);
+    vertPtr = nullptr;
+#ifdef DEBUG_DRAW_CALLS
+    mDrawCalls ++;
+#endif
+    glDrawArrays(GL_QUADS, 0, size / 2);
+}
+
 void NormalOpenGLGraphics::dumpSettings()
 {
     GLint test[1000];
@@ -73,8 +73,13 @@ class NormalOpenGLGraphics final : public Graphics
 
         inline void drawLineArrayf(const int size);
 
+        inline void drawRectArrayf(const int size);
+
         void testDraw() override final;
 
+        void fillRectangles(const Rect *const rects,
+                            const int count) override final;
+
         #include "render/graphicsdef.hpp"
 
         #include "render/openglgraphicsdef.hpp"
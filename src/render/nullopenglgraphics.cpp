@@ -103,7 +103,30 @@ bool NullOpenGLGraphics::setVideoMode(const int w, const int h,
 {
     setMainFlags(w, h, scale, bpp, fs, hwaccel, resize, noFrame);
 
-    return setOpenGLMode();
+    // null renderer never draws, so window created without OpenGL context
+    if (!(mWindow = graphicsManager.createWindow(
+        mActualWidth, mActualHeight,
+        mBpp, getSoftwareFlags())))
+    {
+        mRect.w = 0;
+        mRect.h = 0;
+        return false;
+    }
+
+#ifdef USE_SDL2
+    int w1 = 0;
+    int h1 = 0;
+    SDL_GetWindowSize(mWindow, &w1, &h1);
+    mRect.w = static_cast<int32_t>(w1 / mScale);
+    mRect.h = static_cast<int32_t>(h1 / mScale);
+#else  // USE_SDL2
+
+    mRect.w = static_cast<uint16_t>(mWindow->w / mScale);
+    mRect.h = static_cast<uint16_t>(mWindow->h / mScale);
+#endif  // USE_SDL2
+
+    initArrays(graphicsManager.getMaxVertices());
+    return true;
 }
 
 static inline void drawQuad(const Image *const image A_UNUSED,
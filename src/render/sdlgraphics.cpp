@@ -29,6 +29,8 @@
 #include "graphicsmanager.h"
 #include "graphicsvertexes.h"
 
+#include "render/alphablit.h"
+
 #include "utils/sdlcheckutils.h"
 
 #include "utils/sdlpixel.h"
@@ -57,6 +59,23 @@ SDLGraphics::~SDLGraphics()
 {
 }
 
+void SDLGraphics::blitImage(const Image *const image,
+                            SDL_Surface *const src,
+                            SDL_Rect *const srcRect,
+                            SDL_Rect *const dstRect)
+{
+    // SDL 1.2 ignore surface alpha for surfaces with alpha channel
+    if (image->mHasAlphaChannel && image->mAlpha < 1.0F)
+    {
+        AlphaBlit::lowerBlit(src, *srcRect, mWindow, *dstRect,
+            static_cast<uint8_t>(255 * image->mAlpha));
+    }
+    else
+    {
+        SDL_LowerBlit(src, srcRect, mWindow, dstRect);
+    }
+}
+
 void SDLGraphics::drawRescaledImage(const Image *const image,
                                     int dstX, int dstY,
                                     const int desiredWidth,
@@ -92,7 +111,16 @@ void SDLGraphics::drawRescaledImage(const Image *const image,
         0
     };
 
-    SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect, mWindow, &dstRect);
+    // colorkeyed surfaces use SDL surface alpha
+    if (image->mHasAlphaChannel && image->mAlpha < 1.0F)
+    {
+        AlphaBlit::upperBlit(tmpImage->mSDLSurface, &srcRect,
+            mWindow, &dstRect, static_cast<uint8_t>(255 * image->mAlpha));
+    }
+    else
+    {
+        SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect, mWindow, &dstRect);
+    }
     delete tmpImage;
 }
 
@@ -185,7 +213,7 @@ void SDLGraphics::drawImageInline(const Image *const image,
             static_cast<uint16_t>(h)
         };
 
-        SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+        blitImage(image, src, &srcRect, &dstRect);
     }
 }
 
@@ -278,7 +306,7 @@ void SDLGraphics::drawImageCached(const Image *const image,
             static_cast<uint16_t>(h)
         };
 
-        SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+        blitImage(image, src, &srcRect, &dstRect);
     }
 }
 
@@ -383,7 +411,7 @@ void SDLGraphics::drawPatternCached(const Image *const image,
                         static_cast<uint16_t>(h2)
                     };
 
-                    SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+                    blitImage(image, src, &srcRect, &dstRect);
                 }
 
 //            SDL_BlitSurface(image->mSDLSurface, &srcRect, mWindow, &dstRect);
@@ -504,7 +532,7 @@ void SDLGraphics::drawPatternInline(const Image *const image,
                         static_cast<uint16_t>(h2)
                     };
 
-                    SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+                    blitImage(image, src, &srcRect, &dstRect);
                 }
 
 //            SDL_BlitSurface(image->mSDLSurface, &srcRect, mWindow, &dstRect);
@@ -571,8 +599,17 @@ void SDLGraphics::drawRescaledPattern(const Image *const image,
                 0
             };
 
-            SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect,
-                            mWindow, &dstRect);
+            if (image->mHasAlphaChannel && image->mAlpha < 1.0F)
+            {
+                AlphaBlit::upperBlit(tmpImage->mSDLSurface, &srcRect,
+                    mWindow, &dstRect,
+                    static_cast<uint8_t>(255 * image->mAlpha));
+            }
+            else
+            {
+                SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect,
+                                mWindow, &dstRect);
+            }
         }
     }
 
@@ -740,8 +777,7 @@ void SDLGraphics::drawTileCollection(const ImageCollection
         const DoubleRects::const_iterator it2_end = rects->end();
         while (it2 != it2_end)
         {
-            SDL_LowerBlit(img->mSDLSurface, &(*it2)->src,
-                mWindow, &(*it2)->dst);
+            blitImage(img, img->mSDLSurface, &(*it2)->src, &(*it2)->dst);
             ++ it2;
         }
     }
@@ -756,7 +792,7 @@ void SDLGraphics::drawTileVertexes(const ImageVertexes *const vert)
     const DoubleRects::const_iterator it_end = rects->end();
     while (it != it_end)
     {
-        SDL_LowerBlit(img->mSDLSurface, &(*it)->src, mWindow, &(*it)->dst);
+        blitImage(img, img->mSDLSurface, &(*it)->src, &(*it)->dst);
         ++ it;
     }
 }
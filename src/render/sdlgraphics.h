@@ -64,6 +64,11 @@ class SDLGraphics final : public Graphics
                               const SDL_Surface *const dst,
                               SDL_Rect *dstrect) const;
 
+        void blitImage(const Image *const image,
+                       SDL_Surface *const src,
+                       SDL_Rect *const srcRect,
+                       SDL_Rect *const dstRect);
+
         void drawHLine(int x1, int y, int x2);
 
         void drawVLine(int x, int y1, int y2);
@@ -22,6 +22,8 @@
 
 #include "render/surfacegraphics.h"
 
+#include "render/alphablit.h"
+
 #include "resources/image.h"
 #include "resources/surfaceimagehelper.h"
 
@@ -61,7 +63,21 @@ void SurfaceGraphics::drawImage(const Image *const image,
 #ifdef USE_SDL2
     SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
 #else
-    if (mBlitMode == BLIT_NORMAL)
+    if (image->mHasAlphaChannel && image->mAlpha < 1.0F)
+    {
+        const uint8_t alpha = static_cast<uint8_t>(255 * image->mAlpha);
+        if (mBlitMode == BLIT_NORMAL)
+        {
+            AlphaBlit::upperBlit(image->mSDLSurface, &srcRect,
+                mTarget, &dstRect, alpha);
+        }
+        else
+        {
+            AlphaBlit::combine(image->mSDLSurface, &srcRect,
+                mTarget, &dstRect, alpha);
+        }
+    }
+    else if (mBlitMode == BLIT_NORMAL)
     {
         SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
     }
@@ -121,7 +137,21 @@ void SurfaceGraphics::drawImageCached(const Image *const image,
 #ifdef USE_SDL2
     SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
 #else
-    if (mBlitMode == BLIT_NORMAL)
+    if (image->mHasAlphaChannel && image->mAlpha < 1.0F)
+    {
+        const uint8_t alpha = static_cast<uint8_t>(255 * image->mAlpha);
+        if (mBlitMode == BLIT_NORMAL)
+        {
+            AlphaBlit::upperBlit(image->mSDLSurface, &srcRect,
+                mTarget, &dstRect, alpha);
+        }
+        else
+        {
+            AlphaBlit::combine(image->mSDLSurface, &srcRect,
+                mTarget, &dstRect, alpha);
+        }
+    }
+    else if (mBlitMode == BLIT_NORMAL)
     {
         SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
     }
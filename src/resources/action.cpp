@@ -32,6 +32,8 @@ Action::Action() noexcept :
     mAnimations(),
     mNumber(100)
 {
+    for (int f = 0; f < SpriteDirection::INVALID; f ++)
+        mDirections[f] = nullptr;
 }
 
 Action::~Action()
@@ -41,6 +43,26 @@ Action::~Action()
 
 const Animation *Action::getAnimation(SpriteDirection::Type direction)
                                       const noexcept
+{
+    if (direction < SpriteDirection::DEFAULT
+        || direction >= SpriteDirection::INVALID)
+    {
+        return mAnimations.empty() ? nullptr : mAnimations.begin()->second;
+    }
+    return mDirections[direction];
+}
+
+void Action::updateDirections() noexcept
+{
+    for (int f = 0; f < SpriteDirection::INVALID; f ++)
+    {
+        mDirections[f] = findAnimation(
+            static_cast<SpriteDirection::Type>(f));
+    }
+}
+
+const Animation *Action::findAnimation(SpriteDirection::Type direction)
+                                       const noexcept
 {
     Animations::const_iterator i = mAnimations.find(direction);
 
@@ -71,6 +93,7 @@ void Action::setAnimation(const SpriteDirection::Type direction,
                           Animation *const animation) noexcept
 {
     mAnimations[direction] = animation;
+    updateDirections();
 }
 
 void Action::setLastFrameDelay(const int delay) noexcept
@@ -61,7 +61,16 @@ class Action final
         typedef std::map<SpriteDirection::Type, Animation*> Animations;
         typedef Animations::iterator AnimationIter;
 
+        /**
+         * Fills animations table for each direction, including fallbacks.
+         */
+        void updateDirections() noexcept;
+
+        const Animation *findAnimation(SpriteDirection::Type direction)
+                                       const noexcept A_WARN_UNUSED;
+
         Animations mAnimations;
+        const Animation *mDirections[SpriteDirection::INVALID];
         unsigned mNumber;
 };
 
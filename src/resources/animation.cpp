@@ -22,6 +22,8 @@
 
 #include "resources/animation.h"
 
+#include "resources/spritedef.h"
+
 #include "debug.h"
 
 Animation::Animation() noexcept :
@@ -35,7 +37,8 @@ void Animation::addFrame(Image *const image, const int delay,
                          const int rand) noexcept
 {
     Frame frame
-        = { image, delay, offsetX, offsetY, rand, Frame::ANIMATION, "" };
+        = { image, delay, offsetX, offsetY, rand, Frame::ANIMATION, "",
+        -1, -1 };
     mFrames.push_back(frame);
     mDuration += delay;
 }
@@ -52,26 +55,54 @@ bool Animation::isTerminator(const Frame &candidate) noexcept
 
 void Animation::addJump(const std::string &name, const int rand) noexcept
 {
-    Frame frame = { nullptr, 0, 0, 0, rand, Frame::JUMP, name };
+    Frame frame = { nullptr, 0, 0, 0, rand, Frame::JUMP, name,
+        -1, SpriteDef::getActionId(name) };
     mFrames.push_back(frame);
 }
 
 void Animation::addLabel(const std::string &name) noexcept
 {
-    Frame frame = { nullptr, 0, 0, 0, 100, Frame::LABEL, name };
+    Frame frame = { nullptr, 0, 0, 0, 100, Frame::LABEL, name, -1, -1 };
+    const int index = static_cast<int>(mFrames.size());
     mFrames.push_back(frame);
+
+    // resolve gotos added before this label
+    FOR_EACH (FramesIter, it, mFrames)
+    {
+        Frame &frame2 = *it;
+        if (frame2.type == Frame::GOTO
+            && frame2.nextFrame < 0
+            && frame2.nextAction == name)
+        {
+            frame2.nextFrame = index;
+        }
+    }
 }
 
 void Animation::addGoto(const std::string &name, const int rand) noexcept
 {
-    Frame frame = { nullptr, 0, 0, 0, rand, Frame::GOTO, name };
+    Frame frame = { nullptr, 0, 0, 0, rand, Frame::GOTO, name, -1, -1 };
+
+    // resolve label to frame index, because labels searched
+    // each time when goto reached
+    const size_t sz = mFrames.size();
+    for (size_t f = 0; f < sz; f ++)
+    {
+        const Frame &frame2 = mFrames[f];
+        if (frame2.type == Frame::LABEL && frame2.nextAction == name)
+        {
+            frame.nextFrame = static_cast<int>(f);
+            break;
+        }
+    }
     mFrames.push_back(frame);
 }
 
 void Animation::addPause(const int delay, const int rand) noexcept
 {
-    Frame frame = { nullptr, delay, 0, 0, rand, Frame::PAUSE, "" };
+    Frame frame = { nullptr, delay, 0, 0, rand, Frame::PAUSE, "", -1, -1 };
     mFrames.push_back(frame);
+    mDuration += delay;
 }
 
 void Animation::setLastFrameDelay(const int delay) noexcept
@@ -81,6 +112,7 @@ void Animation::setLastFrameDelay(const int delay) noexcept
     {
         if ((*it).type == Frame::ANIMATION && (*it).image)
         {
+            mDuration += delay - (*it).delay;
             (*it).delay = delay;
             break;
         }
@@ -93,6 +93,9 @@ class BeingInfo final
                       const std::string &filename,
                       const int delay);
 
+        const ItemSoundEvents &getSounds() const A_WARN_UNUSED
+        { return mSounds; }
+
         const SoundInfo &getSound(const ItemSoundEvent::Type event)
                                   const A_WARN_UNUSED;
 
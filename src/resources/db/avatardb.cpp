@@ -30,6 +30,7 @@
 
 #include "utils/dtor.h"
 #include "utils/gettext.h"
+#include "utils/idindex.h"
 
 #include "configuration.h"
 
@@ -38,6 +39,7 @@
 namespace
 {
     BeingInfos mAvatarInfos;
+    IdIndex<BeingInfo> mAvatarIndex;
     bool mLoaded = false;
 }
 
@@ -119,6 +121,7 @@ void AvatarDB::loadXmlFile(const std::string &fileName)
         }
         currentInfo->setDisplay(display);
         mAvatarInfos[id] = currentInfo;
+        mAvatarIndex.insert(id, currentInfo);
     }
 
     mLoaded = true;
@@ -128,14 +131,14 @@ void AvatarDB::unload()
 {
     delete_all(mAvatarInfos);
     mAvatarInfos.clear();
+    mAvatarIndex.clear();
     mLoaded = false;
 }
 
 BeingInfo *AvatarDB::get(const int id)
 {
-    BeingInfoIterator i = mAvatarInfos.find(id);
-    if (i == mAvatarInfos.end())
+    BeingInfo *const info = mAvatarIndex.find(id);
+    if (!info)
         return BeingInfo::unknown;
-    else
-        return i->second;
+    return info;
 }
@@ -30,6 +30,7 @@
 #include "resources/map/blockmask.h"
 
 #include "utils/dtor.h"
+#include "utils/idindex.h"
 
 #include "configuration.h"
 
@@ -38,6 +39,7 @@
 namespace
 {
     BeingInfos mHomunculusInfos;
+    IdIndex<BeingInfo> mHomunculusIndex;
     bool mLoaded = false;
 }
 
@@ -134,6 +136,7 @@ void HomunculusDB::loadXmlFile(const std::string &fileName)
         currentInfo->setDisplay(display);
 
         mHomunculusInfos[id + offset] = currentInfo;
+        mHomunculusIndex.insert(id + offset, currentInfo);
     }
 }
 
@@ -141,6 +144,7 @@ void HomunculusDB::unload()
 {
     delete_all(mHomunculusInfos);
     mHomunculusInfos.clear();
+    mHomunculusIndex.clear();
 
     mLoaded = false;
 }
@@ -148,25 +152,13 @@ void HomunculusDB::unload()
 
 BeingInfo *HomunculusDB::get(const int id)
 {
-    BeingInfoIterator i = mHomunculusInfos.find(id);
-
-    if (i == mHomunculusInfos.end())
-    {
-        i = mHomunculusInfos.find(id);
-        if (i == mHomunculusInfos.end())
-        {
-            logger->log("HomunculusDB: Warning, unknown homunculus ID "
-                "%d requested",
-                id);
-            return BeingInfo::unknown;
-        }
-        else
-        {
-            return i->second;
-        }
-    }
-    else
+    BeingInfo *const info = mHomunculusIndex.find(id);
+    if (!info)
     {
-        return i->second;
+        logger->log("HomunculusDB: Warning, unknown homunculus ID "
+            "%d requested",
+            id);
+        return BeingInfo::unknown;
     }
+    return info;
 }
@@ -39,6 +39,7 @@
 
 #include "utils/delete2.h"
 #include "utils/dtor.h"
+#include "utils/idindex.h"
 #include "utils/stringmap.h"
 
 #include "debug.h"
@@ -47,6 +48,7 @@ namespace
 {
     ItemDB::ItemInfos mItemInfos;
     ItemDB::NamedItemInfos mNamedItemInfos;
+    IdIndex<ItemInfo> mItemIndex;
     ItemInfo *mUnknown = nullptr;
     bool mLoaded = false;
     bool mConstructed = false;
@@ -265,10 +267,11 @@ void ItemDB::loadXmlFile(const std::string &fileName, int &tagNum)
                 fileName.c_str());
             continue;
         }
-        else if (mItemInfos.find(id) != mItemInfos.end())
+        else
         {
-            logger->log("ItemDB: Redefinition of item ID %d", id);
-            itemInfo = mItemInfos[id];
+            itemInfo = mItemIndex.find(id);
+            if (itemInfo)
+                logger->log("ItemDB: Redefinition of item ID %d", id);
         }
         if (!itemInfo)
             itemInfo = new ItemInfo;
@@ -509,6 +512,7 @@ void ItemDB::loadXmlFile(const std::string &fileName, int &tagNum)
         itemInfo->setDisplay(display);
 
         mItemInfos[id] = itemInfo;
+        mItemIndex.insert(id, itemInfo);
         if (!name.empty())
         {
             temp = normalize(name);
@@ -560,6 +564,7 @@ void ItemDB::unload()
     delete_all(mItemInfos);
     mItemInfos.clear();
     mNamedItemInfos.clear();
+    mItemIndex.clear();
     mTags.clear();
     mTagNames.clear();
     mLoaded = false;
@@ -570,8 +575,7 @@ bool ItemDB::exists(const int id)
     if (!mLoaded)
         return false;
 
-    const ItemInfos::const_iterator i = mItemInfos.find(id);
-    return i != mItemInfos.end();
+    return mItemIndex.find(id) != nullptr;
 }
 
 const ItemInfo &ItemDB::get(const int id)
@@ -579,15 +583,14 @@ const ItemInfo &ItemDB::get(const int id)
     if (!mLoaded)
         load();
 
-    const ItemInfos::const_iterator i = mItemInfos.find(id);
-
-    if (i == mItemInfos.end())
+    const ItemInfo *const info = mItemIndex.find(id);
+    if (!info)
     {
         logger->log("ItemDB: Warning, unknown item ID# %d", id);
         return *mUnknown;
     }
 
-    return *(i->second);
+    return *info;
 }
 
 const ItemInfo &ItemDB::get(const std::string &name)
@@ -23,6 +23,7 @@
 #ifndef RESOURCES_DB_ITEMDB_H
 #define RESOURCES_DB_ITEMDB_H
 
+#include "utils/hashmap.h"
 #include "utils/stringvector.h"
 
 #include <map>
@@ -56,7 +57,7 @@ namespace ItemDB
 
     // Items database
     typedef std::map<int, ItemInfo*> ItemInfos;
-    typedef std::map<std::string, ItemInfo*> NamedItemInfos;
+    typedef HASHMAP<std::string, ItemInfo*> NamedItemInfos;
 
     const ItemDB::ItemInfos &getItemInfos();
 
@@ -30,6 +30,7 @@
 #include "resources/map/blockmask.h"
 
 #include "utils/dtor.h"
+#include "utils/idindex.h"
 
 #include "configuration.h"
 
@@ -38,6 +39,7 @@
 namespace
 {
     BeingInfos mMercenaryInfos;
+    IdIndex<BeingInfo> mMercenaryIndex;
     bool mLoaded = false;
 }
 
@@ -133,6 +135,7 @@ void MercenaryDB::loadXmlFile(const std::string &fileName)
         currentInfo->setDisplay(display);
 
         mMercenaryInfos[id + offset] = currentInfo;
+        mMercenaryIndex.insert(id + offset, currentInfo);
     }
 }
 
@@ -140,6 +143,7 @@ void MercenaryDB::unload()
 {
     delete_all(mMercenaryInfos);
     mMercenaryInfos.clear();
+    mMercenaryIndex.clear();
 
     mLoaded = false;
 }
@@ -147,25 +151,13 @@ void MercenaryDB::unload()
 
 BeingInfo *MercenaryDB::get(const int id)
 {
-    BeingInfoIterator i = mMercenaryInfos.find(id);
-
-    if (i == mMercenaryInfos.end())
-    {
-        i = mMercenaryInfos.find(id);
-        if (i == mMercenaryInfos.end())
-        {
-            logger->log("MercenaryDB: Warning, unknown mercenary ID "
-                "%d requested",
-                id);
-            return BeingInfo::unknown;
-        }
-        else
-        {
-            return i->second;
-        }
-    }
-    else
+    BeingInfo *const info = mMercenaryIndex.find(id);
+    if (!info)
     {
-        return i->second;
+        logger->log("MercenaryDB: Warning, unknown mercenary ID "
+            "%d requested",
+            id);
+        return BeingInfo::unknown;
     }
+    return info;
 }
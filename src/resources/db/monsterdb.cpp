@@ -31,6 +31,7 @@
 
 #include "utils/dtor.h"
 #include "utils/gettext.h"
+#include "utils/idindex.h"
 
 #include "configuration.h"
 
@@ -41,6 +42,7 @@ static const unsigned int OLD_TMWATHENA_OFFSET = 1002;
 namespace
 {
     BeingInfos mMonsterInfos;
+    IdIndex<BeingInfo> mMonsterIndex;
     bool mLoaded = false;
 }
 
@@ -140,6 +142,7 @@ void MonsterDB::loadXmlFile(const std::string &fileName)
         currentInfo->setDisplay(display);
 
         mMonsterInfos[id + offset] = currentInfo;
+        mMonsterIndex.insert(id + offset, currentInfo);
     }
 }
 
@@ -147,6 +150,7 @@ void MonsterDB::unload()
 {
     delete_all(mMonsterInfos);
     mMonsterInfos.clear();
+    mMonsterIndex.clear();
 
     mLoaded = false;
 }
@@ -154,24 +158,16 @@ void MonsterDB::unload()
 
 BeingInfo *MonsterDB::get(const int id)
 {
-    BeingInfoIterator i = mMonsterInfos.find(id);
-
-    if (i == mMonsterInfos.end())
+    BeingInfo *info = mMonsterIndex.find(id);
+    if (!info)
     {
-        i = mMonsterInfos.find(id + OLD_TMWATHENA_OFFSET);
-        if (i == mMonsterInfos.end())
+        info = mMonsterIndex.find(id + OLD_TMWATHENA_OFFSET);
+        if (!info)
         {
             logger->log("MonsterDB: Warning, unknown monster ID %d requested",
                         id);
             return BeingInfo::unknown;
         }
-        else
-        {
-            return i->second;
-        }
-    }
-    else
-    {
-        return i->second;
     }
+    return info;
 }
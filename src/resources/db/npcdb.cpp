@@ -31,12 +31,14 @@
 
 #include "utils/dtor.h"
 #include "utils/gettext.h"
+#include "utils/idindex.h"
 
 #include "debug.h"
 
 namespace
 {
     BeingInfos mNPCInfos;
+    IdIndex<BeingInfo> mNPCIndex;
     bool mLoaded = false;
 }
 
@@ -148,6 +150,7 @@ void NPCDB::loadXmlFile(const std::string &fileName)
             currentInfo->addMenu(_("Sell"), "sell 'NAME'");
         }
         mNPCInfos[id] = currentInfo;
+        mNPCIndex.insert(id, currentInfo);
     }
 }
 
@@ -155,23 +158,20 @@ void NPCDB::unload()
 {
     delete_all(mNPCInfos);
     mNPCInfos.clear();
+    mNPCIndex.clear();
 
     mLoaded = false;
 }
 
 BeingInfo *NPCDB::get(const int id)
 {
-    const BeingInfoIterator i = mNPCInfos.find(id);
-
-    if (i == mNPCInfos.end())
+    BeingInfo *const info = mNPCIndex.find(id);
+    if (!info)
     {
         logger->log("NPCDB: Warning, unknown NPC ID %d requested", id);
         return BeingInfo::unknown;
     }
-    else
-    {
-        return i->second;
-    }
+    return info;
 }
 
 uint16_t NPCDB::getAvatarFor(const int id)
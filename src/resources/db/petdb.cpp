@@ -31,12 +31,14 @@
 
 #include "utils/gettext.h"
 #include "utils/dtor.h"
+#include "utils/idindex.h"
 
 #include "debug.h"
 
 namespace
 {
     BeingInfos mPETInfos;
+    IdIndex<BeingInfo> mPETIndex;
     bool mLoaded = false;
 }
 
@@ -174,6 +176,7 @@ void PETDB::loadXmlFile(const std::string &fileName)
         currentInfo->setDisplay(display);
 
         mPETInfos[id] = currentInfo;
+        mPETIndex.insert(id, currentInfo);
     }
 }
 
@@ -181,21 +184,18 @@ void PETDB::unload()
 {
     delete_all(mPETInfos);
     mPETInfos.clear();
+    mPETIndex.clear();
 
     mLoaded = false;
 }
 
 BeingInfo *PETDB::get(const int id)
 {
-    const BeingInfoIterator i = mPETInfos.find(id);
-
-    if (i == mPETInfos.end())
+    BeingInfo *const info = mPETIndex.find(id);
+    if (!info)
     {
         logger->log("PETDB: Warning, unknown PET ID %d requested", id);
         return BeingInfo::unknown;
     }
-    else
-    {
-        return i->second;
-    }
+    return info;
 }
@@ -21,50 +21,376 @@
 #include "resources/delayedmanager.h"
 
 #include "animationdelayload.h"
+#include "configuration.h"
+#include "logger.h"
 
+#include "resources/imagehelper.h"
+#include "resources/imageset.h"
+#include "resources/resourcemanager.h"
+
+#include "utils/physfsrwops.h"
+#include "utils/physfstools.h"
+#include "utils/sdlcheckutils.h"
+#include "utils/sdlhelper.h"
 #include "utils/timer.h"
+#include "utils/xml.h"
 
 #include "debug.h"
 
+namespace
+{
+    // max time for loading delayed sprites per frame in microseconds
+    const unsigned int loadBudget = 5000;
+    // max count of prefetched but not loaded files
+    const size_t prefetchLimit = 32;
+}  // namespace
+
+struct DelayedPrefetch final
+{
+    DelayedPrefetch() :
+        fileName(),
+        document(nullptr),
+        images()
+    {
+    }
+
+    A_DELETE_COPY(DelayedPrefetch)
+
+    std::string fileName;
+    XML::Document *document;
+    std::map<std::string, SDL_Surface*> images;
+};
+
+typedef std::map<std::string, SDL_Surface*>::iterator PrefetchImagesIter;
+
 DelayedAnim DelayedManager::mDelayedAnimations;
+DelayedManager::Requests DelayedManager::mRequests;
+DelayedManager::WantedFiles DelayedManager::mWantedFiles;
+DelayedManager::Prefetches DelayedManager::mPrefetches;
+DelayedPrefetch *DelayedManager::mActivePrefetch = nullptr;
+ImageSet *DelayedManager::mPlaceholder = nullptr;
+SDL_Thread *DelayedManager::mThread = nullptr;
+SDL_mutex *DelayedManager::mMutex = nullptr;
+SDL_sem *DelayedManager::mSem = nullptr;
+volatile bool DelayedManager::mRunning = false;
+
+static std::string getXmlName(const std::string &fileName)
+{
+    const size_t pos = fileName.find('|');
+    if (pos != std::string::npos)
+        return fileName.substr(0, pos);
+    return fileName;
+}
+
+void DelayedManager::start()
+{
+    if (mThread)
+        return;
+    if (!mMutex)
+        mMutex = SDL_CreateMutex();
+    if (!mSem)
+        mSem = SDL_CreateSemaphore(0);
+    if (!mPlaceholder)
+    {
+        const std::string &placeholder = paths.getStringValue(
+            "spriteLoadingFile");
+        if (!placeholder.empty())
+        {
+            mPlaceholder = ResourceManager::getInstance()->getImageSet(
+                placeholder, 32, 32);
+        }
+    }
+
+    SDL_mutexP(mMutex);
+    // files requested before start also can be prefetched
+    FOR_EACH (DelayedAnimIter, it, mDelayedAnimations)
+    {
+        const AnimationDelayLoad *const load = (*it).second;
+        mRequests.insert(std::pair<int, std::string>(
+            load->mPriority, getXmlName(load->getFileName())));
+    }
+    SDL_mutexV(mMutex);
+
+    mRunning = true;
+    mThread = SDL::createThread(&prefetchThread, "prefetch", nullptr);
+    if (!mThread)
+    {
+        logger->log1("Unable to create prefetch thread");
+        mRunning = false;
+    }
+}
+
+void DelayedManager::stop()
+{
+    if (mPlaceholder)
+    {
+        mPlaceholder->decRef();
+        mPlaceholder = nullptr;
+    }
+    if (!mThread)
+        return;
+    mRunning = false;
+    SDL_SemPost(mSem);
+    SDL_WaitThread(mThread, nullptr);
+    mThread = nullptr;
+
+    mRequests.clear();
+    FOR_EACH (Prefetches::iterator, it, mPrefetches)
+        freePrefetch((*it).second);
+    mPrefetches.clear();
+}
+
+void DelayedManager::addDelayedAnimation(AnimationDelayLoad *const animation)
+{
+    if (!animation)
+        return;
+
+    animation->mIter = mDelayedAnimations.insert(
+        std::pair<int, AnimationDelayLoad*>(animation->mPriority,
+        animation));
+
+    if (!mMutex)
+        mMutex = SDL_CreateMutex();
+    const std::string fileName = getXmlName(animation->getFileName());
+    SDL_mutexP(mMutex);
+    mWantedFiles[fileName] ++;
+    SDL_mutexV(mMutex);
+    addRequest(fileName, animation->mPriority);
+}
+
+void DelayedManager::updatePriority(AnimationDelayLoad *const animation,
+                                    const int priority)
+{
+    if (!animation || animation->mPriority == priority)
+        return;
+
+    const bool raise = priority < animation->mPriority;
+    mDelayedAnimations.erase(animation->mIter);
+    animation->mPriority = priority;
+    animation->mIter = mDelayedAnimations.insert(
+        std::pair<int, AnimationDelayLoad*>(priority, animation));
+
+    // old request will be skipped by worker if file already prefetched
+    if (raise)
+        addRequest(getXmlName(animation->getFileName()), priority);
+}
+
+void DelayedManager::addRequest(const std::string &fileName,
+                                const int priority)
+{
+    if (!mThread)
+        return;
+    SDL_mutexP(mMutex);
+    mRequests.insert(std::pair<int, std::string>(priority, fileName));
+    SDL_mutexV(mMutex);
+    SDL_SemPost(mSem);
+}
 
 void DelayedManager::delayedLoad()
 {
     BLOCK_START("DelayedManager::delayedLoad")
-    static int loadTime = 0;
-    if (loadTime < cur_time)
+    const unsigned int startTime = get_time_usec();
+    int k = 0;
+    while (!mDelayedAnimations.empty())
     {
-        loadTime = tick_time;
+        if (k > 0 && get_time_usec() - startTime >= loadBudget)
+            break;
+
+        const DelayedAnimIter it = mDelayedAnimations.begin();
+        AnimationDelayLoad *const load = (*it).second;
+        mDelayedAnimations.erase(it);
 
-        int k = 0;
-        DelayedAnimIter it = mDelayedAnimations.begin();
-        const DelayedAnimIter it_end = mDelayedAnimations.end();
-        while (it != it_end && k < 1)
+        const std::string fileName = getXmlName(load->getFileName());
+        SDL_mutexP(mMutex);
+        const Prefetches::iterator it2 = mPrefetches.find(fileName);
+        if (it2 != mPrefetches.end())
         {
-            (*it)->load();
-            AnimationDelayLoad *tmp = *it;
-            it = mDelayedAnimations.erase(it);
-            delete tmp;
-            k ++;
+            mActivePrefetch = (*it2).second;
+            mPrefetches.erase(it2);
+            // worker can wait for free prefetch slot
+            if (mThread)
+                SDL_SemPost(mSem);
         }
-        const int time2 = tick_time;
-        if (time2 > loadTime)
-            loadTime = time2 + (time2 - loadTime) * 2 + 10;
-        else
-            loadTime = time2 + 3;
+        SDL_mutexV(mMutex);
+        releaseFile(fileName);
+
+        load->load();
+        freePrefetch(mActivePrefetch);
+        mActivePrefetch = nullptr;
+        delete load;
+        k ++;
     }
     BLOCK_END("DelayedManager::delayedLoad")
 }
 
-void DelayedManager::removeDelayLoad(const AnimationDelayLoad
-                                     *const delayedLoad)
+void DelayedManager::removeDelayLoad(AnimationDelayLoad *const delayedLoad)
 {
-    FOR_EACH (DelayedAnimIter, it, mDelayedAnimations)
+    if (!delayedLoad)
+        return;
+    mDelayedAnimations.erase(delayedLoad->mIter);
+    releaseFile(getXmlName(delayedLoad->getFileName()));
+}
+
+void DelayedManager::releaseFile(const std::string &fileName)
+{
+    SDL_mutexP(mMutex);
+    const WantedFiles::iterator it = mWantedFiles.find(fileName);
+    if (it != mWantedFiles.end())
+    {
+        (*it).second --;
+        if ((*it).second <= 0)
+        {
+            mWantedFiles.erase(it);
+            const Prefetches::iterator it2 = mPrefetches.find(fileName);
+            if (it2 != mPrefetches.end())
+            {
+                freePrefetch((*it2).second);
+                mPrefetches.erase(it2);
+                if (mThread)
+                    SDL_SemPost(mSem);
+            }
+        }
+    }
+    SDL_mutexV(mMutex);
+}
+
+XML::Document *DelayedManager::getPrefetchedDocument(const std::string
+                                                     &fileName)
+{
+    if (!mActivePrefetch)
+        return nullptr;
+    XML::Document *const doc = mActivePrefetch->document;
+    // included sprites use own documents
+    if (!doc || mActivePrefetch->fileName != fileName)
+        return nullptr;
+    mActivePrefetch->document = nullptr;
+    return doc;
+}
+
+const Image *DelayedManager::getPlaceholder()
+{
+    if (!mPlaceholder || !mPlaceholder->size())
+        return nullptr;
+    return mPlaceholder->get(0);
+}
+
+SDL_Surface *DelayedManager::getPrefetchedImage(const std::string &fileName)
+{
+    if (!mActivePrefetch)
+        return nullptr;
+    const PrefetchImagesIter it = mActivePrefetch->images.find(fileName);
+    if (it == mActivePrefetch->images.end())
+        return nullptr;
+    SDL_Surface *const surface = (*it).second;
+    mActivePrefetch->images.erase(it);
+    return surface;
+}
+
+void DelayedManager::freePrefetch(DelayedPrefetch *const prefetch)
+{
+    if (!prefetch)
+        return;
+    delete prefetch->document;
+    FOR_EACH (PrefetchImagesIter, it, prefetch->images)
+        MSDL_FreeSurface((*it).second);
+    delete prefetch;
+}
+
+DelayedPrefetch *DelayedManager::prefetch(const std::string &fileName)
+{
+    // PhysFs::loadFile not used here, because logger is not thread safe
+    PHYSFS_file *const file = PhysFs::openRead(fileName.c_str());
+    if (!file)
+        return nullptr;
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+    if (length <= 0)
     {
-        if (*it == delayedLoad)
+        PHYSFS_close(file);
+        return nullptr;
+    }
+    const int size = static_cast<int>(length);
+    char *const data = new char[size];
+    const PHYSFS_sint64 readSize = PHYSFS_read(file, data, 1, size);
+    PHYSFS_close(file);
+    if (readSize != length)
+    {
+        // file changed or read error, main thread will load it itself
+        delete [] data;
+        return nullptr;
+    }
+
+    DelayedPrefetch *const prefetch = new DelayedPrefetch;
+    prefetch->fileName = fileName;
+    prefetch->document = new XML::Document(data, size);
+    delete [] data;
+
+    const XmlNodePtr rootNode = prefetch->document->rootNode();
+    if (!rootNode || !xmlNameEqual(rootNode, "sprite"))
+        return prefetch;
+
+    for_each_xml_child_node(node, rootNode)
+    {
+        if (!mRunning)
+            break;
+        if (!xmlNameEqual(node, "imageset"))
+            continue;
+        const std::string src = getXmlName(
+            XML::getProperty(node, "src", ""));
+        if (src.empty()
+            || prefetch->images.find(src) != prefetch->images.end())
+        {
+            continue;
+        }
+        SDL_Surface *const surface = ImageHelper::loadPng(
+            MPHYSFSRWOPS_openRead(src.c_str()));
+        if (surface)
+            prefetch->images[src] = surface;
+    }
+    return prefetch;
+}
+
+int DelayedManager::prefetchThread(void *ptr A_UNUSED)
+{
+    while (mRunning)
+    {
+        std::string fileName;
+        SDL_mutexP(mMutex);
+        while (!mRequests.empty() && mPrefetches.size() < prefetchLimit)
+        {
+            const Requests::iterator it = mRequests.begin();
+            fileName = (*it).second;
+            mRequests.erase(it);
+            if (mWantedFiles.find(fileName) != mWantedFiles.end()
+                && mPrefetches.find(fileName) == mPrefetches.end())
+            {
+                break;
+            }
+            fileName.clear();
+        }
+        SDL_mutexV(mMutex);
+
+        // woken by new requests, free prefetch slots and stop
+        if (fileName.empty())
+        {
+            SDL_SemWait(mSem);
+            continue;
+        }
+
+        DelayedPrefetch *const data = prefetch(fileName);
+        if (!data)
+            continue;
+
+        SDL_mutexP(mMutex);
+        if (mWantedFiles.find(fileName) != mWantedFiles.end()
+            && mPrefetches.find(fileName) == mPrefetches.end())
+        {
+            mPrefetches[fileName] = data;
+        }
+        else
         {
-            mDelayedAnimations.erase(it);
-            return;
+            freePrefetch(data);
         }
+        SDL_mutexV(mMutex);
     }
+    return 0;
 }
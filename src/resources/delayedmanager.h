@@ -21,32 +21,99 @@
 #ifndef RESOURCES_DELAYEDMANAGER_H
 #define RESOURCES_DELAYEDMANAGER_H
 
-#include <list>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+
+#include <map>
+#include <string>
 
 #include "localconsts.h"
 
 class AnimationDelayLoad;
+class Image;
+class ImageSet;
+
+struct DelayedPrefetch;
+struct SDL_Surface;
+
+namespace XML
+{
+    class Document;
+}  // namespace XML
 
-typedef std::list<AnimationDelayLoad*> DelayedAnim;
+// lower value loaded first
+const int DELAY_PRIORITY_DEFAULT = 1000;
+
+typedef std::multimap<int, AnimationDelayLoad*> DelayedAnim;
 typedef DelayedAnim::iterator DelayedAnimIter;
 
 /**
- * A class for loading and managing resources.
+ * Loads delayed sprites in order of priority, inside of frame time budget.
+ * Sprite xml and images are read, parsed and decoded in background thread,
+ * and main thread only creates resources and textures from ready data.
  */
 class DelayedManager final
 {
     public:
-        static void addDelayedAnimation(AnimationDelayLoad *const animation)
-        { mDelayedAnimations.push_back(animation); }
+        static void start();
+
+        static void stop();
+
+        static void addDelayedAnimation(AnimationDelayLoad *const animation);
+
+        static void updatePriority(AnimationDelayLoad *const animation,
+                                   const int priority);
 
         static void delayedLoad();
 
-        static void removeDelayLoad(const AnimationDelayLoad
-                                    *const delayedLoad);
+        static void removeDelayLoad(AnimationDelayLoad *const delayedLoad);
 
+        /**
+         * Returns prefetched document for file loading right now, or nullptr.
+         * Caller take ownership.
+         */
+        static XML::Document *getPrefetchedDocument(const std::string
+                                                    &fileName) A_WARN_UNUSED;
+
+        /**
+         * Returns prefetched image for file loading right now, or nullptr.
+         * Caller take ownership.
+         */
+        static SDL_Surface *getPrefetchedImage(const std::string &fileName)
+                                               A_WARN_UNUSED;
+
+        /**
+         * Returns image drawn instead of not loaded sprites, or nullptr.
+         */
+        static const Image *getPlaceholder() A_WARN_UNUSED;
 
     private:
+        typedef std::multimap<int, std::string> Requests;
+        typedef std::map<std::string, int> WantedFiles;
+        typedef std::map<std::string, DelayedPrefetch*> Prefetches;
+
+        static int prefetchThread(void *ptr);
+
+        static DelayedPrefetch *prefetch(const std::string &fileName)
+                                         A_WARN_UNUSED;
+
+        static void addRequest(const std::string &fileName,
+                               const int priority);
+
+        static void releaseFile(const std::string &fileName);
+
+        static void freePrefetch(DelayedPrefetch *const prefetch);
+
         static DelayedAnim mDelayedAnimations;
+        static Requests mRequests;
+        static WantedFiles mWantedFiles;
+        static Prefetches mPrefetches;
+        static DelayedPrefetch *mActivePrefetch;
+        static ImageSet *mPlaceholder;
+        static SDL_Thread *mThread;
+        static SDL_mutex *mMutex;
+        static SDL_sem *mSem;
+        static volatile bool mRunning;
 };
 
 #endif  // RESOURCES_DELAYEDMANAGER_H
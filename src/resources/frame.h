@@ -50,6 +50,8 @@ struct Frame final
     int rand;
     FrameType type;
     std::string nextAction;
+    int nextFrame;     /**< Label frame index for goto, or -1. */
+    int nextActionId;  /**< Action id for jump, or -1. */
 };
 
 #endif  // RESOURCES_FRAME_H
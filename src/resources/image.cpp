@@ -55,11 +55,8 @@ Image::Image(SDL_Texture *restrict const image,
     mAlpha(1.0F),
     mSDLSurface(nullptr),
     mTexture(image),
-    mAlphaChannel(nullptr),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(false),
-    mUseAlphaCache(false),
     mIsAlphaVisible(true),
     mIsAlphaCalculated(false)
 {
@@ -87,8 +84,7 @@ Image::Image(SDL_Texture *restrict const image,
 }
 #endif
 
-Image::Image(SDL_Surface *restrict const image, const bool hasAlphaChannel0,
-             uint8_t *restrict const alphaChannel) :
+Image::Image(SDL_Surface *restrict const image, const bool hasAlphaChannel0) :
     Resource(),
 #ifdef USE_OPENGL
     mGLImage(0),
@@ -101,11 +97,8 @@ Image::Image(SDL_Surface *restrict const image, const bool hasAlphaChannel0,
 #ifdef USE_SDL2
     mTexture(nullptr),
 #endif
-    mAlphaChannel(alphaChannel),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(hasAlphaChannel0),
-    mUseAlphaCache(SDLImageHelper::mEnableAlphaCache),
     mIsAlphaVisible(hasAlphaChannel0),
     mIsAlphaCalculated(false)
 {
@@ -145,11 +138,8 @@ Image::Image(const GLuint glimage, const int width, const int height,
 #ifdef USE_SDL2
     mTexture(nullptr),
 #endif
-    mAlphaChannel(nullptr),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(true),
-    mUseAlphaCache(false),
     mIsAlphaVisible(true),
     mIsAlphaCalculated(false)
 {
@@ -162,7 +152,8 @@ Image::Image(const GLuint glimage, const int width, const int height,
     mBounds.w = static_cast<uint16_t>(width);
     mBounds.h = static_cast<uint16_t>(height);
 
-    if (mGLImage)
+    // null renderer images have size but no texture
+    if (mGLImage || OpenGLImageHelper::mUseOpenGL == RENDER_NULL)
     {
         mLoaded = true;
     }
@@ -183,34 +174,15 @@ Image::~Image()
     unload();
 }
 
-void Image::SDLCleanCache()
-{
-    ResourceManager *const resman = ResourceManager::getInstance();
-
-    for (std::map<float, SDL_Surface*>::iterator
-         i = mAlphaCache.begin(), i_end = mAlphaCache.end();
-         i != i_end; ++i)
-    {
-        if (mSDLSurface != i->second)
-            resman->scheduleDelete(i->second);
-        i->second = nullptr;
-    }
-    mAlphaCache.clear();
-}
-
 void Image::unload()
 {
     mLoaded = false;
 
     if (mSDLSurface)
     {
-        SDLCleanCache();
         // Free the image surface.
         MSDL_FreeSurface(mSDLSurface);
         mSDLSurface = nullptr;
-
-        delete [] mAlphaChannel;
-        mAlphaChannel = nullptr;
     }
 #ifdef USE_SDL2
     if (mTexture)
@@ -246,15 +218,6 @@ bool Image::hasAlphaChannel() const
     return false;
 }
 
-SDL_Surface *Image::getByAlpha(const float alpha)
-{
-    const std::map<float, SDL_Surface*>::const_iterator
-        it = mAlphaCache.find(alpha);
-    if (it != mAlphaCache.end())
-        return (*it).second;
-    return nullptr;
-}
-
 void Image::setAlpha(const float alpha)
 {
     if (mAlpha == alpha || !ImageHelper::mEnableAlpha)
@@ -263,145 +226,30 @@ void Image::setAlpha(const float alpha)
     if (alpha < 0.0F || alpha > 1.0F)
         return;
 
+    mAlpha = alpha;
+
     if (mSDLSurface)
     {
-        if (mUseAlphaCache)
-        {
-            SDL_Surface *surface = getByAlpha(mAlpha);
-            if (!surface)
-            {
-                if (mAlphaCache.size() > 100)
-                {
-#ifdef DEBUG_ALPHA_CACHE
-                    logger->log("cleanCache");
-                    for (std::map<float, SDL_Surface*>::const_iterator
-                         i = mAlphaCache.begin(), i_end = mAlphaCache.end();
-                         i != i_end; ++i)
-                    {
-                        logger->log("alpha: " + toString(i->first));
-                    }
-#endif
-                    SDLCleanCache();
-                }
-                surface = mSDLSurface;
-                if (surface)
-                    mAlphaCache[mAlpha] = surface;
-            }
-            else
-            {
-                logger->log("cache bug");
-            }
-
-            surface = getByAlpha(alpha);
-            if (surface)
-            {
-                if (mSDLSurface == surface)
-                    logger->log("bug");
-                mAlphaCache.erase(alpha);
-                mSDLSurface = surface;
-                mAlpha = alpha;
-                return;
-            }
-            else
-            {
-                mSDLSurface = SDLImageHelper::SDLDuplicateSurface(mSDLSurface);
-            }
-        }
-
-        mAlpha = alpha;
-
-        if (!mHasAlphaChannel)
-        {
 #ifdef USE_SDL2
-            SDL_SetSurfaceAlphaMod(mSDLSurface,
-                static_cast<unsigned char>(255 * mAlpha));
+        SDL_SetSurfaceAlphaMod(mSDLSurface,
+            static_cast<unsigned char>(255 * mAlpha));
 #else
+        // Images with alpha channel blended with mAlpha while drawing.
+        if (!mHasAlphaChannel)
+        {
             // Set the alpha value this image is drawn at
             SDL_SetAlpha(mSDLSurface, SDL_SRCALPHA,
                 static_cast<unsigned char>(255 * mAlpha));
-#endif
-        }
-        else
-        {
-            if (SDL_MUSTLOCK(mSDLSurface))
-                SDL_LockSurface(mSDLSurface);
-
-            const int bx = mBounds.x;
-            const int by = mBounds.y;
-            const int bw = mBounds.w;
-            const int bh = mBounds.h;
-            const int bxw = bx + bw;
-            const int sw = mSDLSurface->w;
-            const int maxHeight = std::min(by + bh, mSDLSurface->h);
-            const int maxWidth = std::min(bxw, sw);
-            const int i1 = by * sw + bx;
-            const SDL_PixelFormat * const fmt = mSDLSurface->format;
-            const uint32_t amask = fmt->Amask;
-            const uint32_t invMask = ~fmt->Amask;
-            const uint8_t aloss = fmt->Aloss;
-            const uint8_t ashift = fmt->Ashift;
-
-            if (!bx && bxw == sw)
-            {
-                const int i2 = (maxHeight - 1) * sw + maxWidth - 1;
-                for (int i = i1; i <= i2; i++)
-                {
-                    const uint8_t sourceAlpha = mAlphaChannel[i];
-                    if (sourceAlpha > 0)
-                    {
-                        const uint8_t a = static_cast<uint8_t>(
-                            static_cast<float>(sourceAlpha) * mAlpha);
-
-                        uint32_t c = (static_cast<uint32_t*>(
-                            mSDLSurface->pixels))[i];
-                        c &= invMask;
-                        c |= ((a >> aloss) << ashift & amask);
-                        (static_cast<uint32_t*>(mSDLSurface->pixels))[i] = c;
-                    }
-                }
-            }
-            else
-            {
-                for (int y = by; y < maxHeight; y ++)
-                {
-                    const int idx = y * sw;
-                    const int x1 = idx + bx;
-                    const int x2 = idx + maxWidth;
-                    for (int i = x1; i < x2; i ++)
-                    {
-                        const uint8_t sourceAlpha = mAlphaChannel[i];
-                        if (sourceAlpha > 0)
-                        {
-                            const uint8_t a = static_cast<uint8_t>(
-                                static_cast<float>(sourceAlpha) * mAlpha);
-
-                            uint32_t c = (static_cast<uint32_t*>(
-                                mSDLSurface->pixels))[i];
-                            c &= invMask;
-                            c |= ((a >> aloss) << ashift & amask);
-                            (static_cast<uint32_t*>(
-                                mSDLSurface->pixels))[i] = c;
-                        }
-                    }
-                }
-            }
-
-            if (SDL_MUSTLOCK(mSDLSurface))
-                SDL_UnlockSurface(mSDLSurface);
         }
+#endif
     }
 #ifdef USE_SDL2
     else if (mTexture)
     {
-        mAlpha = alpha;
         SDL_SetTextureAlphaMod(mTexture,
             static_cast<unsigned char>(255 * mAlpha));
     }
 #endif
-    else
-    {
-        mAlpha = alpha;
-    }
 }
 
 Image* Image::SDLgetScaledImage(const int width, const int height) const
@@ -443,7 +291,8 @@ Image *Image::getSubImage(const int x, const int y,
     if (mode == RENDER_NORMAL_OPENGL
         || mode == RENDER_SAFE_OPENGL
         || mode == RENDER_GLES_OPENGL
-        || mode == RENDER_MODERN_OPENGL)
+        || mode == RENDER_MODERN_OPENGL
+        || mode == RENDER_NULL)
     {
         return new SubImage(this, mGLImage, x, y, width, height,
                             mTexWidth, mTexHeight);
@@ -463,10 +312,20 @@ Image *Image::getSubImage(const int x, const int y,
 #endif
 }
 
-void Image::SDLTerminateAlphaCache()
+int Image::calcMemory() const
 {
-    SDLCleanCache();
-    mUseAlphaCache = false;
+    int sz = static_cast<int>(sizeof(Image));
+    if (mSDLSurface)
+        sz += mSDLSurface->pitch * mSDLSurface->h;
+#ifdef USE_SDL2
+    if (mTexture)
+        sz += mBounds.w * mBounds.h * 4;
+#endif
+#ifdef USE_OPENGL
+    if (mGLImage)
+        sz += mTexWidth * mTexHeight * 4;
+#endif
+    return sz;
 }
 
 #ifdef USE_OPENGL
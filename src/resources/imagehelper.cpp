@@ -65,6 +65,17 @@ Image *ImageHelper::load(SDL_RWops *const rw, Dye const &dye)
         return nullptr;
     }
 
+    Image *const image = load(tmpImage, dye);
+    MSDL_FreeSurface(tmpImage);
+    BLOCK_END("ImageHelper::load")
+    return image;
+}
+
+Image *ImageHelper::load(SDL_Surface *const tmpImage, Dye const &dye)
+{
+    if (!tmpImage)
+        return nullptr;
+
     SDL_PixelFormat rgba;
     rgba.palette = nullptr;
     rgba.BitsPerPixel = 32;
@@ -84,7 +95,6 @@ Image *ImageHelper::load(SDL_RWops *const rw, Dye const &dye)
 
     SDL_Surface *const surf = MSDL_ConvertSurface(
         tmpImage, &rgba, SDL_SWSURFACE);
-    MSDL_FreeSurface(tmpImage);
 
     uint32_t *const pixels = static_cast<uint32_t *const>(surf->pixels);
     const int type = dye.getType();
@@ -115,7 +125,6 @@ Image *ImageHelper::load(SDL_RWops *const rw, Dye const &dye)
 
     Image *const image = load(surf);
     MSDL_FreeSurface(surf);
-    BLOCK_END("ImageHelper::load")
     return image;
 }
 
@@ -54,9 +54,17 @@ class ImageHelper notfinal
          * @return <code>NULL</code> if an error occurred, a valid pointer
          *         otherwise.
          */
-        Image *load(SDL_RWops *const rw) A_WARN_UNUSED;
+        virtual Image *load(SDL_RWops *const rw) A_WARN_UNUSED;
 
-        virtual Image *load(SDL_RWops *const rw, Dye const &dye) A_WARN_UNUSED;
+        virtual Image *load(SDL_RWops *const rw,
+                            Dye const &dye) A_WARN_UNUSED;
+
+        /**
+         * Recolors and loads an image from an SDL surface.
+         * Surface is not freed.
+         */
+        virtual Image *load(SDL_Surface *const tmpImage,
+                            Dye const &dye) A_WARN_UNUSED;
 
 #ifdef __GNUC__
         virtual Image *load(SDL_Surface *const) A_WARN_UNUSED = 0;
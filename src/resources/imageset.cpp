@@ -62,6 +62,18 @@ ImageSet::~ImageSet()
     delete_all(mImages);
 }
 
+int ImageSet::calcMemory() const
+{
+    int sz = static_cast<int>(sizeof(ImageSet));
+    FOR_EACH (std::vector<Image*>::const_iterator, it, mImages)
+    {
+        const Image *const image = *it;
+        if (image)
+            sz += image->calcMemory();
+    }
+    return sz;
+}
+
 Image* ImageSet::get(const size_type i) const
 {
     if (i >= mImages.size())
@@ -40,10 +40,10 @@
 #include "particle/particle.h"
 
 #include "resources/ambientlayer.h"
+#include "resources/image.h"
 #include "resources/mapitemtype.h"
 #include "resources/notifytypes.h"
 #include "resources/resourcemanager.h"
-#include "resources/subimage.h"
 
 #include "resources/map/location.h"
 #include "resources/map/mapobjectlist.h"
@@ -1152,10 +1152,17 @@ void Map::addRange(const std::string &name, const int type,
 }
 
 void Map::addPortal(const std::string &name, const int type,
-                    const int x, const int y, const int dx, const int dy)
+                    const int x, const int y, const int dx, const int dy,
+                    const std::string &target,
+                    const int targetX, const int targetY)
 {
     addPortalTile(name, type, (x / mapTileSize) + (dx / mapTileSize / 2),
         (y / mapTileSize) + (dy / mapTileSize / 2));
+    MapItem *const item = mMapPortals.back();
+    item->setTarget(target);
+    // destination stored in pixels like object position
+    if (targetX >= 0 && targetY >= 0)
+        item->setTargetPos(targetX / mapTileSize, targetY / mapTileSize);
 }
 
 void Map::addPortalTile(const std::string &name, const int type,
@@ -1374,36 +1381,35 @@ void Map::reduce()
                     }
                     else if (img->hasAlphaChannel())
                     {
-                        const uint8_t *const arr = img->SDLgetAlphaChannel();
-                        if (!arr)
+                        // sub images share surface with parent image
+                        const SDL_Surface *const surface
+                            = img->getSDLSurface();
+                        if (!surface
+                            || surface->format->BytesPerPixel != 4
+                            || !surface->format->Amask)
+                        {
                             continue;
+                        }
 
+                        const uint32_t amask = surface->format->Amask;
                         bool bad(false);
-                        bool stop(false);
-                        int width;
-                        const SubImage *const subImg
-                            = dynamic_cast<SubImage*>(img);
-                        if (subImg)
-                            width = subImg->mInternalBounds.w;
-                        else
-                            width = img->mBounds.w;
-
-                        for (int f = img->mBounds.x;
-                             f < img->mBounds.x + img->mBounds.w; f ++)
+                        for (int d = img->mBounds.y;
+                             d < img->mBounds.y + img->mBounds.h && !bad;
+                             d ++)
                         {
-                            for (int d = img->mBounds.y;
-                                 d < img->mBounds.y + img->mBounds.h; d ++)
+                            const uint32_t *const row =
+                                reinterpret_cast<const uint32_t*>(
+                                static_cast<const uint8_t*>(surface->pixels)
+                                + d * surface->pitch);
+                            for (int f = img->mBounds.x;
+                                 f < img->mBounds.x + img->mBounds.w; f ++)
                             {
-                                const uint8_t chan = arr[f + d * width];
-                                if (chan != 255)
+                                if ((row[f] & amask) != amask)
                                 {
                                     bad = true;
-                                    stop = true;
                                     break;
                                 }
                             }
-                            if (stop)
-                                break;
                         }
                         if (!bad)
                         {
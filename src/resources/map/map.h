@@ -241,7 +241,9 @@ class Map final : public Properties, public ConfigListener
         std::string getUserMapDirectory() const A_WARN_UNUSED;
 
         void addPortal(const std::string &name, const int type,
-                       const int x, const int y, const int dx, const int dy);
+                       const int x, const int y, const int dx, const int dy,
+                       const std::string &target,
+                       const int targetX, const int targetY);
 
         void addRange(const std::string &name, const int type,
                       const int x, const int y, const int dx, const int dy);
@@ -37,6 +37,9 @@ MapItem::MapItem() :
     mImage(nullptr),
     mComment(),
     mName(),
+    mTarget(),
+    mTargetX(-1),
+    mTargetY(-1),
     mType(MapItemType::EMPTY),
     mX(-1),
     mY(-1)
@@ -48,6 +51,9 @@ MapItem::MapItem(const int type) :
     mImage(nullptr),
     mComment(),
     mName(),
+    mTarget(),
+    mTargetX(-1),
+    mTargetY(-1),
     mType(type),
     mX(-1),
     mY(-1)
@@ -59,6 +65,9 @@ MapItem::MapItem(const int type, std::string comment) :
     mImage(nullptr),
     mComment(comment),
     mName(),
+    mTarget(),
+    mTargetX(-1),
+    mTargetY(-1),
     mType(type),
     mX(-1),
     mY(-1)
@@ -71,6 +80,9 @@ MapItem::MapItem(const int type, std::string comment,
     mImage(nullptr),
     mComment(comment),
     mName(),
+    mTarget(),
+    mTargetX(-1),
+    mTargetY(-1),
     mType(type),
     mX(x),
     mY(y)
@@ -71,6 +71,30 @@ class MapItem final
         void setName(const std::string &name)
         { mName = name; }
 
+        /**
+         * Returns destination map name for warp portals, if known.
+         */
+        const std::string &getTarget() const A_WARN_UNUSED
+        { return mTarget; }
+
+        void setTarget(const std::string &target)
+        { mTarget = target; }
+
+        /**
+         * Returns destination tile for warp portals, or -1 if unknown.
+         */
+        int getTargetX() const A_WARN_UNUSED
+        { return mTargetX; }
+
+        int getTargetY() const A_WARN_UNUSED
+        { return mTargetY; }
+
+        void setTargetPos(const int x, const int y)
+        {
+            mTargetX = x;
+            mTargetY = y;
+        }
+
         void draw(Graphics *const graphics, const int x, const int y,
                   const int dx, const int dy) const;
 
@@ -78,6 +102,9 @@ class MapItem final
         Image *mImage;
         std::string mComment;
         std::string mName;
+        std::string mTarget;
+        int mTargetX;
+        int mTargetY;
         int mType;
         int mX;
         int mY;
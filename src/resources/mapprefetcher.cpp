@@ -0,0 +1,413 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/mapprefetcher.h"
+
+#include "configuration.h"
+#include "logger.h"
+
+#include "resources/image.h"
+#include "resources/imagehelper.h"
+#include "resources/mapreader.h"
+#include "resources/resourcemanager.h"
+
+#include "resources/db/mapdb.h"
+
+#include "resources/map/map.h"
+#include "resources/map/mapitem.h"
+
+#include "utils/physfsrwops.h"
+#include "utils/physfstools.h"
+#include "utils/sdlcheckutils.h"
+#include "utils/sdlhelper.h"
+#include "utils/timer.h"
+#include "utils/xml.h"
+
+#include <map>
+#include <vector>
+
+#include "debug.h"
+
+namespace
+{
+    // distance to portal in tiles, from what map prefetched
+    const int prefetchDistance = 8;
+    // distance to portals in tiles, after what prefetched map released
+    const int releaseDistance = 16;
+    // max time for creating prefetched images per frame in microseconds
+    const unsigned int loadBudget = 3000;
+}  // namespace
+
+struct MapPrefetch final
+{
+    MapPrefetch() :
+        fileName(),
+        documents(),
+        images(),
+        resources()
+    {
+    }
+
+    A_DELETE_COPY(MapPrefetch)
+
+    std::string fileName;
+    std::map<std::string, XML::Document*> documents;
+    std::map<std::string, SDL_Surface*> images;
+    std::vector<Resource*> resources;
+};
+
+typedef std::map<std::string, XML::Document*>::iterator PrefetchDocsIter;
+typedef std::map<std::string, SDL_Surface*>::iterator PrefetchImagesIter;
+
+std::string MapPrefetcher::mRequested;
+std::string MapPrefetcher::mPending;
+MapPrefetch *MapPrefetcher::mReady = nullptr;
+MapPrefetch *MapPrefetcher::mActive = nullptr;
+const Map *MapPrefetcher::mMap = nullptr;
+SDL_Thread *MapPrefetcher::mThread = nullptr;
+SDL_mutex *MapPrefetcher::mMutex = nullptr;
+SDL_sem *MapPrefetcher::mSem = nullptr;
+int MapPrefetcher::mTileX = -1;
+int MapPrefetcher::mTileY = -1;
+int MapPrefetcher::mHits = 0;
+int MapPrefetcher::mMisses = 0;
+int MapPrefetcher::mWarpTime = 0;
+volatile bool MapPrefetcher::mRunning = false;
+
+void MapPrefetcher::start()
+{
+    if (mThread)
+        return;
+    if (!mMutex)
+        mMutex = SDL_CreateMutex();
+    if (!mSem)
+        mSem = SDL_CreateSemaphore(0);
+
+    mRunning = true;
+    mThread = SDL::createThread(&prefetchThread, "mapprefetch", nullptr);
+    if (!mThread)
+    {
+        logger->log1("Unable to create map prefetch thread");
+        mRunning = false;
+    }
+}
+
+void MapPrefetcher::stop()
+{
+    if (!mThread)
+        return;
+    mRunning = false;
+    SDL_SemPost(mSem);
+    SDL_WaitThread(mThread, nullptr);
+    mThread = nullptr;
+
+    mRequested.clear();
+    mPending.clear();
+    mMap = nullptr;
+    freePrefetch(mReady);
+    mReady = nullptr;
+    freePrefetch(mActive);
+    mActive = nullptr;
+}
+
+void MapPrefetcher::logic(const Map *const map,
+                          const int tileX,
+                          const int tileY)
+{
+    if (!mThread || !map)
+        return;
+
+    BLOCK_START("MapPrefetcher::logic")
+    if (map != mMap || tileX != mTileX || tileY != mTileY)
+    {
+        mMap = map;
+        mTileX = tileX;
+        mTileY = tileY;
+
+        const MapItem *portal = nullptr;
+        int dist = releaseDistance + 1;
+        const std::vector<MapItem*> &portals = map->getPortals();
+        FOR_EACH (std::vector<MapItem*>::const_iterator, it, portals)
+        {
+            const MapItem *const item = *it;
+            if (!item || item->getTarget().empty())
+                continue;
+            const int dx = abs(item->getX() - tileX);
+            const int dy = abs(item->getY() - tileY);
+            const int d = dx > dy ? dx : dy;
+            if (d < dist)
+            {
+                dist = d;
+                portal = item;
+            }
+        }
+
+        if (portal && dist <= prefetchDistance)
+        {
+            // same file name as in Game::changeMap
+            std::string fileName = paths.getValue("maps", "maps/")
+                .append(MapDB::getMapName(portal->getTarget()))
+                .append(".tmx");
+            if (!PhysFs::exists(fileName.c_str()))
+                fileName.append(".gz");
+            if (fileName != mRequested && PhysFs::exists(fileName.c_str()))
+                request(fileName);
+        }
+        else if (!portal)
+        {
+            request(std::string());
+        }
+    }
+
+    SDL_mutexP(mMutex);
+    MapPrefetch *const prefetch = mReady;
+    SDL_mutexV(mMutex);
+    // thread not touch ready prefetch
+    if (prefetch)
+        createImages(prefetch, loadBudget);
+    BLOCK_END("MapPrefetcher::logic")
+}
+
+void MapPrefetcher::request(const std::string &fileName)
+{
+    if (fileName == mRequested)
+        return;
+    SDL_mutexP(mMutex);
+    mRequested = fileName;
+    mPending = fileName;
+    MapPrefetch *const old = mReady;
+    mReady = nullptr;
+    SDL_mutexV(mMutex);
+    if (!fileName.empty())
+        SDL_SemPost(mSem);
+    freePrefetch(old);
+}
+
+void MapPrefetcher::createImages(MapPrefetch *const prefetch,
+                                 const unsigned int budget)
+{
+    if (prefetch->images.empty())
+        return;
+
+    const unsigned int startTime = get_time_usec();
+    ResourceManager *const resman = ResourceManager::getInstance();
+    while (!prefetch->images.empty())
+    {
+        if (budget && get_time_usec() - startTime >= budget)
+            break;
+
+        const PrefetchImagesIter it = prefetch->images.begin();
+        const std::string path = (*it).first;
+        SDL_Surface *const surface = (*it).second;
+        prefetch->images.erase(it);
+
+        // hold reference, what image not removed from cache before warp
+        Resource *res = resman->getFromCache(path);
+        if (!res)
+        {
+            res = imageHelper->load(surface);
+            if (res)
+                resman->addResource(path, res);
+        }
+        MSDL_FreeSurface(surface);
+        if (res)
+            prefetch->resources.push_back(res);
+    }
+}
+
+void MapPrefetcher::startMapLoad(const std::string &fileName)
+{
+    if (!mThread)
+        return;
+
+    SDL_mutexP(mMutex);
+    if (mReady && mReady->fileName == fileName)
+    {
+        mActive = mReady;
+        mReady = nullptr;
+    }
+    mRequested.clear();
+    mPending.clear();
+    SDL_mutexV(mMutex);
+
+    if (mActive)
+    {
+        mHits ++;
+        createImages(mActive, 0);
+    }
+    else
+    {
+        mMisses ++;
+    }
+}
+
+void MapPrefetcher::endMapLoad(const unsigned int loadTime)
+{
+    mWarpTime = static_cast<int>(loadTime / 1000);
+    logger->log("Map changed in %d ms, prefetched: %s", mWarpTime,
+        mActive ? "yes" : "no");
+    // map tilesets hold own references to images
+    freePrefetch(mActive);
+    mActive = nullptr;
+    mMap = nullptr;
+}
+
+XML::Document *MapPrefetcher::getDocument(const std::string &fileName)
+{
+    if (!mActive)
+        return nullptr;
+    const PrefetchDocsIter it = mActive->documents.find(fileName);
+    if (it == mActive->documents.end())
+        return nullptr;
+    XML::Document *const doc = (*it).second;
+    mActive->documents.erase(it);
+    return doc;
+}
+
+void MapPrefetcher::freePrefetch(MapPrefetch *const prefetch)
+{
+    if (!prefetch)
+        return;
+    FOR_EACH (PrefetchDocsIter, it, prefetch->documents)
+        delete (*it).second;
+    FOR_EACH (PrefetchImagesIter, it, prefetch->images)
+        MSDL_FreeSurface((*it).second);
+    FOR_EACH (std::vector<Resource*>::iterator, it, prefetch->resources)
+        (*it)->decRef();
+    delete prefetch;
+}
+
+bool MapPrefetcher::isRequested(const std::string &fileName)
+{
+    SDL_mutexP(mMutex);
+    const bool requested = (mRequested == fileName);
+    SDL_mutexV(mMutex);
+    return requested;
+}
+
+static XML::Document *loadDocument(const std::string &fileName)
+{
+    int size = 0;
+    char *const data = static_cast<char*>(PhysFs::loadFile(
+        fileName.c_str(), size));
+    if (!data)
+        return nullptr;
+    XML::Document *const doc = new XML::Document(data, size);
+    free(data);
+    return doc;
+}
+
+MapPrefetch *MapPrefetcher::prefetch(const std::string &fileName)
+{
+    MapPrefetch *const prefetch = new MapPrefetch;
+    prefetch->fileName = fileName;
+
+    XML::Document *const doc = loadDocument(fileName);
+    if (!doc)
+        return prefetch;
+    prefetch->documents[fileName] = doc;
+
+    const XmlNodePtr rootNode = doc->rootNode();
+    if (!rootNode || !xmlNameEqual(rootNode, "map"))
+        return prefetch;
+
+    const std::string pathDir = fileName.substr(0, fileName.rfind("/") + 1);
+    for_each_xml_child_node(childNode, rootNode)
+    {
+        if (!mRunning || !isRequested(fileName))
+            break;
+        if (!xmlNameEqual(childNode, "tileset"))
+            continue;
+
+        // same paths as in MapReader::readTileset
+        XmlNodePtr node = childNode;
+        std::string dir = pathDir;
+        if (XmlHasProp(node, "source"))
+        {
+            const std::string tsxName = MapReader::resolveRelativePath(
+                pathDir, XML::getProperty(node, "source", ""));
+            if (prefetch->documents.find(tsxName)
+                != prefetch->documents.end())
+            {
+                continue;
+            }
+            XML::Document *const tsxDoc = loadDocument(tsxName);
+            if (!tsxDoc)
+                continue;
+            prefetch->documents[tsxName] = tsxDoc;
+            node = tsxDoc->rootNode();
+            if (!node)
+                continue;
+            dir = tsxName.substr(0, tsxName.rfind("/") + 1);
+        }
+
+        for_each_xml_child_node(imageNode, node)
+        {
+            if (!xmlNameEqual(imageNode, "image"))
+                continue;
+            const std::string source = XML::getProperty(
+                imageNode, "source", "");
+            if (source.empty())
+                break;
+            const std::string path = MapReader::resolveRelativePath(
+                dir, source);
+            if (prefetch->images.find(path) != prefetch->images.end())
+                break;
+            SDL_Surface *const surface = ImageHelper::loadPng(
+                MPHYSFSRWOPS_openRead(path.c_str()));
+            if (surface)
+                prefetch->images[path] = surface;
+            // only first image used in tileset
+            break;
+        }
+    }
+    return prefetch;
+}
+
+int MapPrefetcher::prefetchThread(void *ptr A_UNUSED)
+{
+    while (mRunning)
+    {
+        SDL_mutexP(mMutex);
+        const std::string fileName = mPending;
+        mPending.clear();
+        SDL_mutexV(mMutex);
+
+        if (fileName.empty())
+        {
+            // wait for request or stop
+            SDL_SemWait(mSem);
+            continue;
+        }
+
+        MapPrefetch *data = prefetch(fileName);
+
+        SDL_mutexP(mMutex);
+        if (mRequested == fileName && !mReady)
+        {
+            mReady = data;
+            data = nullptr;
+        }
+        SDL_mutexV(mMutex);
+        // prefetch not used, have no resources yet
+        freePrefetch(data);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAPPREFETCHER_H
+#define RESOURCES_MAPPREFETCHER_H
+
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+
+#include <string>
+
+#include "localconsts.h"
+
+class Map;
+
+struct MapPrefetch;
+
+namespace XML
+{
+    class Document;
+}  // namespace XML
+
+/**
+ * Loads map behind nearest warp portal before player use it.
+ * Map and tileset xml are read and parsed and tileset images decoded in
+ * background thread. Main thread adds images to resource manager inside of
+ * frame time budget and holds them until warp or until player walk away.
+ */
+class MapPrefetcher final
+{
+    public:
+        static void start();
+
+        static void stop();
+
+        /**
+         * Checks portals near player and creates prefetched images.
+         */
+        static void logic(const Map *const map,
+                          const int tileX,
+                          const int tileY);
+
+        /**
+         * Must be called before reading map from given file.
+         */
+        static void startMapLoad(const std::string &fileName);
+
+        /**
+         * Must be called after map changed.
+         */
+        static void endMapLoad(const unsigned int loadTime);
+
+        /**
+         * Returns prefetched document for map loading right now, or nullptr.
+         * Caller take ownership.
+         */
+        static XML::Document *getDocument(const std::string &fileName)
+                                          A_WARN_UNUSED;
+
+        static int getHits() A_WARN_UNUSED
+        { return mHits; }
+
+        static int getMisses() A_WARN_UNUSED
+        { return mMisses; }
+
+        static int getWarpTime() A_WARN_UNUSED
+        { return mWarpTime; }
+
+    private:
+        static int prefetchThread(void *ptr);
+
+        static MapPrefetch *prefetch(const std::string &fileName)
+                                     A_WARN_UNUSED;
+
+        static void request(const std::string &fileName);
+
+        static bool isRequested(const std::string &fileName) A_WARN_UNUSED;
+
+        static void createImages(MapPrefetch *const prefetch,
+                                 const unsigned int budget);
+
+        static void freePrefetch(MapPrefetch *const prefetch);
+
+        static std::string mRequested;
+        static std::string mPending;
+        static MapPrefetch *mReady;
+        static MapPrefetch *mActive;
+        static const Map *mMap;
+        static SDL_Thread *mThread;
+        static SDL_mutex *mMutex;
+        static SDL_sem *mSem;
+        static int mTileX;
+        static int mTileY;
+        static int mHits;
+        static int mMisses;
+        static int mWarpTime;
+        static volatile bool mRunning;
+};
+
+#endif  // RESOURCES_MAPPREFETCHER_H
@@ -37,6 +37,7 @@
 #include "resources/beingcommon.h"
 #include "resources/image.h"
 #include "resources/mapitemtype.h"
+#include "resources/mapprefetcher.h"
 #include "resources/resourcemanager.h"
 
 #ifdef USE_OPENGL
@@ -47,7 +48,12 @@
 
 #include "utils/base64.h"
 #include "utils/delete2.h"
+#include "utils/sdlhelper.h"
 #include "utils/stringmap.h"
+#include "utils/timer.h"
+
+#include <SDL_cpuinfo.h>
+#include <SDL_thread.h>
 
 #include <zlib.h>
 
@@ -58,20 +64,73 @@ typedef std::set<XML::Document*>::iterator DocIterator;
 
 namespace
 {
+    // Tile ids of layer data, decoded before map building.
+    struct LayerData final
+    {
+        LayerData(const char *const text0,
+                  const unsigned int size0,
+                  const bool base640,
+                  const bool compressed0) :
+            text(text0),
+            gids(nullptr),
+            size(size0),
+            count(0),
+            error(Z_OK),
+            base64(base640),
+            compressed(compressed0)
+        {
+        }
+
+        A_DELETE_COPY(LayerData)
+
+        ~LayerData()
+        {
+            delete [] gids;
+        }
+
+        const char *text;
+        int *gids;
+        unsigned int size;
+        unsigned int count;
+        int error;
+        bool base64;
+        bool compressed;
+    };
+
+    struct DecodeQueue final
+    {
+        DecodeQueue() :
+            jobs(),
+            mutex(SDL_CreateMutex()),
+            next(0)
+        {
+        }
+
+        A_DELETE_COPY(DecodeQueue)
+
+        ~DecodeQueue()
+        {
+            SDL_DestroyMutex(mutex);
+        }
+
+        std::vector<LayerData*> jobs;
+        SDL_mutex *mutex;
+        size_t next;
+    };
+
+    typedef std::map<XmlNodePtr, LayerData*> DecodedLayers;
+    typedef DecodedLayers::iterator DecodedLayersIterator;
+
     std::map<std::string, XmlNodePtr> mKnownLayers;
     std::set<XML::Document*> mKnownDocs;
+    DecodedLayers mDecodedLayers;
 }  // namespace
 
-static int inflateMemory(unsigned char *restrict const in,
-                         const unsigned int inLength,
-                         unsigned char *&restrict out,
-                         unsigned int &restrict outLength);
-
-static int inflateMemory(unsigned char *restrict const in,
-                         const unsigned int inLength,
-                         unsigned char *&restrict out);
+// max threads used for layers decoding
+static const int maxDecodeThreads = 4;
 
-static std::string resolveRelativePath(std::string base, std::string relative)
+std::string MapReader::resolveRelativePath(std::string base,
+                                           std::string relative)
 {
     // Remove trailing "/", if present
     size_t i = base.length();
@@ -98,17 +157,14 @@ static std::string resolveRelativePath(std::string base, std::string relative)
 }
 
 /**
- * Inflates either zlib or gzip deflated memory. The inflated memory is
- * expected to be freed by the caller.
+ * Inflates either zlib or gzip deflated memory into buffer with known size.
+ * Data what not fit into buffer is ignored.
  */
-int inflateMemory(unsigned char *restrict const in,
-                  const unsigned int inLength,
-                  unsigned char *&restrict out,
-                  unsigned int &restrict outLength)
+static int inflateLayer(unsigned char *restrict const in,
+                        const unsigned int inLength,
+                        unsigned char *restrict const out,
+                        unsigned int &restrict outLength)
 {
-    int bufferSize = 256 * 1024;
-    out = static_cast<unsigned char*>(calloc(bufferSize, 1));
-
     z_stream strm;
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
@@ -116,90 +172,125 @@ int inflateMemory(unsigned char *restrict const in,
     strm.next_in = in;
     strm.avail_in = inLength;
     strm.next_out = out;
-    strm.avail_out = bufferSize;
+    strm.avail_out = outLength;
 
     int ret = inflateInit2(&strm, 15 + 32);
     if (ret != Z_OK)
         return ret;
 
-    do
-    {
-        if (!strm.next_out)
-        {
-            inflateEnd(&strm);
-            return Z_MEM_ERROR;
-        }
-
-        ret = inflate(&strm, Z_NO_FLUSH);
-        if (ret == Z_STREAM_ERROR)
-            return ret;
-
-        switch (ret)
-        {
-            case Z_NEED_DICT:
-                ret = Z_DATA_ERROR;
-            case Z_DATA_ERROR:
-            case Z_MEM_ERROR:
-                (void) inflateEnd(&strm);
-                return ret;
-            default:
-                break;
-        }
-
-        if (ret != Z_STREAM_END)
-        {
-            out = static_cast<unsigned char*>(realloc(out, bufferSize * 2));
-
-            if (!out)
-            {
-                inflateEnd(&strm);
-                return Z_MEM_ERROR;
-            }
+    ret = inflate(&strm, Z_FINISH);
+    const bool full = !strm.avail_out;
+    outLength -= strm.avail_out;
+    (void) inflateEnd(&strm);
 
-            strm.next_out = out + static_cast<size_t>(bufferSize);
-            strm.avail_out = bufferSize;
-            bufferSize *= 2;
-        }
+    if (ret == Z_STREAM_END || (full && ret != Z_DATA_ERROR
+        && ret != Z_MEM_ERROR && ret != Z_STREAM_ERROR))
+    {
+        return Z_OK;
     }
-    while (ret != Z_STREAM_END);
+    if (ret == Z_NEED_DICT || ret == Z_BUF_ERROR || ret == Z_OK)
+        return Z_DATA_ERROR;
+    return ret;
+}
 
-    outLength = bufferSize - strm.avail_out;
-    (void) inflateEnd(&strm);
-    return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
+static void logInflateError(const int ret)
+{
+    if (ret == Z_MEM_ERROR)
+        logger->log1("Error: Out of memory while decompressing map data!");
+    else if (ret == Z_VERSION_ERROR)
+        logger->log1("Error: Incompatible zlib version!");
+    else if (ret == Z_DATA_ERROR)
+        logger->log1("Error: Incorrect zlib compressed data!");
+    else
+        logger->log1("Error: Unknown error while decompressing map data!");
 }
 
-int inflateMemory(unsigned char *restrict const in,
-                  const unsigned int inLength,
-                  unsigned char *&restrict out)
+/**
+ * Decodes base64 or csv layer data into tile ids.
+ * Can be called from any thread.
+ */
+static void decodeLayer(LayerData *const data)
 {
-    unsigned int outLength = 0;
-    const int ret = inflateMemory(in, inLength, out, outLength);
+    const char *ptr = data->text;
+    const unsigned int size = data->size;
+    data->gids = new int[size];
 
-    if (ret != Z_OK || !out)
+    if (data->base64)
     {
-        if (ret == Z_MEM_ERROR)
+        unsigned char *const bytes = reinterpret_cast<unsigned char*>(
+            data->gids);
+        unsigned int len = size * 4;
+        if (data->compressed)
         {
-            logger->log1("Error: Out of memory while decompressing map data!");
+            const unsigned int textLen = static_cast<unsigned int>(
+                strlen(ptr));
+            const unsigned int binSize = textLen / 4 * 3 + 3;
+            unsigned char *const binData = new unsigned char[binSize];
+            const int binLen = decodeBase64To(ptr, binData,
+                static_cast<int>(binSize));
+            data->error = inflateLayer(binData,
+                static_cast<unsigned int>(binLen),
+                bytes,
+                len);
+            delete [] binData;
+            if (data->error != Z_OK)
+                return;
         }
-        else if (ret == Z_VERSION_ERROR)
+        else
         {
-            logger->log1("Error: Incompatible zlib version!");
+            len = static_cast<unsigned int>(decodeBase64To(ptr, bytes,
+                static_cast<int>(len)));
         }
-        else if (ret == Z_DATA_ERROR)
+
+        // convert little endian ids in place
+        const unsigned int count = len / 4;
+        for (unsigned int f = 0; f < count; f ++)
         {
-            logger->log1("Error: Incorrect zlib compressed data!");
+            const unsigned char *const b = bytes + f * 4;
+            data->gids[f] = b[0] | b[1] << 8 | b[2] << 16 | b[3] << 24;
         }
-        else
+        data->count = count;
+    }
+    else
+    {
+        unsigned int count = 0;
+        while (count < size)
         {
-            logger->log1("Error: Unknown error while decompressing map data!");
+            while (*ptr && (*ptr < '0' || *ptr > '9') && *ptr != '-')
+                ptr ++;
+            if (!*ptr)
+                break;
+            const bool negative = (*ptr == '-');
+            if (negative)
+                ptr ++;
+            unsigned int val = 0;
+            while (*ptr >= '0' && *ptr <= '9')
+            {
+                val = val * 10 + static_cast<unsigned int>(*ptr - '0');
+                ptr ++;
+            }
+            data->gids[count ++] = negative ? -static_cast<int>(val)
+                : static_cast<int>(val);
         }
-
-        free(out);
-        out = nullptr;
-        outLength = 0;
+        data->count = count;
     }
+}
 
-    return outLength;
+static int decodeThread(void *ptr)
+{
+    DecodeQueue *const queue = static_cast<DecodeQueue*>(ptr);
+    if (!queue)
+        return 0;
+    for (;;)
+    {
+        SDL_mutexP(queue->mutex);
+        const size_t idx = queue->next ++;
+        SDL_mutexV(queue->mutex);
+        if (idx >= queue->jobs.size())
+            break;
+        decodeLayer(queue->jobs[idx]);
+    }
+    return 0;
 }
 
 void MapReader::addLayerToList(const std::string &fileName)
@@ -238,14 +329,19 @@ Map *MapReader::readMap(const std::string &restrict filename,
     BLOCK_START("MapReader::readMap str")
     logger->log("Attempting to read map %s", realFilename.c_str());
 
-    XML::Document doc(realFilename, UseResman_true, SkipError_false);
-    if (!doc.isLoaded())
+    const unsigned int startTime = get_time_usec();
+    XML::Document *doc = MapPrefetcher::getDocument(realFilename);
+    if (!doc)
+        doc = new XML::Document(realFilename, UseResman_true, SkipError_false);
+    logger->log("Map xml loaded in %u us", get_time_usec() - startTime);
+    if (!doc->isLoaded())
     {
+        delete doc;
         BLOCK_END("MapReader::readMap str")
         return createEmptyMap(filename, realFilename);
     }
 
-    XmlNodePtrConst node = doc.rootNode();
+    XmlNodePtrConst node = doc->rootNode();
 
     Map *map = nullptr;
     // Parse the inflated map data
@@ -271,6 +367,7 @@ Map *MapReader::readMap(const std::string &restrict filename,
             updateMusic(map);
     }
 
+    delete doc;
     BLOCK_END("MapReader::readMap str")
     return map;
 }
@@ -290,6 +387,97 @@ void MapReader::unloadTempLayers()
     mKnownDocs.clear();
 }
 
+void MapReader::decodeLayers(const XmlNodePtrConst node,
+                             const int mapWidth,
+                             const int mapHeight)
+{
+    BLOCK_START("MapReader::decodeLayers")
+    DecodeQueue queue;
+    for_each_xml_child_node(childNode, node)
+    {
+        if (!xmlNameEqual(childNode, "layer"))
+            continue;
+
+        // same layer node as selected in readMap
+        XmlNodePtr layerNode = childNode;
+        std::string name = XML::getProperty(childNode, "name", "");
+        name = toLower(name);
+        const LayerInfoIterator it = mKnownLayers.find(name);
+        if (it != mKnownLayers.end())
+            layerNode = (*it).second;
+
+        const int w = XML::getProperty(layerNode, "width", mapWidth);
+        const int h = XML::getProperty(layerNode, "height", mapHeight);
+        if (w <= 0 || h <= 0)
+            continue;
+
+        for_each_xml_child_node(dataNode, layerNode)
+        {
+            if (!xmlNameEqual(dataNode, "data"))
+                continue;
+
+            const std::string encoding =
+                XML::getProperty(dataNode, "encoding", "");
+            const std::string compression =
+                XML::getProperty(dataNode, "compression", "");
+            XmlNodePtrConst textNode = dataNode->xmlChildrenNode;
+            if (textNode && textNode->content && (encoding == "csv"
+                || (encoding == "base64" && (compression.empty()
+                || compression == "gzip" || compression == "zlib"))))
+            {
+                LayerData *const data = new LayerData(
+                    reinterpret_cast<const char*>(textNode->content),
+                    static_cast<unsigned int>(w * h),
+                    encoding == "base64",
+                    !compression.empty());
+                mDecodedLayers[dataNode] = data;
+                queue.jobs.push_back(data);
+            }
+            break;
+        }
+    }
+
+    if (queue.jobs.empty())
+    {
+        BLOCK_END("MapReader::decodeLayers")
+        return;
+    }
+
+#ifdef USE_SDL2
+    int threads = SDL_GetCPUCount();
+#else  // USE_SDL2
+
+    int threads = 2;
+#endif  // USE_SDL2
+
+    if (threads > maxDecodeThreads)
+        threads = maxDecodeThreads;
+    if (threads > static_cast<int>(queue.jobs.size()))
+        threads = static_cast<int>(queue.jobs.size());
+
+    // main thread decode layers too
+    SDL_Thread *threadList[maxDecodeThreads];
+    for (int f = 1; f < threads; f ++)
+    {
+        threadList[f] = SDL::createThread(&decodeThread,
+            "mapdecode", &queue);
+    }
+    decodeThread(&queue);
+    for (int f = 1; f < threads; f ++)
+    {
+        if (threadList[f])
+            SDL_WaitThread(threadList[f], nullptr);
+    }
+    BLOCK_END("MapReader::decodeLayers")
+}
+
+void MapReader::unloadDecodedLayers()
+{
+    FOR_EACH (DecodedLayersIterator, it, mDecodedLayers)
+        delete (*it).second;
+    mDecodedLayers.clear();
+}
+
 static void loadReplaceLayer(const LayerInfoIterator &it, Map *const map)
 {
     MapReader::readLayer((*it).second, map);
@@ -301,6 +489,7 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
         return nullptr;
 
     BLOCK_START("MapReader::readMap xml")
+    const unsigned int startTime = get_time_usec();
     // Take the filename off the path
     const std::string pathDir = path.substr(0, path.rfind("/") + 1);
 
@@ -325,6 +514,9 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
     logger->log("loading replace layer list");
     loadLayers(path + "_replace.d");
 
+    decodeLayers(node, w, h);
+    const unsigned int decodeTime = get_time_usec();
+
     Map *const map = new Map(w, h, tilew, tileh);
 
     const std::string fileName = path.substr(path.rfind("/") + 1);
@@ -432,8 +624,40 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
                             map->addParticleEffect(warpPath,
                                 objX, objY, objW, objH);
                         }
+                        // destination used for prefetching and routes
+                        std::string target;
+                        int targetX = -1;
+                        int targetY = -1;
+                        for_each_xml_child_node(propsNode, objectNode)
+                        {
+                            if (!xmlNameEqual(propsNode, "properties"))
+                                continue;
+                            for_each_xml_child_node(prop, propsNode)
+                            {
+                                if (!xmlNameEqual(prop, "property"))
+                                    continue;
+                                const std::string name = XML::getProperty(
+                                    prop, "name", "");
+                                if (name == "dest_map")
+                                {
+                                    target = XML::getProperty(
+                                        prop, "value", "");
+                                }
+                                else if (name == "dest_x")
+                                {
+                                    targetX = XML::getProperty(
+                                        prop, "value", -1);
+                                }
+                                else if (name == "dest_y")
+                                {
+                                    targetY = XML::getProperty(
+                                        prop, "value", -1);
+                                }
+                            }
+                        }
                         map->addPortal(objName, MapItemType::PORTAL,
-                                       objX, objY, objW, objH);
+                                       objX, objY, objW, objH, target,
+                                       targetX, targetY);
                     }
                     else if (objType == "SPAWN")
                     {
@@ -461,6 +685,11 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
     map->reduce();
     map->setWalkLayer(resman->getWalkLayer(fileName, map));
     unloadTempLayers();
+    unloadDecodedLayers();
+    const unsigned int endTime = get_time_usec();
+    logger->log("Map layers decoded in %u us, map built in %u us",
+        decodeTime - startTime,
+        endTime - decodeTime);
     BLOCK_END("MapReader::readMap xml")
     return map;
 }
@@ -578,140 +807,32 @@ inline static void setTile(Map *const map, MapLayer *const layer,
         } \
     } \
 
-bool MapReader::readBase64Layer(const XmlNodePtrConst childNode,
-                                Map *const map,
-                                MapLayer *const layer,
-                                const MapLayer::Type &layerType,
-                                MapHeights *const heights,
-                                const std::string &compression,
-                                int &restrict x, int &restrict y,
-                                const int w, const int h)
+// Sets decoded tiles to map in layer order.
+static void commitLayer(const LayerData *const data,
+                        Map *const map,
+                        MapLayer *const layer,
+                        const MapLayer::Type &layerType,
+                        MapHeights *const heights,
+                        const int w, const int h)
 {
-    if (!compression.empty() && compression != "gzip"
-        && compression != "zlib")
-    {
-        logger->log1("Warning: only gzip and zlib layer"
-            " compression supported!");
-        return false;
-    }
-
-    // Read base64 encoded map file
-    XmlNodePtrConst dataChild = childNode->xmlChildrenNode;
-    if (!dataChild)
-        return true;
-
-    const size_t len = strlen(
-        reinterpret_cast<const char*>(dataChild->content)) + 1;
-    unsigned char *charData = new unsigned char[len + 1];
-    xmlChar *const xmlChars = xmlNodeGetContent(dataChild);
-    const char *charStart = reinterpret_cast<const char*>(xmlChars);
-    if (!charStart)
-    {
-        delete [] charData;
-        return false;
-    }
-
-    unsigned char *charIndex = charData;
-
-    while (*charStart)
+    if (data->error != Z_OK)
     {
-        if (*charStart != ' ' && *charStart != '\t' &&
-            *charStart != '\n')
-        {
-            *charIndex = *charStart;
-            charIndex++;
-        }
-        charStart++;
-    }
-    *charIndex = '\0';
-
-    int binLen;
-    unsigned char *binData = php3_base64_decode(charData,
-        static_cast<int>(strlen(reinterpret_cast<char*>(
-        charData))), &binLen);
-
-    delete [] charData;
-    xmlFree(xmlChars);
-
-    if (binData)
-    {
-        if (compression == "gzip" || compression == "zlib")
-        {
-            // Inflate the gzipped layer data
-            unsigned char *inflated = nullptr;
-            const unsigned int inflatedSize =
-                inflateMemory(binData, binLen, inflated);
-
-            free(binData);
-            binData = inflated;
-            binLen = inflatedSize;
-
-            if (!inflated)
-            {
-                logger->log1("Error: Could not decompress layer!");
-                return false;
-            }
-        }
-
-        const std::map<int, TileAnimation*> &tileAnimations
-            = map->getTileAnimations();
-
-        const bool hasAnimations = !tileAnimations.empty();
-        for (int i = 0; i < binLen - 3; i += 4)
-        {
-            const int gid = binData[i] |
-                binData[i + 1] << 8 |
-                binData[i + 2] << 16 |
-                binData[i + 3] << 24;
-
-            addTile();
-
-            x++;
-            if (x == w)
-            {
-                x = 0; y++;
-
-                // When we're done, don't crash on too much data
-                if (y == h)
-                    break;
-            }
-        }
-        free(binData);
+        logInflateError(data->error);
+        logger->log1("Error: Could not decompress layer!");
+        return;
     }
-    return true;
-}
-
-bool MapReader::readCsvLayer(const XmlNodePtrConst childNode,
-                             Map *const map,
-                             MapLayer *const layer,
-                             const MapLayer::Type &layerType,
-                             MapHeights *const heights,
-                             int &restrict x, int &restrict y,
-                             const int w, const int h)
-{
-    XmlNodePtrConst dataChild = childNode->xmlChildrenNode;
-    if (!dataChild)
-        return true;
-
-    xmlChar *const xmlChars = xmlNodeGetContent(dataChild);
-    const char *const data = reinterpret_cast<const char*>(xmlChars);
-    if (!data)
-        return false;
-
-    std::string csv(data);
-    size_t oldPos = 0;
 
     const std::map<int, TileAnimation*> &tileAnimations
         = map->getTileAnimations();
     const bool hasAnimations = !tileAnimations.empty();
 
-    while (oldPos != csv.npos)
+    const int *const gids = data->gids;
+    const unsigned int count = data->count;
+    int x = 0;
+    int y = 0;
+    for (unsigned int f = 0; f < count; f ++)
     {
-        const size_t pos = csv.find_first_of(",", oldPos);
-        if (pos == csv.npos)
-            return false;
-
-        const int gid = atoi(csv.substr(oldPos, pos - oldPos).c_str());
+        const int gid = gids[f];
         addTile();
 
         x++;
@@ -721,13 +842,37 @@ bool MapReader::readCsvLayer(const XmlNodePtrConst childNode,
 
             // When we're done, don't crash on too much data
             if (y == h)
-                return false;
+                break;
         }
+    }
+}
 
-        oldPos = pos + 1;
+void MapReader::readDecodedLayer(XmlNodePtrConst childNode,
+                                 Map *const map,
+                                 MapLayer *const layer,
+                                 const MapLayer::Type &layerType,
+                                 MapHeights *const heights,
+                                 const bool base64,
+                                 const bool compressed,
+                                 const int w, const int h)
+{
+    const DecodedLayersIterator it = mDecodedLayers.find(childNode);
+    if (it != mDecodedLayers.end())
+    {
+        commitLayer((*it).second, map, layer, layerType, heights, w, h);
+        return;
     }
-    xmlFree(xmlChars);
-    return true;
+
+    // layer was not decoded in readMap
+    XmlNodePtrConst dataChild = childNode->xmlChildrenNode;
+    if (!dataChild || !dataChild->content)
+        return;
+    LayerData data(reinterpret_cast<const char*>(dataChild->content),
+        static_cast<unsigned int>(w * h),
+        base64,
+        compressed);
+    decodeLayer(&data);
+    commitLayer(&data, map, layer, layerType, heights, w, h);
 }
 
 void MapReader::readLayer(const XmlNodePtr node, Map *const map)
@@ -813,29 +958,18 @@ void MapReader::readLayer(const XmlNodePtr node, Map *const map)
         const std::string compression =
             XML::getProperty(childNode, "compression", "");
 
-        if (encoding == "base64")
-        {
-            if (readBase64Layer(childNode, map, layer, layerType,
-                heights, compression, x, y, w, h))
-            {
-                continue;
-            }
-            else
-            {
-                return;
-            }
-        }
-        else if (encoding == "csv")
+        if (encoding == "base64" || encoding == "csv")
         {
-            if (readCsvLayer(childNode, map, layer, layerType,
-                heights, x, y, w, h))
-            {
-                continue;
-            }
-            else
+            if (encoding == "base64" && !compression.empty()
+                && compression != "gzip" && compression != "zlib")
             {
+                logger->log1("Warning: only gzip and zlib layer"
+                    " compression supported!");
                 return;
             }
+            readDecodedLayer(childNode, map, layer, layerType, heights,
+                encoding == "base64", !compression.empty(), w, h);
+            return;
         }
         else
         {
@@ -896,7 +1030,13 @@ Tileset *MapReader::readTileset(XmlNodePtr node,
         std::string filename = XML::getProperty(node, "source", "");
         filename = resolveRelativePath(path, filename);
 
-        doc = new XML::Document(filename, UseResman_true, SkipError_false);
+        doc = MapPrefetcher::getDocument(filename);
+        if (!doc)
+        {
+            doc = new XML::Document(filename,
+                UseResman_true,
+                SkipError_false);
+        }
         node = doc->rootNode();
         if (!node)
         {
@@ -62,6 +62,13 @@ class MapReader final
          */
         static void readLayer(const XmlNodePtr node, Map *const map);
 
+        /**
+         * Returns path of file referenced from map or tileset directory.
+         */
+        static std::string resolveRelativePath(std::string base,
+                                               std::string relative)
+                                               A_WARN_UNUSED;
+
     private:
         /**
          * Reads the properties element.
@@ -73,22 +80,23 @@ class MapReader final
         static void readProperties(const XmlNodePtrConst node,
                                    Properties *const props);
 
-        static bool readBase64Layer(const XmlNodePtrConst childNode,
-                                    Map *const map,
-                                    MapLayer *const layer,
-                                    const MapLayer::Type &layerType,
-                                    MapHeights *const heights,
-                                    const std::string &compression,
-                                    int &restrict x, int &restrict y,
-                                    const int w, const int h);
-
-        static bool readCsvLayer(const XmlNodePtrConst childNode,
-                                 Map *const map,
-                                 MapLayer *const layer,
-                                 const MapLayer::Type &layerType,
-                                 MapHeights *const heights,
-                                 int &restrict x, int &restrict y,
-                                 const int w, const int h);
+        /**
+         * Decodes data of all map layers using several threads.
+         */
+        static void decodeLayers(const XmlNodePtrConst node,
+                                 const int mapWidth,
+                                 const int mapHeight);
+
+        static void unloadDecodedLayers();
+
+        static void readDecodedLayer(XmlNodePtrConst childNode,
+                                     Map *const map,
+                                     MapLayer *const layer,
+                                     const MapLayer::Type &layerType,
+                                     MapHeights *const heights,
+                                     const bool base64,
+                                     const bool compressed,
+                                     const int w, const int h);
 
         /**
          * Reads a tile set.
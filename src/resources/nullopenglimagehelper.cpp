@@ -0,0 +1,93 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/nullopenglimagehelper.h"
+
+#ifdef USE_OPENGL
+
+#include "logger.h"
+
+#include "resources/image.h"
+
+#include <SDL_image.h>
+
+#include "debug.h"
+
+Image *NullOpenGLImageHelper::load(SDL_RWops *const rw)
+{
+    if (!rw)
+        return nullptr;
+
+    if (!IMG_isPNG(rw))
+    {
+        // other formats decoded and pixels dropped in load(SDL_Surface*)
+        return ImageHelper::load(rw);
+    }
+
+    // png signature (8 bytes), IHDR length and type (8 bytes),
+    // width and height (big endian, 4 bytes each)
+    uint8_t header[24];
+    const bool ok = SDL_RWread(rw, header, 1, 24) == 24
+        && header[12] == 'I' && header[13] == 'H'
+        && header[14] == 'D' && header[15] == 'R';
+    SDL_RWclose(rw);
+    if (!ok)
+    {
+        logger->log1("Error, broken png header");
+        return nullptr;
+    }
+
+    const int width = (header[16] << 24) | (header[17] << 16)
+        | (header[18] << 8) | header[19];
+    const int height = (header[20] << 24) | (header[21] << 16)
+        | (header[22] << 8) | header[23];
+    return new Image(0, width, height, width, height);
+}
+
+Image *NullOpenGLImageHelper::load(SDL_RWops *const rw,
+                                   Dye const &dye A_UNUSED)
+{
+    return load(rw);
+}
+
+Image *NullOpenGLImageHelper::load(SDL_Surface *const tmpImage,
+                                   Dye const &dye A_UNUSED)
+{
+    return load(tmpImage);
+}
+
+Image *NullOpenGLImageHelper::load(SDL_Surface *const tmpImage)
+{
+    if (!tmpImage)
+        return nullptr;
+    return new Image(0, tmpImage->w, tmpImage->h, tmpImage->w, tmpImage->h);
+}
+
+Image *NullOpenGLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
+                                                const int width,
+                                                const int height,
+                                                const float alpha A_UNUSED)
+{
+    if (!tmpImage)
+        return nullptr;
+    return new Image(0, width, height, width, height);
+}
+
+#endif  // USE_OPENGL
@@ -0,0 +1,70 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_NULLOPENGLIMAGEHELPER_H
+#define RESOURCES_NULLOPENGLIMAGEHELPER_H
+
+#include "localconsts.h"
+#include "main.h"
+
+#ifdef USE_OPENGL
+
+#include "resources/imagehelper.h"
+
+class Dye;
+class Image;
+
+/**
+ * Image loader for null renderer (headless mode).
+ * Images keep only size, pixels never decoded or uploaded.
+ */
+class NullOpenGLImageHelper final : public ImageHelper
+{
+    public:
+        NullOpenGLImageHelper()
+        { }
+
+        A_DELETE_COPY(NullOpenGLImageHelper)
+
+        ~NullOpenGLImageHelper()
+        { }
+
+        /**
+         * Reads image size from png header without decoding pixels.
+         */
+        Image *load(SDL_RWops *const rw) override final A_WARN_UNUSED;
+
+        Image *load(SDL_RWops *const rw,
+                    Dye const &dye) override final A_WARN_UNUSED;
+
+        Image *load(SDL_Surface *const tmpImage,
+                    Dye const &dye) override final A_WARN_UNUSED;
+
+        Image *load(SDL_Surface *const tmpImage)
+                    override final A_WARN_UNUSED;
+
+        Image *createTextSurface(SDL_Surface *const tmpImage,
+                                 const int width, const int height,
+                                 const float alpha)
+                                 override final A_WARN_UNUSED;
+};
+
+#endif  // USE_OPENGL
+#endif  // RESOURCES_NULLOPENGLIMAGEHELPER_H
@@ -56,17 +56,12 @@ OpenGLImageHelper::~OpenGLImageHelper()
         &mTextures[mFreeTextureIndex]);
 }
 
-Image *OpenGLImageHelper::load(SDL_RWops *const rw, Dye const &dye)
+Image *OpenGLImageHelper::load(SDL_Surface *const tmpImage, Dye const &dye)
 {
-    SDL_Surface *const tmpImage = loadPng(rw);
     if (!tmpImage)
-    {
-        logger->log("Error, image load failed: %s", IMG_GetError());
         return nullptr;
-    }
 
     SDL_Surface *const surf = convertTo32Bit(tmpImage);
-    MSDL_FreeSurface(tmpImage);
 
     uint32_t *pixels = static_cast<uint32_t *>(surf->pixels);
     const int type = dye.getType();
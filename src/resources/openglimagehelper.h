@@ -68,15 +68,15 @@ class OpenGLImageHelper final : public ImageHelper
         ~OpenGLImageHelper();
 
         /**
-         * Loads an image from an SDL_RWops structure and recolors it.
+         * Recolors and loads an image from an SDL surface.
          *
-         * @param rw         The SDL_RWops to load the image from.
+         * @param tmpImage   The SDL surface to load the image from.
          * @param dye        The dye used to recolor the image.
          *
          * @return <code>NULL</code> if an error occurred, a valid pointer
          *         otherwise.
          */
-        Image *load(SDL_RWops *const rw,
+        Image *load(SDL_Surface *const tmpImage,
                     Dye const &dye) override final A_WARN_UNUSED;
 
         /**
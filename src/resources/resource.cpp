@@ -32,6 +32,12 @@ Resource::~Resource()
 {
 }
 
+int Resource::calcMemory() const
+{
+    return static_cast<int>(sizeof(Resource) + mIdPath.size()
+        + mSource.size());
+}
+
 void Resource::incRef()
 {
 #ifdef DEBUG_IMAGES
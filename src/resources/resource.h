@@ -43,6 +43,7 @@ class Resource notfinal
             mSource(),
             mTimeStamp(0),
             mRefCount(0),
+            mMemory(0),
             mProtected(false),
 #ifdef DEBUG_DUMP_LEAKS
             mNotCount(false),
@@ -96,6 +97,11 @@ class Resource notfinal
         void setNotCount(const bool b)
         { mNotCount = b; }
 
+        /**
+         * Returns approximate memory used by resource in bytes.
+         */
+        virtual int calcMemory() const A_WARN_UNUSED;
+
 #ifdef DEBUG_DUMP_LEAKS
         bool getDumped() const A_WARN_UNUSED
         { return mDumped; }
@@ -116,6 +122,7 @@ class Resource notfinal
     private:
         time_t mTimeStamp;   /**< Time at which the resource was orphaned. */
         unsigned int mRefCount;  /**< Reference count. */
+        int mMemory;         /**< Memory size while orphaned. */
         bool mProtected;
         bool mNotCount;
 #ifdef DEBUG_DUMP_LEAKS
@@ -26,12 +26,15 @@
 #include "logger.h"
 #include "navigationmanager.h"
 
+#include "enums/resources/memorytype.h"
+
 #include "resources/map/walklayer.h"
 
 #ifdef USE_OPENGL
 #include "resources/atlasmanager.h"
 #include "resources/atlasresource.h"
 #endif
+#include "resources/delayedmanager.h"
 #include "resources/dye.h"
 #include "resources/image.h"
 #include "resources/imagehelper.h"
@@ -53,6 +56,8 @@
 
 #include <SDL_image.h>
 
+#include <algorithm>
+
 #include <sys/time.h>
 
 #include "debug.h"
@@ -65,6 +70,8 @@ ResourceManager::ResourceManager() :
     mOrphanedResources(),
     mDeletedResources(),
     mOldestOrphan(0),
+    mOrphanedMemory(0),
+    mCacheSize(config.getIntValue("resourceCacheSize") * 1024 * 1024),
     mDestruction(0),
     mUseLongLiveSprites(config.getBoolValue("uselonglivesprites"))
 {
@@ -221,10 +228,18 @@ bool ResourceManager::cleanOrphans(const bool always)
     time_t oldest = static_cast<time_t>(tv.tv_sec);
     const time_t threshold = oldest - 30;
 
-    if (mOrphanedResources.empty() || (!always && mOldestOrphan >= threshold))
+    if (!always)
+        mCacheSize = config.getIntValue("resourceCacheSize") * 1024 * 1024;
+
+    if (mOrphanedResources.empty() || (!always
+        && mOldestOrphan >= threshold && mOrphanedMemory <= mCacheSize))
+    {
         return false;
+    }
 
-    bool status(false);
+    // resources deleted after removal from list,
+    // to avoid issues in recursion
+    std::vector<Resource*> deleted;
     ResourceIterator iter = mOrphanedResources.begin();
     while (iter != mOrphanedResources.end())
     {
@@ -243,18 +258,91 @@ bool ResourceManager::cleanOrphans(const bool always)
         }
         else
         {
-            logResource(res);
             const ResourceIterator toErase = iter;
             ++iter;
             mOrphanedResources.erase(toErase);
-            delete res;  // delete only after removal from list,
-                         // to avoid issues in recursion
-            status = true;
+            mOrphanedMemory -= res->mMemory;
+            deleted.push_back(res);
         }
     }
 
     mOldestOrphan = oldest;
-    return status;
+    if (!always && mOrphanedMemory > mCacheSize)
+        evictOrphans(deleted);
+
+    if (mOrphanedResources.empty())
+        mOrphanedMemory = 0;
+
+    FOR_EACH (std::vector<Resource*>::const_iterator, it, deleted)
+    {
+        Resource *const res = *it;
+        logResource(res);
+        delete res;
+    }
+    return !deleted.empty();
+}
+
+void ResourceManager::evictOrphans(std::vector<Resource*> &deleted)
+{
+    typedef std::pair<time_t, Resource*> OrphanPair;
+    std::vector<OrphanPair> orphans;
+    orphans.reserve(mOrphanedResources.size());
+    FOR_EACH (ResourceCIterator, it, mOrphanedResources)
+    {
+        Resource *const res = it->second;
+        if (res)
+            orphans.push_back(OrphanPair(res->mTimeStamp, res));
+    }
+    std::sort(orphans.begin(), orphans.end());
+
+    const size_t sz = orphans.size();
+    size_t f = 0;
+    for (; f < sz && mOrphanedMemory > mCacheSize; f ++)
+    {
+        Resource *const res = orphans[f].second;
+        mOrphanedResources.erase(res->mIdPath);
+        mOrphanedMemory -= res->mMemory;
+        deleted.push_back(res);
+    }
+    if (f < sz)
+        mOldestOrphan = orphans[f].first;
+}
+
+void ResourceManager::calcMemoryUsage(const Resources &resources,
+                                      int *const memory,
+                                      int *const count)
+{
+    FOR_EACH (ResourceCIterator, it, resources)
+    {
+        const Resource *const res = it->second;
+        if (!res)
+            continue;
+        MemoryType::Type type = MemoryType::OTHER;
+        if (dynamic_cast<const Image*>(res))
+            type = MemoryType::IMAGES;
+        else if (dynamic_cast<const ImageSet*>(res))
+            type = MemoryType::IMAGESETS;
+        else if (dynamic_cast<const SpriteDef*>(res))
+            type = MemoryType::SPRITES;
+        else if (dynamic_cast<const SoundEffect*>(res))
+            type = MemoryType::SOUNDS;
+        else if (dynamic_cast<const SDLMusic*>(res))
+            type = MemoryType::MUSIC;
+        memory[type] += res->calcMemory();
+        count[type] ++;
+    }
+}
+
+void ResourceManager::calcMemoryUsage(int *const memory,
+                                      int *const count) const
+{
+    for (int f = 0; f < MemoryType::LAST; f ++)
+    {
+        memory[f] = 0;
+        count[f] = 0;
+    }
+    calcMemoryUsage(mResources, memory, count);
+    calcMemoryUsage(mOrphanedResources, memory, count);
 }
 
 void ResourceManager::logResource(const Resource *const res)
@@ -360,8 +448,7 @@ void ResourceManager::searchAndAddArchives(const std::string &restrict path,
         if (len > ext.length() && !ext.compare((*i) + (len - ext.length())))
         {
             const std::string file = path + (*i);
-            const std::string realPath = std::string(
-                PhysFs::getRealDir(file.c_str()));
+            const std::string realPath = PhysFs::getRealDir(file.c_str());
             addToSearchPath(std::string(realPath).append(
                 dirSep).append(file), append);
         }
@@ -383,8 +470,7 @@ void ResourceManager::searchAndRemoveArchives(const std::string &restrict path,
         if (len > ext.length() && !ext.compare((*i) + (len - ext.length())))
         {
             const std::string file = path + (*i);
-            const std::string realPath = std::string(
-                PhysFs::getRealDir(file.c_str()));
+            const std::string realPath = PhysFs::getRealDir(file.c_str());
             removeFromSearchPath(std::string(realPath).append(
                 dirSep).append(file));
         }
@@ -454,7 +540,10 @@ Resource *ResourceManager::getFromCache(const std::string &idPath)
         mResources.insert(*resIter);
         mOrphanedResources.erase(resIter);
         if (res)
+        {
+            mOrphanedMemory -= res->mMemory;
             res->incRef();
+        }
         return res;
     }
     return nullptr;
@@ -571,6 +660,18 @@ struct DyedImageLoader final
             d = new Dye(path1.substr(p + 1));
             path1 = path1.substr(0, p);
         }
+        SDL_Surface *const surface = DelayedManager::getPrefetchedImage(
+            path1);
+        if (surface)
+        {
+            // image already decoded in background
+            Resource *const res = d ? imageHelper->load(surface, *d)
+                : imageHelper->load(surface);
+            MSDL_FreeSurface(surface);
+            delete d;
+            BLOCK_END("DyedImageLoader::load")
+            return res;
+        }
         SDL_RWops *const rw = MPHYSFSRWOPS_openRead(path1.c_str());
         if (!rw)
         {
@@ -863,9 +964,11 @@ void ResourceManager::release(Resource *const res)
     const time_t timestamp = static_cast<time_t>(tv.tv_sec);
 
     res->mTimeStamp = timestamp;
+    res->mMemory = res->calcMemory();
     if (mOrphanedResources.empty())
         mOldestOrphan = timestamp;
 
+    mOrphanedMemory += res->mMemory;
     mOrphanedResources.insert(*resIter);
     mResources.erase(resIter);
 #else
@@ -895,6 +998,7 @@ void ResourceManager::moveToDeleted(Resource *const res)
         if (resIter != mOrphanedResources.end() && resIter->second == res)
         {
             mOrphanedResources.erase(resIter);
+            mOrphanedMemory -= res->mMemory;
             found = true;
         }
     }
@@ -926,7 +1030,10 @@ void ResourceManager::decRefDelete(Resource *const res)
         {
             resIter = mOrphanedResources.find(res->mIdPath);
             if (resIter != mOrphanedResources.end() && resIter->second == res)
+            {
                 mOrphanedResources.erase(resIter);
+                mOrphanedMemory -= res->mMemory;
+            }
         }
 
         delete res;
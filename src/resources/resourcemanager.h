@@ -23,6 +23,7 @@
 #ifndef RESOURCES_RESOURCEMANAGER_H
 #define RESOURCES_RESOURCEMANAGER_H
 
+#include "utils/hashmap.h"
 #include "utils/stringvector.h"
 
 #include <map>
@@ -234,7 +235,7 @@ class ResourceManager final
         int size() const A_WARN_UNUSED
         { return static_cast<int>(mResources.size()); }
 
-        typedef std::map<std::string, Resource*> Resources;
+        typedef HASHMAP<std::string, Resource*> Resources;
         typedef Resources::iterator ResourceIterator;
         typedef Resources::const_iterator ResourceCIterator;
 
@@ -246,8 +247,28 @@ class ResourceManager final
         { return &mOrphanedResources; }
 #endif
 
+        /**
+         * Deletes resources orphaned more than 30 seconds ago, or all
+         * orphans if always is true. If orphans use more memory than cache
+         * size, least recently used orphans deleted.
+         */
         bool cleanOrphans(const bool always = false);
 
+        /**
+         * Calculates memory and count of cached resources by type.
+         * Both arrays must have MemoryType::LAST elements.
+         */
+        void calcMemoryUsage(int *const memory, int *const count) const;
+
+        int getOrphanedMemory() const A_WARN_UNUSED
+        { return mOrphanedMemory; }
+
+        int getOrphanedCount() const A_WARN_UNUSED
+        { return static_cast<int>(mOrphanedResources.size()); }
+
+        int getCacheSize() const A_WARN_UNUSED
+        { return mCacheSize; }
+
         void cleanProtected();
 
         bool isInCache(const std::string &idPath) const A_WARN_UNUSED;
@@ -262,12 +283,24 @@ class ResourceManager final
          */
         static void cleanUp(Resource *const resource);
 
+        /**
+         * Removes least recently used orphans from cache until orphans
+         * memory fit in cache size.
+         */
+        void evictOrphans(std::vector<Resource*> &deleted);
+
+        static void calcMemoryUsage(const Resources &resources,
+                                    int *const memory,
+                                    int *const count);
+
         static ResourceManager *instance;
         std::set<SDL_Surface*> deletedSurfaces;
         Resources mResources;
         Resources mOrphanedResources;
         std::set<Resource*> mDeletedResources;
         time_t mOldestOrphan;
+        int mOrphanedMemory;
+        int mCacheSize;
         bool mDestruction;
         bool mUseLongLiveSprites;
 };
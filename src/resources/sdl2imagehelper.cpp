@@ -39,7 +39,6 @@
 
 #include "debug.h"
 
-bool SDLImageHelper::mEnableAlphaCache = false;
 #ifdef USE_SDL2
 SDL_Renderer *SDLImageHelper::mRenderer = nullptr;
 #endif
@@ -67,12 +67,6 @@ class SDLImageHelper final : public ImageHelper
                                 SDL_Surface *const surface)
                                 const override final;
 
-        static void SDLSetEnableAlphaCache(const bool n)
-        { mEnableAlphaCache = n; }
-
-        static bool SDLGetEnableAlphaCache() A_WARN_UNUSED
-        { return mEnableAlphaCache; }
-
         static SDL_Surface* SDLDuplicateSurface(SDL_Surface *const tmpImage)
                                                 A_WARN_UNUSED;
 
@@ -90,7 +84,6 @@ class SDLImageHelper final : public ImageHelper
         /** SDL_Surface to SDL_Surface Image loader */
         Image *_SDLload(SDL_Surface *tmpImage) A_WARN_UNUSED;
 
-        static bool mEnableAlphaCache;
 #ifdef USE_SDL2
         static SDL_Renderer *mRenderer;
 #endif
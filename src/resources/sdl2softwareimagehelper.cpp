@@ -38,7 +38,6 @@
 
 #include "debug.h"
 
-bool SDL2SoftwareImageHelper::mEnableAlphaCache = false;
 SDL_PixelFormat *SDL2SoftwareImageHelper::mFormat = nullptr;
 
 Image *SDL2SoftwareImageHelper::load(SDL_Surface *const tmpImage)
@@ -75,7 +74,7 @@ Image *SDL2SoftwareImageHelper::_SDLload(SDL_Surface *tmpImage)
         return nullptr;
 
     SDL_Surface *image = SDL_ConvertSurface(tmpImage, mFormat, 0);
-    return new Image(image, false, nullptr);
+    return new Image(image, false);
 }
 
 int SDL2SoftwareImageHelper::combineSurface(SDL_Surface *restrict const src,
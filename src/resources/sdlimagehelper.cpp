@@ -38,16 +38,10 @@
 
 #include "debug.h"
 
-bool SDLImageHelper::mEnableAlphaCache = false;
-
-Image *SDLImageHelper::load(SDL_RWops *const rw, Dye const &dye)
+Image *SDLImageHelper::load(SDL_Surface *const tmpImage, Dye const &dye)
 {
-    SDL_Surface *const tmpImage = loadPng(rw);
     if (!tmpImage)
-    {
-        logger->log("Error, image load failed: %s", IMG_GetError());
         return nullptr;
-    }
 
     SDL_PixelFormat rgba;
     rgba.palette = nullptr;
@@ -70,7 +64,6 @@ Image *SDLImageHelper::load(SDL_RWops *const rw, Dye const &dye)
 
     SDL_Surface *const surf = MSDL_ConvertSurface(
         tmpImage, &rgba, SDL_SWSURFACE);
-    MSDL_FreeSurface(tmpImage);
 
     uint32_t *pixels = static_cast<uint32_t *>(surf->pixels);
     const int type = dye.getType();
@@ -120,9 +113,6 @@ Image *SDLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
     bool hasAlpha = false;
     const size_t sz = tmpImage->w * tmpImage->h;
 
-    // The alpha channel to be filled with alpha values
-    uint8_t *alphaChannel = new uint8_t[sz];
-
     const SDL_PixelFormat *const fmt = tmpImage->format;
     if (fmt->Amask)
     {
@@ -143,8 +133,6 @@ Image *SDLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
 
             if (a != 255)
                 hasAlpha = true;
-
-            alphaChannel[i] = a;
         }
     }
 
@@ -152,27 +140,17 @@ Image *SDLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
 
     // Convert the surface to the current display format
     if (hasAlpha)
-    {
         image = MSDL_DisplayFormatAlpha(tmpImage);
-    }
     else
-    {
         image = MSDL_DisplayFormat(tmpImage);
 
-        // We also delete the alpha channel since
-        // it's not used.
-        delete [] alphaChannel;
-        alphaChannel = nullptr;
-    }
-
     if (!image)
     {
         logger->log1("Error: Image convert failed.");
-        delete [] alphaChannel;
         return nullptr;
     }
 
-    Image *const img = new Image(image, hasAlpha, alphaChannel);
+    Image *const img = new Image(image, hasAlpha);
     img->mAlpha = alpha;
     return img;
 }
@@ -202,11 +180,6 @@ Image *SDLImageHelper::_SDLload(SDL_Surface *tmpImage)
         converted = true;
     }
 
-    const size_t sz = tmpImage->w * tmpImage->h;
-
-    // The alpha channel to be filled with alpha values
-    uint8_t *alphaChannel = new uint8_t[sz];
-
     // Figure out whether the image uses its alpha layer
     if (!tmpImage->format->palette)
     {
@@ -217,6 +190,7 @@ Image *SDLImageHelper::_SDLload(SDL_Surface *tmpImage)
             const uint8_t ashift = fmt->Ashift;
             const uint8_t aloss = fmt->Aloss;
             const uint32_t *pixels = static_cast<uint32_t*>(tmpImage->pixels);
+            const size_t sz = tmpImage->w * tmpImage->h;
             cilk_for (size_t i = 0; i < sz; ++ i)
             {
                 const unsigned v = (pixels[i] & amask) >> ashift;
@@ -225,55 +199,37 @@ Image *SDLImageHelper::_SDLload(SDL_Surface *tmpImage)
 
                 if (a != 255)
                     hasAlpha = true;
-
-                alphaChannel[i] = a;
             }
         }
         else
         {
             if (SDL_ALPHA_OPAQUE != 255)
-            {
                 hasAlpha = true;
-                memset(alphaChannel, SDL_ALPHA_OPAQUE, sz);
-            }
         }
     }
     else
     {
         if (SDL_ALPHA_OPAQUE != 255)
-        {
             hasAlpha = true;
-            memset(alphaChannel, SDL_ALPHA_OPAQUE, sz);
-        }
     }
 
     SDL_Surface *image;
 
     // Convert the surface to the current display format
     if (hasAlpha)
-    {
         image = MSDL_DisplayFormatAlpha(tmpImage);
-    }
     else
-    {
         image = MSDL_DisplayFormat(tmpImage);
 
-        // We also delete the alpha channel since
-        // it's not used.
-        delete [] alphaChannel;
-        alphaChannel = nullptr;
-    }
-
     if (!image)
     {
         logger->log1("Error: Image convert failed.");
-        delete [] alphaChannel;
         return nullptr;
     }
 
     if (converted)
         MSDL_FreeSurface(tmpImage);
-    return new Image(image, hasAlpha, alphaChannel);
+    return new Image(image, hasAlpha);
 }
 
 int SDLImageHelper::combineSurface(SDL_Surface *restrict const src,
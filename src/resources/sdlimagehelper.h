@@ -53,15 +53,15 @@ class SDLImageHelper final : public ImageHelper
         { }
 
         /**
-         * Loads an image from an SDL_RWops structure and recolors it.
+         * Recolors and loads an image from an SDL surface.
          *
-         * @param rw         The SDL_RWops to load the image from.
+         * @param tmpImage   The SDL surface to load the image from.
          * @param dye        The dye used to recolor the image.
          *
          * @return <code>NULL</code> if an error occurred, a valid pointer
          *         otherwise.
          */
-        Image *load(SDL_RWops *const rw,
+        Image *load(SDL_Surface *const tmpImage,
                     Dye const &dye) override final A_WARN_UNUSED;
 
         /**
@@ -79,12 +79,6 @@ class SDLImageHelper final : public ImageHelper
                                 SDL_Surface *const surface)
                                 const override final;
 
-        static void SDLSetEnableAlphaCache(const bool n)
-        { mEnableAlphaCache = n; }
-
-        static bool SDLGetEnableAlphaCache() A_WARN_UNUSED
-        { return mEnableAlphaCache; }
-
         static SDL_Surface* SDLDuplicateSurface(SDL_Surface *const tmpImage)
                                                 A_WARN_UNUSED;
 
@@ -96,8 +90,6 @@ class SDLImageHelper final : public ImageHelper
     protected:
         /** SDL_Surface to SDL_Surface Image loader */
         Image *_SDLload(SDL_Surface *tmpImage) A_WARN_UNUSED;
-
-        static bool mEnableAlphaCache;
 };
 
 #endif  // USE_SDL2
@@ -49,10 +49,18 @@ Resource *SoundEffect::load(SDL_RWops *const rw)
     }
 }
 
-bool SoundEffect::play(const int loops, const int volume,
-                       const int channel) const
+int SoundEffect::calcMemory() const
+{
+    int sz = static_cast<int>(sizeof(SoundEffect));
+    if (mChunk)
+        sz += static_cast<int>(sizeof(Mix_Chunk) + mChunk->alen);
+    return sz;
+}
+
+int SoundEffect::play(const int loops, const int volume,
+                      const int channel) const
 {
     Mix_VolumeChunk(mChunk, volume);
 
-    return Mix_PlayChannel(channel, mChunk, loops) != -1;
+    return Mix_PlayChannel(channel, mChunk, loops);
 }
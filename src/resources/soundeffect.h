@@ -34,6 +34,8 @@
  */
 class SoundEffect final : public Resource
 {
+    friend class SoundManager;
+
     public:
         A_DELETE_COPY(SoundEffect)
 
@@ -59,11 +61,12 @@ class SoundEffect final : public Resource
          * @param volume    Sample playback volume.
          * @param channel   Sample playback channel.
          *
-         * @return <code>true</code> if the playback started properly
-         *         <code>false</code> otherwise.
+         * @return channel used for playback, or -1 if an error occurred.
          */
-        bool play(const int loops, const int volume,
-                  const int channel = -1) const;
+        int play(const int loops, const int volume,
+                 const int channel = -1) const;
+
+        int calcMemory() const override final A_WARN_UNUSED;
 
     protected:
         /**
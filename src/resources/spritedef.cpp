@@ -30,6 +30,7 @@
 
 #include "resources/action.h"
 #include "resources/animation.h"
+#include "resources/delayedmanager.h"
 #include "resources/dye.h"
 #include "resources/imageset.h"
 #include "resources/resourcemanager.h"
@@ -40,28 +41,93 @@
 
 SpriteReference *SpriteReference::Empty = nullptr;
 
+SpriteDef::ActionIds SpriteDef::mActionIds;
+
 const Action *SpriteDef::getAction(const std::string &action,
                                    const unsigned num) const
 {
-    Actions::const_iterator i = mActions.find(num);
-    if (i == mActions.end() && num != 100)
-        i = mActions.find(100);
+    const Action *const act = getAction(findActionId(action), num);
+    if (!act)
+        logger->log("Warning: no action \"%s\" defined!", action.c_str());
+    return act;
+}
 
-    if (i == mActions.end() || !(*i).second)
+const Action *SpriteDef::getAction(const int id,
+                                   const unsigned num) const
+{
+    if (id < 0)
         return nullptr;
 
-    const ActionMap *const actMap = (*i).second;
-    if (!actMap)
+    // numbers without own actions use table 0 with actions for 100
+    const size_t idx = num < mNumberIndex.size() ? mNumberIndex[num] : 0;
+    if (idx >= mActionTables.size())
         return nullptr;
-    const ActionMap::const_iterator it = actMap->find(action);
 
-    if (it == actMap->end())
-    {
-        logger->log("Warning: no action \"%s\" defined!", action.c_str());
+    const ActionTable &table = mActionTables[idx];
+    if (static_cast<size_t>(id) >= table.size())
         return nullptr;
+    return table[id];
+}
+
+int SpriteDef::getActionId(const std::string &action)
+{
+    const ActionIds::const_iterator it = mActionIds.find(action);
+    if (it != mActionIds.end())
+        return (*it).second;
+    const int id = static_cast<int>(mActionIds.size());
+    mActionIds[action] = id;
+    return id;
+}
+
+int SpriteDef::findActionId(const std::string &action)
+{
+    const ActionIds::const_iterator it = mActionIds.find(action);
+    if (it != mActionIds.end())
+        return (*it).second;
+    return -1;
+}
+
+void SpriteDef::buildActionTables()
+{
+    mActionTables.clear();
+    mNumberIndex.clear();
+    if (mActions.empty())
+        return;
+
+    // numbers over 100 never requested, see findNumber
+    unsigned maxNumber = 0;
+    FOR_EACH (ActionsConstIter, it, mActions)
+    {
+        const unsigned num = (*it).first;
+        if (num <= 100 && num > maxNumber)
+            maxNumber = num;
     }
+    mNumberIndex.assign(maxNumber + 1, 0);
+    mActionTables.push_back(ActionTable());
 
-    return (*it).second;
+    FOR_EACH (ActionsConstIter, it, mActions)
+    {
+        const unsigned num = (*it).first;
+        const ActionMap *const actMap = (*it).second;
+        if (!actMap || num > 100)
+            continue;
+        size_t idx = 0;
+        if (num != 100)
+        {
+            idx = mActionTables.size();
+            mActionTables.push_back(ActionTable());
+            mNumberIndex[num] = static_cast<unsigned char>(idx);
+        }
+        ActionTable &table = mActionTables[idx];
+        FOR_EACHP (ActionMap::const_iterator, it2, actMap)
+        {
+            const size_t id = static_cast<size_t>(
+                getActionId((*it2).first));
+            if (id >= table.size())
+                table.resize(id + 1, nullptr);
+            table[id] = (*it2).second;
+        }
+    }
 }
 
 unsigned SpriteDef::findNumber(const unsigned num) const
@@ -87,14 +153,16 @@ SpriteDef *SpriteDef::load(const std::string &animationFile,
     if (pos != std::string::npos)
         palettes = animationFile.substr(pos + 1);
 
-    XML::Document doc(animationFile.substr(0, pos),
-        UseResman_true,
-        SkipError_false);
-    XmlNodePtrConst rootNode = doc.rootNode();
+    const std::string fileName = animationFile.substr(0, pos);
+    XML::Document *doc = DelayedManager::getPrefetchedDocument(fileName);
+    if (!doc)
+        doc = new XML::Document(fileName, UseResman_true, SkipError_false);
+    XmlNodePtrConst rootNode = doc->rootNode();
 
     if (!rootNode || !xmlNameEqual(rootNode, "sprite"))
     {
         logger->log("Error, failed to parse %s", animationFile.c_str());
+        delete doc;
 
         const std::string errorFile = paths.getStringValue("sprites").append(
             paths.getStringValue("spriteErrorFile"));
@@ -111,11 +179,13 @@ SpriteDef *SpriteDef::load(const std::string &animationFile,
     def->substituteActions();
     if (settings.fixDeadAnimation)
         def->fixDeadAction();
+    def->buildActionTables();
     if (prot)
     {
         def->incRef();
         def->setProtected(true);
     }
+    delete doc;
     BLOCK_END("SpriteDef::load")
     return def;
 }
@@ -27,10 +27,12 @@
 
 #include "resources/spritedirection.h"
 
+#include "utils/hashmap.h"
 #include "utils/xml.h"
 
 #include <map>
 #include <set>
+#include <vector>
 
 class Action;
 class Animation;
@@ -57,6 +59,22 @@ class SpriteDef final : public Resource
         const Action *getAction(const std::string &action,
                                 const unsigned num) const A_WARN_UNUSED;
 
+        /**
+         * Returns the specified action by action id.
+         */
+        const Action *getAction(const int id,
+                                const unsigned num) const A_WARN_UNUSED;
+
+        /**
+         * Returns id for action name, adding new id if need.
+         */
+        static int getActionId(const std::string &action) A_WARN_UNUSED;
+
+        /**
+         * Returns id for action name, or -1 if action name is unknown.
+         */
+        static int findActionId(const std::string &action) A_WARN_UNUSED;
+
         unsigned findNumber(const unsigned num) const A_WARN_UNUSED;
 
         /**
@@ -87,6 +105,8 @@ class SpriteDef final : public Resource
             Resource(),
             mImageSets(),
             mActions(),
+            mActionTables(),
+            mNumberIndex(),
             mProcessedFiles()
         { }
 
@@ -144,15 +164,27 @@ class SpriteDef final : public Resource
         void substituteAction(const std::string &restrict complete,
                               const std::string &restrict with);
 
+        /**
+         * Creates action tables indexed by action id,
+         * and index of tables by number.
+         */
+        void buildActionTables();
+
         typedef std::map<std::string, ImageSet*> ImageSets;
         typedef ImageSets::iterator ImageSetIterator;
         typedef std::map<std::string, Action*> ActionMap;
         typedef std::map<unsigned, ActionMap*> Actions;
         typedef Actions::const_iterator ActionsConstIter;
         typedef Actions::iterator ActionsIter;
+        typedef std::vector<const Action*> ActionTable;
+        typedef std::vector<ActionTable> ActionTables;
+        typedef HASHMAP<std::string, int> ActionIds;
 
         ImageSets mImageSets;
         Actions mActions;
+        ActionTables mActionTables;
+        std::vector<unsigned char> mNumberIndex;  /**< Table for number. */
+        static ActionIds mActionIds;
         std::set<std::string> mProcessedFiles;
 };
 
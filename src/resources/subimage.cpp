@@ -39,10 +39,8 @@ SubImage::SubImage(Image *const parent, SDL_Texture *const image,
     if (mParent)
     {
         mParent->incRef();
-        mParent->SDLTerminateAlphaCache();
         mHasAlphaChannel = mParent->hasAlphaChannel();
         mIsAlphaVisible = mHasAlphaChannel;
-        mAlphaChannel = mParent->SDLgetAlphaChannel();
         mSource = parent->getIdPath();
 #ifdef DEBUG_IMAGES
         logger->log("set name2 %p, %s", this, mSource.c_str());
@@ -55,7 +53,6 @@ SubImage::SubImage(Image *const parent, SDL_Texture *const image,
     {
         mHasAlphaChannel = false;
         mIsAlphaVisible = false;
-        mAlphaChannel = nullptr;
     }
 
     // Set up the rectangle.
@@ -77,7 +74,6 @@ SubImage::SubImage(Image *const parent, SDL_Texture *const image,
         mInternalBounds.w = 1;
         mInternalBounds.h = 1;
     }
-    mUseAlphaCache = false;
 }
 #endif
 
@@ -91,10 +87,8 @@ SubImage::SubImage(Image *const parent, SDL_Surface *const image,
     if (mParent)
     {
         mParent->incRef();
-        mParent->SDLTerminateAlphaCache();
         mHasAlphaChannel = mParent->hasAlphaChannel();
         mIsAlphaVisible = mHasAlphaChannel;
-        mAlphaChannel = mParent->SDLgetAlphaChannel();
         mSource = parent->getIdPath();
 #ifdef DEBUG_IMAGES
         logger->log("set name2 %p, %s", static_cast<void*>(this),
@@ -108,7 +102,6 @@ SubImage::SubImage(Image *const parent, SDL_Surface *const image,
     {
         mHasAlphaChannel = false;
         mIsAlphaVisible = false;
-        mAlphaChannel = nullptr;
     }
 
     // Set up the rectangle.
@@ -130,7 +123,6 @@ SubImage::SubImage(Image *const parent, SDL_Surface *const image,
         mInternalBounds.w = 1;
         mInternalBounds.h = 1;
     }
-    mUseAlphaCache = false;
 }
 
 #ifdef USE_OPENGL
@@ -183,8 +175,6 @@ SubImage::~SubImage()
 #endif
     // Avoid destruction of the image
     mSDLSurface = nullptr;
-    // Avoid possible destruction of its alpha channel
-    mAlphaChannel = nullptr;
 #ifdef USE_SDL2
     // Avoid destruction of texture
     mTexture = nullptr;
@@ -212,6 +202,12 @@ Image *SubImage::getSubImage(const int x, const int y,
         return nullptr;
 }
 
+int SubImage::calcMemory() const
+{
+    // surface or texture owned by parent image
+    return static_cast<int>(sizeof(SubImage));
+}
+
 #ifdef USE_OPENGL
 void SubImage::decRef()
 {
@@ -38,8 +38,6 @@
 
 #include "debug.h"
 
-bool SurfaceImageHelper::mEnableAlphaCache = false;
-
 Image *SurfaceImageHelper::load(SDL_Surface *const tmpImage)
 {
     return _SDLload(tmpImage);
@@ -55,10 +53,9 @@ Image *SurfaceImageHelper::createTextSurface(SDL_Surface *const tmpImage,
 
     Image *img;
     bool hasAlpha = false;
-    uint8_t *alphaChannel = nullptr;
     SDL_Surface *image = SDLDuplicateSurface(tmpImage);
 
-    img = new Image(image, hasAlpha, alphaChannel);
+    img = new Image(image, hasAlpha);
     img->setAlpha(alpha);
     return img;
 }
@@ -78,7 +75,7 @@ Image *SurfaceImageHelper::_SDLload(SDL_Surface *tmpImage) const
         return nullptr;
 
     SDL_Surface *image = convertTo32Bit(tmpImage);
-    return new Image(image, false, nullptr);
+    return new Image(image, false);
 }
 
 RenderType SurfaceImageHelper::useOpenGL() const
@@ -26,16 +26,32 @@
 
 #include "being/localplayer.h"
 
+#include "resources/beinginfo.h"
+#include "resources/notifytypes.h"
 #include "resources/sdlmusic.h"
 #include "resources/resourcemanager.h"
 #include "resources/soundeffect.h"
 
+#include "resources/db/sounddb.h"
+
+#include "utils/physfstools.h"
+#include "utils/sdlhelper.h"
+
 #include <SDL.h>
 
 #include "debug.h"
 
 SoundManager soundManager;
 
+namespace
+{
+    const int sfxChannels = 16;
+    // same sample started again in this time (ms) not played
+    const int sfxDedupeTime = 60;
+    // max channels playing same sample
+    const int sfxSampleVoices = 3;
+}  // namespace
+
 /**
  * This will be set to true, when a music can be freed after a fade out
  * Currently used by fadeOutCallBack()
@@ -63,7 +79,17 @@ SoundManager::SoundManager() :
     mPlayGui(false),
     mPlayMusic(false),
     mFadeoutMusic(true),
-    mCacheSounds(true)
+    mCacheSounds(true),
+    mVoices(),
+    mPreloadQueue(),
+    mPreloadReady(),
+    mPreloadRequested(),
+    mPreloadInfos(),
+    mPreloaded(),
+    mPreloadThread(nullptr),
+    mPreloadMutex(nullptr),
+    mPreloadSem(nullptr),
+    mPreloadRunning(false)
 {
     // This set up our callback function used to
     // handle fade outs endings.
@@ -160,13 +186,16 @@ void SoundManager::init()
         logger->log("Fallback to stereo audio");
     }
 
-    Mix_AllocateChannels(16);
+    Mix_AllocateChannels(sfxChannels);
     Mix_VolumeMusic(mMusicVolume);
     Mix_Volume(-1, mSfxVolume);
+    mVoices.clear();
+    mVoices.resize(sfxChannels);
 
     info();
 
     mInstalled = true;
+    startPreload();
 
     if (!mCurrentMusicFile.empty() && mPlayMusic)
         playMusic(mCurrentMusicFile);
@@ -354,44 +383,129 @@ void SoundManager::logic()
             mNextMusicFile.clear();
         }
     }
+    if (mPreloadThread)
+        addPreloaded();
     BLOCK_END("SoundManager::logic")
 }
 
+std::string SoundManager::getSfxPath(const std::string &path)
+{
+    if (!path.compare(0, 4, "sfx/"))
+        return path;
+    return paths.getValue("sfx", "sfx/").append(path);
+}
+
+int SoundManager::getSfxChannel(const SoundEffect *const sample,
+                                const int volume) const
+{
+    const int time = static_cast<int>(SDL_GetTicks());
+    int freeChannel = -1;
+    int quietChannel = -1;
+    int quietVolume = volume;
+    int quietTime = time;
+    int sameChannel = -1;
+    int sameVolume = volume;
+    int sameTime = time;
+    int sameVoices = 0;
+    const int sz = static_cast<int>(mVoices.size());
+    for (int f = 0; f < sz; f ++)
+    {
+        if (f == mGuiChannel)
+            continue;
+        if (!Mix_Playing(f))
+        {
+            if (freeChannel == -1)
+                freeChannel = f;
+            continue;
+        }
+        const SfxVoice &voice = mVoices[f];
+        if (voice.sample == sample)
+        {
+            // same hit from many beings at once sounds as one hit
+            if (time - voice.time < sfxDedupeTime && voice.volume >= volume)
+                return -1;
+            sameVoices ++;
+            // from voices with same volume replace oldest
+            if (voice.volume < sameVolume
+                || (voice.volume == sameVolume && voice.time < sameTime))
+            {
+                sameVolume = voice.volume;
+                sameTime = voice.time;
+                sameChannel = f;
+            }
+        }
+        if (voice.volume < quietVolume
+            || (voice.volume == quietVolume && voice.time < quietTime))
+        {
+            quietVolume = voice.volume;
+            quietTime = voice.time;
+            quietChannel = f;
+        }
+    }
+
+    // replace more distant voice of same sample
+    if (sameVoices >= sfxSampleVoices)
+        return sameChannel;
+    if (freeChannel != -1)
+        return freeChannel;
+    // all channels busy, replace most distant sound
+    return quietChannel;
+}
+
 void SoundManager::playSfx(const std::string &path,
-                           const int x, const int y) const
+                           const int x, const int y)
 {
     if (!mInstalled || path.empty() || !mPlayBattle)
         return;
 
-    std::string tmpPath;
-    if (!path.compare(0, 4, "sfx/"))
-        tmpPath = path;
-    else
-        tmpPath = paths.getValue("sfx", "sfx/").append(path);
+    int vol = 120;
+    if (localPlayer && (x > 0 || y > 0))
+    {
+        int dx = localPlayer->getTileX() - x;
+        int dy = localPlayer->getTileY() - y;
+        if (dx < 0)
+            dx = -dx;
+        if (dy < 0)
+            dy = -dy;
+        const int dist = dx > dy ? dx : dy;
+        if (dist * 8 > vol)
+            return;
+
+        vol -= dist * 8;
+    }
+
+    const std::string tmpPath = getSfxPath(path);
     ResourceManager *const resman = ResourceManager::getInstance();
-    SoundEffect *const sample = resman->getSoundEffect(tmpPath);
-    if (sample)
+    SoundEffect *sample = nullptr;
+    if (mPreloadThread
+        && mPreloadRequested.find(tmpPath) != mPreloadRequested.end())
     {
-        logger->log("SoundManager::playSfx() Playing: %s", path.c_str());
-        int vol = 120;
-        if (localPlayer && (x > 0 || y > 0))
+        // sound still decoding in preload thread
+        sample = static_cast<SoundEffect*>(resman->getFromCache(tmpPath));
+        if (!sample)
+            return;
+    }
+    else
+    {
+        sample = resman->getSoundEffect(tmpPath);
+        if (!sample)
+            return;
+    }
+
+    const int channel = getSfxChannel(sample, vol);
+    if (channel != -1)
+    {
+        const int ret = sample->play(0, vol, channel);
+        if (ret != -1)
         {
-            int dx = localPlayer->getTileX() - x;
-            int dy = localPlayer->getTileY() - y;
-            if (dx < 0)
-                dx = -dx;
-            if (dy < 0)
-                dy = -dy;
-            const int dist = dx > dy ? dx : dy;
-            if (dist * 8 > vol)
-                return;
-
-            vol -= dist * 8;
+            SfxVoice &voice = mVoices[ret];
+            voice.sample = sample;
+            voice.volume = vol;
+            voice.time = static_cast<int>(SDL_GetTicks());
         }
-        sample->play(0, vol);
-        if (!mCacheSounds)
-            sample->decRef();
     }
+    if (!mCacheSounds)
+        sample->decRef();
 }
 
 void SoundManager::playGuiSound(const std::string &name)
@@ -405,16 +519,10 @@ void SoundManager::playGuiSfx(const std::string &path)
     if (!mInstalled || path.empty() || !mPlayGui)
         return;
 
-    std::string tmpPath;
-    if (!path.compare(0, 4, "sfx/"))
-        tmpPath = path;
-    else
-        tmpPath = paths.getValue("sfx", "sfx/").append(path);
     ResourceManager *const resman = ResourceManager::getInstance();
-    SoundEffect *const sample = resman->getSoundEffect(tmpPath);
+    SoundEffect *const sample = resman->getSoundEffect(getSfxPath(path));
     if (sample)
     {
-        logger->log("SoundManager::playGuiSfx() Playing: %s", path.c_str());
         const int ret = sample->play(0, 120, mGuiChannel);
         if (ret != -1)
             mGuiChannel = ret;
@@ -423,12 +531,194 @@ void SoundManager::playGuiSfx(const std::string &path)
     }
 }
 
+void SoundManager::preloadSfx(const std::string &path)
+{
+    if (!mPreloadThread || path.empty())
+        return;
+
+    const std::string tmpPath = getSfxPath(path);
+    if (mPreloadRequested.find(tmpPath) != mPreloadRequested.end())
+        return;
+    mPreloadRequested.insert(tmpPath);
+
+    ResourceManager *const resman = ResourceManager::getInstance();
+    SoundEffect *const sample = static_cast<SoundEffect*>(
+        resman->getFromCache(tmpPath));
+    if (sample)
+    {
+        mPreloaded.push_back(sample);
+        return;
+    }
+
+    SDL_mutexP(mPreloadMutex);
+    mPreloadQueue.push_back(tmpPath);
+    SDL_mutexV(mPreloadMutex);
+    SDL_SemPost(mPreloadSem);
+}
+
+void SoundManager::preloadSfx(const BeingInfo *const info)
+{
+    if (!mPreloadThread || !info || !mPlayBattle)
+        return;
+    if (mPreloadInfos.find(info) != mPreloadInfos.end())
+        return;
+    mPreloadInfos.insert(info);
+
+    const ItemSoundEvents &sounds = info->getSounds();
+    FOR_EACH (ItemSoundEvents::const_iterator, it, sounds)
+    {
+        const SoundInfoVect *const vect = (*it).second;
+        if (!vect)
+            continue;
+        FOR_EACHP (SoundInfoVect::const_iterator, it2, vect)
+            preloadSfx((*it2).sound);
+    }
+}
+
+void SoundManager::preloadNotifySfx()
+{
+    if (!mPreloadThread || !mPlayBattle)
+        return;
+    for (int f = 0; f < NotifyTypes::TYPE_END; f ++)
+        preloadSfx(SoundDB::getSound(f));
+}
+
+void SoundManager::clearPreload()
+{
+    if (mPreloadMutex)
+    {
+        SDL_mutexP(mPreloadMutex);
+        mPreloadQueue.clear();
+        SDL_mutexV(mPreloadMutex);
+    }
+    // sounds already decoding added to cache as orphans
+    addPreloaded();
+    FOR_EACH (std::vector<SoundEffect*>::iterator, it, mPreloaded)
+        (*it)->decRef();
+    mPreloaded.clear();
+    mPreloadRequested.clear();
+    mPreloadInfos.clear();
+}
+
+void SoundManager::addPreloaded()
+{
+    if (!mPreloadMutex)
+        return;
+
+    SfxChunks ready;
+    SDL_mutexP(mPreloadMutex);
+    ready.swap(mPreloadReady);
+    SDL_mutexV(mPreloadMutex);
+    if (ready.empty())
+        return;
+
+    ResourceManager *const resman = ResourceManager::getInstance();
+    FOR_EACH (SfxChunksIter, it, ready)
+    {
+        const std::string &path = (*it).first;
+        Mix_Chunk *const chunk = (*it).second;
+        if (!chunk)
+        {
+            // playSfx will try load it and report error
+            mPreloadRequested.erase(path);
+            continue;
+        }
+        SoundEffect *sample = static_cast<SoundEffect*>(
+            resman->getFromCache(path));
+        if (sample)
+        {
+            Mix_FreeChunk(chunk);
+        }
+        else
+        {
+            sample = new SoundEffect(chunk);
+            resman->addResource(path, sample);
+        }
+        if (mPreloadRequested.find(path) != mPreloadRequested.end())
+            mPreloaded.push_back(sample);
+        else
+            sample->decRef();
+    }
+}
+
+int SoundManager::preloadThread(void *ptr)
+{
+    SoundManager *const manager = static_cast<SoundManager*>(ptr);
+    while (manager->mPreloadRunning)
+    {
+        SDL_SemWait(manager->mPreloadSem);
+        if (!manager->mPreloadRunning)
+            break;
+
+        SDL_mutexP(manager->mPreloadMutex);
+        if (manager->mPreloadQueue.empty())
+        {
+            SDL_mutexV(manager->mPreloadMutex);
+            continue;
+        }
+        const std::string path = manager->mPreloadQueue.front();
+        manager->mPreloadQueue.pop_front();
+        SDL_mutexV(manager->mPreloadMutex);
+
+        Mix_Chunk *chunk = nullptr;
+        int size = 0;
+        void *const data = PhysFs::loadFile(path, size);
+        if (data)
+        {
+            chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(data, size), 1);
+            free(data);
+        }
+
+        SDL_mutexP(manager->mPreloadMutex);
+        manager->mPreloadReady.push_back(std::pair<std::string, Mix_Chunk*>(
+            path, chunk));
+        SDL_mutexV(manager->mPreloadMutex);
+    }
+    return 0;
+}
+
+void SoundManager::startPreload()
+{
+    if (mPreloadThread)
+        return;
+    if (!mPreloadMutex)
+        mPreloadMutex = SDL_CreateMutex();
+    if (!mPreloadSem)
+        mPreloadSem = SDL_CreateSemaphore(0);
+
+    mPreloadRunning = true;
+    mPreloadThread = SDL::createThread(&preloadThread, "soundpreload", this);
+    if (!mPreloadThread)
+    {
+        logger->log1("Unable to create sound preload thread");
+        mPreloadRunning = false;
+    }
+}
+
+void SoundManager::stopPreload()
+{
+    if (!mPreloadThread)
+        return;
+    mPreloadRunning = false;
+    SDL_SemPost(mPreloadSem);
+    SDL_WaitThread(mPreloadThread, nullptr);
+    mPreloadThread = nullptr;
+
+    clearPreload();
+    SDL_mutexP(mPreloadMutex);
+    FOR_EACH (SfxChunksIter, it, mPreloadReady)
+        Mix_FreeChunk((*it).second);
+    mPreloadReady.clear();
+    SDL_mutexV(mPreloadMutex);
+}
+
 void SoundManager::close()
 {
     if (!mInstalled)
         return;
 
     haltMusic();
+    stopPreload();
     logger->log1("SoundManager::close() Shutting down sound...");
     Mix_CloseAudio();
 
@@ -24,12 +24,20 @@
 #define SOUNDMANAGER_H
 
 #include <SDL_mixer.h>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
 
 #include "listeners/configlistener.h"
 
+#include <list>
+#include <set>
+#include <vector>
+
 #include "localconsts.h"
 
+class BeingInfo;
 class SDLMusic;
+class SoundEffect;
 
 /** SoundManager
  *
@@ -105,7 +113,7 @@ class SoundManager final : public ConfigListener
          * @param path The resource path to the sound file.
          */
         void playSfx(const std::string &path, const int x = 0,
-                     const int y = 0) const;
+                     const int y = 0);
 
         /**
          * Plays an item for gui.
@@ -116,6 +124,29 @@ class SoundManager final : public ConfigListener
 
         void playGuiSound(const std::string &name);
 
+        /**
+         * Queues sound effect for decoding in background thread.
+         * Preloaded sounds kept in cache until clearPreload called.
+         *
+         * @param path The resource path to the sound file.
+         */
+        void preloadSfx(const std::string &path);
+
+        /**
+         * Queues all sounds of being for preload.
+         */
+        void preloadSfx(const BeingInfo *const info);
+
+        /**
+         * Queues notification sounds from SoundDB for preload.
+         */
+        void preloadNotifySfx();
+
+        /**
+         * Releases sounds preloaded for previous map.
+         */
+        void clearPreload();
+
         void changeAudio();
 
         void volumeOff() const;
@@ -134,10 +165,52 @@ class SoundManager final : public ConfigListener
 
         void shutdown();
 
+#ifdef UNITTESTS
+        int getSfxVoiceTime(const int channel) const A_WARN_UNUSED
+        { return mVoices[channel].time; }
+#endif
+
     private:
+        struct SfxVoice final
+        {
+            SfxVoice() :
+                sample(nullptr),
+                volume(0),
+                time(0)
+            { }
+
+            const SoundEffect *sample;
+            int volume;
+            int time;
+        };
+
+        typedef std::list<std::pair<std::string, Mix_Chunk*> > SfxChunks;
+        typedef SfxChunks::iterator SfxChunksIter;
+
         /** Logs various info about sound device. */
         static void info();
 
+        static int preloadThread(void *ptr);
+
+        void startPreload();
+
+        void stopPreload();
+
+        /**
+         * Adds decoded sounds to resource manager.
+         */
+        void addPreloaded();
+
+        /**
+         * Selects channel for sound effect, or returns -1 if sound must
+         * be skipped.
+         */
+        int getSfxChannel(const SoundEffect *const sample,
+                          const int volume) const A_WARN_UNUSED;
+
+        static std::string getSfxPath(const std::string &path)
+                                      A_WARN_UNUSED;
+
         /** Halts and frees currently playing music. */
         void haltMusic();
 
@@ -160,6 +233,20 @@ class SoundManager final : public ConfigListener
         bool mPlayMusic;
         bool mFadeoutMusic;
         bool mCacheSounds;
+
+        std::vector<SfxVoice> mVoices;
+        /** Sounds waiting for decode. */
+        std::list<std::string> mPreloadQueue;
+        /** Decoded sounds waiting for adding to resource manager. */
+        SfxChunks mPreloadReady;
+        /** Sounds queued or loaded since last clearPreload. */
+        std::set<std::string> mPreloadRequested;
+        std::set<const BeingInfo*> mPreloadInfos;
+        std::vector<SoundEffect*> mPreloaded;
+        SDL_Thread *mPreloadThread;
+        SDL_mutex *mPreloadMutex;
+        SDL_sem *mPreloadSem;
+        volatile bool mPreloadRunning;
 };
 
 extern SoundManager soundManager;
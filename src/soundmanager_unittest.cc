@@ -0,0 +1,125 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "soundmanager.h"
+
+#include "configuration.h"
+#include "logger.h"
+
+#include "resources/resourcemanager.h"
+
+#include "utils/delete2.h"
+
+#include "gtest/gtest.h"
+
+#include <physfs.h>
+
+#include <SDL_timer.h>
+
+#include <vector>
+
+#include "debug.h"
+
+extern const char *dirSeparator;
+
+static char audioDriver[] = "SDL_AUDIODRIVER=dummy";
+
+TEST(SoundManager, voices)
+{
+    putenv(audioDriver);
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    logger = new Logger();
+    ResourceManager *const resman = ResourceManager::getInstance();
+    resman->addToSearchPath("data", false);
+    resman->addToSearchPath("../data", false);
+
+    config.setValue("audioFrequency", 22050);
+    config.setValue("audioChannels", 2);
+    config.setValue("sfxVolume", 100);
+    config.setValue("musicVolume", 60);
+    config.setValue("playBattleSound", true);
+    config.setValue("playGuiSound", false);
+    config.setValue("playMusic", false);
+    config.setValue("fadeoutmusic", false);
+    config.setValue("uselonglivesounds", true);
+    soundManager.init();
+
+    int frequency = 0;
+    uint16_t format = 0;
+    int channels = 0;
+    ASSERT_NE(0, Mix_QuerySpec(&frequency, &format, &channels));
+
+    // same sample at same time played once
+    for (int f = 0; f < 10; f ++)
+        soundManager.playSfx("system/newmessage.ogg");
+    EXPECT_EQ(1, Mix_Playing(-1));
+
+    // voices of one sample limited
+    for (int f = 0; f < 2; f ++)
+    {
+        SDL_Delay(70);
+        soundManager.playSfx("system/newmessage.ogg");
+    }
+    EXPECT_EQ(3, Mix_Playing(-1));
+
+    const int channelsCount = Mix_AllocateChannels(-1);
+    int oldestChannel = -1;
+    std::vector<int> times(channelsCount);
+    for (int f = 0; f < channelsCount; f ++)
+    {
+        times[f] = soundManager.getSfxVoiceTime(f);
+        if (Mix_Playing(f) && (oldestChannel == -1
+            || times[f] < times[oldestChannel]))
+        {
+            oldestChannel = f;
+        }
+    }
+    ASSERT_NE(-1, oldestChannel);
+
+    // next voice replaces oldest one
+    SDL_Delay(70);
+    soundManager.playSfx("system/newmessage.ogg");
+    EXPECT_EQ(3, Mix_Playing(-1));
+    EXPECT_NE(0, Mix_Playing(oldestChannel));
+    EXPECT_GT(soundManager.getSfxVoiceTime(oldestChannel),
+        times[oldestChannel]);
+    for (int f = 0; f < channelsCount; f ++)
+    {
+        if (f != oldestChannel)
+            EXPECT_EQ(times[f], soundManager.getSfxVoiceTime(f));
+    }
+
+    // preloaded sound decoded in thread and held in cache
+    soundManager.preloadSfx("system/chat2.ogg");
+    const uint32_t startTime = SDL_GetTicks();
+    while (!resman->isInCache("sfx/system/chat2.ogg")
+           && SDL_GetTicks() - startTime < 3000)
+    {
+        SDL_Delay(10);
+        soundManager.logic();
+    }
+    EXPECT_TRUE(resman->isInCache("sfx/system/chat2.ogg"));
+
+    soundManager.clearPreload();
+    soundManager.close();
+    soundManager.shutdown();
+    delete2(logger);
+}
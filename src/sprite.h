@@ -117,6 +117,13 @@ class Sprite notfinal
 
         virtual bool updateNumber(const unsigned num) = 0;
 
+        /**
+         * Sets load priority for not yet loaded sprite.
+         * Lower value loaded first.
+         */
+        virtual void setDelayPriority(const int priority A_UNUSED)
+        { }
+
     protected:
         Sprite() :
             mAlpha()
@@ -51,6 +51,8 @@ TestMain::~TestMain()
 
 void TestMain::initConfig()
 {
+    // test processes read config right after it written
+    Configuration::stopWriter();
     mConfig.init(settings.configDir + "/test.xml");
     mConfig.clear();
 //    mConfig.setDefaultValues(getConfigDefaults());
@@ -54,6 +54,15 @@ Text::Text(const std::string &text, const int x, const int y,
     mText(text),
     mColor(color),
     mOutlineColor(theme->getColor(Theme::OUTLINE, 255)),
+    mListIter(),
+    mWantedY(y),
+    mIndexX(0),
+    mIndexY(0),
+    mCellX1(0),
+    mCellY1(0),
+    mCellX2(-1),
+    mCellY2(-1),
+    mStamp(0),
     mIsSpeech(isSpeech)
 {
     if (!textManager)
@@ -130,6 +139,8 @@ void Text::adviseXY(const int x, const int y, const bool move)
     {
         mX = x - mXOffset;
         mY = y;
+        if (textManager)
+            textManager->updateText(this);
     }
 }
 
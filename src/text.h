@@ -26,6 +26,8 @@
 
 #include "render/graphics.h"
 
+#include <list>
+
 #include "localconsts.h"
 
 class Font;
@@ -58,6 +60,14 @@ class Text notfinal
         int getHeight() const A_WARN_UNUSED
         { return mHeight; }
 
+#ifdef UNITTESTS
+        int getX() const A_WARN_UNUSED
+        { return mX; }
+
+        int getY() const A_WARN_UNUSED
+        { return mY; }
+#endif
+
         /**
          * Allows the originator of the text to specify the ideal coordinates.
          */
@@ -80,6 +90,15 @@ class Text notfinal
         std::string mText;     /**< The text to display. */
         const Color *mColor;     /**< The color of the text. */
         const Color mOutlineColor;
+        std::list<Text*>::iterator mListIter; /**< Place in text manager. */
+        int mWantedY;          /**< The y-value before placement. */
+        int mIndexX;           /**< The x-value used in text manager index. */
+        int mIndexY;           /**< The y-value used in text manager index. */
+        int mCellX1;           /**< Cells range in text manager index. */
+        int mCellY1;
+        int mCellX2;
+        int mCellY2;
+        unsigned int mStamp;   /**< Index change counter at placement. */
         bool mIsSpeech;        /**< Is this text a speech bubble? */
 
     protected:
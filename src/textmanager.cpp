@@ -23,40 +23,86 @@
 
 #include "text.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "debug.h"
 
 TextManager *textManager = nullptr;
 
+namespace
+{
+    const int TEST = 50;  // Number of lines to test for text
+    const int CELL_WIDTH = 64;
+    const int CELL_HEIGHT = 32;
+
+    int toCell(const int pos, const int size)
+    {
+        // round to lower cell for negative positions too
+        return pos >= 0 ? pos / size : (pos - size + 1) / size;
+    }
+
+    unsigned int getBucket(const int cellX, const int cellY)
+    {
+        return (static_cast<unsigned int>(cellX) * 73856093U
+            ^ static_cast<unsigned int>(cellY) * 19349663U)
+            % TEXT_BUCKETS;
+    }
+}  // namespace
+
 TextManager::TextManager() :
-    mTextList()
+    mTextList(),
+    mStamp(0)
 {
+    std::memset(&mStamps, 0, sizeof(mStamps));
 }
 
 void TextManager::addText(Text *const text)
 {
+    text->mWantedY = text->mY;
     place(text, nullptr, text->mX, text->mY, text->mHeight);
     mTextList.push_back(text);
+    text->mListIter = --mTextList.end();
+    addToBuckets(text);
 }
 
-void TextManager::moveText(Text *const text, const int x, const int y) const
+void TextManager::moveText(Text *const text, const int x, const int y)
 {
+    // nothing moved near text since last placement
+    if (text->mX == x && text->mWantedY == y && isPlaced(text))
+        return;
+
+    removeFromBuckets(text);
     text->mX = x;
     text->mY = y;
+    text->mWantedY = y;
     place(text, text, text->mX, text->mY, text->mHeight);
+    addToBuckets(text);
 }
 
-void TextManager::removeText(const Text *const text)
+void TextManager::updateText(Text *const text)
 {
-    FOR_EACH (TextList::iterator, ptr, mTextList)
-    {
-        if (*ptr == text)
-        {
-            mTextList.erase(ptr);
-            return;
-        }
-    }
+    if (text->mX == text->mIndexX && text->mY == text->mIndexY)
+        return;
+
+    removeFromBuckets(text);
+    text->mWantedY = text->mY;
+    addToBuckets(text);
+}
+
+void TextManager::removeText(Text *const text)
+{
+    if (text->mCellX1 > text->mCellX2)
+        return;
+
+    removeFromBuckets(text);
+    mTextList.erase(text->mListIter);
+    text->mListIter = mTextList.end();
+    // mark as removed, second remove must do nothing
+    text->mCellX1 = 0;
+    text->mCellX2 = -1;
+    text->mCellY1 = 0;
+    text->mCellY2 = -1;
 }
 
 TextManager::~TextManager()
@@ -72,38 +118,126 @@ void TextManager::draw(Graphics *const graphics,
     BLOCK_END("TextManager::draw")
 }
 
+bool TextManager::isPlaced(const Text *const text) const
+{
+    const int occupiedTop = text->mWantedY - (TEST - text->mHeight) / 2;
+    const int cellX1 = toCell(text->mX, CELL_WIDTH);
+    const int cellX2 = toCell(text->mX + text->mWidth, CELL_WIDTH);
+    const int cellY1 = toCell(occupiedTop, CELL_HEIGHT);
+    const int cellY2 = toCell(occupiedTop + TEST - 1, CELL_HEIGHT);
+    const unsigned int stamp = text->mStamp;
+    for (int cellY = cellY1; cellY <= cellY2; cellY ++)
+    {
+        for (int cellX = cellX1; cellX <= cellX2; cellX ++)
+        {
+            if (mStamps[getBucket(cellX, cellY)] > stamp)
+                return false;
+        }
+    }
+    return true;
+}
+
+void TextManager::addToBuckets(Text *const text)
+{
+    text->mCellX1 = toCell(text->mX, CELL_WIDTH);
+    text->mCellX2 = toCell(text->mX + text->mWidth, CELL_WIDTH);
+    text->mCellY1 = toCell(text->mY, CELL_HEIGHT);
+    text->mCellY2 = toCell(text->mY + text->mHeight - 1, CELL_HEIGHT);
+    text->mIndexX = text->mX;
+    text->mIndexY = text->mY;
+
+    nextStamp();
+    for (int cellY = text->mCellY1; cellY <= text->mCellY2; cellY ++)
+    {
+        for (int cellX = text->mCellX1; cellX <= text->mCellX2; cellX ++)
+        {
+            const unsigned int bucket = getBucket(cellX, cellY);
+            TextBucket &texts = mBuckets[bucket];
+            // bucket can be shared by other cell of same text
+            if (std::find(texts.begin(), texts.end(), text) == texts.end())
+                texts.push_back(text);
+            mStamps[bucket] = mStamp;
+        }
+    }
+    text->mStamp = mStamp;
+}
+
+void TextManager::removeFromBuckets(const Text *const text)
+{
+    nextStamp();
+    for (int cellY = text->mCellY1; cellY <= text->mCellY2; cellY ++)
+    {
+        for (int cellX = text->mCellX1; cellX <= text->mCellX2; cellX ++)
+        {
+            const unsigned int bucket = getBucket(cellX, cellY);
+            TextBucket &texts = mBuckets[bucket];
+            const TextBucketIter it = std::find(texts.begin(),
+                texts.end(), text);
+            if (it != texts.end())
+            {
+                *it = texts.back();
+                texts.pop_back();
+            }
+            mStamps[bucket] = mStamp;
+        }
+    }
+}
+
+void TextManager::nextStamp()
+{
+    mStamp ++;
+    if (mStamp)
+        return;
+
+    // counter wrapped, old stamps can not be compared any more.
+    // mark all buckets as changed to place all texts again.
+    for (int f = 0; f < TEXT_BUCKETS; f ++)
+        mStamps[f] = 1;
+    FOR_EACH (TextList::iterator, it, mTextList)
+        (*it)->mStamp = 0;
+    mStamp = 1;
+}
+
 void TextManager::place(const Text *const textObj, const Text *const omit,
                         const int &x A_UNUSED, int &y, const int h) const
 {
     const int xLeft = textObj->mX;
     const int xRight1 = xLeft + textObj->mWidth;
-    const int TEST = 50;  // Number of lines to test for text
-    const int nBeings = 30;
     bool occupied[TEST];  // is some other text obscuring this line?
     std::memset(&occupied, 0, sizeof(occupied));  // set all to false
     const int wantedTop = (TEST - h) / 2;   // Entry in occupied at top of text
     const int occupiedTop = y - wantedTop;  // Line in map representing
                                             // to of occupied
-    int cnt = 0;
 
-    for (TextList::const_iterator ptr = mTextList.begin(),
-         pEnd = mTextList.end(); ptr != pEnd && cnt < nBeings; ++ptr, cnt ++)
+    // check only texts from buckets near wanted place
+    const int cellX1 = toCell(xLeft, CELL_WIDTH);
+    const int cellX2 = toCell(xRight1, CELL_WIDTH);
+    const int cellY1 = toCell(occupiedTop, CELL_HEIGHT);
+    const int cellY2 = toCell(occupiedTop + TEST - 1, CELL_HEIGHT);
+    for (int cellY = cellY1; cellY <= cellY2; cellY ++)
     {
-        const Text *const text = *ptr;
-
-        if (text != omit && text->mX + 1 <= xRight1
-            && text->mX + text->mWidth > xLeft)
+        for (int cellX = cellX1; cellX <= cellX2; cellX ++)
         {
-            int from = text->mY - occupiedTop;
-            int to = from + text->mHeight - 1;
-            if (to < 0 || from >= TEST)  // out of range considered
-                continue;
-            if (from < 0)
-                from = 0;
-            if (to >= TEST)
-                to = TEST - 1;
-            for (int i = from; i <= to; ++i)
-                occupied[i] = true;
+            const TextBucket &texts = mBuckets[getBucket(cellX, cellY)];
+            FOR_EACH (TextBucketCIter, ptr, texts)
+            {
+                const Text *const text = *ptr;
+
+                if (text != omit && text->mX + 1 <= xRight1
+                    && text->mX + text->mWidth > xLeft)
+                {
+                    int from = text->mY - occupiedTop;
+                    int to = from + text->mHeight - 1;
+                    if (to < 0 || from >= TEST)  // out of range considered
+                        continue;
+                    if (from < 0)
+                        from = 0;
+                    if (to >= TEST)
+                        to = TEST - 1;
+                    for (int i = from; i <= to; ++i)
+                        occupied[i] = true;
+                }
+            }
         }
     }
     bool ok = true;
@@ -23,12 +23,15 @@
 #define TEXTMANAGER_H
 
 #include <list>
+#include <vector>
 
 #include "localconsts.h"
 
 class Graphics;
 class Text;
 
+const int TEXT_BUCKETS = 512;
+
 class TextManager final
 {
     public:
@@ -52,12 +55,17 @@ class TextManager final
         /**
          * Move the text around the screen
          */
-        void moveText(Text *const text, const int x, const int y) const;
+        void moveText(Text *const text, const int x, const int y);
+
+        /**
+         * Update text position in index after it was set without placing
+         */
+        void updateText(Text *const text);
 
         /**
          * Remove the text from the manager
          */
-        void removeText(const Text *const text);
+        void removeText(Text *const text);
 
         /**
          * Draw the text
@@ -65,6 +73,13 @@ class TextManager final
         void draw(Graphics *const graphics,
                   const int xOff, const int yOff);
 
+        typedef std::list<Text *> TextList; /**< The container type */
+
+#ifdef UNITTESTS
+        void setStamp(const unsigned int stamp)
+        { mStamp = stamp; }
+#endif
+
     private:
         /**
          * Position the text so as to avoid conflict
@@ -72,8 +87,25 @@ class TextManager final
         void place(const Text *const textObj, const Text *const omit,
                    const int &x, int &y, const int h) const;
 
-        typedef std::list<Text *> TextList; /**< The container type */
+        /**
+         * Check is nothing changed near text since it was placed
+         */
+        bool isPlaced(const Text *const text) const A_WARN_UNUSED;
+
+        void addToBuckets(Text *const text);
+
+        void removeFromBuckets(const Text *const text);
+
+        void nextStamp();
+
         TextList mTextList; /**< The container */
+
+        typedef std::vector<Text *> TextBucket;
+        typedef TextBucket::iterator TextBucketIter;
+        typedef TextBucket::const_iterator TextBucketCIter;
+        TextBucket mBuckets[TEXT_BUCKETS]; /**< Texts by screen area */
+        unsigned int mStamps[TEXT_BUCKETS]; /**< Last change in bucket */
+        unsigned int mStamp;
 };
 
 extern TextManager *textManager;
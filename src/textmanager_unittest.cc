@@ -0,0 +1,171 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "text.h"
+#include "textmanager.h"
+
+#include "client.h"
+#include "logger.h"
+
+#include "gui/theme.h"
+
+#include "resources/sdlimagehelper.h"
+
+#include "gtest/gtest.h"
+
+#include <physfs.h>
+
+#include <SDL_timer.h>
+
+#include <climits>
+
+#include "debug.h"
+
+extern const char *dirSeparator;
+
+TEST(TextManager, crowd)
+{
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    client = new Client;
+    logger = new Logger();
+    imageHelper = new SDLImageHelper();
+    theme = new Theme;
+
+    const Color color;
+    const int beings = 600;
+    Text *texts[beings];
+    for (int f = 0; f < beings; f ++)
+    {
+        texts[f] = new Text("player name", (f % 40) * 32, (f / 40) * 32,
+            Graphics::CENTER, &color);
+    }
+    ASSERT_TRUE(textManager != nullptr);
+
+    // all beings moving in crowded town
+    const uint32_t startTime = SDL_GetTicks();
+    for (int tick = 0; tick < 100; tick ++)
+    {
+        for (int f = 0; f < beings; f ++)
+        {
+            texts[f]->adviseXY((f % 40) * 32 + tick,
+                (f / 40) * 32 + (tick & 7), true);
+        }
+    }
+    logger->log("textmanager: %d texts moved 100 times in %d ms",
+        beings, static_cast<int>(SDL_GetTicks() - startTime));
+
+    // same positions again, placement taken from cache
+    for (int f = 0; f < beings; f ++)
+    {
+        texts[f]->adviseXY((f % 40) * 32 + 99,
+            (f / 40) * 32 + (99 & 7), true);
+    }
+
+    for (int f = 0; f < beings; f ++)
+        delete texts[f];
+    EXPECT_TRUE(textManager == nullptr);
+
+    delete client;
+    client = nullptr;
+}
+
+TEST(TextManager, place)
+{
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    client = new Client;
+    logger = new Logger();
+    imageHelper = new SDLImageHelper();
+    theme = new Theme;
+
+    const Color color;
+    // without font each text is 1x1 pixels
+    Text *const text1 = new Text("1", 100, 100, Graphics::LEFT, &color);
+    Text *const text2 = new Text("2", 100, 100, Graphics::LEFT, &color);
+    Text *const text3 = new Text("3", 100, 100, Graphics::LEFT, &color);
+    Text *const text4 = new Text("4", 300, 100, Graphics::LEFT, &color);
+    ASSERT_TRUE(textManager != nullptr);
+    ASSERT_EQ(1, text1->getHeight());
+
+    // first text stay on wanted place, next go to nearest free lines
+    EXPECT_EQ(100, text1->getY());
+    EXPECT_EQ(99, text2->getY());
+    EXPECT_EQ(101, text3->getY());
+    // far text not moved
+    EXPECT_EQ(100, text4->getY());
+    EXPECT_EQ(300, text4->getX());
+
+    // removed text not used in placement
+    delete text1;
+    text2->adviseXY(100, 100, true);
+    EXPECT_EQ(100, text2->getY());
+    text3->adviseXY(100, 100, true);
+    EXPECT_EQ(99, text3->getY());
+
+    // second remove of same text do nothing
+    textManager->removeText(text3);
+    textManager->removeText(text3);
+    delete text3;
+    text2->adviseXY(100, 98, true);
+    EXPECT_EQ(98, text2->getY());
+    text4->adviseXY(100, 98, true);
+    EXPECT_EQ(97, text4->getY());
+
+    delete text2;
+    delete text4;
+    EXPECT_TRUE(textManager == nullptr);
+
+    delete client;
+    client = nullptr;
+}
+
+TEST(TextManager, stampWrap)
+{
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    client = new Client;
+    logger = new Logger();
+    imageHelper = new SDLImageHelper();
+    theme = new Theme;
+
+    const Color color;
+    Text *const text1 = new Text("1", 100, 100, Graphics::LEFT, &color);
+    ASSERT_TRUE(textManager != nullptr);
+    textManager->setStamp(UINT_MAX - 2);
+    Text *const text2 = new Text("2", 100, 100, Graphics::LEFT, &color);
+    Text *const text3 = new Text("3", 100, 100, Graphics::LEFT, &color);
+    EXPECT_EQ(99, text2->getY());
+    EXPECT_EQ(101, text3->getY());
+
+    // counter wrap here, texts must be placed again
+    delete text1;
+    text2->adviseXY(100, 100, true);
+    EXPECT_EQ(100, text2->getY());
+    text3->adviseXY(100, 100, true);
+    EXPECT_EQ(99, text3->getY());
+
+    delete text2;
+    delete text3;
+    EXPECT_TRUE(textManager == nullptr);
+
+    delete client;
+    client = nullptr;
+}
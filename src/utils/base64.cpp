@@ -174,6 +174,66 @@ unsigned char *php3_base64_decode(const unsigned char *restrict const string,
     return result;
 }
 
+static inline int decodeBase64Char(const unsigned char ch)
+{
+    if (ch >= 'A' && ch <= 'Z')
+        return ch - 'A';
+    if (ch >= 'a' && ch <= 'z')
+        return ch - 'a' + 26;
+    if (ch >= '0' && ch <= '9')
+        return ch - '0' + 52;
+    if (ch == '+')
+        return 62;
+    if (ch == '/')
+        return 63;
+    return -1;
+}
+
+/* decode without temporary buffers, skipping whitespace and unknown chars */
+int decodeBase64To(const char *restrict src,
+                   unsigned char *restrict const dst,
+                   const int dstSize)
+{
+    unsigned int acc = 0;
+    int n = 0;
+    int j = 0;
+
+    while (j < dstSize)
+    {
+        const unsigned char ch = static_cast<unsigned char>(*src++);
+        if (!ch || ch == base64_pad)
+            break;
+        const int val = decodeBase64Char(ch);
+        if (val < 0)
+            continue;
+        acc = (acc << 6U) | static_cast<unsigned int>(val);
+        if (++ n == 4)
+        {
+            dst[j++] = static_cast<unsigned char>(acc >> 16U);
+            if (j < dstSize)
+                dst[j++] = static_cast<unsigned char>(acc >> 8U);
+            if (j < dstSize)
+                dst[j++] = static_cast<unsigned char>(acc);
+            acc = 0;
+            n = 0;
+        }
+    }
+
+    /* tail, what not fill full group of 3 bytes */
+    if (n == 2 && j < dstSize)
+    {
+        dst[j++] = static_cast<unsigned char>(acc >> 4U);
+    }
+    else if (n == 3)
+    {
+        if (j < dstSize)
+            dst[j++] = static_cast<unsigned char>(acc >> 10U);
+        if (j < dstSize)
+            dst[j++] = static_cast<unsigned char>(acc >> 2U);
+    }
+    return j;
+}
+
 std::string encodeBase64String(std::string value)
 {
     int sz = 0;
@@ -39,6 +39,10 @@ unsigned char *php3_base64_encode(const unsigned char *restrict,
 unsigned char *php3_base64_decode(const unsigned char *restrict,
                                   int, int *restrict ) A_WARN_UNUSED;
 
+int decodeBase64To(const char *restrict src,
+                   unsigned char *restrict const dst,
+                   const int dstSize) A_WARN_UNUSED;
+
 std::string encodeBase64String(std::string value) A_WARN_UNUSED;
 
 std::string decodeBase64String(std::string value) A_WARN_UNUSED;
@@ -253,11 +253,11 @@ bool Files::existsLocal(const std::string &path)
 std::string Files::getPath(const std::string &file)
 {
     // get the real path to the file
-    const char *const tmp = PhysFs::getRealDir(file.c_str());
+    const std::string tmp = PhysFs::getRealDir(file.c_str());
     std::string path;
 
-    // if the file is not in the search path, then its nullptr
-    if (tmp)
+    // if the file is not in the search path, then its empty
+    if (!tmp.empty())
     {
         path = std::string(tmp).append(dirSeparator).append(file);
     }
@@ -0,0 +1,34 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_HASHMAP_H
+#define UTILS_HASHMAP_H
+
+// unordered map if compiler support it, or ordered map as fallback.
+// Keys must have both std::hash and operator<.
+#if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#include <unordered_map>
+#define HASHMAP std::unordered_map
+#else
+#include <map>
+#define HASHMAP std::map
+#endif
+
+#endif  // UTILS_HASHMAP_H
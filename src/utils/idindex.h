@@ -0,0 +1,132 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UTILS_IDINDEX_H
+#define UTILS_IDINDEX_H
+
+#include <vector>
+
+#include "localconsts.h"
+
+/**
+ * Flat open addressing hash table from int id to not null pointer.
+ * Used as lookup index for databases, which own objects in other
+ * containers. Only insert and clear supported.
+ */
+template<typename T>
+class IdIndex final
+{
+    public:
+        IdIndex() :
+            mKeys(),
+            mValues(),
+            mMask(0),
+            mSize(0),
+            mShift(32)
+        {
+        }
+
+        A_DELETE_COPY(IdIndex)
+
+        void clear()
+        {
+            mKeys.clear();
+            mValues.clear();
+            mMask = 0;
+            mSize = 0;
+            mShift = 32;
+        }
+
+        /**
+         * Adds value for id, or replaces old value.
+         */
+        void insert(const int id, T *const value)
+        {
+            if (!value)
+                return;
+            if ((mSize + 1) * 2 > mValues.size())
+                rehash(mValues.empty() ? 64 : mValues.size() * 2);
+            const size_t pos = findSlot(id);
+            if (!mValues[pos])
+                mSize ++;
+            mKeys[pos] = id;
+            mValues[pos] = value;
+        }
+
+        /**
+         * Returns value for id or nullptr.
+         */
+        T *find(const int id) const A_WARN_UNUSED
+        {
+            if (!mSize)
+                return nullptr;
+            return mValues[findSlot(id)];
+        }
+
+        size_t size() const A_WARN_UNUSED
+        { return mSize; }
+
+    private:
+        // multiplicative hash, high bits used as slot
+        size_t hash(const int id) const A_WARN_UNUSED
+        {
+            return static_cast<size_t>((static_cast<unsigned int>(id)
+                * 2654435761U) >> mShift);
+        }
+
+        size_t findSlot(const int id) const A_WARN_UNUSED
+        {
+            size_t pos = hash(id);
+            while (mValues[pos] && mKeys[pos] != id)
+                pos = (pos + 1) & mMask;
+            return pos;
+        }
+
+        void rehash(const size_t sz)
+        {
+            std::vector<int> keys(sz, 0);
+            std::vector<T*> values(sz, static_cast<T*>(nullptr));
+            mKeys.swap(keys);
+            mValues.swap(values);
+            mMask = sz - 1;
+            mShift = 32;
+            for (size_t f = sz; f > 1; f >>= 1)
+                mShift --;
+            const size_t oldSize = values.size();
+            for (size_t f = 0; f < oldSize; f ++)
+            {
+                if (values[f])
+                {
+                    const size_t pos = findSlot(keys[f]);
+                    mKeys[pos] = keys[f];
+                    mValues[pos] = values[f];
+                }
+            }
+        }
+
+        std::vector<int> mKeys;
+        std::vector<T*> mValues;
+        size_t mMask;
+        size_t mSize;
+        unsigned int mShift;
+};
+
+#endif  // UTILS_IDINDEX_H
@@ -0,0 +1,164 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utils/idindex.h"
+
+#include "logger.h"
+
+#include "utils/delete2.h"
+#include "utils/hashmap.h"
+#include "utils/stringutils.h"
+
+#include "gtest/gtest.h"
+
+#include <SDL_timer.h>
+
+#include <map>
+
+#include "debug.h"
+
+namespace
+{
+    struct Info final
+    {
+        int id;
+    };
+}  // namespace
+
+TEST(IdIndex, find)
+{
+    IdIndex<Info> index;
+    EXPECT_EQ(0U, index.size());
+    EXPECT_EQ(nullptr, index.find(0));
+    EXPECT_EQ(nullptr, index.find(10));
+
+    std::vector<Info> infos(1000);
+    for (int f = 0; f < 1000; f ++)
+    {
+        // tmwa items, monsters with offset and negative hair ids
+        const int id = f < 500 ? 500 + f : (f < 900 ? 1002 + f * 64 : -f);
+        infos[f].id = id;
+        index.insert(id, &infos[f]);
+    }
+    EXPECT_EQ(1000U, index.size());
+    for (int f = 0; f < 1000; f ++)
+    {
+        const Info *const info = index.find(infos[f].id);
+        ASSERT_NE(nullptr, info);
+        EXPECT_EQ(infos[f].id, info->id);
+    }
+    EXPECT_EQ(nullptr, index.find(0));
+    EXPECT_EQ(nullptr, index.find(499));
+    EXPECT_EQ(nullptr, index.find(1003));
+    EXPECT_EQ(nullptr, index.find(-1000));
+
+    // redefinition
+    Info info;
+    info.id = 500;
+    index.insert(500, &info);
+    EXPECT_EQ(1000U, index.size());
+    EXPECT_EQ(&info, index.find(500));
+
+    index.insert(12, nullptr);
+    EXPECT_EQ(1000U, index.size());
+    EXPECT_EQ(nullptr, index.find(12));
+
+    index.clear();
+    EXPECT_EQ(0U, index.size());
+    EXPECT_EQ(nullptr, index.find(500));
+}
+
+TEST(IdIndex, DISABLED_benchmark)
+{
+    logger = new Logger();
+    const int count = 5000;
+    const int lookups = 10000000;
+
+    std::vector<Info> infos(count);
+    std::map<int, Info*> infosMap;
+    IdIndex<Info> index;
+    std::map<std::string, Info*> namesMap;
+    HASHMAP<std::string, Info*> namesHash;
+    StringVect names;
+    for (int f = 0; f < count; f ++)
+    {
+        const int id = 500 + f * 3;
+        infos[f].id = id;
+        infosMap[id] = &infos[f];
+        index.insert(id, &infos[f]);
+        const std::string name = strprintf("item name %d", id);
+        names.push_back(name);
+        namesMap[name] = &infos[f];
+        namesHash[name] = &infos[f];
+    }
+
+    int64_t sum1 = 0;
+    uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < lookups; f ++)
+    {
+        const std::map<int, Info*>::const_iterator it
+            = infosMap.find(500 + (f % count) * 3);
+        if (it != infosMap.end())
+            sum1 += it->second->id;
+    }
+    logger->log("idindex: %d lookups in std::map in %d ms",
+        lookups, static_cast<int>(SDL_GetTicks() - startTime));
+
+    int64_t sum2 = 0;
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < lookups; f ++)
+    {
+        const Info *const info = index.find(500 + (f % count) * 3);
+        if (info)
+            sum2 += info->id;
+    }
+    logger->log("idindex: %d lookups in IdIndex in %d ms",
+        lookups, static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(sum1, sum2);
+
+    const int nameLookups = lookups / 10;
+    sum1 = 0;
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < nameLookups; f ++)
+    {
+        const std::map<std::string, Info*>::const_iterator it
+            = namesMap.find(names[f % count]);
+        if (it != namesMap.end())
+            sum1 += it->second->id;
+    }
+    logger->log("idindex: %d name lookups in std::map in %d ms",
+        nameLookups, static_cast<int>(SDL_GetTicks() - startTime));
+
+    sum2 = 0;
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < nameLookups; f ++)
+    {
+        const HASHMAP<std::string, Info*>::const_iterator it
+            = namesHash.find(names[f % count]);
+        if (it != namesHash.end())
+            sum2 += it->second->id;
+    }
+    logger->log("idindex: %d name lookups in hash map in %d ms",
+        nameLookups, static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(sum1, sum2);
+
+    delete2(logger);
+}
@@ -0,0 +1,917 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/physfsindex.h"
+
+#ifndef WIN32
+
+#include "logger.h"
+
+#include "utils/hashmap.h"
+#include "utils/mutex.h"
+#include "utils/physfstools.h"
+#include "utils/timer.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#endif  // WIN32
+
+#include "debug.h"
+
+#ifndef WIN32
+
+namespace
+{
+    enum
+    {
+        METHOD_STORED = 0,
+        METHOD_DEFLATED = 8,
+        METHOD_DIRECTORY = 0xfffe,
+        METHOD_UNSUPPORTED = 0xffff
+    };
+
+    const uint32_t CACHE_MAGIC = 0x4d504649U;
+    const uint32_t CACHE_VERSION = 2U;
+
+    struct ZipEntry final
+    {
+        ZipEntry() :
+            name(),
+            offset(0U),
+            compressedSize(0U),
+            size(0U),
+            method(METHOD_UNSUPPORTED)
+        { }
+
+        std::string name;
+        uint32_t offset;
+        uint32_t compressedSize;
+        uint32_t size;
+        uint16_t method;
+    };
+
+    struct ZipArchive final
+    {
+        ZipArchive() :
+            path(),
+            entries(),
+            mtime(0),
+            size(0),
+            inode(0),
+            data(nullptr)
+        { }
+
+        A_DELETE_COPY(ZipArchive)
+
+        std::string path;
+        std::vector<ZipEntry> entries;
+        // modification time in nanoseconds
+        int64_t mtime;
+        int64_t size;
+        uint64_t inode;
+        const uint8_t *data;
+    };
+
+    struct IndexEntry final
+    {
+        IndexEntry(const ZipArchive *const archive0,
+                   const int position0,
+                   const int entry0) :
+            archive(archive0),
+            position(position0),
+            entry(entry0)
+        { }
+
+        const ZipArchive *archive;
+        int position;
+        // index in archive entries or -1 for implicit directory
+        int entry;
+    };
+
+    typedef std::map<std::string, ZipArchive*> Archives;
+    typedef Archives::iterator ArchivesIter;
+    typedef HASHMAP<std::string, IndexEntry> Index;
+    typedef Index::const_iterator IndexCIter;
+    typedef std::vector<std::pair<int, std::string> > Dirs;
+    // name to index in searchDirs, or DIR_NONE / DIR_LINK
+    typedef HASHMAP<std::string, int> DirLookups;
+    typedef DirLookups::const_iterator DirLookupsCIter;
+
+    enum
+    {
+        DIR_NONE = -1,
+        DIR_LINK = -2
+    };
+
+    enum Resolve
+    {
+        NOT_HANDLED = 0,
+        NOT_FOUND,
+        IN_DIR,
+        IN_ARCHIVE
+    };
+}  // namespace
+
+// archives in current search path
+static Archives openArchives;
+// archives loaded from cache file and not yet used
+static Archives cachedArchives;
+// archives changed or removed from search path. Kept mapped because
+// open SDL_RWops can still read from them.
+static std::vector<ZipArchive*> retiredArchives;
+static Index fileIndex;
+static Dirs searchDirs;
+// cached results of search dirs lookups, cleared when dirs changed
+static DirLookups dirLookups;
+static std::string cacheFileName;
+// protect index, used from loader threads too
+static Mutex indexMutex;
+static bool indexValid = false;
+static bool indexEnabled = false;
+static bool cacheLoaded = false;
+
+static uint16_t readU16(const uint8_t *const ptr)
+{
+    return static_cast<uint16_t>(ptr[0] | (ptr[1] << 8));
+}
+
+static uint32_t readU32(const uint8_t *const ptr)
+{
+    return static_cast<uint32_t>(ptr[0])
+        | (static_cast<uint32_t>(ptr[1]) << 8)
+        | (static_cast<uint32_t>(ptr[2]) << 16)
+        | (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+static int64_t getMtime(const struct stat &st)
+{
+#ifdef __APPLE__
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL
+        + st.st_mtimespec.tv_nsec;
+#else  // __APPLE__
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL
+        + st.st_mtim.tv_nsec;
+#endif  // __APPLE__
+}
+
+static bool isSameFile(const ZipArchive *const archive,
+                       const struct stat &st)
+{
+    return archive->mtime == getMtime(st)
+        && archive->size == static_cast<int64_t>(st.st_size)
+        && archive->inode == static_cast<uint64_t>(st.st_ino);
+}
+
+// Archive replaced or rewritten after cache file was saved.
+static bool isChanged(const ZipArchive *const archive)
+{
+    struct stat st;
+    return stat(archive->path.c_str(), &st) || !isSameFile(archive, st);
+}
+
+static bool mapArchive(ZipArchive *const archive)
+{
+    if (archive->data)
+        return true;
+    if (archive->size <= 0)
+        return false;
+
+    const int fd = open(archive->path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    void *const ptr = mmap(nullptr, static_cast<size_t>(archive->size),
+        PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return false;
+    archive->data = static_cast<const uint8_t*>(ptr);
+    return true;
+}
+
+static void deleteArchive(ZipArchive *const archive)
+{
+    if (archive->data)
+    {
+        munmap(const_cast<uint8_t*>(archive->data),
+            static_cast<size_t>(archive->size));
+    }
+    delete archive;
+}
+
+static bool parseArchive(ZipArchive *const archive)
+{
+    if (archive->size < 22 || !mapArchive(archive))
+        return false;
+
+    const uint8_t *const data = archive->data;
+    const size_t size = static_cast<size_t>(archive->size);
+
+    // end of central directory record is last 22 bytes plus comment
+    size_t pos = size - 22;
+    const size_t minPos = pos > 65535 ? pos - 65535 : 0;
+    while (readU32(data + pos) != 0x06054b50U)
+    {
+        if (pos == minPos)
+            return false;
+        pos --;
+    }
+
+    const uint8_t *const eocd = data + pos;
+    // multi disk archives not supported
+    if (readU16(eocd + 4) || readU16(eocd + 6))
+        return false;
+    const unsigned int count = readU16(eocd + 10);
+    const uint32_t cdSize = readU32(eocd + 12);
+    const uint32_t cdOffset = readU32(eocd + 16);
+    // zip64 archives not supported
+    if (count == 0xffffU || cdOffset == 0xffffffffU)
+        return false;
+    if (cdSize > pos || cdOffset > pos - cdSize)
+        return false;
+
+    // archives can have data before first entry (self extracting)
+    const size_t dataStart = pos - cdSize - cdOffset;
+    const uint8_t *ptr = data + pos - cdSize;
+    const uint8_t *const end = data + pos;
+
+    std::vector<ZipEntry> &entries = archive->entries;
+    entries.clear();
+    entries.reserve(count);
+    for (unsigned int f = 0; f < count; f ++)
+    {
+        if (ptr + 46 > end || readU32(ptr) != 0x02014b50U)
+            return false;
+
+        const unsigned int flags = readU16(ptr + 8);
+        const unsigned int nameLen = readU16(ptr + 28);
+        const unsigned int extraLen = readU16(ptr + 30);
+        const unsigned int commentLen = readU16(ptr + 32);
+        if (ptr + 46 + nameLen > end)
+            return false;
+
+        ZipEntry entry;
+        entry.name.assign(reinterpret_cast<const char*>(ptr + 46), nameLen);
+        entry.method = readU16(ptr + 10);
+        entry.compressedSize = readU32(ptr + 20);
+        entry.size = readU32(ptr + 24);
+        entry.offset = static_cast<uint32_t>(dataStart + readU32(ptr + 42));
+
+        const size_t sz = entry.name.size();
+        if (sz && entry.name[sz - 1] == '/')
+        {
+            entry.name.resize(sz - 1);
+            entry.method = METHOD_DIRECTORY;
+        }
+        else if ((flags & 1U)
+                 || (entry.method != METHOD_STORED
+                 && entry.method != METHOD_DEFLATED)
+                 || entry.compressedSize == 0xffffffffU
+                 || entry.size == 0xffffffffU)
+        {
+            // encrypted, zip64 or unknown compression, PhysFS will read it
+            entry.method = METHOD_UNSUPPORTED;
+        }
+
+        if (!entry.name.empty())
+            entries.push_back(entry);
+        ptr += 46 + nameLen + extraLen + commentLen;
+    }
+    return true;
+}
+
+static bool readCacheData(FILE *const file, void *const data,
+                          const size_t size)
+{
+    return fread(data, 1, size, file) == size;
+}
+
+static bool readCacheString(FILE *const file, std::string &str)
+{
+    uint32_t len = 0;
+    if (!readCacheData(file, &len, sizeof(len)) || len > 65535)
+        return false;
+    str.resize(len);
+    return !len || readCacheData(file, &str[0], len);
+}
+
+static void loadCache()
+{
+    cacheLoaded = true;
+    if (cacheFileName.empty())
+        return;
+    FILE *const file = fopen(cacheFileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    uint32_t header[3];
+    bool ok = readCacheData(file, header, sizeof(header))
+        && header[0] == CACHE_MAGIC && header[1] == CACHE_VERSION;
+    const uint32_t archivesCount = ok ? header[2] : 0;
+    for (uint32_t f = 0; ok && f < archivesCount; f ++)
+    {
+        ZipArchive *const archive = new ZipArchive;
+        uint32_t count = 0;
+        ok = readCacheString(file, archive->path)
+            && readCacheData(file, &archive->mtime, sizeof(archive->mtime))
+            && readCacheData(file, &archive->size, sizeof(archive->size))
+            && readCacheData(file, &archive->inode, sizeof(archive->inode))
+            && readCacheData(file, &count, sizeof(count));
+        if (ok)
+            archive->entries.resize(count);
+        for (uint32_t i = 0; ok && i < count; i ++)
+        {
+            ZipEntry &entry = archive->entries[i];
+            ok = readCacheString(file, entry.name)
+                && readCacheData(file, &entry.offset, sizeof(entry.offset))
+                && readCacheData(file, &entry.compressedSize,
+                sizeof(entry.compressedSize))
+                && readCacheData(file, &entry.size, sizeof(entry.size))
+                && readCacheData(file, &entry.method, sizeof(entry.method));
+        }
+        if (ok && cachedArchives.find(archive->path)
+            == cachedArchives.end())
+        {
+            cachedArchives[archive->path] = archive;
+        }
+        else
+        {
+            delete archive;
+        }
+    }
+    fclose(file);
+
+    if (!ok)
+    {
+        logger->log("Virtual file index: broken cache file %s",
+            cacheFileName.c_str());
+        FOR_EACH (ArchivesIter, it, cachedArchives)
+            deleteArchive((*it).second);
+        cachedArchives.clear();
+    }
+}
+
+static void writeCacheString(FILE *const file, const std::string &str)
+{
+    const uint32_t len = static_cast<uint32_t>(str.size());
+    fwrite(&len, sizeof(len), 1, file);
+    fwrite(str.c_str(), 1, len, file);
+}
+
+static void writeCacheArchive(FILE *const file,
+                              const ZipArchive *const archive)
+{
+    writeCacheString(file, archive->path);
+    fwrite(&archive->mtime, sizeof(archive->mtime), 1, file);
+    fwrite(&archive->size, sizeof(archive->size), 1, file);
+    fwrite(&archive->inode, sizeof(archive->inode), 1, file);
+    const uint32_t count = static_cast<uint32_t>(archive->entries.size());
+    fwrite(&count, sizeof(count), 1, file);
+    FOR_EACH (std::vector<ZipEntry>::const_iterator, it, archive->entries)
+    {
+        const ZipEntry &entry = *it;
+        writeCacheString(file, entry.name);
+        fwrite(&entry.offset, sizeof(entry.offset), 1, file);
+        fwrite(&entry.compressedSize, sizeof(entry.compressedSize), 1, file);
+        fwrite(&entry.size, sizeof(entry.size), 1, file);
+        fwrite(&entry.method, sizeof(entry.method), 1, file);
+    }
+}
+
+static void saveCache()
+{
+    if (cacheFileName.empty())
+        return;
+
+    // drop cached archives what was deleted or changed on disk
+    for (ArchivesIter it = cachedArchives.begin();
+         it != cachedArchives.end(); )
+    {
+        if (isChanged((*it).second))
+        {
+            deleteArchive((*it).second);
+            cachedArchives.erase(it++);
+        }
+        else
+        {
+            ++ it;
+        }
+    }
+
+    const std::string tempName = cacheFileName + ".tmp";
+    FILE *const file = fopen(tempName.c_str(), "wb");
+    if (!file)
+        return;
+
+    const uint32_t header[3] =
+    {
+        CACHE_MAGIC,
+        CACHE_VERSION,
+        static_cast<uint32_t>(openArchives.size() + cachedArchives.size())
+    };
+    fwrite(header, sizeof(header), 1, file);
+    FOR_EACH (ArchivesIter, it, openArchives)
+        writeCacheArchive(file, (*it).second);
+    FOR_EACH (ArchivesIter, it, cachedArchives)
+        writeCacheArchive(file, (*it).second);
+    const bool failed = ferror(file) != 0;
+    fclose(file);
+
+    if (failed || rename(tempName.c_str(), cacheFileName.c_str()))
+        remove(tempName.c_str());
+}
+
+static void addArchive(const ZipArchive *const archive, const int position)
+{
+    const int count = static_cast<int>(archive->entries.size());
+    for (int f = 0; f < count; f ++)
+    {
+        const std::string &name = archive->entries[f].name;
+        // first archive in search path wins
+        if (!fileIndex.insert(std::pair<std::string, IndexEntry>(
+            name, IndexEntry(archive, position, f))).second)
+        {
+            continue;
+        }
+
+        // parent directories may not have own entries in archive
+        size_t pos = name.rfind('/');
+        while (pos != std::string::npos && pos > 0)
+        {
+            if (!fileIndex.insert(std::pair<std::string, IndexEntry>(
+                name.substr(0, pos), IndexEntry(archive, position, -1))).second)
+            {
+                break;
+            }
+            pos = name.rfind('/', pos - 1);
+        }
+    }
+}
+
+static ZipArchive *getArchive(const char *const path,
+                              const struct stat &st,
+                              bool &parsed)
+{
+    parsed = false;
+
+    ArchivesIter it = openArchives.find(path);
+    if (it != openArchives.end())
+    {
+        ZipArchive *const archive = (*it).second;
+        if (isSameFile(archive, st))
+            return archive;
+        retiredArchives.push_back(archive);
+        openArchives.erase(it);
+    }
+
+    it = cachedArchives.find(path);
+    if (it != cachedArchives.end())
+    {
+        ZipArchive *const archive = (*it).second;
+        cachedArchives.erase(it);
+        if (isSameFile(archive, st))
+        {
+            openArchives[path] = archive;
+            return archive;
+        }
+        deleteArchive(archive);
+    }
+
+    ZipArchive *const archive = new ZipArchive;
+    archive->path = path;
+    archive->mtime = getMtime(st);
+    archive->size = static_cast<int64_t>(st.st_size);
+    archive->inode = static_cast<uint64_t>(st.st_ino);
+    if (!parseArchive(archive))
+    {
+        deleteArchive(archive);
+        return nullptr;
+    }
+    parsed = true;
+    openArchives[path] = archive;
+    return archive;
+}
+
+static bool buildIndex()
+{
+    const unsigned int startTime = get_time_usec();
+    if (!cacheLoaded)
+        loadCache();
+
+    fileIndex.clear();
+    searchDirs.clear();
+    dirLookups.clear();
+
+    std::set<std::string> used;
+    unsigned int parsedCount = 0;
+    bool ok = true;
+    char **const list = PHYSFS_getSearchPath();
+    if (!list)
+        return false;
+
+    int position = 0;
+    for (char **i = list; *i; i ++, position ++)
+    {
+        struct stat st;
+        if (stat(*i, &st))
+        {
+            ok = false;
+            break;
+        }
+        if (S_ISDIR(st.st_mode))
+        {
+            searchDirs.push_back(std::pair<int, std::string>(position, *i));
+            continue;
+        }
+
+        bool parsed = false;
+        const ZipArchive *const archive = getArchive(*i, st, parsed);
+        if (!archive)
+        {
+            logger->log("Virtual file index: unsupported archive %s", *i);
+            ok = false;
+            break;
+        }
+        if (parsed)
+            parsedCount ++;
+        used.insert(*i);
+        addArchive(archive, position);
+    }
+    PhysFs::freeList(list);
+
+    // archives removed from search path
+    for (ArchivesIter it = openArchives.begin(); it != openArchives.end(); )
+    {
+        if (used.find((*it).first) == used.end())
+        {
+            retiredArchives.push_back((*it).second);
+            openArchives.erase(it++);
+        }
+        else
+        {
+            ++ it;
+        }
+    }
+
+    if (!ok)
+    {
+        fileIndex.clear();
+        searchDirs.clear();
+        logger->log1("Virtual file index disabled");
+        return false;
+    }
+
+    if (parsedCount)
+        saveCache();
+
+    logger->log("Virtual file index: %u files in %u archives "
+        "(%u parsed, %u from cache), %u dirs, built in %u us",
+        static_cast<unsigned int>(fileIndex.size()),
+        static_cast<unsigned int>(used.size()),
+        parsedCount,
+        static_cast<unsigned int>(used.size()) - parsedCount,
+        static_cast<unsigned int>(searchDirs.size()),
+        get_time_usec() - startTime);
+    return true;
+}
+
+static bool normalizeName(const char *fileName, std::string &name)
+{
+    if (!fileName)
+        return false;
+    while (*fileName == '/')
+        fileName ++;
+
+    name.clear();
+    const char *segment = fileName;
+    for (const char *ptr = fileName; ; ptr ++)
+    {
+        const char c = *ptr;
+        if (c == '/' || c == 0)
+        {
+            const size_t len = static_cast<size_t>(ptr - segment);
+            // PhysFS rejects relative segments itself
+            if ((len == 1 && segment[0] == '.')
+                || (len == 2 && segment[0] == '.' && segment[1] == '.'))
+            {
+                return false;
+            }
+            if (len)
+            {
+                if (!name.empty())
+                    name.append("/");
+                name.append(segment, len);
+            }
+            if (c == 0)
+                break;
+            segment = ptr + 1;
+        }
+        else if (c == '\\' || c == ':')
+        {
+            return false;
+        }
+    }
+    return !name.empty();
+}
+
+// Finds first search dir before archive position what have file.
+// Result cached until index rebuilt or dirs changed.
+static int findInDirs(const std::string &name, const int position)
+{
+    const DirLookupsCIter it = dirLookups.find(name);
+    if (it != dirLookups.end())
+        return (*it).second;
+
+    int found = DIR_NONE;
+    const int sz = static_cast<int>(searchDirs.size());
+    for (int f = 0; f < sz; f ++)
+    {
+        const std::pair<int, std::string> &dir = searchDirs[f];
+        if (dir.first > position)
+            break;
+        const std::string path = std::string(dir.second).append(
+            dirSeparator).append(name);
+        struct stat st;
+        if (!lstat(path.c_str(), &st))
+        {
+            // symbolic links policy handled by PhysFS
+            found = S_ISLNK(st.st_mode) ? DIR_LINK : f;
+            break;
+        }
+    }
+    dirLookups[name] = found;
+    return found;
+}
+
+static Resolve resolve(const char *const fileName,
+                       const IndexEntry *&entry,
+                       const char *&realDir)
+{
+    if (!indexValid)
+    {
+        indexEnabled = buildIndex();
+        indexValid = true;
+    }
+    if (!indexEnabled)
+        return NOT_HANDLED;
+
+    std::string name;
+    if (!normalizeName(fileName, name))
+        return NOT_HANDLED;
+
+    const IndexCIter it = fileIndex.find(name);
+    const bool found = it != fileIndex.end();
+
+    // directories what placed in search path before archive
+    if (!searchDirs.empty())
+    {
+        const int dir = findInDirs(name, found
+            ? (*it).second.position : searchDirs.back().first);
+        if (dir == DIR_LINK)
+            return NOT_HANDLED;
+        if (dir != DIR_NONE)
+        {
+            realDir = searchDirs[dir].second.c_str();
+            return IN_DIR;
+        }
+    }
+
+    if (!found)
+    {
+        realDir = nullptr;
+        return NOT_FOUND;
+    }
+    // archives validated on index build. Updates replace archives by
+    // rename, so old mapping stay valid until search path changed.
+    entry = &(*it).second;
+    realDir = entry->archive->path.c_str();
+    return IN_ARCHIVE;
+}
+
+static const uint8_t *getEntryData(const IndexEntry *const indexEntry,
+                                   const ZipEntry *&entry)
+{
+    if (indexEntry->entry < 0)
+        return nullptr;
+    ZipArchive *const archive = const_cast<ZipArchive*>(
+        indexEntry->archive);
+    entry = &archive->entries[indexEntry->entry];
+    if ((entry->method != METHOD_STORED && entry->method != METHOD_DEFLATED)
+        || !mapArchive(archive))
+    {
+        return nullptr;
+    }
+
+    const uint8_t *const data = archive->data;
+    const size_t size = static_cast<size_t>(archive->size);
+    const size_t offset = entry->offset;
+    if (offset + 30 > size || readU32(data + offset) != 0x04034b50U)
+        return nullptr;
+    const size_t start = offset + 30 + readU16(data + offset + 26)
+        + readU16(data + offset + 28);
+    if (start + entry->compressedSize > size)
+        return nullptr;
+    return data + start;
+}
+
+#endif  // WIN32
+
+namespace PhysFsIndex
+{
+#ifndef WIN32
+    void invalidate()
+    {
+        MutexLocker lock(&indexMutex);
+        indexValid = false;
+    }
+
+    void dirsChanged()
+    {
+        MutexLocker lock(&indexMutex);
+        dirLookups.clear();
+    }
+
+    void clear()
+    {
+        MutexLocker lock(&indexMutex);
+        fileIndex.clear();
+        searchDirs.clear();
+        dirLookups.clear();
+        FOR_EACH (ArchivesIter, it, openArchives)
+            deleteArchive((*it).second);
+        openArchives.clear();
+        FOR_EACH (ArchivesIter, it, cachedArchives)
+            deleteArchive((*it).second);
+        cachedArchives.clear();
+        FOR_EACH (std::vector<ZipArchive*>::iterator, it, retiredArchives)
+            deleteArchive(*it);
+        retiredArchives.clear();
+        indexValid = false;
+        cacheLoaded = false;
+    }
+
+    void setCacheFile(const std::string &fileName)
+    {
+        MutexLocker lock(&indexMutex);
+        cacheFileName = fileName;
+        cacheLoaded = false;
+        indexValid = false;
+    }
+
+    bool getRealDir(const char *const fileName,
+                    std::string &realDir)
+    {
+        const IndexEntry *entry = nullptr;
+        const char *dir = nullptr;
+        MutexLocker lock(&indexMutex);
+        if (resolve(fileName, entry, dir) == NOT_HANDLED)
+            return false;
+        // copy, because index can be rebuilt from other thread
+        if (dir)
+            realDir = dir;
+        else
+            realDir.clear();
+        return true;
+    }
+
+    bool loadFile(const char *const fileName,
+                  void *&buffer,
+                  int &fileSize,
+                  std::string &realDir)
+    {
+        const IndexEntry *indexEntry = nullptr;
+        const char *dir = nullptr;
+        const ZipEntry *entry = nullptr;
+        const uint8_t *data = nullptr;
+        {
+            MutexLocker lock(&indexMutex);
+            if (resolve(fileName, indexEntry, dir) != IN_ARCHIVE)
+                return false;
+            // mapped data stay valid until exit
+            data = getEntryData(indexEntry, entry);
+            realDir = dir;
+        }
+        if (!data || !entry->size)
+            return false;
+
+        uint8_t *const buf = static_cast<uint8_t*>(calloc(entry->size, 1));
+        if (!buf)
+            return false;
+
+        if (entry->method == METHOD_STORED)
+        {
+            memcpy(buf, data, entry->size);
+        }
+        else
+        {
+            z_stream strm;
+            memset(&strm, 0, sizeof(strm));
+            strm.next_in = const_cast<Bytef*>(data);
+            strm.avail_in = entry->compressedSize;
+            strm.next_out = buf;
+            strm.avail_out = entry->size;
+            // raw deflate stream without zlib header
+            if (inflateInit2(&strm, -MAX_WBITS) != Z_OK)
+            {
+                free(buf);
+                return false;
+            }
+            const int ret = inflate(&strm, Z_FINISH);
+            inflateEnd(&strm);
+            if (ret != Z_STREAM_END || strm.total_out != entry->size)
+            {
+                free(buf);
+                return false;
+            }
+        }
+
+        buffer = buf;
+        fileSize = static_cast<int>(entry->size);
+        return true;
+    }
+
+    bool mapFile(const char *const fileName,
+                 const void *&data,
+                 int &fileSize)
+    {
+        const IndexEntry *indexEntry = nullptr;
+        const char *realDir = nullptr;
+        MutexLocker lock(&indexMutex);
+        if (resolve(fileName, indexEntry, realDir) != IN_ARCHIVE)
+            return false;
+
+        const ZipEntry *entry = nullptr;
+        const uint8_t *const ptr = getEntryData(indexEntry, entry);
+        if (!ptr || entry->method != METHOD_STORED)
+            return false;
+        data = ptr;
+        fileSize = static_cast<int>(entry->size);
+        return true;
+    }
+#else  // WIN32
+
+    void invalidate()
+    {
+    }
+
+    void dirsChanged()
+    {
+    }
+
+    void clear()
+    {
+    }
+
+    void setCacheFile(const std::string &fileName A_UNUSED)
+    {
+    }
+
+    bool getRealDir(const char *const fileName A_UNUSED,
+                    std::string &realDir A_UNUSED)
+    {
+        return false;
+    }
+
+    bool loadFile(const char *const fileName A_UNUSED,
+                  void *&buffer A_UNUSED,
+                  int &fileSize A_UNUSED,
+                  std::string &realDir A_UNUSED)
+    {
+        return false;
+    }
+
+    bool mapFile(const char *const fileName A_UNUSED,
+                 const void *&data A_UNUSED,
+                 int &fileSize A_UNUSED)
+    {
+        return false;
+    }
+#endif  // WIN32
+}  // namespace PhysFsIndex
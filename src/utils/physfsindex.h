@@ -0,0 +1,88 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_PHYSFSINDEX_H
+#define UTILS_PHYSFSINDEX_H
+
+#include <string>
+
+#include "localconsts.h"
+
+/**
+ * Hashed index of files inside zip archives from PhysFS search path.
+ *
+ * Index resolve virtual path to archive entry without asking every
+ * archive in search path. Archives are memory mapped, stored entries can
+ * be read without copying. Parsed archive directories are saved to cache
+ * file and reused while archive mtime, size and inode not changed.
+ * Archives checked only when index built. Archive must be replaced by
+ * rename, not rewritten in place, while it in search path.
+ * Lookups in search path directories cached until dirsChanged() or
+ * invalidate() called.
+ *
+ * All functions return false if index can't answer and caller must use
+ * PhysFS. Can be used from any thread.
+ */
+namespace PhysFsIndex
+{
+    /**
+     * Mark index as outdated. Called after search path changes.
+     */
+    void invalidate();
+
+    /**
+     * Forget cached lookups in search path directories. Called after
+     * files written.
+     */
+    void dirsChanged();
+
+    /**
+     * Unmap all archives and drop index.
+     */
+    void clear();
+
+    void setCacheFile(const std::string &fileName);
+
+    /**
+     * Finds real directory or archive for virtual file.
+     * realDir set to empty string if file not exists.
+     */
+    bool getRealDir(const char *const fileName,
+                    std::string &realDir) A_WARN_UNUSED;
+
+    /**
+     * Loads file stored in archive. Buffer must be freed by free().
+     * realDir set to archive path.
+     */
+    bool loadFile(const char *const fileName,
+                  void *&buffer,
+                  int &fileSize,
+                  std::string &realDir) A_WARN_UNUSED;
+
+    /**
+     * Returns pointer to uncompressed archive entry inside mapped archive.
+     * Pointer valid until search path changed.
+     */
+    bool mapFile(const char *const fileName,
+                 const void *&data,
+                 int &fileSize) A_WARN_UNUSED;
+}  // namespace PhysFsIndex
+
+#endif  // UTILS_PHYSFSINDEX_H
@@ -0,0 +1,204 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/physfsindex.h"
+
+#include "logger.h"
+
+#include "utils/physfstools.h"
+#include "utils/stringutils.h"
+
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#include <SDL_timer.h>
+
+#include "debug.h"
+
+namespace
+{
+    void writeU16(std::string &buf, const unsigned int val)
+    {
+        buf.push_back(static_cast<char>(val & 0xffU));
+        buf.push_back(static_cast<char>((val >> 8) & 0xffU));
+    }
+
+    void writeU32(std::string &buf, const unsigned int val)
+    {
+        writeU16(buf, val & 0xffffU);
+        writeU16(buf, (val >> 16) & 0xffffU);
+    }
+
+    // zip archive with stored entries "dir/file<N>.txt"
+    void createArchive(const std::string &fileName, const int count)
+    {
+        std::string data;
+        std::string dir;
+        for (int f = 0; f < count; f ++)
+        {
+            const std::string name = strprintf("dir/file%d.txt", f);
+            const std::string text = strprintf("content %d", f);
+            const unsigned int crc = static_cast<unsigned int>(crc32(0,
+                reinterpret_cast<const Bytef*>(text.c_str()),
+                static_cast<uInt>(text.size())));
+            const unsigned int offset = static_cast<unsigned int>(
+                data.size());
+            const unsigned int nameLen = static_cast<unsigned int>(
+                name.size());
+            const unsigned int textLen = static_cast<unsigned int>(
+                text.size());
+
+            writeU32(data, 0x04034b50U);
+            writeU16(data, 10);  // version
+            writeU16(data, 0);  // flags
+            writeU16(data, 0);  // stored
+            writeU32(data, 0);  // time and date
+            writeU32(data, crc);
+            writeU32(data, textLen);
+            writeU32(data, textLen);
+            writeU16(data, nameLen);
+            writeU16(data, 0);  // extra
+            data.append(name).append(text);
+
+            writeU32(dir, 0x02014b50U);
+            writeU16(dir, 10);  // version made by
+            writeU16(dir, 10);  // version
+            writeU16(dir, 0);  // flags
+            writeU16(dir, 0);  // stored
+            writeU32(dir, 0);  // time and date
+            writeU32(dir, crc);
+            writeU32(dir, textLen);
+            writeU32(dir, textLen);
+            writeU16(dir, nameLen);
+            writeU16(dir, 0);  // extra
+            writeU16(dir, 0);  // comment
+            writeU16(dir, 0);  // disk
+            writeU16(dir, 0);  // internal attributes
+            writeU32(dir, 0);  // external attributes
+            writeU32(dir, offset);
+            dir.append(name);
+        }
+
+        const unsigned int dirOffset = static_cast<unsigned int>(data.size());
+        data.append(dir);
+        writeU32(data, 0x06054b50U);
+        writeU16(data, 0);  // disk
+        writeU16(data, 0);  // disk with central directory
+        writeU16(data, static_cast<unsigned int>(count));
+        writeU16(data, static_cast<unsigned int>(count));
+        writeU32(data, static_cast<unsigned int>(dir.size()));
+        writeU32(data, dirOffset);
+        writeU16(data, 0);  // comment
+
+        FILE *const file = fopen(fileName.c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        fwrite(data.c_str(), 1, data.size(), file);
+        fclose(file);
+    }
+
+    void init(const std::string &archive, const int count)
+    {
+        PHYSFS_init("manaplus");
+        dirSeparator = "/";
+        if (!logger)
+            logger = new Logger();
+        createArchive(archive, count);
+        PhysFs::addToSearchPath("data", 1);
+        PhysFs::addToSearchPath(archive.c_str(), 1);
+    }
+}  // namespace
+
+TEST(PhysFsIndex, lookup)
+{
+    const std::string archive = "physfsindex.zip";
+    init(archive, 100);
+
+    const char *const realPath = PHYSFS_getRealDir("dir/file10.txt");
+    ASSERT_NE(nullptr, realPath);
+    EXPECT_TRUE(PhysFs::exists("dir/file10.txt"));
+    EXPECT_TRUE(PhysFs::exists("dir"));
+    EXPECT_EQ(std::string(realPath), PhysFs::getRealDir("dir/file10.txt"));
+    EXPECT_FALSE(PhysFs::exists("dir/file100.txt"));
+    EXPECT_TRUE(PhysFs::getRealDir("dir/file100.txt").empty());
+    EXPECT_EQ(nullptr, PhysFs::openRead("dir/file100.txt"));
+
+    int size = 0;
+    char *const buf = static_cast<char*>(
+        PhysFs::loadFile("dir/file42.txt", size));
+    ASSERT_NE(nullptr, buf);
+    EXPECT_EQ(10, size);
+    EXPECT_EQ(0, memcmp(buf, "content 42", 10));
+    free(buf);
+
+    PHYSFS_file *const file = PhysFs::openRead("dir/file7.txt");
+    ASSERT_NE(nullptr, file);
+    EXPECT_EQ(9, PHYSFS_fileLength(file));
+    PHYSFS_close(file);
+
+    PhysFs::removeFromSearchPath(archive.c_str());
+    PhysFs::removeFromSearchPath("data");
+    EXPECT_FALSE(PhysFs::exists("dir/file10.txt"));
+    ::remove(archive.c_str());
+}
+
+TEST(PhysFsIndex, DISABLED_benchmark)
+{
+    const std::string archive = "physfsindex.zip";
+    const int count = 20000;
+    const int lookups = 1000000;
+    init(archive, count);
+
+    StringVect names;
+    for (int f = 0; f < count; f ++)
+    {
+        names.push_back(strprintf("dir/file%d.txt", f));
+        names.push_back(strprintf("dir/missing%d.txt", f));
+    }
+    const int namesSize = static_cast<int>(names.size());
+
+    int found1 = 0;
+    uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < lookups; f ++)
+    {
+        if (PHYSFS_exists(names[f % namesSize].c_str()))
+            found1 ++;
+    }
+    logger->log("physfsindex: %d lookups in PhysFS in %d ms",
+        lookups, static_cast<int>(SDL_GetTicks() - startTime));
+
+    int found2 = 0;
+    startTime = SDL_GetTicks();
+    for (int f = 0; f < lookups; f ++)
+    {
+        if (PhysFs::exists(names[f % namesSize].c_str()))
+            found2 ++;
+    }
+    logger->log("physfsindex: %d lookups in index in %d ms",
+        lookups, static_cast<int>(SDL_GetTicks() - startTime));
+    EXPECT_EQ(found1, found2);
+    EXPECT_EQ(lookups / 2, found2);
+
+    PhysFs::removeFromSearchPath(archive.c_str());
+    PhysFs::removeFromSearchPath("data");
+    ::remove(archive.c_str());
+}
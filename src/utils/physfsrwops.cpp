@@ -28,6 +28,7 @@
 
 #include "utils/fuzzer.h"
 #include "utils/physfscheckutils.h"
+#include "utils/physfsindex.h"
 
 #include "debug.h"
 
@@ -242,6 +243,14 @@ SDL_RWops *PHYSFSRWOPS_openRead(const char *const fname)
     if (Fuzzer::conditionTerminate(fname))
         return nullptr;
 #endif
+    // stored archive entries read directly from mapped archive
+    const void *data = nullptr;
+    int size = 0;
+    if (PhysFsIndex::mapFile(fname, data, size))
+    {
+        BLOCK_END("PHYSFSRWOPS_openRead")
+        return SDL_RWFromConstMem(data, size);
+    }
 #ifdef USE_PROFILER
     SDL_RWops *const ret = create_rwops(PhysFs::openRead(fname));
     BLOCK_END("PHYSFSRWOPS_openRead")
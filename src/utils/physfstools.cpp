@@ -22,6 +22,8 @@
 
 #include "logger.h"
 
+#include "utils/physfsindex.h"
+
 #include <iostream>
 #include <unistd.h>
 
@@ -55,6 +57,7 @@ namespace PhysFs
         }
         updateDirSeparator();
         atexit((void(*)()) PHYSFS_deinit);
+        atexit(PhysFsIndex::clear);
     }
 
     void updateDirSeparator()
@@ -79,6 +82,9 @@ namespace PhysFs
 
     bool exists(const char *const fname)
     {
+        std::string realDir;
+        if (PhysFsIndex::getRealDir(fname, realDir))
+            return !realDir.empty();
         return PHYSFS_exists(fname);
     }
 
@@ -99,17 +105,25 @@ namespace PhysFs
 
     PHYSFS_file *openRead(const char *const filename)
     {
+        // missing files not searched in every archive again
+        std::string realDir;
+        if (PhysFsIndex::getRealDir(filename, realDir) && realDir.empty())
+            return nullptr;
         return PHYSFS_openRead(filename);
     }
 
     PHYSFS_file *openWrite(const char *const filename)
     {
-        return PHYSFS_openWrite(filename);
+        PHYSFS_file *const file = PHYSFS_openWrite(filename);
+        PhysFsIndex::dirsChanged();
+        return file;
     }
 
     PHYSFS_file *openAppend(const char *const filename)
     {
-        return PHYSFS_openAppend(filename);
+        PHYSFS_file *const file = PHYSFS_openAppend(filename);
+        PhysFsIndex::dirsChanged();
+        return file;
     }
 
     bool setWriteDir(const char *const newDir)
@@ -119,26 +133,45 @@ namespace PhysFs
 
     bool addToSearchPath(const char *const newDir, const int appendToPath)
     {
+        PhysFsIndex::invalidate();
         return PHYSFS_addToSearchPath(newDir, appendToPath);
     }
 
     bool removeFromSearchPath(const char *const oldDir)
     {
+        PhysFsIndex::invalidate();
         return PHYSFS_removeFromSearchPath(oldDir);
     }
 
-    const char *getRealDir(const char *const filename)
+    std::string getRealDir(const char *const filename)
     {
-        return PHYSFS_getRealDir(filename);
+        std::string realDir;
+        if (PhysFsIndex::getRealDir(filename, realDir))
+            return realDir;
+        const char *const dir = PHYSFS_getRealDir(filename);
+        if (dir)
+            realDir = dir;
+        return realDir;
     }
 
     bool mkdir(const char *const dirname)
     {
-        return PHYSFS_mkdir(dirname);
+        const bool ret = PHYSFS_mkdir(dirname);
+        PhysFsIndex::dirsChanged();
+        return ret;
     }
 
     void *loadFile(const std::string &fileName, int &fileSize)
     {
+        void *buffer = nullptr;
+        std::string realDir;
+        if (PhysFsIndex::loadFile(fileName.c_str(), buffer, fileSize,
+            realDir))
+        {
+            logger->log("Loaded %s/%s", realDir.c_str(), fileName.c_str());
+            return buffer;
+        }
+
         // Attempt to open the specified file using PhysicsFS
         PHYSFS_file *const file = PhysFs::openRead(fileName.c_str());
 
@@ -149,12 +182,12 @@ namespace PhysFs
             return nullptr;
         }
 
-        logger->log("Loaded %s/%s", PhysFs::getRealDir(fileName.c_str()),
-            fileName.c_str());
+        logger->log("Loaded %s/%s", PhysFs::getRealDir(
+            fileName.c_str()).c_str(), fileName.c_str());
 
         fileSize = static_cast<int>(PHYSFS_fileLength(file));
         // Allocate memory and load the file
-        void *const buffer = calloc(fileSize, 1);
+        buffer = calloc(fileSize, 1);
         PHYSFS_read(file, buffer, 1, fileSize);
         PHYSFS_close(file);
 
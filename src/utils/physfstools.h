@@ -41,7 +41,7 @@ namespace PhysFs
     bool setWriteDir(const char *const newDir);
     bool addToSearchPath(const char *const newDir, const int appendToPath);
     bool removeFromSearchPath(const char *const oldDir);
-    const char *getRealDir(const char *const filename);
+    std::string getRealDir(const char *const filename);
     bool mkdir(const char *const dirName);
     void *loadFile(const std::string &fileName, int &fileSize);
 }  // namespace PhysFs
@@ -22,6 +22,14 @@
 
 #include <unistd.h>
 
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <cstdio>
+#endif
+
 #include "localconsts.h"
 
 #ifdef USE_SDL2
@@ -290,3 +298,45 @@ void setPriority(const bool big A_UNUSED)
 {
 }
 #endif
+
+#ifdef WIN32
+bool getResourceUsage(int &rssKb A_UNUSED,
+                      int &maxRssKb A_UNUSED,
+                      int &cpuMs A_UNUSED)
+{
+    return false;
+}
+#else
+bool getResourceUsage(int &rssKb, int &maxRssKb, int &cpuMs)
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return false;
+#ifdef __APPLE__
+    // reported in bytes
+    maxRssKb = static_cast<int>(usage.ru_maxrss / 1024);
+#else
+    maxRssKb = static_cast<int>(usage.ru_maxrss);
+#endif
+    rssKb = maxRssKb;
+#ifdef __linux__
+    // current resident size in pages is second field
+    FILE *const file = fopen("/proc/self/statm", "r");
+    if (file)
+    {
+        long size = 0;
+        long resident = 0;
+        if (fscanf(file, "%ld %ld", &size, &resident) == 2)
+        {
+            rssKb = static_cast<int>(resident
+                * (sysconf(_SC_PAGESIZE) / 1024));
+        }
+        fclose(file);
+    }
+#endif
+    cpuMs = static_cast<int>((usage.ru_utime.tv_sec
+        + usage.ru_stime.tv_sec) * 1000
+        + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000);
+    return true;
+}
+#endif
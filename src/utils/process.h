@@ -34,4 +34,11 @@ bool openBrowser(std::string url);
 
 void setPriority(const bool big);
 
+/**
+ * Returns current and peak resident memory size in kilobytes and used
+ * cpu time in milliseconds of current process. Current size is peak size
+ * where system not report it.
+ */
+bool getResourceUsage(int &rssKb, int &maxRssKb, int &cpuMs);
+
 #endif  // UTILS_PROCESS_H
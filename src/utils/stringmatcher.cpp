@@ -0,0 +1,175 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/stringmatcher.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "debug.h"
+
+StringMatcher::StringMatcher() :
+    mTable(),
+    mLengths(),
+    mClassesCount(0),
+    mHasChars(false)
+{
+    memset(mClasses, 0, sizeof(mClasses));
+    memset(mChars, 0, sizeof(mChars));
+}
+
+void StringMatcher::clear()
+{
+    mTable.clear();
+    mLengths.clear();
+    mClassesCount = 0;
+    memset(mClasses, 0, sizeof(mClasses));
+    memset(mChars, 0, sizeof(mChars));
+    mHasChars = false;
+}
+
+void StringMatcher::buildChars(const std::string &chars)
+{
+    clear();
+    FOR_EACH (std::string::const_iterator, it, chars)
+    {
+        mChars[static_cast<unsigned char>(*it)] = true;
+        mHasChars = true;
+    }
+}
+
+void StringMatcher::build(const StringVect &patterns)
+{
+    clear();
+
+    // class 0 reserved for bytes not present in any pattern
+    int classes = 1;
+    FOR_EACH (StringVectCIter, it, patterns)
+    {
+        const std::string &str = *it;
+        FOR_EACH (std::string::const_iterator, it2, str)
+        {
+            const int chr = tolower(static_cast<unsigned char>(*it2));
+            if (!mClasses[chr])
+                mClasses[chr] = static_cast<unsigned char>(classes ++);
+        }
+    }
+    if (classes == 1)
+        return;
+
+    // lower case bytes mapped to self, so upper case can use them
+    for (int f = 0; f < 256; f ++)
+        mClasses[f] = mClasses[tolower(f)];
+
+    mClassesCount = classes;
+    mTable.assign(classes, -1);
+    mLengths.assign(1, 0);
+
+    // trie of patterns
+    int states = 1;
+    FOR_EACH (StringVectCIter, it, patterns)
+    {
+        const std::string &str = *it;
+        if (str.empty())
+            continue;
+        int state = 0;
+        FOR_EACH (std::string::const_iterator, it2, str)
+        {
+            const size_t idx = state * classes
+                + mClasses[static_cast<unsigned char>(*it2)];
+            if (mTable[idx] < 0)
+            {
+                mTable[idx] = states ++;
+                mTable.resize(states * classes, -1);
+                mLengths.push_back(0);
+            }
+            state = mTable[idx];
+        }
+        mLengths[state] = static_cast<unsigned int>(str.size());
+    }
+
+    // breadth first pass converts trie into automaton:
+    // missing transitions replaced by transitions of failure state.
+    std::vector<int> fails(states, 0);
+    std::vector<int> queue;
+    queue.reserve(states);
+    for (int cls = 0; cls < classes; cls ++)
+    {
+        int &next = mTable[cls];
+        if (next < 0)
+            next = 0;
+        else
+            queue.push_back(next);
+    }
+
+    const size_t queueSize = states - 1;
+    for (size_t f = 0; f < queueSize; f ++)
+    {
+        const int state = queue[f];
+        const int fail = fails[state];
+        if (!mLengths[state])
+            mLengths[state] = mLengths[fail];
+        for (int cls = 0; cls < classes; cls ++)
+        {
+            int &next = mTable[state * classes + cls];
+            const int fallback = mTable[fail * classes + cls];
+            if (next < 0)
+            {
+                next = fallback;
+            }
+            else
+            {
+                fails[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+size_t StringMatcher::find(const std::string &text) const
+{
+    if (mHasChars)
+    {
+        const size_t sz = text.size();
+        for (size_t f = 0; f < sz; f ++)
+        {
+            if (mChars[static_cast<unsigned char>(text[f])])
+                return f;
+        }
+        return std::string::npos;
+    }
+    if (mTable.empty())
+        return std::string::npos;
+
+    const int *const table = &mTable[0];
+    const unsigned int *const lengths = &mLengths[0];
+    const int classes = mClassesCount;
+    const size_t sz = text.size();
+    int state = 0;
+    for (size_t f = 0; f < sz; f ++)
+    {
+        state = table[state * classes
+            + mClasses[static_cast<unsigned char>(text[f])]];
+        const unsigned int len = lengths[state];
+        if (len)
+            return f + 1 - len;
+    }
+    return std::string::npos;
+}
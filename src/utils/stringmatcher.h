@@ -0,0 +1,76 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_STRINGMATCHER_H
+#define UTILS_STRINGMATCHER_H
+
+#include "utils/stringvector.h"
+
+#include "localconsts.h"
+
+/**
+ * Case insensitive search of many substrings at once.
+ *
+ * Patterns compiled into Aho-Corasick automaton when list changed, then
+ * each text scanned only once for all patterns.
+ */
+class StringMatcher final
+{
+    public:
+        StringMatcher();
+
+        A_DELETE_COPY(StringMatcher)
+
+        /**
+         * Compiles automaton for patterns. Empty patterns ignored.
+         */
+        void build(const StringVect &patterns);
+
+        /**
+         * Case sensitive search of any byte from string.
+         * Replaces patterns set by build.
+         */
+        void buildChars(const std::string &chars);
+
+        void clear();
+
+        bool empty() const A_WARN_UNUSED
+        { return mTable.empty() && !mHasChars; }
+
+        /**
+         * Returns position of first pattern found in text,
+         * or std::string::npos.
+         */
+        size_t find(const std::string &text) const A_WARN_UNUSED;
+
+    private:
+        /** Transitions, mClassesCount entries per state. */
+        std::vector<int> mTable;
+        /** Length of longest pattern ending in state, or 0. */
+        std::vector<unsigned int> mLengths;
+        int mClassesCount;
+        /** Char class for each byte, 0 for bytes not in patterns. */
+        unsigned char mClasses[256];
+        /** Bytes set by buildChars. */
+        bool mChars[256];
+        bool mHasChars;
+};
+
+#endif  // UTILS_STRINGMATCHER_H
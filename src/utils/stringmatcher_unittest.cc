@@ -0,0 +1,181 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/stringmatcher.h"
+
+#include "logger.h"
+
+#include "utils/delete2.h"
+#include "utils/stringutils.h"
+
+#include "gtest/gtest.h"
+
+#include <SDL_timer.h>
+
+#include "debug.h"
+
+TEST(StringMatcher, find)
+{
+    StringMatcher matcher;
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_EQ(std::string::npos, matcher.find("text"));
+
+    StringVect patterns;
+    patterns.push_back("he");
+    patterns.push_back("She");
+    patterns.push_back("his");
+    patterns.push_back("hers");
+    patterns.push_back("");
+    matcher.build(patterns);
+    EXPECT_FALSE(matcher.empty());
+
+    EXPECT_EQ(std::string::npos, matcher.find(""));
+    EXPECT_EQ(std::string::npos, matcher.find("abc"));
+    EXPECT_EQ(0U, matcher.find("HE"));
+    EXPECT_EQ(1U, matcher.find("ushers"));
+    EXPECT_EQ(1U, matcher.find("ahIs"));
+    EXPECT_EQ(3U, matcher.find("abhhe"));
+    EXPECT_EQ(std::string::npos, matcher.find("h e s"));
+
+    patterns.clear();
+    matcher.build(patterns);
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_EQ(std::string::npos, matcher.find("he"));
+
+    // chars matched case sensitive, like unsecureChars in isGoodName
+    matcher.buildChars("IO0@#$");
+    EXPECT_FALSE(matcher.empty());
+    EXPECT_EQ(std::string::npos, matcher.find("name"));
+    EXPECT_EQ(std::string::npos, matcher.find("1i"));
+    EXPECT_EQ(std::string::npos, matcher.find("io lion"));
+    EXPECT_EQ(1U, matcher.find("1I"));
+    EXPECT_EQ(4U, matcher.find("name@"));
+    EXPECT_EQ(2U, matcher.find("\xd0\xbeO"));
+    for (size_t f = 0; f < 6; f ++)
+    {
+        const char *const check = "IO0@#$";
+        const std::string name = std::string("abc") + check[f];
+        EXPECT_EQ(name.find_first_of(check), matcher.find(name));
+    }
+
+    matcher.buildChars("");
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_EQ(std::string::npos, matcher.find("name@"));
+
+    // build replaces chars
+    matcher.buildChars("@");
+    patterns.push_back("he");
+    matcher.build(patterns);
+    EXPECT_EQ(std::string::npos, matcher.find("name@"));
+    EXPECT_EQ(0U, matcher.find("HE"));
+}
+
+TEST(StringMatcher, findI)
+{
+    StringVect patterns;
+    patterns.push_back("sell");
+    patterns.push_back("buy");
+    patterns.push_back("zeny");
+    patterns.push_back("Bone");
+    patterns.push_back("one");
+    StringMatcher matcher;
+    matcher.build(patterns);
+
+    const char *const lines[] =
+    {
+        "player: S> Bone Helmet",
+        "player: hello all",
+        "player: b> zeny for items",
+        "player: someone there?",
+        "player: BUYING",
+        "player: nothing"
+    };
+    for (size_t f = 0; f < sizeof(lines) / sizeof(lines[0]); f ++)
+    {
+        EXPECT_EQ(findI(lines[f], patterns) != std::string::npos,
+            matcher.find(lines[f]) != std::string::npos);
+    }
+}
+
+TEST(StringMatcher, DISABLED_benchmark)
+{
+    logger = new Logger();
+
+    StringVect patterns;
+    const char *const words[] =
+    {
+        "sell", "buy", "trade", "zeny", "gp", "s>", "b>", "t>",
+        "wts", "wtb", "price", "offer", "cheap", "shop", "vend", "auction",
+        "PlayerName", "friend", "party", "guild", "event", "drop",
+        "help", "warp", "gm", "admin", "boss", "spawn", "quest", "reward"
+    };
+    for (size_t f = 0; f < sizeof(words) / sizeof(words[0]); f ++)
+        patterns.push_back(words[f]);
+
+    // chat flood: mostly lines without any pattern
+    const char *const flood[] =
+    {
+        "Spammer: lalalalalalalalalalalalalalalalalalalalala",
+        "Someone: hi there, how are you all doing today?",
+        "Another: i am looking for my lost dog, please",
+        "Trader: S> Bone Helmet, Red Potion x100, cheap!!!",
+        "Walker: lol",
+        "Runner: where is the cave entrance near town?"
+    };
+    const int floodSize = sizeof(flood) / sizeof(flood[0]);
+    StringVect lines;
+    for (int f = 0; f < 60000; f ++)
+        lines.push_back(flood[f % floodSize]);
+
+    StringMatcher matcher;
+    uint32_t startTime = SDL_GetTicks();
+    for (int f = 0; f < 100; f ++)
+        matcher.build(patterns);
+    logger->log("stringmatcher: %d patterns compiled 100 times in %d ms",
+        static_cast<int>(patterns.size()),
+        static_cast<int>(SDL_GetTicks() - startTime));
+
+    int found1 = 0;
+    startTime = SDL_GetTicks();
+    FOR_EACH (StringVectCIter, it, lines)
+    {
+        if (findI(*it, patterns) != std::string::npos)
+            found1 ++;
+    }
+    logger->log("stringmatcher: findI %d lines in %d ms",
+        static_cast<int>(lines.size()),
+        static_cast<int>(SDL_GetTicks() - startTime));
+
+    int found2 = 0;
+    startTime = SDL_GetTicks();
+    FOR_EACH (StringVectCIter, it, lines)
+    {
+        if (matcher.find(*it) != std::string::npos)
+            found2 ++;
+    }
+    logger->log("stringmatcher: matcher %d lines in %d ms",
+        static_cast<int>(lines.size()),
+        static_cast<int>(SDL_GetTicks() - startTime));
+
+    EXPECT_EQ(found1, found2);
+    EXPECT_NE(0, found2);
+
+    delete2(logger);
+}
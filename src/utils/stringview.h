@@ -0,0 +1,84 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_STRINGVIEW_H
+#define UTILS_STRINGVIEW_H
+
+#include <cstring>
+#include <string>
+
+#include "localconsts.h"
+
+/**
+ * Not owning pointer and length of string part.
+ * Data must live while view used, for packets only inside handler.
+ */
+class StringView final
+{
+    public:
+        StringView() :
+            mData(""),
+            mSize(0)
+        { }
+
+        StringView(const char *const data, const size_t size) :
+            mData(data),
+            mSize(size)
+        { }
+
+        const char *data() const A_WARN_UNUSED
+        { return mData; }
+
+        size_t size() const A_WARN_UNUSED
+        { return mSize; }
+
+        bool empty() const A_WARN_UNUSED
+        { return mSize == 0; }
+
+        /**
+         * Copies view into new string.
+         */
+        std::string str() const A_WARN_UNUSED
+        { return std::string(mData, mSize); }
+
+        bool operator==(const std::string &str) const A_WARN_UNUSED
+        {
+            return mSize == str.size()
+                && !memcmp(mData, str.data(), mSize);
+        }
+
+        bool operator!=(const std::string &str) const A_WARN_UNUSED
+        { return !(*this == str); }
+
+        bool operator==(const char *const str) const A_WARN_UNUSED
+        {
+            return !strncmp(mData, str, mSize)
+                && str[mSize] == '\0';
+        }
+
+        bool operator!=(const char *const str) const A_WARN_UNUSED
+        { return !(*this == str); }
+
+    private:
+        const char *mData;
+        size_t mSize;
+};
+
+#endif  // UTILS_STRINGVIEW_H
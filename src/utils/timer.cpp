@@ -107,6 +107,20 @@ int get_elapsed_time1(const int startTime)
         return time + (MAX_TICK_VALUE - startTime);
 }
 
+unsigned int get_time_usec()
+{
+#ifdef USE_SDL2
+    const uint64_t freq = SDL_GetPerformanceFrequency();
+    if (freq)
+    {
+        const uint64_t counter = SDL_GetPerformanceCounter();
+        return static_cast<unsigned int>(counter / freq * 1000000U
+            + counter % freq * 1000000U / freq);
+    }
+#endif
+    return SDL_GetTicks() * 1000U;
+}
+
 void startTimers()
 {
     // Initialize logic and seconds counters
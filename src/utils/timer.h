@@ -46,4 +46,10 @@ int get_elapsed_time(const int startTime) A_WARN_UNUSED;
 
 int get_elapsed_time1(const int startTime) A_WARN_UNUSED;
 
+/**
+ * Returns time in microseconds for statistics. Value wraps around,
+ * so only difference between two values is meaningful.
+ */
+unsigned int get_time_usec() A_WARN_UNUSED;
+
 #endif  // UTILS_TIMER_H
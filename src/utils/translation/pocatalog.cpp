@@ -0,0 +1,307 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utils/translation/pocatalog.h"
+
+#include "utils/mkdir.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "debug.h"
+
+namespace
+{
+    const uint32_t CATALOG_MAGIC = 0x54434f50U;
+    const uint32_t CATALOG_VERSION = 1;
+
+    // magic, version, source size, source hash, count, table size,
+    // pool size
+    const size_t HEADER_FIELDS = 7;
+    const size_t HEADER_SIZE = HEADER_FIELDS * sizeof(uint32_t);
+}  // namespace
+
+PoCatalog::PoCatalog() :
+    mBuffer(),
+    mMapped(nullptr),
+    mMappedSize(0),
+    mTable(nullptr),
+    mPool(nullptr),
+    mTableSize(0),
+    mCount(0)
+{
+}
+
+PoCatalog::~PoCatalog()
+{
+#ifndef WIN32
+    if (mMapped)
+        munmap(mMapped, mMappedSize);
+#endif
+}
+
+uint32_t PoCatalog::hash(const char *const data, const size_t len)
+{
+    // FNV-1a
+    uint32_t value = 2166136261U;
+    for (size_t f = 0; f < len; f ++)
+    {
+        value ^= static_cast<unsigned char>(data[f]);
+        value *= 16777619U;
+    }
+    return value;
+}
+
+PoCatalog *PoCatalog::create(const PoMap &strings)
+{
+    const uint32_t count = static_cast<uint32_t>(strings.size());
+    uint32_t tableSize = 16;
+    while (tableSize < count * 2)
+        tableSize <<= 1;
+
+    // offset 0 in pool used as empty slot mark
+    size_t poolSize = 1;
+    FOR_EACH (PoMap::const_iterator, it, strings)
+        poolSize += (*it).first.size() + (*it).second.size() + 2;
+
+    const size_t tableBytes = tableSize * sizeof(Entry);
+    const size_t size = HEADER_SIZE + tableBytes + poolSize;
+    PoCatalog *const catalog = new PoCatalog;
+    std::vector<char> &buf = catalog->mBuffer;
+    buf.assign(size, 0);
+
+    uint32_t *const header = reinterpret_cast<uint32_t*>(&buf[0]);
+    header[0] = CATALOG_MAGIC;
+    header[1] = CATALOG_VERSION;
+    header[4] = count;
+    header[5] = tableSize;
+    header[6] = static_cast<uint32_t>(poolSize);
+
+    Entry *const table = reinterpret_cast<Entry*>(&buf[HEADER_SIZE]);
+    char *const pool = &buf[HEADER_SIZE + tableBytes];
+    const uint32_t mask = tableSize - 1;
+    uint32_t pos = 1;
+    FOR_EACH (PoMap::const_iterator, it, strings)
+    {
+        const std::string &key = (*it).first;
+        const std::string &value = (*it).second;
+        const uint32_t keyHash = hash(key.c_str(), key.size());
+        uint32_t slot = keyHash & mask;
+        while (table[slot].key)
+            slot = (slot + 1) & mask;
+
+        Entry &entry = table[slot];
+        entry.hash = keyHash;
+        entry.key = pos;
+        memcpy(pool + pos, key.c_str(), key.size() + 1);
+        pos += static_cast<uint32_t>(key.size() + 1);
+        entry.value = pos;
+        memcpy(pool + pos, value.c_str(), value.size() + 1);
+        pos += static_cast<uint32_t>(value.size() + 1);
+    }
+
+    catalog->init(&buf[0], size);
+    return catalog;
+}
+
+bool PoCatalog::init(const char *const data, const size_t size)
+{
+    if (size < HEADER_SIZE)
+        return false;
+
+    const uint32_t *const header = reinterpret_cast<const uint32_t*>(data);
+    const uint32_t count = header[4];
+    const uint32_t tableSize = header[5];
+    const uint32_t poolSize = header[6];
+    if (header[0] != CATALOG_MAGIC
+        || header[1] != CATALOG_VERSION
+        || !tableSize
+        || (tableSize & (tableSize - 1))
+        || count >= tableSize
+        || tableSize > (size - HEADER_SIZE) / sizeof(Entry)
+        || !poolSize
+        || size != HEADER_SIZE + tableSize * sizeof(Entry) + poolSize)
+    {
+        return false;
+    }
+
+    const Entry *const table = reinterpret_cast<const Entry*>(
+        data + HEADER_SIZE);
+    const char *const pool = data + HEADER_SIZE
+        + tableSize * sizeof(Entry);
+    if (pool[poolSize - 1])
+        return false;
+
+    // broken cache file must not give pointers out of pool
+    uint32_t found = 0;
+    for (uint32_t f = 0; f < tableSize; f ++)
+    {
+        const Entry &entry = table[f];
+        if (!entry.key)
+            continue;
+        if (entry.key >= poolSize || entry.value >= poolSize)
+            return false;
+        found ++;
+    }
+    if (found != count)
+        return false;
+
+    mTable = table;
+    mPool = pool;
+    mTableSize = tableSize;
+    mCount = count;
+    return true;
+}
+
+PoCatalog *PoCatalog::load(const std::string &fileName,
+                           const uint32_t sourceSize,
+                           const uint32_t sourceHash)
+{
+#ifndef WIN32
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st)
+        || st.st_size < static_cast<off_t>(HEADER_SIZE))
+    {
+        close(fd);
+        return nullptr;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void *const ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return nullptr;
+
+    PoCatalog *const catalog = new PoCatalog;
+    catalog->mMapped = ptr;
+    catalog->mMappedSize = size;
+    const char *const data = static_cast<const char*>(ptr);
+#else
+    FILE *const file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return nullptr;
+
+    fseek(file, 0, SEEK_END);
+    const long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < static_cast<long>(HEADER_SIZE))
+    {
+        fclose(file);
+        return nullptr;
+    }
+    const size_t size = static_cast<size_t>(fileSize);
+    PoCatalog *const catalog = new PoCatalog;
+    catalog->mBuffer.resize(size);
+    const bool ok = fread(&catalog->mBuffer[0], 1, size, file) == size;
+    fclose(file);
+    if (!ok)
+    {
+        delete catalog;
+        return nullptr;
+    }
+    const char *const data = &catalog->mBuffer[0];
+#endif
+
+    const uint32_t *const header = reinterpret_cast<const uint32_t*>(data);
+    if (!catalog->init(data, size)
+        || header[2] != sourceSize
+        || header[3] != sourceHash)
+    {
+        delete catalog;
+        return nullptr;
+    }
+    return catalog;
+}
+
+bool PoCatalog::save(const std::string &fileName,
+                     const uint32_t sourceSize,
+                     const uint32_t sourceHash) const
+{
+    if (mBuffer.empty())
+        return false;
+
+    const size_t pos = fileName.rfind("/");
+    if (pos != std::string::npos
+        && mkdir_r(fileName.substr(0, pos).c_str()))
+    {
+        return false;
+    }
+
+    const std::string tempName = fileName + ".tmp";
+    FILE *const file = fopen(tempName.c_str(), "wb");
+    if (!file)
+        return false;
+
+    uint32_t header[HEADER_FIELDS];
+    memcpy(header, &mBuffer[0], HEADER_SIZE);
+    header[2] = sourceSize;
+    header[3] = sourceHash;
+    fwrite(header, HEADER_SIZE, 1, file);
+    fwrite(&mBuffer[HEADER_SIZE], mBuffer.size() - HEADER_SIZE, 1, file);
+    const bool failed = ferror(file) != 0;
+    fclose(file);
+
+#ifdef WIN32
+    // rename not replaces existing file
+    if (!failed)
+        remove(fileName.c_str());
+#endif
+    if (failed || rename(tempName.c_str(), fileName.c_str()))
+    {
+        remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+const char *PoCatalog::find(const char *const key,
+                            const size_t len) const
+{
+    if (!mCount)
+        return nullptr;
+
+    const uint32_t keyHash = hash(key, len);
+    const uint32_t mask = mTableSize - 1;
+    uint32_t slot = keyHash & mask;
+    while (mTable[slot].key)
+    {
+        const Entry &entry = mTable[slot];
+        if (entry.hash == keyHash
+            && !strncmp(mPool + entry.key, key, len)
+            && !mPool[entry.key + len])
+        {
+            return mPool + entry.value;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return nullptr;
+}
@@ -0,0 +1,101 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UTILS_TRANSLATION_POCATALOG_H
+#define UTILS_TRANSLATION_POCATALOG_H
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "localconsts.h"
+
+typedef std::map <std::string, std::string> PoMap;
+
+/**
+ * Compiled translations. Open addressing hash table with offsets into
+ * one strings pool. Same data block used in memory and in cache file,
+ * so cached catalog used directly from mapped file.
+ */
+class PoCatalog final
+{
+    public:
+        A_DELETE_COPY(PoCatalog)
+
+        ~PoCatalog();
+
+        /**
+         * Compiles catalog from parsed strings.
+         */
+        static PoCatalog *create(const PoMap &strings) A_WARN_UNUSED;
+
+        /**
+         * Loads catalog from cache file, if it was compiled from po file
+         * with same size and hash. Returns nullptr in other case.
+         */
+        static PoCatalog *load(const std::string &fileName,
+                               const uint32_t sourceSize,
+                               const uint32_t sourceHash) A_WARN_UNUSED;
+
+        bool save(const std::string &fileName,
+                  const uint32_t sourceSize,
+                  const uint32_t sourceHash) const;
+
+        /**
+         * Returns translation for key or nullptr.
+         */
+        const char *find(const char *const key,
+                         const size_t len) const A_WARN_UNUSED;
+
+        uint32_t size() const A_WARN_UNUSED
+        { return mCount; }
+
+        static uint32_t hash(const char *const data,
+                             const size_t len) A_WARN_UNUSED;
+
+    private:
+        struct Entry final
+        {
+            uint32_t hash;
+            uint32_t key;
+            uint32_t value;
+        };
+
+        PoCatalog();
+
+        bool init(const char *const data, const size_t size);
+
+        std::vector<char> mBuffer;
+        void *mMapped;
+        size_t mMappedSize;
+        const Entry *mTable;
+        const char *mPool;
+        uint32_t mTableSize;
+        uint32_t mCount;
+};
+
+#endif  // UTILS_TRANSLATION_POCATALOG_H
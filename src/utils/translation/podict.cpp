@@ -20,6 +20,12 @@
 
 #include "utils/translation/podict.h"
 
+#include "utils/dtor.h"
+
+#include "utils/translation/pocatalog.h"
+
+#include <string.h>
+
 #include "debug.h"
 
 std::string empty;
@@ -27,25 +33,52 @@ std::string empty;
 PoDict *translator = nullptr;
 
 PoDict::PoDict(std::string lang) :
-    mPoLines(),
+    mCatalogs(),
     mLang(lang)
 {
 }
 
 PoDict::~PoDict()
 {
+    delete_all(mCatalogs);
+    mCatalogs.clear();
+}
+
+const char *PoDict::find(const char *const str,
+                         const size_t len) const
+{
+    // usually only main and help catalogs
+    for (Catalogs::const_reverse_iterator it = mCatalogs.rbegin(),
+         it_end = mCatalogs.rend(); it != it_end; ++ it)
+    {
+        const char *const value = (*it)->find(str, len);
+        if (value)
+            return value;
+    }
+    return nullptr;
 }
 
 const std::string PoDict::getStr(const std::string &str)
 {
-    if (mPoLines.find(str) == mPoLines.end())
+    const char *const value = find(str.c_str(), str.size());
+    if (!value)
         return str;
-    return mPoLines[str];
+    return value;
 }
 
 const char *PoDict::getChar(const char *const str)
 {
-    if (mPoLines.find(str) == mPoLines.end())
+    if (mCatalogs.empty())
+        return str;
+    const char *const value = find(str, strlen(str));
+    if (!value)
         return str;
-    return mPoLines[str].c_str();
+    return value;
+}
+
+void PoDict::addCatalog(PoCatalog *const catalog)
+{
+    if (!catalog)
+        return;
+    mCatalogs.push_back(catalog);
 }
@@ -21,12 +21,12 @@
 #ifndef UTILS_TRANSLATION_PODICT_H
 #define UTILS_TRANSLATION_PODICT_H
 
-#include <map>
 #include <string>
+#include <vector>
 
 #include "localconsts.h"
 
-typedef std::map <std::string, std::string> PoMap;
+class PoCatalog;
 
 class PoDict final
 {
@@ -44,17 +44,22 @@ class PoDict final
     protected:
         friend class PoParser;
 
-        PoMap *getMap()
-        { return &mPoLines; }
-
-        void set(const std::string &key, const std::string &value)
-        { mPoLines[key] = value; }
+        /**
+         * Adds translations from catalog, with replacing old ones.
+         * Dict takes ownership of catalog.
+         * Catalogs not merged, newest catalog searched first.
+         */
+        void addCatalog(PoCatalog *const catalog);
 
         void setLang(const std::string &lang)
         { mLang = lang; }
 
     private:
-        PoMap mPoLines;
+        const char *find(const char *const str,
+                         const size_t len) const A_WARN_UNUSED;
+
+        typedef std::vector<PoCatalog*> Catalogs;
+        Catalogs mCatalogs;
         std::string mLang;
 };
 
@@ -20,8 +20,6 @@
 
 #include "utils/translation/poparser.h"
 
-#include "resources/resourcemanager.h"
-
 #include "utils/physfstools.h"
 #include "utils/stringutils.h"
 
@@ -31,6 +29,8 @@
 
 #include "debug.h"
 
+std::string PoParser::mCacheDir;
+
 PoParser::PoParser() :
     mLang(),
     mFile(),
@@ -43,25 +43,6 @@ PoParser::PoParser() :
 {
 }
 
-void PoParser::openFile(const std::string &name)
-{
-    const ResourceManager *const resman = ResourceManager::getInstance();
-    if (!resman)
-        return;
-    int size;
-    char *buf = static_cast<char*>(PhysFs::loadFile(getFileName(name), size));
-
-    if (buf)
-    {
-        mFile.str(std::string(buf, size));
-        free(buf);
-    }
-    else
-    {
-        mFile.clear();
-    }
-}
-
 PoDict *PoParser::load(const std::string &restrict lang,
                        const std::string &restrict fileName,
                        PoDict *restrict const dict)
@@ -74,13 +55,48 @@ PoDict *PoParser::load(const std::string &restrict lang,
     else
         mDict = dict;
 
-    if (fileName.empty())
-        openFile(mLang);
-    else
-        openFile(fileName);
+    const std::string name = fileName.empty() ? mLang : fileName;
+    int size = 0;
+    char *const buf = static_cast<char*>(PhysFs::loadFile(
+        getFileName(name), size));
+    if (!buf)
+        return mDict;
+
+    // compiled catalog valid while po file not changed
+    const uint32_t sourceSize = static_cast<uint32_t>(size);
+    const uint32_t sourceHash = PoCatalog::hash(buf, size);
+    const std::string cacheName = getCacheFileName(name);
+    PoCatalog *catalog = nullptr;
+    if (!cacheName.empty())
+        catalog = PoCatalog::load(cacheName, sourceSize, sourceHash);
+
+    if (!catalog)
+    {
+        mFile.clear();
+        mFile.str(std::string(buf, size));
+        PoMap strings;
+        parse(strings);
+        mFile.str(std::string());
+        catalog = PoCatalog::create(strings);
+        if (!cacheName.empty()
+            && !catalog->save(cacheName, sourceSize, sourceHash))
+        {
+            logger->log("Unable to save translations cache: %s",
+                cacheName.c_str());
+        }
+    }
+    free(buf);
+
+    mDict->addCatalog(catalog);
+    return mDict;
+}
 
+void PoParser::parse(PoMap &strings)
+{
     mMsgId.clear();
     mMsgStr.clear();
+    mReadingId = false;
+    mReadingStr = false;
 
     // cycle by msgid+msgstr
     while (readLine())
@@ -104,28 +120,21 @@ PoDict *PoParser::load(const std::string &restrict lang,
 
         if (!mMsgId.empty() && !mMsgStr.empty())
         {
-//            logger->log("add key: " + mMsgId);
-//            logger->log("add value: " + mMsgStr);
-
             convertStr(mMsgId);
             convertStr(mMsgStr);
             // store key and value
-            mDict->set(mMsgId, mMsgStr);
+            strings[mMsgId] = mMsgStr;
         }
 
         mMsgId.clear();
         mMsgStr.clear();
     }
-
-    return mDict;
 }
 
 bool PoParser::readLine()
 {
-    char line[1001];
-    if (!mFile.getline(line, 1000))
+    if (!std::getline(mFile, mLine))
         return false;
-    mLine = line;
     return true;
 }
 
@@ -242,6 +251,13 @@ std::string PoParser::getFileName(const std::string &lang)
     return strprintf("translations/%s.po", lang.c_str());
 }
 
+std::string PoParser::getCacheFileName(const std::string &lang)
+{
+    if (mCacheDir.empty())
+        return std::string();
+    return strprintf("%s/%s.bin", mCacheDir.c_str(), lang.c_str());
+}
+
 PoDict *PoParser::getDict() const
 {
     return new PoDict(mLang);
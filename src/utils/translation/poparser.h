@@ -23,6 +23,8 @@
 
 #include "localconsts.h"
 
+#include "utils/translation/pocatalog.h"
+
 #include <sstream>
 
 class PoDict;
@@ -42,11 +44,18 @@ class PoParser final
 
         static PoDict *getEmptyDict();
 
+        /**
+         * Sets directory for compiled catalogs cache.
+         * Empty directory disables cache.
+         */
+        static void setCacheDir(const std::string &dir)
+        { mCacheDir = dir; }
+
     private:
         void setLang(const std::string &lang)
         { mLang = lang; }
 
-        void openFile(const std::string &name);
+        void parse(PoMap &strings);
 
         bool readLine();
 
@@ -58,6 +67,8 @@ class PoParser final
 
         static std::string getFileName(const std::string &lang);
 
+        static std::string getCacheFileName(const std::string &lang);
+
         PoDict *getDict() const;
 
         static void convertStr(std::string &str);
@@ -80,6 +91,8 @@ class PoParser final
         bool mReadingId;
 
         bool mReadingStr;
+
+        static std::string mCacheDir;
 };
 
 #endif  // UTILS_TRANSLATION_POPARSER_H
@@ -0,0 +1,206 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2015  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utils/translation/poparser.h"
+
+#include "client.h"
+#include "logger.h"
+
+#include "utils/delete2.h"
+#include "utils/physfstools.h"
+
+#include "utils/translation/podict.h"
+
+#include "resources/resourcemanager.h"
+
+#include "gtest/gtest.h"
+
+#include <SDL_timer.h>
+
+#include <stdio.h>
+
+#include "debug.h"
+
+namespace
+{
+    const char *const cacheDir = "pocache";
+
+    // bundled help translations
+    const char *const langs[] =
+    {
+        "cs", "de", "es", "fr", "id", "it", "ja", "nl", "nl_BE", "pl",
+        "pt_BR", "ru", "sr", "sv_SE", "tr", "uk", "zh_CN"
+    };
+    const size_t langsSize = sizeof(langs) / sizeof(langs[0]);
+
+    void init()
+    {
+        PHYSFS_init("manaplus");
+        dirSeparator = "/";
+        logger = new Logger();
+        ResourceManager *const resman = ResourceManager::getInstance();
+        resman->addToSearchPath("data", false);
+        resman->addToSearchPath("../data", false);
+    }
+}  // namespace
+
+TEST(PoCatalog, find)
+{
+    PoMap strings;
+    strings["Map"] = "Karte";
+    strings["Quit"] = "Beenden";
+    strings["\"Outfit 1\""] = "\"Ausstattung 1\"";
+    PoCatalog *const catalog = PoCatalog::create(strings);
+    ASSERT_NE(nullptr, catalog);
+    EXPECT_EQ(3U, catalog->size());
+    EXPECT_STREQ("Karte", catalog->find("Map", 3));
+    EXPECT_STREQ("Beenden", catalog->find("Quit", 4));
+    EXPECT_STREQ("\"Ausstattung 1\"", catalog->find("\"Outfit 1\"", 10));
+    EXPECT_EQ(nullptr, catalog->find("Ma", 2));
+    EXPECT_EQ(nullptr, catalog->find("Maps", 4));
+    EXPECT_EQ(nullptr, catalog->find("", 0));
+
+    // cache file used only for same po file
+    const std::string fileName = std::string(cacheDir) + "/test.bin";
+    EXPECT_TRUE(catalog->save(fileName, 100, 12345));
+    EXPECT_EQ(nullptr, PoCatalog::load(fileName, 100, 12346));
+    EXPECT_EQ(nullptr, PoCatalog::load(fileName, 101, 12345));
+    PoCatalog *const catalog2 = PoCatalog::load(fileName, 100, 12345);
+    ASSERT_NE(nullptr, catalog2);
+    EXPECT_EQ(3U, catalog2->size());
+    EXPECT_STREQ("Karte", catalog2->find("Map", 3));
+    EXPECT_EQ(nullptr, catalog2->find("Maps", 4));
+
+    FOR_EACH (PoMap::const_iterator, it, strings)
+    {
+        EXPECT_STREQ((*it).second.c_str(),
+            catalog2->find((*it).first.c_str(), (*it).first.size()));
+    }
+
+    // broken cache file
+    FILE *const file = fopen(fileName.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    fseek(file, 20, SEEK_SET);
+    const unsigned char bad[4] = {0xff, 0xff, 0xff, 0x7f};
+    fwrite(bad, 4, 1, file);
+    fclose(file);
+    EXPECT_EQ(nullptr, PoCatalog::load(fileName, 100, 12345));
+
+    remove(fileName.c_str());
+    delete catalog;
+    delete catalog2;
+}
+
+TEST(PoParser, DISABLED_benchmark)
+{
+    client = new Client;
+    init();
+    PoParser::setCacheDir(cacheDir);
+
+    for (size_t f = 0; f < langsSize; f ++)
+    {
+        const std::string name = std::string("help/") + langs[f];
+        remove((std::string(cacheDir) + "/" + name + ".bin").c_str());
+    }
+
+    uint32_t startTime = SDL_GetTicks();
+    for (size_t f = 0; f < langsSize; f ++)
+    {
+        PoParser parser;
+        PoDict *const dict = parser.load(langs[f],
+            std::string("help/") + langs[f]);
+        delete dict;
+    }
+    logger->log("poparser: %d languages parsed in %d ms",
+        static_cast<int>(langsSize),
+        static_cast<int>(SDL_GetTicks() - startTime));
+
+    startTime = SDL_GetTicks();
+    for (size_t f = 0; f < langsSize; f ++)
+    {
+        PoParser parser;
+        PoDict *const dict = parser.load(langs[f],
+            std::string("help/") + langs[f]);
+        delete dict;
+    }
+    logger->log("poparser: %d languages loaded from cache in %d ms",
+        static_cast<int>(langsSize),
+        static_cast<int>(SDL_GetTicks() - startTime));
+
+    // parsed and cached catalogs must translate same way
+    for (int n = 0; n < 2; n ++)
+    {
+        PoParser parser;
+        PoDict *const dict = parser.load("ru", "help/ru");
+        EXPECT_EQ("\xd0\x9d\xd0\xb0\xd1\x91\xd0\xbc\xd0\xbd\xd0\xb8\xd0\xba"
+            "\xd0\xb8 \xd0\xb8\xd0\xbb\xd0\xb8 \xd0\xb3\xd0\xbe\xd0\xbc"
+            "\xd1\x83\xd0\xbd\xd0\xba\xd1\x83\xd0\xbb\xd1\x8b",
+            dict->getStr("Mercenaries or homunculuses"));
+        EXPECT_STREQ("\"\xd0\x9d\xd0\xb0\xd1\x80\xd1\x8f\xd0\xb4 12\"",
+            dict->getChar("\"Outfit shortcut 12\""));
+        EXPECT_EQ("not translated", dict->getStr("not translated"));
+        delete dict;
+        PoParser::setCacheDir("");
+    }
+
+    for (size_t f = 0; f < langsSize; f ++)
+    {
+        const std::string name = std::string("help/") + langs[f];
+        remove((std::string(cacheDir) + "/" + name + ".bin").c_str());
+    }
+    delete2(logger);
+    delete2(client);
+}
+
+TEST(PoParser, layers)
+{
+    client = new Client;
+    init();
+    PoParser::setCacheDir("");
+
+    // catalog loaded later override strings from older catalogs
+    PoParser parser;
+    PoDict *dict = parser.load("de", "help/de");
+    ASSERT_NE(nullptr, dict);
+    EXPECT_EQ("S\xc3\xb6ldner oder Homunkuluse",
+        dict->getStr("Mercenaries or homunculuses"));
+    PoParser parser2;
+    EXPECT_EQ(dict, parser2.load("ru", "help/ru", dict));
+    EXPECT_EQ("\xd0\x9d\xd0\xb0\xd1\x91\xd0\xbc\xd0\xbd\xd0\xb8\xd0\xba"
+        "\xd0\xb8 \xd0\xb8\xd0\xbb\xd0\xb8 \xd0\xb3\xd0\xbe\xd0\xbc"
+        "\xd1\x83\xd0\xbd\xd0\xba\xd1\x83\xd0\xbb\xd1\x8b",
+        dict->getStr("Mercenaries or homunculuses"));
+    EXPECT_EQ("not translated", dict->getStr("not translated"));
+    delete dict;
+
+    PoParser parser3;
+    dict = parser3.load("ru", "help/ru");
+    PoParser parser4;
+    EXPECT_EQ(dict, parser4.load("de", "help/de", dict));
+    EXPECT_EQ("S\xc3\xb6ldner oder Homunkuluse",
+        dict->getStr("Mercenaries or homunculuses"));
+    EXPECT_STREQ("\"Kurzbefehl Ausr\xc3\xbcstungset 12\"",
+        dict->getChar("\"Outfit shortcut 12\""));
+    delete dict;
+
+    delete2(logger);
+    delete2(client);
+}